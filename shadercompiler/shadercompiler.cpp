@@ -128,7 +128,7 @@ static void InitializeShaderFilesDependencies()
 
         for (std::string_view shaderFileDir : elem.second.m_UniqueDependencies)
         {
-             boost::hash_combine(elem.second.m_FullHash, GetFileContentsHash(shaderFileDir.data()));
+             elem.second.m_FullHash = HashUtils::Combine(elem.second.m_FullHash, GetFileContentsHash(shaderFileDir.data()));
              metaDataJSON[elem.first] = elem.second.m_FullHash;
         }
     }
@@ -200,6 +200,8 @@ int main()
         PrintAutogenByteCodeHeadersFile(allShaders);
     }
 
+    Logger::GetInstance().ShutDown();
+
     system("pause");
     return 0;
 }
@@ -47,8 +47,32 @@ Visual* Scene::GetVisualFromID(ObjectID id)
 {
     if (id == ID_InvalidObject) return nullptr;
 
-    auto it = std::find_if(m_AllVisuals.begin(), m_AllVisuals.end(), [&](Visual* v) { return v->m_ObjectID == id; });
-    return it == m_AllVisuals.end() ? nullptr : *it;
+    auto it = m_VisualsByID.find(id);
+    return it == m_VisualsByID.end() ? nullptr : it->second;
+}
+
+void Scene::AddVisualInternal(Visual* visual)
+{
+    bbeMultiThreadDetector();
+    assert(m_AllVisuals.size() < C_VISUALS_ARRAY_SZ); // Ensure it doesnt grow and invalid all Visual ptrs in the engine
+
+    const bool inserted = m_VisualsByID.emplace(visual->m_ObjectID, visual).second;
+    assert(inserted);
+
+    m_AllVisuals.push_back(visual);
+}
+
+void Scene::RemoveVisualInternal(Visual* visual)
+{
+    bbeMultiThreadDetector();
+
+    auto it = std::find(m_AllVisuals.begin(), m_AllVisuals.end(), visual);
+    assert(it != m_AllVisuals.end());
+    std::swap(*it, m_AllVisuals.back());
+    m_AllVisuals.pop_back();
+
+    const std::size_t numErased = m_VisualsByID.erase(visual->m_ObjectID);
+    assert(numErased == 1);
 }
 
 void Scene::OpenSceneWindow()
@@ -75,12 +99,7 @@ void Scene::AddNewVisual()
     Visual* newVisual = m_VisualsPool.construct();
 
     // add to container in the beginning of the next engine frame
-    g_System.AddSystemCommand([&, newVisual]()
-        {
-            bbeMultiThreadDetector();
-            assert(m_AllVisuals.size() < C_VISUALS_ARRAY_SZ); // Ensure it doesnt grow and invalid all Visual ptrs in the engine
-            m_AllVisuals.push_back(newVisual);
-        });
+    g_System.AddSystemCommand([&, newVisual]() { AddVisualInternal(newVisual); }, CommandProperties{ 1, true /*serial*/ });
 
     m_SelectedVisual = newVisual;
 }
@@ -112,14 +131,7 @@ void Scene::UpdateSceneVisualsWindow()
     {
         // remove from container in the beginning of the next engine frame
         Visual* visualToDelete = m_SelectedVisual;
-        g_System.AddSystemCommand([&, visualToDelete]()
-            {
-                bbeMultiThreadDetector();
-                auto it = std::find(m_AllVisuals.begin(), m_AllVisuals.end(), visualToDelete);
-                assert(it != m_AllVisuals.end());
-                std::swap(*it, m_AllVisuals.back());
-                m_AllVisuals.pop_back();
-            });
+        g_System.AddSystemCommand([&, visualToDelete]() { RemoveVisualInternal(visualToDelete); }, CommandProperties{ 1, true /*serial*/ });
 
         m_SelectedVisual = nullptr;
     }
@@ -27,6 +27,11 @@ public:
     Visual* m_SelectedVisual = nullptr;
 
     VisualsArray m_AllVisuals;
+    FlatHashMap<ObjectID, Visual*, ObjectIDHash> m_VisualsByID; // kept in sync with m_AllVisuals
     ObjectPool<Visual> m_VisualsPool;
+
+private:
+    void AddVisualInternal(Visual* visual);
+    void RemoveVisualInternal(Visual* visual);
 };
 #define g_Scene Scene::GetInstance()
@@ -555,6 +555,35 @@ void DirectX::LoadWICTextureFromFileSimple(const wchar_t* szFileName, std::vecto
     LoadWICTextureFromFileEx(nullptr, szFileName, 0, D3D12_RESOURCE_FLAG_NONE, WIC_LOADER_DEFAULT, nullptr, decodedData, subresource, &desc);
 }
 
+//--------------------------------------------------------------------------------------
+void DirectX::LoadWICTextureFromMemorySimple(const uint8_t* wicData, size_t wicDataSize, std::vector<std::byte>& decodedData, D3D12_SUBRESOURCE_DATA& subresource, D3D12_RESOURCE_DESC& desc) noexcept
+{
+    if (!wicData || !wicDataSize || wicDataSize > UINT32_MAX)
+        return;
+
+    auto pWIC = _GetWIC();
+    if (!pWIC)
+        return;
+
+    // Create input stream for memory
+    ComPtr<IWICStream> stream;
+    if (FAILED(pWIC->CreateStream(stream.GetAddressOf())))
+        return;
+
+    if (FAILED(stream->InitializeFromMemory(const_cast<uint8_t*>(wicData), static_cast<DWORD>(wicDataSize))))
+        return;
+
+    ComPtr<IWICBitmapDecoder> decoder;
+    if (FAILED(pWIC->CreateDecoderFromStream(stream.Get(), nullptr, WICDecodeMetadataCacheOnDemand, decoder.GetAddressOf())))
+        return;
+
+    ComPtr<IWICBitmapFrameDecode> frame;
+    if (FAILED(decoder->GetFrame(0, frame.GetAddressOf())))
+        return;
+
+    CreateTextureFromWIC(nullptr, frame.Get(), 0, D3D12_RESOURCE_FLAG_NONE, WIC_LOADER_DEFAULT, nullptr, decodedData, subresource, &desc);
+}
+
 //--------------------------------------------------------------------------------------
 _Use_decl_annotations_
 HRESULT DirectX::LoadWICTextureFromMemory(
@@ -39,6 +39,7 @@ namespace DirectX
 #endif
 
     void LoadWICTextureFromFileSimple(const wchar_t* szFileName, std::vector<std::byte>& decodedData, D3D12_SUBRESOURCE_DATA& subresource, D3D12_RESOURCE_DESC& desc) noexcept;
+    void LoadWICTextureFromMemorySimple(const uint8_t* wicData, size_t wicDataSize, std::vector<std::byte>& decodedData, D3D12_SUBRESOURCE_DATA& subresource, D3D12_RESOURCE_DESC& desc) noexcept;
 
     // Standard version
     HRESULT __cdecl LoadWICTextureFromMemory(
@@ -28,30 +28,29 @@ void GfxContext::Initialize(D3D12_COMMAND_LIST_TYPE cmdListType, std::string_vie
     m_CommandList->Dev()->IASetIndexBuffer(&NullIndexBufferView);
 
     m_PSO.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+}
 
-    // allocate static heaps
-    static const uint32_t NbStaticDescriptors = 128;
-    m_StaticHeaps.set_capacity(NbStaticDescriptors);
-    for (uint32_t i = 0; i < NbStaticDescriptors; ++i)
+GfxContext::~GfxContext()
+{
+    for (uint32_t type = 0; type < D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES; ++type)
     {
-        m_StaticHeaps.push_back();
+        for (uint32_t page : m_StagingDescriptorPages[type].m_Pages)
+        {
+            g_GfxCPUDescriptorAllocator.FreePage((D3D12_DESCRIPTOR_HEAP_TYPE)type, page);
+        }
     }
 }
 
-CD3DX12_CPU_DESCRIPTOR_HANDLE GfxContext::AllocateStaticDescHeap(D3D12_DESCRIPTOR_HEAP_TYPE type, std::string_view debugName)
+CD3DX12_CPU_DESCRIPTOR_HANDLE GfxContext::AllocateStagingDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE type)
 {
-    // Get a heap from the front of buffer & re-init it to appropriate type
-    GfxDescriptorHeap& toRet = m_StaticHeaps.front();
-    toRet.Release();
-    toRet.Initialize(type, D3D12_DESCRIPTOR_HEAP_FLAG_NONE, 1);
-
-    SetD3DDebugName(toRet.Dev(), debugName);
-
-    // rotate circular buffer to the next element, so we always use the "oldest" heap
-    assert(m_StaticHeaps.full());
-    m_StaticHeaps.rotate(m_StaticHeaps.begin() + 1);
+    StagingDescriptorPages& pages = m_StagingDescriptorPages[type];
+    if (pages.m_NumUsedInLastPage == GfxDescriptorPagePool::NbDescriptorsPerPage)
+    {
+        pages.m_Pages.push_back(g_GfxCPUDescriptorAllocator.AllocatePage(type));
+        pages.m_NumUsedInLastPage = 0;
+    }
 
-    return CD3DX12_CPU_DESCRIPTOR_HANDLE{ toRet.Dev()->GetCPUDescriptorHandleForHeapStart() };
+    return g_GfxCPUDescriptorAllocator.GetCPUHandle(type, pages.m_Pages.back(), pages.m_NumUsedInLastPage++);
 }
 
 void GfxContext::ClearRenderTargetView(GfxTexture& tex, const bbeVector4& clearColor)
@@ -60,9 +59,7 @@ void GfxContext::ClearRenderTargetView(GfxTexture& tex, const bbeVector4& clearC
 
     LazyTransitionResource(tex, D3D12_RESOURCE_STATE_RENDER_TARGET, true);
 
-    CD3D12_RENDER_TARGET_VIEW_DESC desc{ D3D12_RTV_DIMENSION_TEXTURE2D, tex.GetFormat() };
-    CD3DX12_CPU_DESCRIPTOR_HANDLE descHeap = AllocateStaticDescHeap(D3D12_DESCRIPTOR_HEAP_TYPE_RTV, __FUNCTION__);
-    g_GfxManager.GetGfxDevice().Dev()->CreateRenderTargetView(tex.GetD3D12Resource(), &desc, descHeap);
+    const D3D12_CPU_DESCRIPTOR_HANDLE descHeap = g_GfxViewCache.GetRTV(tex, tex.GetFormat());
 
     const UINT numRects = 0;
     const D3D12_RECT* pRects = nullptr;
@@ -75,13 +72,7 @@ void GfxContext::ClearDSVInternal(GfxTexture& tex, float depth, uint8_t stencil,
 
     LazyTransitionResource(tex, D3D12_RESOURCE_STATE_DEPTH_WRITE, true);
 
-    D3D12_DEPTH_STENCIL_VIEW_DESC desc{};
-    desc.Format = tex.GetFormat();
-    desc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
-
-    CD3DX12_CPU_DESCRIPTOR_HANDLE descHeap = AllocateStaticDescHeap(D3D12_DESCRIPTOR_HEAP_TYPE_DSV, __FUNCTION__);
-
-    g_GfxManager.GetGfxDevice().Dev()->CreateDepthStencilView(tex.GetD3D12Resource(), &desc, descHeap);
+    const D3D12_CPU_DESCRIPTOR_HANDLE descHeap = g_GfxViewCache.GetDSV(tex, D3D12_DSV_FLAG_NONE);
 
     m_CommandList->Dev()->ClearDepthStencilView(descHeap, flags, depth, stencil, 0, nullptr);
 }
@@ -94,9 +85,9 @@ void GfxContext::ClearUAVF(GfxTexture& tex, const bbeVector4& clearValue)
 
     SetShaderVisibleDescriptorHeap();
 
-    CD3DX12_CPU_DESCRIPTOR_HANDLE CPUDescHeap = AllocateStaticDescHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, __FUNCTION__);
+    const D3D12_CPU_DESCRIPTOR_HANDLE CPUDescHeap = g_GfxViewCache.GetUAV(tex);
 
-    GfxDescriptorHeapHandle destHandle = g_GfxGPUDescriptorAllocator.AllocateShaderVisible(1);
+    GfxDescriptorHeapHandle destHandle = g_GfxGPUDescriptorAllocator.AllocateShaderVisible(m_ShaderVisibleDescriptors, 1);
 
     g_GfxManager.GetGfxDevice().Dev()->CopyDescriptorsSimple(1, destHandle.m_CPUHandle, CPUDescHeap, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
@@ -111,9 +102,9 @@ void GfxContext::ClearUAVU(GfxTexture& tex, const bbeVector4U& clearValue)
 
     SetShaderVisibleDescriptorHeap();
 
-    CD3DX12_CPU_DESCRIPTOR_HANDLE CPUDescHeap = AllocateStaticDescHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, __FUNCTION__);
+    const D3D12_CPU_DESCRIPTOR_HANDLE CPUDescHeap = g_GfxViewCache.GetUAV(tex);
 
-    GfxDescriptorHeapHandle destHandle = g_GfxGPUDescriptorAllocator.AllocateShaderVisible(1);
+    GfxDescriptorHeapHandle destHandle = g_GfxGPUDescriptorAllocator.AllocateShaderVisible(m_ShaderVisibleDescriptors, 1);
     g_GfxManager.GetGfxDevice().Dev()->CopyDescriptorsSimple(1, destHandle.m_CPUHandle, CPUDescHeap, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
     m_CommandList->Dev()->ClearUnorderedAccessViewUint(destHandle.m_GPUHandle, CPUDescHeap, tex.GetD3D12Resource(), (const UINT*)&clearValue, 0, nullptr);
@@ -130,12 +121,8 @@ void GfxContext::SetRTVHelper(GfxTexture* (&RTVs)[NbRTs])
         m_RTVs[i].m_Tex = RTVs[i];
         (&m_PSO.RTVFormats)->RTFormats[i] = RTVs[i]->GetFormat();
 
-        // TODO: Any other dimensions for RTV other than Texture2D?
         const D3D12_RESOURCE_DESC resourceDesc = RTVs[i]->GetD3D12Resource()->GetDesc();
-        CD3D12_RENDER_TARGET_VIEW_DESC RTVdesc{ D3D12_RTV_DIMENSION_TEXTURE2D, resourceDesc.Format };
-
-        m_RTVs[i].m_CPUDescHeap = AllocateStaticDescHeap(D3D12_DESCRIPTOR_HEAP_TYPE_RTV, __FUNCTION__);
-        g_GfxManager.GetGfxDevice().Dev()->CreateRenderTargetView(RTVs[i]->GetD3D12Resource(), &RTVdesc, m_RTVs[i].m_CPUDescHeap);
+        m_RTVs[i].m_CPUDescHeap = g_GfxViewCache.GetRTV(*RTVs[i], resourceDesc.Format);
 
         LazyTransitionResource(*m_RTVs[i].m_Tex, D3D12_RESOURCE_STATE_RENDER_TARGET);
     }
@@ -252,90 +239,23 @@ void GfxContext::CheckStagingResourceInputs(uint32_t rootIndex, uint32_t offset,
     assert(m_StagedResources[rootIndex].m_Types[offset] == type);
 }
 
-static D3D12_SHADER_RESOURCE_VIEW_DESC CreateSRVDesc(GfxTexture& tex)
-{
-    D3D12_SHADER_RESOURCE_VIEW_DESC SRVDesc{};
-
-    const D3D12_RESOURCE_DESC resourceDesc = tex.GetD3D12Resource()->GetDesc();
-    switch (resourceDesc.Dimension)
-    {
-    case D3D12_RESOURCE_DIMENSION_BUFFER:
-        SRVDesc = CD3D12_SHADER_RESOURCE_VIEW_DESC{ D3D12_SRV_DIMENSION_BUFFER, resourceDesc.Format };
-        if (resourceDesc.Format == DXGI_FORMAT_UNKNOWN)
-        {
-            SRVDesc.Buffer.NumElements = tex.GetNumElements();
-            SRVDesc.Buffer.StructureByteStride = tex.GetStructureByteStride();
-        }
-        break;
-    case D3D12_RESOURCE_DIMENSION_TEXTURE2D:
-        SRVDesc = CD3D12_SHADER_RESOURCE_VIEW_DESC{ D3D12_SRV_DIMENSION_TEXTURE2D, resourceDesc.Format };
-        SRVDesc.Texture2D.MipLevels = 1; // TODO: Mips
-        break;
-
-        // TODO: Other dimensions when needed
-    default: assert(false);
-    }
-
-    return SRVDesc;
-}
-
 void GfxContext::StageSRV(GfxTexture& tex, uint32_t rootIndex, uint32_t offset)
 {
     CheckStagingResourceInputs(rootIndex, offset, D3D12_DESCRIPTOR_RANGE_TYPE_SRV);
 
-    const D3D12_SHADER_RESOURCE_VIEW_DESC SRVDesc = CreateSRVDesc(tex);
-
-    StaticString<128> heapDebugName = StringFormat("SRV. Index: %d, Offset: %d", rootIndex, offset);
-    CD3DX12_CPU_DESCRIPTOR_HANDLE CPUDescHeap = AllocateStaticDescHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, heapDebugName.c_str());
-    g_GfxManager.GetGfxDevice().Dev()->CreateShaderResourceView(tex.GetD3D12Resource(), &SRVDesc, CPUDescHeap);
-
     // TODO: Specific states for Pixel/Non-Pixel resources?
     LazyTransitionResource(tex, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 
-    StageDescriptor(CPUDescHeap, rootIndex, offset);
-}
-
-static D3D12_UNORDERED_ACCESS_VIEW_DESC CreateUAVDesc(GfxTexture& tex)
-{
-    D3D12_UNORDERED_ACCESS_VIEW_DESC UAVDesc{};
-
-    const D3D12_RESOURCE_DESC resourceDesc = tex.GetD3D12Resource()->GetDesc();
-    switch (resourceDesc.Dimension)
-    {
-    case D3D12_RESOURCE_DIMENSION_BUFFER:
-        UAVDesc = CD3D12_UNORDERED_ACCESS_VIEW_DESC{ D3D12_UAV_DIMENSION_BUFFER, resourceDesc.Format };
-        if (resourceDesc.Format == DXGI_FORMAT_UNKNOWN)
-        {
-            UAVDesc.Buffer.NumElements = tex.m_NumElements;
-            UAVDesc.Buffer.StructureByteStride = tex.m_StructureByteStride;
-        }
-        break;
-    case D3D12_RESOURCE_DIMENSION_TEXTURE2D:
-        UAVDesc = CD3D12_UNORDERED_ACCESS_VIEW_DESC{ D3D12_UAV_DIMENSION_TEXTURE2D, resourceDesc.Format };
-        break;
-
-        // TODO: Other dimensions when needed
-    default: assert(false);
-    }
-
-    return UAVDesc;
+    StageDescriptor(g_GfxViewCache.GetSRV(tex), rootIndex, offset);
 }
 
 void GfxContext::StageUAV(GfxTexture& tex, uint32_t rootIndex, uint32_t offset)
 {
     CheckStagingResourceInputs(rootIndex, offset, D3D12_DESCRIPTOR_RANGE_TYPE_UAV);
 
-    const D3D12_UNORDERED_ACCESS_VIEW_DESC UAVDesc = CreateUAVDesc(tex);
-
-    static ID3D12Resource* pCounterResource = nullptr; // TODO
-
-    StaticString<128> heapDebugName = StringFormat("UAV. Index: %d, Offset: %d", rootIndex, offset);
-    CD3DX12_CPU_DESCRIPTOR_HANDLE CPUDescHeap = AllocateStaticDescHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, heapDebugName.c_str());
-    g_GfxManager.GetGfxDevice().Dev()->CreateUnorderedAccessView(tex.GetD3D12Resource(), pCounterResource, &UAVDesc, CPUDescHeap);
-
     LazyTransitionResource(tex, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 
-    StageDescriptor(CPUDescHeap, rootIndex, offset);
+    StageDescriptor(g_GfxViewCache.GetUAV(tex), rootIndex, offset);
 }
 
 void GfxContext::StageDescriptor(D3D12_CPU_DESCRIPTOR_HANDLE srcDescriptor, uint32_t rootIndex, uint32_t offset)
@@ -349,73 +269,85 @@ void GfxContext::StageDescriptor(D3D12_CPU_DESCRIPTOR_HANDLE srcDescriptor, uint
     m_StaleResourcesBitMap.set(rootIndex);
 }
 
+// Every state a PSO depends on, packed so it's hashed with a single call.
+// Always zeroed before being filled: padding bytes must not change the hash
+struct GraphicPSOHashKey
+{
+    std::size_t m_RootSigHash;
+    std::size_t m_VSHash;
+    std::size_t m_PSHash;
+    std::size_t m_VertexFormatHash;
+    D3D12_BLEND_DESC m_BlendState;
+    D3D12_RASTERIZER_DESC m_RasterizerState;
+    D3D12_DEPTH_STENCIL_DESC1 m_DepthStencilState;
+    DXGI_FORMAT m_DSVFormat;
+    D3D12_PRIMITIVE_TOPOLOGY m_Topology;
+    D3D12_PRIMITIVE_TOPOLOGY_TYPE m_PrimitiveTopologyType;
+    uint32_t m_NbRTVs;
+    DXGI_FORMAT m_RTVFormats[D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT];
+    DXGI_SAMPLE_DESC m_SampleDesc;
+};
+
 std::size_t GfxContext::GetPSOHash(bool forGraphicPSO)
 {
-    // Always get root sig Hash
-    std::size_t finalHash = m_RootSig->m_Hash;
-
-    if (forGraphicPSO)
+    if (!forGraphicPSO)
     {
-        // VS/PS Shaders
-        if (m_Shaders[VS])
-            boost::hash_combine(finalHash, m_Shaders[VS]->m_Hash);
-        if (m_Shaders[PS])
-            boost::hash_combine(finalHash, m_Shaders[PS]->m_Hash);
-
-        // Blend States
-        boost::hash_combine(finalHash, GenericTypeHash(m_PSO.BlendState));
-
-        // Rasterizer States
-        boost::hash_combine(finalHash, GenericTypeHash(m_PSO.RasterizerState));
-
-        // Depth Stencil State
-        // Note: Have to manually extract each Depth Stencil State 1-by-1 to achieve consistent hash and I have no fking idea why
-        const CD3DX12_DEPTH_STENCIL_DESC1 depthStencilState = (CD3DX12_DEPTH_STENCIL_DESC1)m_PSO.DepthStencilState;
-        if (depthStencilState.DepthEnable)
-        {
-            boost::hash_combine(finalHash, depthStencilState.DepthWriteMask);
-            boost::hash_combine(finalHash, depthStencilState.DepthFunc);
-            boost::hash_combine(finalHash, depthStencilState.StencilEnable);
-            boost::hash_combine(finalHash, depthStencilState.StencilReadMask);
-            boost::hash_combine(finalHash, depthStencilState.StencilWriteMask);
-            boost::hash_combine(finalHash, depthStencilState.FrontFace.StencilFailOp);
-            boost::hash_combine(finalHash, depthStencilState.FrontFace.StencilDepthFailOp);
-            boost::hash_combine(finalHash, depthStencilState.FrontFace.StencilPassOp);
-            boost::hash_combine(finalHash, depthStencilState.FrontFace.StencilFunc);
-            boost::hash_combine(finalHash, depthStencilState.BackFace.StencilFailOp);
-            boost::hash_combine(finalHash, depthStencilState.BackFace.StencilDepthFailOp);
-            boost::hash_combine(finalHash, depthStencilState.BackFace.StencilPassOp);
-            boost::hash_combine(finalHash, depthStencilState.BackFace.StencilFunc);
-            boost::hash_combine(finalHash, depthStencilState.DepthBoundsTestEnable);
-        }
+        // We only need to hash the root sig & CS shader
+        const std::size_t computeKey[] = { m_RootSig->m_Hash, m_Shaders[CS]->m_Hash };
+        return HashUtils::XXH3_64(computeKey, sizeof(computeKey));
+    }
 
-        // DSV Format
-        boost::hash_combine(finalHash, GenericTypeHash(m_PSO.DSVFormat));
+    GraphicPSOHashKey key;
+    memset(&key, 0, sizeof(key));
 
-        // Vertex Input Layout
-        boost::hash_combine(finalHash, m_VertexFormat->GetHash());
+    key.m_RootSigHash = m_RootSig->m_Hash;
 
-        // Topology
-        boost::hash_combine(finalHash, m_Topology);
-        boost::hash_combine(finalHash, GenericTypeHash(m_PSO.PrimitiveTopologyType));
+    // VS/PS Shaders
+    key.m_VSHash = m_Shaders[VS] ? m_Shaders[VS]->m_Hash : 0;
+    key.m_PSHash = m_Shaders[PS] ? m_Shaders[PS]->m_Hash : 0;
 
-        // RTV Formats
-        boost::hash_combine(finalHash, m_RTVs.size());
-        for (uint32_t i = 0; i < m_RTVs.size(); ++i)
-        {
-            boost::hash_combine(finalHash, m_RTVs[i].m_Tex->GetFormat());
-        }
+    // Blend & Rasterizer States
+    key.m_BlendState = (CD3DX12_BLEND_DESC)m_PSO.BlendState;
+    key.m_RasterizerState = (CD3DX12_RASTERIZER_DESC)m_PSO.RasterizerState;
 
-        // Sample Descriptors
-        boost::hash_combine(finalHash, GenericTypeHash(m_PSO.SampleDesc));
+    // Depth Stencil State
+    // Note: copied member by member, so the padding bytes of the desc stay zeroed
+    const CD3DX12_DEPTH_STENCIL_DESC1 depthStencilState = (CD3DX12_DEPTH_STENCIL_DESC1)m_PSO.DepthStencilState;
+    if (depthStencilState.DepthEnable)
+    {
+        D3D12_DEPTH_STENCIL_DESC1& keyDepthStencil = key.m_DepthStencilState;
+        keyDepthStencil.DepthEnable = depthStencilState.DepthEnable;
+        keyDepthStencil.DepthWriteMask = depthStencilState.DepthWriteMask;
+        keyDepthStencil.DepthFunc = depthStencilState.DepthFunc;
+        keyDepthStencil.StencilEnable = depthStencilState.StencilEnable;
+        keyDepthStencil.StencilReadMask = depthStencilState.StencilReadMask;
+        keyDepthStencil.StencilWriteMask = depthStencilState.StencilWriteMask;
+        keyDepthStencil.FrontFace = depthStencilState.FrontFace;
+        keyDepthStencil.BackFace = depthStencilState.BackFace;
+        keyDepthStencil.DepthBoundsTestEnable = depthStencilState.DepthBoundsTestEnable;
     }
-    else
+
+    // DSV Format
+    key.m_DSVFormat = m_PSO.DSVFormat;
+
+    // Vertex Input Layout
+    key.m_VertexFormatHash = m_VertexFormat->GetHash();
+
+    // Topology
+    key.m_Topology = m_Topology;
+    key.m_PrimitiveTopologyType = m_PSO.PrimitiveTopologyType;
+
+    // RTV Formats
+    key.m_NbRTVs = m_RTVs.size();
+    for (uint32_t i = 0; i < m_RTVs.size(); ++i)
     {
-        // We only need to hash CS shader
-        boost::hash_combine(finalHash, m_Shaders[CS]->m_Hash);
+        key.m_RTVFormats[i] = m_RTVs[i].m_Tex->GetFormat();
     }
 
-    return finalHash;
+    // Sample Descriptors
+    key.m_SampleDesc = m_PSO.SampleDesc;
+
+    return HashUtils::XXH3_64(&key, sizeof(key));
 }
 
 void GfxContext::PrepareGraphicsStates()
@@ -475,20 +407,15 @@ void GfxContext::PrepareGraphicsStates()
         D3D12_CPU_DESCRIPTOR_HANDLE DSVDescHandle{};
         if (m_DSV)
         {
-            DSVDescHandle = AllocateStaticDescHeap(D3D12_DESCRIPTOR_HEAP_TYPE_DSV, "DSV");
-
             const D3D12_DSV_FLAGS flags = (&m_PSO.DepthStencilState)->DepthWriteMask == D3D12_DEPTH_WRITE_MASK_ALL ? D3D12_DSV_FLAG_NONE : D3D12_DSV_FLAG_READ_ONLY_DEPTH;
-
-            D3D12_DEPTH_STENCIL_VIEW_DESC DSVDesc{ m_DSV->GetFormat(), D3D12_DSV_DIMENSION_TEXTURE2D, flags };
-            g_GfxManager.GetGfxDevice().Dev()->CreateDepthStencilView(m_DSV->GetD3D12Resource(), &DSVDesc, DSVDescHandle);
+            DSVDescHandle = g_GfxViewCache.GetDSV(*m_DSV, flags);
         }
 
         // Set Render Targets
         m_CommandList->Dev()->OMSetRenderTargets(m_RTVs.size(), rtvHandles.data(), FALSE, m_DSV ? &DSVDescHandle : nullptr);
     }
 
-    std::size_t buffersHash = std::hash<void*>{}(m_VertexBuffer);
-    boost::hash_combine(buffersHash, m_IndexBuffer);
+    const std::size_t buffersHash = HashUtils::Combine((uintptr_t)m_VertexBuffer, (uintptr_t)m_IndexBuffer);
     if (m_LastBuffersHash != buffersHash)
     {
         m_LastBuffersHash = buffersHash;
@@ -633,6 +560,9 @@ void GfxContext::CommitStagedResources(RootDescTableSetter rootDescSetterFunc)
 
     GfxDevice& gfxDevice = g_GfxManager.GetGfxDevice();
 
+    // Tables holding a CBV staged just now can't match any committed table, and never will: no point hashing & remembering them
+    std::bitset<GfxRootSignature::MaxRootParams> newCBVTables;
+
     // Upload CBV bytes
     for (uint32_t i = 0; i < _countof(m_StagedCBVs); ++i)
     {
@@ -642,57 +572,90 @@ void GfxContext::CommitStagedResources(RootDescTableSetter rootDescSetterFunc)
         if (stagedCBV.m_CBBytes.empty())
             continue;
 
-        // Create upload heap for constant buffer
-        D3D12MA::Allocation* uploadHeap = g_GfxMemoryAllocator.AllocateVolatile(D3D12_HEAP_TYPE_UPLOAD, CD3DX12_RESOURCE_DESC1::Buffer(stagedCBV.m_CBBytes.size()));
-        assert(uploadHeap);
+        // Sub-allocate the constant buffer from this frame's upload pages
+        const GfxUploadAllocation upload = g_GfxMemoryAllocator.AllocateUpload((uint32_t)stagedCBV.m_CBBytes.size());
+        SIMDMemCopyToWriteCombined(upload.m_CPUAddress, stagedCBV.m_CBBytes.data(), stagedCBV.m_CBBytes.size());
 
         // init desc heap for cbuffer
-        CD3DX12_CPU_DESCRIPTOR_HANDLE descHeap = AllocateStaticDescHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, StringFormat("CBV: %s", stagedCBV.m_Name));
+        CD3DX12_CPU_DESCRIPTOR_HANDLE descHeap = AllocateStagingDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
         // Describe and create a constant buffer view.
-        D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc{ uploadHeap->GetResource()->GetGPUVirtualAddress(), (uint32_t)stagedCBV.m_CBBytes.size() };
+        D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc{ upload.m_GPUAddress, (uint32_t)stagedCBV.m_CBBytes.size() };
         gfxDevice.Dev()->CreateConstantBufferView(&cbvDesc, descHeap);
 
-        void* mappedMemory = nullptr;
-        DX12_CALL(uploadHeap->GetResource()->Map(0, nullptr, reinterpret_cast<void**>(&mappedMemory)));
-        memcpy(mappedMemory, stagedCBV.m_CBBytes.data(), stagedCBV.m_CBBytes.size());
-        uploadHeap->GetResource()->Unmap(0, nullptr);
-
         const uint32_t RootOffset = 0; // TODO?
         StageDescriptor(descHeap, cbRegister, RootOffset);
+        newCBVTables.set(cbRegister);
     }
 
     // Resources
     if (m_StaleResourcesBitMap.none())
         return;
-    
-    uint32_t numHeapsNeeded = 0;
-    RunOnAllBits(m_StaleResourcesBitMap.to_ulong(), [&](uint32_t rootIndex) { numHeapsNeeded += m_StagedResources[rootIndex].m_Descriptors.size(); });
-    assert(numHeapsNeeded > 0);
-
-    // allocate shader visible heaps
-    GfxDescriptorHeapHandle destHandle = g_GfxGPUDescriptorAllocator.AllocateShaderVisible(numHeapsNeeded);
 
     SetShaderVisibleDescriptorHeap();
 
+    // a recycled view descriptor may now hold another view: same source handles, different table
+    const uint32_t viewCacheNumReleases = g_GfxViewCache.GetNumReleases();
+    if (m_ViewCacheNumReleases != viewCacheNumReleases)
+    {
+        m_CommittedTables.Clear();
+        m_ViewCacheNumReleases = viewCacheNumReleases;
+    }
+
+    // Tables with the same contents as one this context already copied are reused as is: shader visible descriptors are only recycled after the frame is done on the GPU
+    struct TableToCopy
+    {
+        uint32_t m_RootIndex;
+        uint64_t m_Hash;
+        bool m_HasNewCBV;
+    };
+    InplaceArray<TableToCopy, GfxRootSignature::MaxRootParams> tablesToCopy;
+    uint32_t numHeapsNeeded = 0;
+
     RunOnAllBits(m_StaleResourcesBitMap.to_ulong(), [&](uint32_t rootIndex)
     {
+        const std::vector<CD3DX12_CPU_DESCRIPTOR_HANDLE>& srcDescriptors = m_StagedResources[rootIndex].m_Descriptors;
+
+        uint64_t tableHash = 0;
+        if (!newCBVTables.test(rootIndex))
+        {
+            const uint64_t committedGPUHandle = m_CommittedTables.Find(srcDescriptors.data(), (uint32_t)srcDescriptors.size(), tableHash);
+            if (committedGPUHandle)
+            {
+                (m_CommandList->Dev()->*rootDescSetterFunc)(rootIndex, D3D12_GPU_DESCRIPTOR_HANDLE{ committedGPUHandle });
+                return;
+            }
+        }
+
+        tablesToCopy.push_back({ rootIndex, tableHash, newCBVTables.test(rootIndex) });
+        numHeapsNeeded += (uint32_t)srcDescriptors.size();
+    });
+
+    if (tablesToCopy.empty())
+        return;
+
+    // allocate shader visible heaps for all the tables at once
+    GfxDescriptorHeapHandle destHandle = g_GfxGPUDescriptorAllocator.AllocateShaderVisible(m_ShaderVisibleDescriptors, numHeapsNeeded);
+
+    static const uint32_t descriptorSize = gfxDevice.Dev()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    for (const TableToCopy& table : tablesToCopy)
+    {
+        const std::vector<CD3DX12_CPU_DESCRIPTOR_HANDLE>& srcDescriptors = m_StagedResources[table.m_RootIndex].m_Descriptors;
+        const UINT numDescriptors = (UINT)srcDescriptors.size();
+
         // set desc heap for this table
-        (m_CommandList->Dev()->*rootDescSetterFunc)(rootIndex, destHandle.m_GPUHandle);
+        (m_CommandList->Dev()->*rootDescSetterFunc)(table.m_RootIndex, destHandle.m_GPUHandle);
 
-        const GfxRootSignature::StagedResourcesDescriptors& resourceDesc = m_StagedResources[rootIndex];
+        // gather the whole table in one copy. Null source range sizes means every source range is 1 descriptor
+        gfxDevice.Dev()->CopyDescriptors(1, &destHandle.m_CPUHandle, &numDescriptors, numDescriptors, srcDescriptors.data(), nullptr, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
-        // copy descriptors to shader visible heaps 1 by 1
-        // TODO: is this ineffcient? Better to use the full "CopyDescriptors" method?
-        for (uint32_t i = 0; i < resourceDesc.m_Descriptors.size(); ++i)
+        if (!table.m_HasNewCBV)
         {
-            assert(resourceDesc.m_Descriptors[i].ptr != 0);
-            gfxDevice.Dev()->CopyDescriptorsSimple(1, destHandle.m_CPUHandle, resourceDesc.m_Descriptors[i], D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-
-            static const uint32_t descriptorSize = gfxDevice.Dev()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-            destHandle.Offset(1, descriptorSize);
+            m_CommittedTables.Add(table.m_Hash, srcDescriptors.data(), numDescriptors, destHandle.m_GPUHandle.ptr);
         }
-    });
+
+        destHandle.Offset(numDescriptors, descriptorSize);
+    }
 }
 
 void GfxContext::DrawInstanced(uint32_t vertexCountPerInstance, uint32_t instanceCount, uint32_t startVertexLocation, uint32_t startInstanceLocation)
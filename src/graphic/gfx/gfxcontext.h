@@ -2,6 +2,7 @@
 
 #include <graphic/gfx/gfxcommandlist.h>
 #include <graphic/gfx/gfxdescriptorheap.h>
+#include <graphic/gfx/gfxdescriptortablecache.h>
 #include <graphic/gfx/gfxrootsignature.h>
 #include <graphic/gfx/gfxvertexformat.h>
 #include <graphic/gfx/gfxshadermanager.h>
@@ -18,6 +19,8 @@ struct GfxShader;
 class GfxContext
 {
 public:
+    ~GfxContext();
+
     GfxCommandList& GetCommandList() { return *m_CommandList; }
 
     void Initialize(D3D12_COMMAND_LIST_TYPE cmdListType, std::string_view name);
@@ -85,7 +88,7 @@ private:
     void StageCBVInternal(const void* data, uint32_t bufferSize, uint32_t cbRegister, const char* CBName);
     void SetShaderVisibleDescriptorHeap();
     void ClearDSVInternal(GfxTexture& tex, float depth, uint8_t stencil, D3D12_CLEAR_FLAGS flags);
-    CD3DX12_CPU_DESCRIPTOR_HANDLE AllocateStaticDescHeap(D3D12_DESCRIPTOR_HEAP_TYPE, std::string_view debugName);
+    CD3DX12_CPU_DESCRIPTOR_HANDLE AllocateStagingDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE);
     std::size_t GetPSOHash(bool forGraphicPSO);
 
     void LazyTransitionResource(GfxResourceBase& resource, D3D12_RESOURCE_STATES newState, bool flushImmediate = false);
@@ -119,7 +122,18 @@ private:
 
     std::bitset<GfxRootSignature::MaxRootParams> m_StaleResourcesBitMap;
 
-    CircularBuffer<GfxDescriptorHeap> m_StaticHeaps;
+    // Staging descriptors are only read when recording, and live until the context is destroyed at the end of the frame
+    struct StagingDescriptorPages
+    {
+        InplaceArray<uint32_t, 2> m_Pages;
+        uint32_t m_NumUsedInLastPage = GfxDescriptorPagePool::NbDescriptorsPerPage;
+    };
+    StagingDescriptorPages m_StagingDescriptorPages[D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES];
+    GfxShaderVisibleDescriptorBlock m_ShaderVisibleDescriptors;
+
+    // Descriptor tables already copied to the shader visible heap by this context. Forgotten when the view cache recycles descriptors
+    GfxDescriptorTableCache m_CommittedTables;
+    uint32_t m_ViewCacheNumReleases = 0;
 
     struct StagedCBV
     {
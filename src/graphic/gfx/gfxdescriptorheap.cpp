@@ -16,52 +16,59 @@ void GfxDescriptorHeap::Initialize(D3D12_DESCRIPTOR_HEAP_TYPE heapType, D3D12_DE
     DX12_CALL(gfxDevice.Dev()->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&m_DescriptorHeap)));
 }
 
-void GfxGPUDescriptorAllocator::Initialize()
+void GfxCPUDescriptorAllocator::Initialize()
 {
     bbeProfileFunction();
 
-    m_ShaderVisibleDescriptorHeap.Initialize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE, NbShaderVisibleDescriptors);
-
-    static const uint32_t descHeapSize = g_GfxManager.GetGfxDevice().Dev()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-
-    // allocate shader visible heaps
-    m_FreeShaderVisibleHeaps.set_capacity(NbShaderVisibleDescriptors);
-    for (uint32_t i = 0; i < NbShaderVisibleDescriptors; ++i)
+    // No D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER support! 100% Static Samplers usage!
+    for (D3D12_DESCRIPTOR_HEAP_TYPE type : { D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, D3D12_DESCRIPTOR_HEAP_TYPE_DSV })
     {
-        GfxDescriptorHeapHandle newHandle{};
-        newHandle.m_CPUHandle.InitOffsetted(m_ShaderVisibleDescriptorHeap.Dev()->GetCPUDescriptorHandleForHeapStart(), i, descHeapSize);
-        newHandle.m_GPUHandle.InitOffsetted(m_ShaderVisibleDescriptorHeap.Dev()->GetGPUDescriptorHandleForHeapStart(), i, descHeapSize);
+        m_DescriptorSizes[type] = g_GfxManager.GetGfxDevice().Dev()->GetDescriptorHandleIncrementSize(type);
+
+        m_Pools[type].Initialize(type, [this, type](uint32_t heapIdx, uint32_t numDescriptors)
+            {
+                GfxDescriptorHeap& heap = m_Heaps[type][heapIdx];
+                heap.Initialize(type, D3D12_DESCRIPTOR_HEAP_FLAG_NONE, numDescriptors);
+                SetD3DDebugName(heap.Dev(), StringFormat("GfxCPUDescriptorAllocator: %d, %d", type, heapIdx));
 
-        m_FreeShaderVisibleHeaps.push_back(newHandle);
+                m_HeapStarts[type][heapIdx] = heap.Dev()->GetCPUDescriptorHandleForHeapStart();
+            });
     }
 }
 
-GfxDescriptorHeapHandle GfxGPUDescriptorAllocator::AllocateShaderVisible(uint32_t numHeaps)
+CD3DX12_CPU_DESCRIPTOR_HANDLE GfxCPUDescriptorAllocator::GetCPUHandle(D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t page, uint32_t indexInPage) const
 {
-    assert(numHeaps > 0);
+    assert(indexInPage < GfxDescriptorPagePool::NbDescriptorsPerPage);
 
-    static std::mutex ShaderVisibleDescHeapAllocatorLock;
-    bbeAutoLock(ShaderVisibleDescHeapAllocatorLock);
+    return CD3DX12_CPU_DESCRIPTOR_HANDLE{ m_HeapStarts[type][GfxDescriptorPagePool::GetHeapIndex(page)], (INT)GfxDescriptorPagePool::GetOffsetInHeap(page, indexInPage), m_DescriptorSizes[type] };
+}
 
-    // Requested shader visible heaps are assumed to be needed to be contiguous
-    // In the event that we do a full circle around the CircularBuffer, and the number of requested heaps overflows back into the start, simply allocate and discard the tail heaps
-    if ((m_AllocationCounter + numHeaps) > NbShaderVisibleDescriptors)
-    {
-        const int32_t allocationOverflow = NbShaderVisibleDescriptors - m_AllocationCounter;
-        AllocateShaderVisibleInternal(allocationOverflow);
-    }
+void GfxGPUDescriptorAllocator::Initialize()
+{
+    bbeProfileFunction();
+
+    m_ShaderVisibleDescriptorHeap.Initialize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE, NbShaderVisibleDescriptors);
 
-    return AllocateShaderVisibleInternal(numHeaps);
+    m_DescriptorSize = g_GfxManager.GetGfxDevice().Dev()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    m_ShaderVisibleHeapStart.m_CPUHandle = CD3DX12_CPU_DESCRIPTOR_HANDLE{ m_ShaderVisibleDescriptorHeap.Dev()->GetCPUDescriptorHandleForHeapStart() };
+    m_ShaderVisibleHeapStart.m_GPUHandle = CD3DX12_GPU_DESCRIPTOR_HANDLE{ m_ShaderVisibleDescriptorHeap.Dev()->GetGPUDescriptorHandleForHeapStart() };
+
+    m_ShaderVisibleRing.Initialize(NbShaderVisibleDescriptors, [] { return g_GfxManager.GetFrameFence().GetCompletedValue(); });
 }
 
-GfxDescriptorHeapHandle GfxGPUDescriptorAllocator::AllocateShaderVisibleInternal(uint32_t numHeaps)
+GfxDescriptorHeapHandle GfxGPUDescriptorAllocator::GetShaderVisibleHandle(uint32_t offset) const
 {
-    assert(m_FreeShaderVisibleHeaps.size() >= numHeaps);
-    m_AllocationCounter = (m_AllocationCounter + numHeaps) % NbShaderVisibleDescriptors;
+    GfxDescriptorHeapHandle ret = m_ShaderVisibleHeapStart;
+    ret.Offset(offset, m_DescriptorSize);
+    return ret;
+}
 
-    // allocate needed heaps and rotate circular buffer
-    GfxDescriptorHeapHandle ret = m_FreeShaderVisibleHeaps.front();
-    m_FreeShaderVisibleHeaps.rotate(m_FreeShaderVisibleHeaps.begin() + numHeaps);
+GfxDescriptorHeapHandle GfxGPUDescriptorAllocator::AllocateShaderVisible(uint32_t numHeaps)
+{
+    return GetShaderVisibleHandle(m_ShaderVisibleRing.Allocate(numHeaps));
+}
 
-    return ret;
+GfxDescriptorHeapHandle GfxGPUDescriptorAllocator::AllocateShaderVisible(GfxShaderVisibleDescriptorBlock& block, uint32_t numHeaps)
+{
+    return GetShaderVisibleHandle(m_ShaderVisibleRing.Allocate(block, numHeaps, NbDescriptorsPerContextBlock));
 }
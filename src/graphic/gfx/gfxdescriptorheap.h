@@ -1,5 +1,8 @@
 #pragma once
 
+#include <graphic/gfx/gfxdescriptorpagepool.h>
+#include <graphic/gfx/gfxdescriptorring.h>
+
 class GfxDescriptorHeap
 {
 public:
@@ -26,24 +29,49 @@ struct GfxDescriptorHeapHandle
     }
 };
 
+// Non shader visible descriptors used for staging: pages are handed to GfxContexts, which return them when they're destroyed at the end of the frame
+class GfxCPUDescriptorAllocator
+{
+    DeclareSingletonFunctions(GfxCPUDescriptorAllocator);
+
+public:
+    void Initialize();
+
+    uint32_t AllocatePage(D3D12_DESCRIPTOR_HEAP_TYPE type) { return m_Pools[type].AllocatePage(); }
+    void FreePage(D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t page) { m_Pools[type].FreePage(page); }
+
+    CD3DX12_CPU_DESCRIPTOR_HANDLE GetCPUHandle(D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t page, uint32_t indexInPage) const;
+
+private:
+    GfxDescriptorPagePool m_Pools[D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES];
+    GfxDescriptorHeap m_Heaps[D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES][GfxDescriptorPagePool::NbMaxHeaps];
+    D3D12_CPU_DESCRIPTOR_HANDLE m_HeapStarts[D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES][GfxDescriptorPagePool::NbMaxHeaps]{};
+    uint32_t m_DescriptorSizes[D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES]{};
+};
+#define g_GfxCPUDescriptorAllocator GfxCPUDescriptorAllocator::GetInstance()
+
 // No D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER support! 100% Static Samplers usage!
 class GfxGPUDescriptorAllocator
 {
     DeclareSingletonFunctions(GfxGPUDescriptorAllocator);
 
 public:
-    static const uint32_t NbShaderVisibleDescriptors = BBE_KB(1);
+    static const uint32_t NbShaderVisibleDescriptors = BBE_KB(64);
+    static const uint32_t NbDescriptorsPerContextBlock = 128;
 
     const GfxDescriptorHeap& GetInternalShaderVisibleHeap() const { return m_ShaderVisibleDescriptorHeap; }
     void Initialize();
+    void EndFrame(uint64_t frameFenceValue) { m_ShaderVisibleRing.EndFrame(frameFenceValue); }
+
     GfxDescriptorHeapHandle AllocateShaderVisible(uint32_t numHeaps);
+    GfxDescriptorHeapHandle AllocateShaderVisible(GfxShaderVisibleDescriptorBlock& block, uint32_t numHeaps);
 
 private:
-    GfxDescriptorHeapHandle AllocateShaderVisibleInternal(uint32_t numHeaps);
+    GfxDescriptorHeapHandle GetShaderVisibleHandle(uint32_t offset) const;
 
-    // Shader Visible heaps
-    uint32_t m_AllocationCounter = 0;
-    CircularBuffer<GfxDescriptorHeapHandle> m_FreeShaderVisibleHeaps;
+    GfxDescriptorRing m_ShaderVisibleRing;
     GfxDescriptorHeap m_ShaderVisibleDescriptorHeap;
+    GfxDescriptorHeapHandle m_ShaderVisibleHeapStart;
+    uint32_t m_DescriptorSize = 0;
 };
 #define g_GfxGPUDescriptorAllocator GfxGPUDescriptorAllocator::GetInstance()
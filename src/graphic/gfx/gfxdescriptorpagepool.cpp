@@ -0,0 +1,88 @@
+#include <graphic/gfx/gfxdescriptorpagepool.h>
+
+thread_local GfxDescriptorPagePool::ThreadCache GfxDescriptorPagePool::ms_ThreadCache;
+
+void GfxDescriptorPagePool::Initialize(uint32_t poolIdx, HeapCreator&& createHeap)
+{
+    assert(poolIdx < NbMaxPools);
+
+    // 0 is never used, so a zero initialized thread cache never matches
+    static std::atomic<uint32_t> s_NextPoolID = 1;
+
+    m_PoolIdx = poolIdx;
+    m_PoolID = s_NextPoolID++;
+    m_CreateHeap = std::move(createHeap);
+
+    bbeAutoLock(m_FreePagesLock);
+    AddHeap();
+}
+
+FixedSizeArray<uint32_t, GfxDescriptorPagePool::NbCachedPagesPerThread>& GfxDescriptorPagePool::GetThreadCachedPages()
+{
+    FixedSizeArray<uint32_t, NbCachedPagesPerThread>& cachedPages = ms_ThreadCache.m_Pages[m_PoolIdx];
+    if (ms_ThreadCache.m_PoolID[m_PoolIdx] != m_PoolID)
+    {
+        // left over by a pool that's gone
+        cachedPages.clear();
+        ms_ThreadCache.m_PoolID[m_PoolIdx] = m_PoolID;
+    }
+    return cachedPages;
+}
+
+void GfxDescriptorPagePool::AddHeap()
+{
+    const uint32_t heapIdx = m_NumHeaps.load(std::memory_order_relaxed);
+    assert(heapIdx < NbMaxHeaps && "Too many staging descriptors in flight!");
+
+    m_CreateHeap(heapIdx, NbPagesPerHeap * NbDescriptorsPerPage);
+
+    // push in reverse, so that pages are handed out in order
+    for (uint32_t i = NbPagesPerHeap; i > 0; --i)
+    {
+        m_FreePages.push_back(heapIdx * NbPagesPerHeap + i - 1);
+    }
+    m_NumHeaps.store(heapIdx + 1, std::memory_order_release);
+}
+
+uint32_t GfxDescriptorPagePool::AllocatePage()
+{
+    FixedSizeArray<uint32_t, NbCachedPagesPerThread>& cachedPages = GetThreadCachedPages();
+    if (!cachedPages.empty())
+    {
+        const uint32_t page = cachedPages.back();
+        cachedPages.pop_back();
+        return page;
+    }
+
+    bbeAutoLock(m_FreePagesLock);
+    if (m_FreePages.empty())
+    {
+        bbeProfile("Add Descriptor Heap");
+        AddHeap();
+    }
+
+    const uint32_t page = m_FreePages.back();
+    m_FreePages.pop_back();
+    return page;
+}
+
+void GfxDescriptorPagePool::FreePage(uint32_t page)
+{
+    assert(GetHeapIndex(page) < GetNumHeaps());
+
+    FixedSizeArray<uint32_t, NbCachedPagesPerThread>& cachedPages = GetThreadCachedPages();
+    if (cachedPages.size() < cachedPages.capacity())
+    {
+        cachedPages.push_back(page);
+        return;
+    }
+
+    bbeAutoLock(m_FreePagesLock);
+    m_FreePages.push_back(page);
+}
+
+uint32_t GfxDescriptorPagePool::GetNumFreePages()
+{
+    bbeAutoLock(m_FreePagesLock);
+    return (uint32_t)m_FreePages.size();
+}
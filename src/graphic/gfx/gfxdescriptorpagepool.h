@@ -0,0 +1,49 @@
+#pragma once
+
+// Fixed-size pages of descriptors for one heap type, carved out of a few big heaps. Knows nothing about D3D12: heaps are created through a callback, and pages are plain indices.
+// Allocation and free are O(1): a small per-thread cache first, then a global free list
+class GfxDescriptorPagePool
+{
+public:
+    static const uint32_t NbDescriptorsPerPage = 64;
+    static const uint32_t NbPagesPerHeap = 64;
+    static const uint32_t NbMaxHeaps = 64;
+    static const uint32_t NbMaxPools = 4;
+    static const uint32_t NbCachedPagesPerThread = 4;
+
+    using HeapCreator = InplaceFunction<void(uint32_t heapIdx, uint32_t numDescriptors), 16>;
+
+    // 'poolIdx' selects this pool's slot in the per-thread caches: live pools must use different ones
+    void Initialize(uint32_t poolIdx, HeapCreator&& createHeap);
+
+    uint32_t AllocatePage();
+    void FreePage(uint32_t page);
+
+    uint32_t GetNumHeaps() const { return m_NumHeaps.load(std::memory_order_acquire); }
+
+    // Pages in the global free list only: pages sitting in per-thread caches aren't counted
+    uint32_t GetNumFreePages();
+
+    static uint32_t GetHeapIndex(uint32_t page) { return page / NbPagesPerHeap; }
+    static uint32_t GetOffsetInHeap(uint32_t page, uint32_t indexInPage) { return (page % NbPagesPerHeap) * NbDescriptorsPerPage + indexInPage; }
+
+private:
+    struct ThreadCache
+    {
+        // Pool the cached pages belong to. A thread cache slot still holding pages of a previous pool that used the same slot must not hand them out
+        uint32_t m_PoolID[NbMaxPools] = {};
+        FixedSizeArray<uint32_t, NbCachedPagesPerThread> m_Pages[NbMaxPools];
+    };
+    static thread_local ThreadCache ms_ThreadCache;
+
+    FixedSizeArray<uint32_t, NbCachedPagesPerThread>& GetThreadCachedPages();
+    void AddHeap();
+
+    uint32_t m_PoolIdx = 0;
+    uint32_t m_PoolID = 0;
+    HeapCreator m_CreateHeap;
+
+    std::mutex m_FreePagesLock;
+    std::vector<uint32_t> m_FreePages;
+    std::atomic<uint32_t> m_NumHeaps = 0;
+};
@@ -0,0 +1,98 @@
+#include <graphic/gfx/gfxdescriptorring.h>
+
+void GfxDescriptorRing::Initialize(uint32_t capacity, FenceValueGetter&& getCompletedFenceValue)
+{
+    assert(capacity > 0);
+
+    m_Capacity = capacity;
+    m_GetCompletedFenceValue = std::move(getCompletedFenceValue);
+}
+
+uint32_t GfxDescriptorRing::Allocate(uint32_t numDescriptors)
+{
+    assert(numDescriptors > 0 && numDescriptors <= m_Capacity);
+
+    while (true)
+    {
+        const uint64_t rangeBegin = m_Head.fetch_add(numDescriptors, std::memory_order_relaxed);
+        const uint32_t offset = (uint32_t)(rangeBegin % m_Capacity);
+
+        // Ranges must be contiguous in the heap. For one crossing the end of the ring, try to extend our claim so it starts at the beginning of the ring instead:
+        // that only works if nobody allocated after us. Otherwise skip it: what's left before the end of the ring is retired with the frame like any other range
+        if (offset + numDescriptors > m_Capacity)
+        {
+            const uint64_t wrapBegin = rangeBegin - offset + m_Capacity;
+            uint64_t expectedHead = rangeBegin + numDescriptors;
+            if (m_Head.compare_exchange_strong(expectedHead, wrapBegin + numDescriptors, std::memory_order_relaxed))
+            {
+                WaitForRetirement(wrapBegin + numDescriptors);
+                return 0;
+            }
+            continue;
+        }
+
+        WaitForRetirement(rangeBegin + numDescriptors);
+        return offset;
+    }
+}
+
+void GfxDescriptorRing::WaitForRetirement(uint64_t rangeEnd)
+{
+    if (rangeEnd <= m_Tail.load(std::memory_order_acquire) + m_Capacity)
+        return;
+
+    bbeProfileFunction();
+    m_NumStalls.fetch_add(1, std::memory_order_relaxed);
+
+    bbeAutoLock(m_InFlightFramesLock);
+    while (rangeEnd > m_Tail.load(std::memory_order_relaxed) + m_Capacity)
+    {
+        // Nothing left to retire means the current frame alone filled the whole ring
+        assert(!m_InFlightFrames.empty() && "Shader visible descriptor ring is too small for a single frame!");
+
+        RetireCompletedFrames();
+        std::this_thread::yield();
+    }
+}
+
+void GfxDescriptorRing::RetireCompletedFrames()
+{
+    const uint64_t completedFenceValue = m_GetCompletedFenceValue();
+    while (!m_InFlightFrames.empty() && m_InFlightFrames.front().m_FenceValue <= completedFenceValue)
+    {
+        m_Tail.store(m_InFlightFrames.front().m_Head, std::memory_order_release);
+        m_InFlightFrames.pop_front();
+    }
+}
+
+void GfxDescriptorRing::EndFrame(uint64_t fenceValue)
+{
+    bbeAutoLock(m_InFlightFramesLock);
+
+    assert(m_InFlightFrames.empty() || m_InFlightFrames.back().m_FenceValue < fenceValue);
+    m_InFlightFrames.push_back({ fenceValue, m_Head.load(std::memory_order_relaxed) });
+
+    // keep the tail fresh, so that allocations rarely need to look at fences
+    RetireCompletedFrames();
+}
+
+uint32_t GfxDescriptorRing::Allocate(GfxShaderVisibleDescriptorBlock& block, uint32_t numDescriptors, uint32_t blockSize)
+{
+    assert(numDescriptors > 0);
+
+    // Big tables go straight to the ring, rather than wasting most of a block
+    if (numDescriptors > blockSize / 2)
+        return Allocate(numDescriptors);
+
+    if (block.m_NumFree < numDescriptors)
+    {
+        block.m_Offset = Allocate(blockSize);
+        block.m_NumFree = blockSize;
+    }
+
+    const uint32_t offset = block.m_Offset;
+    block.m_Offset += numDescriptors;
+    block.m_NumFree -= numDescriptors;
+
+    return offset;
+}
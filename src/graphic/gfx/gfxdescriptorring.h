@@ -0,0 +1,51 @@
+#pragma once
+
+// Per-context chunk of a descriptor ring. Contexts carve descriptors out of it without touching the shared ring head
+struct GfxShaderVisibleDescriptorBlock
+{
+    uint32_t m_Offset = 0;
+    uint32_t m_NumFree = 0;
+};
+
+// Lock-free ring of descriptor indices, retired by frame fence values. Knows nothing about D3D12, so it can be driven by any fence.
+// Ranges are claimed with one atomic fetch-add on an ever increasing head. A range is only handed out once the frame that last used that part of the ring is done on the GPU
+class GfxDescriptorRing
+{
+public:
+    using FenceValueGetter = InplaceFunction<uint64_t(), 16>;
+
+    void Initialize(uint32_t capacity, FenceValueGetter&& getCompletedFenceValue);
+
+    // Returns the index of the first of 'numDescriptors' contiguous descriptors. Only stalls if the ring wraps into descriptors the GPU may still be reading
+    uint32_t Allocate(uint32_t numDescriptors);
+
+    // Same, carved out of 'block'. A new block of 'blockSize' descriptors is taken from the ring when it runs out. Tables bigger than half a block go straight to the ring
+    uint32_t Allocate(GfxShaderVisibleDescriptorBlock& block, uint32_t numDescriptors, uint32_t blockSize);
+
+    // Call after signaling 'fenceValue' for the frame: everything allocated since the previous call is retired when the GPU reaches it
+    void EndFrame(uint64_t fenceValue);
+
+    uint32_t GetCapacity() const { return m_Capacity; }
+    uint32_t GetNumStalls() const { return m_NumStalls.load(std::memory_order_relaxed); }
+
+private:
+    void WaitForRetirement(uint64_t rangeEnd);
+    void RetireCompletedFrames();
+
+    struct InFlightFrame
+    {
+        uint64_t m_FenceValue;
+        uint64_t m_Head;
+    };
+
+    uint32_t m_Capacity = 0;
+    FenceValueGetter m_GetCompletedFenceValue;
+
+    // Head and tail are virtual offsets: (offset % m_Capacity) is the descriptor index. Everything before the tail is retired
+    alignas(CacheLineSize) std::atomic<uint64_t> m_Head = 0;
+    alignas(CacheLineSize) std::atomic<uint64_t> m_Tail = 0;
+
+    std::mutex m_InFlightFramesLock;
+    std::deque<InFlightFrame> m_InFlightFrames;
+    std::atomic<uint32_t> m_NumStalls = 0;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+// Descriptor tables already copied to the shader visible heap, keyed by their source descriptors. Knows nothing about D3D12: source descriptors are anything with a 'ptr', and copies are GPU handle values.
+// Only valid while the copies are: a context owns one, and its shader visible descriptors aren't recycled before the frame is done on the GPU
+class GfxDescriptorTableCache
+{
+public:
+    // Returns the GPU handle of an identical table, or 0. 'hash' is returned either way, for Add() on a miss
+    template <typename SrcHandle>
+    uint64_t Find(const SrcHandle* srcDescriptors, uint32_t numDescriptors, uint64_t& hash);
+
+    template <typename SrcHandle>
+    void Add(uint64_t hash, const SrcHandle* srcDescriptors, uint32_t numDescriptors, uint64_t GPUHandle);
+
+    // When source descriptors were rewritten: the same handles don't mean the same contents anymore
+    void Clear() { m_Tables.clear(); }
+
+    uint32_t GetNumHits() const { return m_NumHits; }
+    uint32_t GetNumMisses() const { return m_NumMisses; }
+
+private:
+    struct CommittedTable
+    {
+        uint64_t m_GPUHandle = 0;
+        InplaceArray<uint64_t, 8> m_SrcDescriptors;
+    };
+
+    FlatHashMap<uint64_t, CommittedTable> m_Tables;
+    uint32_t m_NumHits = 0;
+    uint32_t m_NumMisses = 0;
+};
+
+template <typename SrcHandle>
+uint64_t GfxDescriptorTableCache::Find(const SrcHandle* srcDescriptors, uint32_t numDescriptors, uint64_t& hash)
+{
+    hash = numDescriptors;
+    for (uint32_t i = 0; i < numDescriptors; ++i)
+    {
+        assert(srcDescriptors[i].ptr != 0);
+        hash = HashUtils::Combine(hash, srcDescriptors[i].ptr);
+    }
+
+    // handles are compared on a hash hit, so collisions can't alias
+    auto it = m_Tables.find(hash);
+    if (it != m_Tables.end() && std::equal(srcDescriptors, srcDescriptors + numDescriptors, it->second.m_SrcDescriptors.begin(), it->second.m_SrcDescriptors.end(),
+                                           [](const SrcHandle& lhs, uint64_t rhs) { return lhs.ptr == rhs; }))
+    {
+        ++m_NumHits;
+        return it->second.m_GPUHandle;
+    }
+
+    ++m_NumMisses;
+    return 0;
+}
+
+template <typename SrcHandle>
+void GfxDescriptorTableCache::Add(uint64_t hash, const SrcHandle* srcDescriptors, uint32_t numDescriptors, uint64_t GPUHandle)
+{
+    assert(GPUHandle != 0);
+
+    CommittedTable& table = m_Tables[hash];
+    table.m_GPUHandle = GPUHandle;
+    table.m_SrcDescriptors.clear();
+    for (uint32_t i = 0; i < numDescriptors; ++i)
+    {
+        table.m_SrcDescriptors.push_back(srcDescriptors[i].ptr);
+    }
+}
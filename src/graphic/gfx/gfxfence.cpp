@@ -45,6 +45,17 @@ void GfxFence::WaitForSignalFromGPU() const
 
     bbeProfileFunction();
 
+    // GPU is usually only a few micro-seconds away. Poll a bit before paying for the kernel event round-trip
+    static const uint32_t FenceSpinCount = 256;
+    UINT64 spinCompletedValue = completedValue;
+    if (FutexUtils::SpinUntil([&] { spinCompletedValue = m_Fence->GetCompletedValue(); return spinCompletedValue >= m_FenceValue; }, FenceSpinCount))
+    {
+        // device removed while we were spinning: also reads as "completed"
+        if (spinCompletedValue == UINT64_MAX)
+            DeviceRemovedHandler();
+        return;
+    }
+
     const DWORD waitResult = ::WaitForSingleObject(m_FenceEvent, 1000);
 
     // GPU hang? Deadlock?
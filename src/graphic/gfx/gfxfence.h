@@ -16,6 +16,7 @@ public:
     void WaitForSignalFromGPU() const;
 
     uint64_t GetValue() const { return m_FenceValue; }
+    uint64_t GetCompletedValue() const { return m_Fence->GetCompletedValue(); }
     ::HANDLE GetEvent() const { return m_FenceEvent; }
 
 private:
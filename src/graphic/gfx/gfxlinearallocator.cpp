@@ -0,0 +1,153 @@
+#include <graphic/gfx/gfxlinearallocator.h>
+
+void GfxLinearAllocator::Initialize(uint32_t pageSize, PageCreator&& createPage, PageDestroyer&& destroyPage, FenceValueGetter&& getCompletedFenceValue)
+{
+    assert(pageSize > 0 && bbeIsAligned(pageSize, DefaultAlignment));
+
+    m_PageSize = pageSize;
+    m_CreatePage = std::move(createPage);
+    m_DestroyPage = std::move(destroyPage);
+    m_GetCompletedFenceValue = std::move(getCompletedFenceValue);
+}
+
+void GfxLinearAllocator::ShutDown()
+{
+    bbeAutoLock(m_PagesLock);
+
+    for (uint32_t i = 0; i < m_NumPageSlots; ++i)
+    {
+        if (m_AlivePages[i])
+            m_DestroyPage(i);
+    }
+    m_AlivePages.reset();
+    m_DedicatedPages.reset();
+    m_NumAlivePages = 0;
+    m_NumPageSlots = 0;
+
+    m_FreePages.clear();
+    m_FreePageSlots.clear();
+    m_FramePages.clear();
+    m_RetiredPages.clear();
+    m_CurrentPage.store(PackPageState(InvalidPageIdx, 0));
+}
+
+GfxLinearAllocator::Allocation GfxLinearAllocator::Allocate(uint32_t size, uint32_t alignment)
+{
+    assert(size > 0);
+    assert(IsPowerOfTwo(alignment) && alignment >= DefaultAlignment);
+
+    // Everything is bumped in multiples of DefaultAlignment. Bigger alignments are padded inside the allocation
+    const uint32_t allocSize = AlignUp(size + alignment - DefaultAlignment, DefaultAlignment);
+
+    if (allocSize > m_PageSize)
+    {
+        bbeAutoLock(m_PagesLock);
+        const uint32_t pageIdx = CreatePage(AlignUp(size, DefaultAlignment), true);
+        m_FramePages.push_back(pageIdx);
+        return { pageIdx, 0 };
+    }
+
+    while (true)
+    {
+        const uint64_t pageState = m_CurrentPage.fetch_add(allocSize);
+        const uint32_t pageIdx = (uint32_t)(pageState >> 32);
+        const uint32_t offset = (uint32_t)pageState;
+
+        // 64 bits: threads bumping a full page push the offset well past its end
+        if (pageIdx != InvalidPageIdx && (uint64_t)offset + allocSize <= m_PageSize)
+            return { pageIdx, AlignUp(offset, alignment) };
+
+        SwitchPage(pageIdx);
+    }
+}
+
+void GfxLinearAllocator::SwitchPage(uint32_t fullPageIdx)
+{
+    bbeAutoLock(m_PagesLock);
+
+    // another thread already switched it
+    if ((uint32_t)(m_CurrentPage.load() >> 32) != fullPageIdx)
+        return;
+
+    RecycleCompletedPages();
+
+    uint32_t newPageIdx = 0;
+    if (!m_FreePages.empty())
+    {
+        newPageIdx = m_FreePages.back();
+        m_FreePages.pop_back();
+    }
+    else
+    {
+        newPageIdx = CreatePage(m_PageSize, false);
+    }
+
+    m_FramePages.push_back(newPageIdx);
+    m_CurrentPage.store(PackPageState(newPageIdx, 0));
+}
+
+uint32_t GfxLinearAllocator::CreatePage(uint32_t pageSize, bool dedicated)
+{
+    bbeProfileFunction();
+
+    uint32_t pageIdx = m_NumPageSlots;
+    if (!m_FreePageSlots.empty())
+    {
+        pageIdx = m_FreePageSlots.back();
+        m_FreePageSlots.pop_back();
+    }
+    else
+    {
+        assert(m_NumPageSlots < NbMaxPages);
+        ++m_NumPageSlots;
+    }
+
+    m_CreatePage(pageIdx, pageSize);
+
+    m_AlivePages.set(pageIdx);
+    m_DedicatedPages.set(pageIdx, dedicated);
+    m_NumAlivePages.fetch_add(1, std::memory_order_relaxed);
+
+    return pageIdx;
+}
+
+void GfxLinearAllocator::RecycleCompletedPages()
+{
+    if (m_RetiredPages.empty())
+        return;
+
+    const uint64_t completedFenceValue = m_GetCompletedFenceValue();
+    while (!m_RetiredPages.empty() && m_RetiredPages.front().m_FenceValue <= completedFenceValue)
+    {
+        const uint32_t pageIdx = m_RetiredPages.front().m_PageIdx;
+        m_RetiredPages.pop_front();
+
+        if (!m_DedicatedPages[pageIdx])
+        {
+            m_FreePages.push_back(pageIdx);
+            continue;
+        }
+
+        m_DestroyPage(pageIdx);
+        m_AlivePages.reset(pageIdx);
+        m_NumAlivePages.fetch_sub(1, std::memory_order_relaxed);
+        m_FreePageSlots.push_back(pageIdx);
+    }
+}
+
+void GfxLinearAllocator::EndFrame(uint64_t fenceValue)
+{
+    bbeAutoLock(m_PagesLock);
+
+    m_NumPagesUsedLastFrame.store((uint32_t)m_FramePages.size(), std::memory_order_relaxed);
+    for (uint32_t pageIdx : m_FramePages)
+    {
+        m_RetiredPages.push_back({ fenceValue, pageIdx });
+    }
+    m_FramePages.clear();
+
+    // next frame starts on a fresh page, so that a page is never shared by 2 frames
+    m_CurrentPage.store(PackPageState(InvalidPageIdx, 0));
+
+    RecycleCompletedPages();
+}
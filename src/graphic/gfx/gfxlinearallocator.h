@@ -0,0 +1,65 @@
+#pragma once
+
+// Per-frame linear allocator over big pages. Knows nothing about D3D12: pages are created and destroyed through callbacks, and identified by index.
+// Sub-allocations are an atomic bump in the current page. Pages are only recycled once the fence of the frame that used them has completed
+class GfxLinearAllocator
+{
+public:
+    static const uint32_t DefaultAlignment = 256;
+    static const uint32_t NbMaxPages = 256;
+
+    struct Allocation
+    {
+        uint32_t m_PageIdx;
+        uint32_t m_Offset;
+    };
+
+    using PageCreator = InplaceFunction<void(uint32_t pageIdx, uint32_t pageSize), 16>;
+    using PageDestroyer = InplaceFunction<void(uint32_t pageIdx), 16>;
+    using FenceValueGetter = InplaceFunction<uint64_t(), 16>;
+
+    void Initialize(uint32_t pageSize, PageCreator&&, PageDestroyer&&, FenceValueGetter&&);
+    void ShutDown();
+
+    // 'alignment' must be a power of two, of at least DefaultAlignment. Allocations bigger than a page get a dedicated page, destroyed once the frame is done
+    Allocation Allocate(uint32_t size, uint32_t alignment = DefaultAlignment);
+
+    // Call after signaling 'fenceValue' for the frame: pages used since the previous call are recycled when the GPU reaches it
+    void EndFrame(uint64_t fenceValue);
+
+    uint32_t GetNumPages() const { return m_NumAlivePages.load(std::memory_order_relaxed); }
+    uint32_t GetNumPagesUsedLastFrame() const { return m_NumPagesUsedLastFrame.load(std::memory_order_relaxed); }
+
+private:
+    static const uint32_t InvalidPageIdx = UINT32_MAX;
+    static uint64_t PackPageState(uint32_t pageIdx, uint32_t offset) { return ((uint64_t)pageIdx << 32) | offset; }
+
+    void SwitchPage(uint32_t fullPageIdx);
+    uint32_t CreatePage(uint32_t pageSize, bool dedicated);
+    void RecycleCompletedPages();
+
+    uint32_t m_PageSize = 0;
+    PageCreator m_CreatePage;
+    PageDestroyer m_DestroyPage;
+    FenceValueGetter m_GetCompletedFenceValue;
+
+    // Current page index in the high 32 bits, bump offset in the low 32 bits
+    alignas(CacheLineSize) std::atomic<uint64_t> m_CurrentPage = PackPageState(InvalidPageIdx, 0);
+
+    struct RetiredPage
+    {
+        uint64_t m_FenceValue;
+        uint32_t m_PageIdx;
+    };
+
+    std::mutex m_PagesLock;
+    std::vector<uint32_t> m_FreePages;
+    std::vector<uint32_t> m_FreePageSlots;
+    std::vector<uint32_t> m_FramePages;
+    std::deque<RetiredPage> m_RetiredPages;
+    std::bitset<NbMaxPages> m_AlivePages;
+    std::bitset<NbMaxPages> m_DedicatedPages;
+    uint32_t m_NumPageSlots = 0;
+    std::atomic<uint32_t> m_NumAlivePages = 0;
+    std::atomic<uint32_t> m_NumPagesUsedLastFrame = 0;
+};
@@ -48,6 +48,8 @@ void GfxManager::Initialize(tf::Subflow& subFlow)
     tf::Task preInitGate = subFlow.emplace([this](tf::Subflow& sf) { PreInit(sf); });
     tf::Task mainInitGate = subFlow.emplace([this](tf::Subflow& sf) { MainInit(sf); }).succeed(preInitGate);
     subFlow.emplace([this] { PostInit(); }).succeed(mainInitGate);
+
+    SetScheduledRenderers();
 }
 
 void GfxManager::PreInit(tf::Subflow& subFlow)
@@ -58,9 +60,11 @@ void GfxManager::PreInit(tf::Subflow& subFlow)
     m_GfxDevice.Initialize();
 
     subFlow.emplace([] { gs_FrameFence.Initialize(); });
-    subFlow.emplace([this] { m_GfxCommandManager.Initialize(); });
+    subFlow.emplace([this] { m_GfxCommandManager.Initialize(128); }); // resource creations & uploads queue up during loads
     subFlow.emplace([] { g_GfxPSOManager.Initialize(); });
     subFlow.emplace([] { g_GfxGPUDescriptorAllocator.Initialize(); });
+    subFlow.emplace([] { g_GfxCPUDescriptorAllocator.Initialize(); });
+    subFlow.emplace([] { g_GfxViewCache.Initialize(); });
     subFlow.emplace([] { g_GfxMemoryAllocator.Initialize(); });
     subFlow.emplace([](tf::Subflow& sf) { g_GfxCommandListsManager.Initialize(sf); });
 }
@@ -84,6 +88,8 @@ void GfxManager::PostInit()
 
     // signal frame fence and stall cpu until all gpu work is done
     gs_FrameFence.IncrementAndSignal(g_GfxCommandListsManager.GetMainQueue().Dev());
+    g_GfxGPUDescriptorAllocator.EndFrame(gs_FrameFence.GetValue());
+    g_GfxMemoryAllocator.EndFrame(gs_FrameFence.GetValue());
     gs_FrameFence.WaitForSignalFromGPU();
 }
 
@@ -114,49 +120,53 @@ void GfxManager::ShutDown()
 
 void GfxManager::ScheduleGraphicTasks(tf::Subflow& subFlow)
 {
-    bbeProfileFunction();
+    // watched by the profiler's spike detector. See System::Initialize
+    bbeProfileGroup("Graphic", "GfxManager::ScheduleGraphicTasks");
 
     // TODO: This will kill performance with D3D12_GPU_BASED_VALIDATION_STATE_TRACKING enabled!
     // Implement proper fence-based free-ing of gpu resources
     gs_FrameFence.WaitForSignalFromGPU();
 
-    tf::Task beginFrameGate = subFlow.emplace([this] { BeginFrame(); });
-    subFlow.emplace([this](tf::Subflow& sf) { m_GfxCommandManager.ConsumeAllCommandsMT(sf); }).succeed(beginFrameGate);
-    tf::Task endFrameGate = subFlow.emplace([this] { EndFrame(); });
+    if (m_FrameTaskflowDirty)
+        BuildFrameTaskflow();
 
-    struct ExecutionContext
-    {
-        GfxRendererBase* m_Renderer = nullptr;
-        bool m_DoSkeletonScheduling = true;
-    };
+    subFlow.composed_of(m_FrameTaskflow);
+}
 
-    // Functor for Renderers' cmd list population
-    FixedSizeFlatMap<D3D12_COMMAND_LIST_TYPE, ExecutionContext, 3> lastExecutionContext;
-    auto ScheduleRenderer = [&](GfxRendererBase* renderer, bool doSkeletonScheduling = true)
-    {
-        // reset each renderers' dependencies and event
-        renderer->m_Event.Reset();
-        renderer->m_Dependencies.clear();
+void GfxManager::SetScheduledRenderers()
+{
+    m_ScheduledRenderers.clear();
+    m_ScheduledRenderers.push_back({ g_GfxBodyGravityParticlesUpdate, false });
+    m_ScheduledRenderers.push_back({ g_GfxForwardLightingPass });
+    m_ScheduledRenderers.push_back({ g_GfxBodyGravityParticlesRender });
+    m_ScheduledRenderers.push_back({ g_GfxIMGUIRenderer });
 
-        GfxContext& context = GenerateLightweightGfxContext();
+    m_FrameTaskflowDirty = true;
+}
 
-        // Do nothing if no need to render
-        if (!renderer->ShouldPopulateCommandList(context))
-            return;
+void GfxManager::BuildFrameTaskflow()
+{
+    bbeProfileFunction();
 
-        // Rough skeleton dependency scheduling based off last renderer of same cmd list type
-        D3D12_COMMAND_LIST_TYPE cmdListType = renderer->GetCommandListType(context);
-        if (lastExecutionContext[cmdListType].m_Renderer && lastExecutionContext[cmdListType].m_DoSkeletonScheduling)
-            renderer->m_Dependencies.push_back(lastExecutionContext[cmdListType].m_Renderer);
-        lastExecutionContext[cmdListType] = { renderer, doSkeletonScheduling };
+    m_FrameTaskflow.clear();
 
-        subFlow.emplace([&, renderer, cmdListType]()
+    tf::Task prepareRenderersGate = m_FrameTaskflow.emplace([this] { PrepareRenderersForFrame(); });
+    tf::Task beginFrameGate = m_FrameTaskflow.emplace([this] { BeginFrame(); }).succeed(prepareRenderersGate);
+    m_FrameTaskflow.emplace([this](tf::Subflow& sf) { m_GfxCommandManager.ConsumeAllCommandsMT(sf); }).succeed(beginFrameGate);
+    tf::Task endFrameGate = m_FrameTaskflow.emplace([this] { EndFrame(); });
+
+    for (ScheduledRenderer& scheduledRenderer : m_ScheduledRenderers)
+    {
+        tf::Task populateCmdListTask = m_FrameTaskflow.emplace([&scheduledRenderer]()
             {
-                context.Initialize(cmdListType, renderer->GetName());
-                
+                GfxRendererBase* renderer = scheduledRenderer.m_Renderer;
+                GfxContext& context = *scheduledRenderer.m_Context;
+
+                context.Initialize(scheduledRenderer.m_CommandListType, renderer->GetName());
+
                 renderer->AddDependencies();
                 renderer->PopulateCommandList(context);
-                
+
                 // Execute cmd list only after prior dependent renderers are done
                 for (GfxRendererBase* dependentRenderer : renderer->m_Dependencies)
                 {
@@ -170,14 +180,55 @@ void GfxManager::ScheduleGraphicTasks(tf::Subflow& subFlow)
 
                 // signal event after cmd list submission
                 renderer->m_Event.Signal();
+            }).name(scheduledRenderer.m_Renderer->GetName());
+
+        tf::Task rendererDoneTask = m_FrameTaskflow.emplace([] {}).precede(endFrameGate);
+
+        // Condition task: 0 == populate cmd list, 1 == skip renderer for this frame
+        m_FrameTaskflow.emplace([&scheduledRenderer]() -> int { return scheduledRenderer.m_ShouldPopulate ? 0 : 1; })
+            .succeed(beginFrameGate)
+            .precede(populateCmdListTask, rendererDoneTask);
+
+        populateCmdListTask.precede(rendererDoneTask);
+    }
+
+    m_FrameTaskflowDirty = false;
+}
 
-            }).succeed(beginFrameGate).precede(endFrameGate);
+void GfxManager::PrepareRenderersForFrame()
+{
+    bbeProfileFunction();
+
+    struct ExecutionContext
+    {
+        GfxRendererBase* m_Renderer = nullptr;
+        bool m_DoSkeletonScheduling = true;
     };
 
-    ScheduleRenderer(g_GfxBodyGravityParticlesUpdate, false);
-    ScheduleRenderer(g_GfxForwardLightingPass);
-    ScheduleRenderer(g_GfxBodyGravityParticlesRender);
-    ScheduleRenderer(g_GfxIMGUIRenderer);
+    FixedSizeFlatMap<D3D12_COMMAND_LIST_TYPE, ExecutionContext, 3> lastExecutionContext;
+    for (ScheduledRenderer& scheduledRenderer : m_ScheduledRenderers)
+    {
+        GfxRendererBase* renderer = scheduledRenderer.m_Renderer;
+
+        // reset each renderers' dependencies and event
+        renderer->m_Event.Reset();
+        renderer->m_Dependencies.clear();
+
+        scheduledRenderer.m_Context = &GenerateLightweightGfxContext();
+
+        // Do nothing if no need to render
+        scheduledRenderer.m_ShouldPopulate = renderer->ShouldPopulateCommandList(*scheduledRenderer.m_Context);
+        if (!scheduledRenderer.m_ShouldPopulate)
+            continue;
+
+        // Rough skeleton dependency scheduling based off last renderer of same cmd list type
+        const D3D12_COMMAND_LIST_TYPE cmdListType = renderer->GetCommandListType(*scheduledRenderer.m_Context);
+        if (lastExecutionContext[cmdListType].m_Renderer && lastExecutionContext[cmdListType].m_DoSkeletonScheduling)
+            renderer->m_Dependencies.push_back(lastExecutionContext[cmdListType].m_Renderer);
+        lastExecutionContext[cmdListType] = { renderer, scheduledRenderer.m_DoSkeletonScheduling };
+
+        scheduledRenderer.m_CommandListType = cmdListType;
+    }
 }
 
 void GfxManager::BeginFrame()
@@ -219,13 +270,22 @@ void GfxManager::EndFrame()
     // signal frame fence after presenting
     gs_FrameFence.IncrementAndSignal(g_GfxCommandListsManager.GetMainQueue().Dev());
 
+    // shader visible descriptors and upload pages used this frame are recycled once the GPU reaches the frame fence
+    g_GfxGPUDescriptorAllocator.EndFrame(gs_FrameFence.GetValue());
+    g_GfxMemoryAllocator.EndFrame(gs_FrameFence.GetValue());
+
     // reset array of GfxContexts to prepare for next frame
-    std::for_each(m_AllContexts.begin(), m_AllContexts.end(), [this](GfxContext* context) { m_ContextsPool.destroy(context); });
+    std::for_each(m_AllContexts.begin(), m_AllContexts.end(), [](GfxContext* context) { context->~GfxContext(); });
     m_AllContexts.clear();
 
     ++m_GraphicFrameNumber;
 }
 
+const GfxFence& GfxManager::GetFrameFence() const
+{
+    return gs_FrameFence;
+}
+
 GfxContext& GfxManager::GenerateNewContext(D3D12_COMMAND_LIST_TYPE cmdListType, std::string_view name)
 {
     GfxContext& newContext = GenerateLightweightGfxContext();
@@ -238,8 +298,9 @@ GfxContext& GfxManager::GenerateLightweightGfxContext()
 {
     bbeProfileFunction();
 
+    GfxContext* ret = g_FrameArena.New<GfxContext>();
+
     bbeAutoLock(m_ContextsLock);
-    GfxContext* ret = m_ContextsPool.construct();
     m_AllContexts.push_back(ret);
     return *ret;
 }
@@ -255,6 +316,7 @@ void GfxManager::UpdateIMGUIPropertyGrid()
 
     static bool showMemoryStats = false;
     static bool showDetailedStats = false;
+    static bool showViewCacheStats = false;
 
     ScopedIMGUIWindow window{ "GfxManager" };
     ImGui::Checkbox("Show Memory Stats", &showMemoryStats);
@@ -281,9 +343,23 @@ void GfxManager::UpdateIMGUIPropertyGrid()
 
         ImGui::NewLine();
 
+        ImGui::Text("Upload Pages:");
+        ImGui::LabelText("Alive", "\t%u", g_GfxMemoryAllocator.GetUploadAllocator().GetNumPages());
+        ImGui::LabelText("Used Last Frame", "\t%u", g_GfxMemoryAllocator.GetUploadAllocator().GetNumPagesUsedLastFrame());
+
+        ImGui::NewLine();
+
         ImGui::Checkbox("Show Detailed Stats", &showDetailedStats);
     }
 
+    ImGui::Checkbox("Show View Cache Stats", &showViewCacheStats);
+    if (showViewCacheStats)
+    {
+        ImGui::LabelText("Views", "\t%u", g_GfxViewCache.GetNumViews());
+        ImGui::LabelText("Hits", "\t%llu", g_GfxViewCache.GetNumHits());
+        ImGui::LabelText("Misses", "\t%llu", g_GfxViewCache.GetNumMisses());
+    }
+
     if (showDetailedStats)
     {
         WCHAR* statsStringW = NULL;
@@ -8,6 +8,9 @@
 
 #include <graphic/view.h>
 
+class GfxFence;
+class GfxRendererBase;
+
 class GfxManager
 {
     DeclareSingletonFunctions(GfxManager);
@@ -22,12 +25,13 @@ public:
     void EndFrame();
 
     template <typename Lambda>
-    void AddGraphicCommand(Lambda&& lambda) { m_GfxCommandManager.AddCommand(std::forward<Lambda>(lambda)); }
+    void AddGraphicCommand(Lambda&& lambda, CommandProperties properties = {}) { m_GfxCommandManager.AddCommand(std::forward<Lambda>(lambda), properties); }
 
     GfxContext& GenerateNewContext(D3D12_COMMAND_LIST_TYPE, std::string_view name);
 
     GfxDevice& GetGfxDevice() { return m_GfxDevice; }
     GfxSwapChain& GetSwapChain() { return m_SwapChain; }
+    const GfxFence& GetFrameFence() const;
 
     View& GetMainView() { return m_MainView; }
 
@@ -39,11 +43,25 @@ private:
     void PostInit();
     GfxContext& GenerateLightweightGfxContext();
     void UpdateIMGUIPropertyGrid();
+    void SetScheduledRenderers();
+    void BuildFrameTaskflow();
+    void PrepareRenderersForFrame();
+
+    struct ScheduledRenderer
+    {
+        GfxRendererBase* m_Renderer = nullptr;
+        bool m_DoSkeletonScheduling = true;
+
+        // per-frame data, filled in PrepareRenderersForFrame
+        GfxContext* m_Context = nullptr;
+        D3D12_COMMAND_LIST_TYPE m_CommandListType = D3D12_COMMAND_LIST_TYPE_DIRECT;
+        bool m_ShouldPopulate = false;
+    };
 
     static const uint32_t NbMaxContexts = 128;
 
+    // GfxContexts live in the frame arena. Only their destructors are run in EndFrame
     std::mutex m_ContextsLock;
-    ObjectPool<GfxContext> m_ContextsPool;
     InplaceArray<GfxContext*, NbMaxContexts> m_AllContexts;
 
     GfxDevice    m_GfxDevice;
@@ -51,6 +69,11 @@ private:
 
     CommandManager m_GfxCommandManager;
 
+    // Persistent per-frame task graph. Only rebuilt when the set of scheduled renderers changes
+    tf::Taskflow m_FrameTaskflow;
+    bool m_FrameTaskflowDirty = true;
+    InplaceArray<ScheduledRenderer, 8> m_ScheduledRenderers;
+
     View m_MainView;
 
     uint32_t m_GraphicFrameNumber = 0;
@@ -14,6 +14,31 @@ void GfxMemoryAllocator::Initialize()
 
     DX12_CALL(D3D12MA::CreateAllocator(&desc, &m_D3D12MemoryAllocator));
     assert(m_D3D12MemoryAllocator);
+
+    auto CreateUploadPage = [this](uint32_t pageIdx, uint32_t pageSize)
+    {
+        UploadPage& page = m_UploadPages[pageIdx];
+        assert(!page.m_Allocation);
+
+        page.m_Allocation = AllocateInternal(D3D12_HEAP_TYPE_UPLOAD, CD3DX12_RESOURCE_DESC1::Buffer(pageSize), D3D12_RESOURCE_STATE_GENERIC_READ, nullptr);
+        SetD3DDebugName(page.m_Allocation->GetResource(), StringFormat("Upload Page %u", pageIdx));
+
+        // upload heaps can stay mapped for their whole lifetime
+        const D3D12_RANGE readRange{};
+        DX12_CALL(page.m_Allocation->GetResource()->Map(0, &readRange, reinterpret_cast<void**>(&page.m_CPUAddress)));
+        page.m_GPUAddress = page.m_Allocation->GetResource()->GetGPUVirtualAddress();
+    };
+
+    auto DestroyUploadPage = [this](uint32_t pageIdx)
+    {
+        UploadPage& page = m_UploadPages[pageIdx];
+        page.m_Allocation->GetResource()->Unmap(0, nullptr);
+        page.m_Allocation->GetResource()->Release();
+        page.m_Allocation->Release();
+        page = UploadPage{};
+    };
+
+    m_UploadAllocator.Initialize(UploadPageSize, CreateUploadPage, DestroyUploadPage, [] { return g_GfxManager.GetFrameFence().GetCompletedValue(); });
 }
 
 D3D12MA::Allocation* GfxMemoryAllocator::AllocateInternal(D3D12_HEAP_TYPE heapType, const CD3DX12_RESOURCE_DESC1& desc, D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE* clearValue)
@@ -50,7 +75,6 @@ D3D12MA::Allocation* GfxMemoryAllocator::AllocateStatic(const CD3DX12_RESOURCE_D
     return allocHandle;
 }
 
-// TODO: Heap Pools of 256 bytes, 4 KB & 64 KB
 D3D12MA::Allocation* GfxMemoryAllocator::AllocateVolatile(D3D12_HEAP_TYPE heapType, const CD3DX12_RESOURCE_DESC1& desc)
 {
     assert(heapType == D3D12_HEAP_TYPE_UPLOAD || heapType == D3D12_HEAP_TYPE_READBACK);
@@ -66,9 +90,18 @@ D3D12MA::Allocation* GfxMemoryAllocator::AllocateVolatile(D3D12_HEAP_TYPE heapTy
     return allocHandle;
 }
 
+GfxUploadAllocation GfxMemoryAllocator::AllocateUpload(uint32_t size, uint32_t alignment)
+{
+    const GfxLinearAllocator::Allocation allocation = m_UploadAllocator.Allocate(size, alignment);
+    const UploadPage& page = m_UploadPages[allocation.m_PageIdx];
+
+    return GfxUploadAllocation{ page.m_Allocation->GetResource(), allocation.m_Offset, page.m_CPUAddress + allocation.m_Offset, page.m_GPUAddress + allocation.m_Offset };
+}
+
 void GfxMemoryAllocator::ShutDown()
 {
     GarbageCollect();
+    m_UploadAllocator.ShutDown();
 
     for (D3D12MA::Allocation* allocHandle : m_StaticAllocations)
     {
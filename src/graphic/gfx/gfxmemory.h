@@ -1,5 +1,16 @@
 #pragma once
 
+#include <graphic/gfx/gfxlinearallocator.h>
+
+// Persistently mapped upload memory, valid until the end of the frame it's allocated in
+struct GfxUploadAllocation
+{
+    D3D12Resource* m_Resource = nullptr;
+    uint64_t m_ResourceOffset = 0;
+    std::byte* m_CPUAddress = nullptr;
+    D3D12_GPU_VIRTUAL_ADDRESS m_GPUAddress = 0;
+};
+
 class GfxMemoryAllocator
 {
     DeclareSingletonFunctions(GfxMemoryAllocator);
@@ -11,6 +22,10 @@ public:
 
     D3D12MA::Allocation* AllocateStatic(const CD3DX12_RESOURCE_DESC1&, D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE*);
     D3D12MA::Allocation* AllocateVolatile(D3D12_HEAP_TYPE, const CD3DX12_RESOURCE_DESC1&);
+    GfxUploadAllocation AllocateUpload(uint32_t size, uint32_t alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+
+    void EndFrame(uint64_t frameFenceValue) { m_UploadAllocator.EndFrame(frameFenceValue); }
+    const GfxLinearAllocator& GetUploadAllocator() const { return m_UploadAllocator; }
 
     void ShutDown();
     void ReleaseStatic(D3D12MA::Allocation*);
@@ -26,5 +41,16 @@ private:
 
     std::mutex m_VolatileAllocationsLck;
     InplaceArray<D3D12MA::Allocation*, 128> m_VolatileAllocations;
+
+    static const uint32_t UploadPageSize = BBE_MB(4);
+
+    struct UploadPage
+    {
+        D3D12MA::Allocation* m_Allocation = nullptr;
+        std::byte* m_CPUAddress = nullptr;
+        D3D12_GPU_VIRTUAL_ADDRESS m_GPUAddress = 0;
+    };
+    GfxLinearAllocator m_UploadAllocator;
+    UploadPage m_UploadPages[GfxLinearAllocator::NbMaxPages];
 };
 #define g_GfxMemoryAllocator GfxMemoryAllocator::GetInstance()
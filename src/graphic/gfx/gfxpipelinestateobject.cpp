@@ -44,15 +44,13 @@ void GfxPSOManager::ShutDown()
     assert(m_PipelineLibrary);
 
     // Important: An ID3D12PipelineLibrary object becomes undefined when the underlying memory, that was used to initalize it, changes.
-    assert(m_PipelineLibrary->GetSerializedSize() <= UINT_MAX);    // Code below casts to UINT.
-    const UINT librarySize = static_cast<UINT>(m_PipelineLibrary->GetSerializedSize());
+    const uint64_t librarySize = m_PipelineLibrary->GetSerializedSize();
     if (m_NewPSOs > 0 && librarySize > 0)
     {
         g_Log.info("Saving '{}' new PSOs into PipelineLibrary", m_NewPSOs);
 
         // Grow the file if needed.
-        const size_t neededSize = sizeof(UINT) + librarySize;
-        if (neededSize > m_MemoryMappedCacheFile.GetCurrentFileSize())
+        if (librarySize > m_MemoryMappedCacheFile.GetDataCapacity())
         {
             // The file mapping is going to change thus it will invalidate the ID3D12PipelineLibrary object.
             // Serialize the library contents to temporary memory first.
@@ -61,18 +59,19 @@ void GfxPSOManager::ShutDown()
 
             DX12_CALL(m_PipelineLibrary->Serialize(pTempData.data(), librarySize));
 
-            // Now it's safe to grow the mapping.
-            m_MemoryMappedCacheFile.GrowMapping(librarySize);
-
-            // Save the size of the library and the library itself.
-            memcpy(m_MemoryMappedCacheFile.GetData(), pTempData.data(), librarySize);
-            m_MemoryMappedCacheFile.SetSize(librarySize);
+            // Now it's safe to grow the mapping. On failure the previous cache stays as is, and is only missing the new PSOs
+            if (m_MemoryMappedCacheFile.GrowMapping(librarySize))
+            {
+                // Save the size of the library and the library itself.
+                memcpy(m_MemoryMappedCacheFile.GetData(), pTempData.data(), librarySize);
+                m_MemoryMappedCacheFile.SetSize(librarySize);
+            }
         }
         else
         {
             // The mapping didn't change, we can serialize directly to the mapped file.
             // Save the size of the library and the library itself.
-            assert(neededSize <= m_MemoryMappedCacheFile.GetCurrentFileSize());
+            assert(librarySize <= m_MemoryMappedCacheFile.GetDataCapacity());
             DX12_CALL(m_PipelineLibrary->Serialize(m_MemoryMappedCacheFile.GetData(), librarySize));
             m_MemoryMappedCacheFile.SetSize(librarySize);
         }
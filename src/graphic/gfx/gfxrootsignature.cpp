@@ -91,22 +91,24 @@ std::size_t GfxRootSignatureManager::GetOrCreateRootSig(CD3DX12_DESCRIPTOR_RANGE
     for (uint32_t i = 0; i < nbRanges; ++i)
         rootParams[i].InitAsDescriptorTable(1, &ranges[i]);
 
-    std::size_t hash = 0;
-    boost::hash_combine(hash, flags);
+    HashUtils::Hasher64 hasher;
+    hasher.Update(flags);
     for (uint32_t i = 0; i < nbRanges; ++i)
     {
-        boost::hash_combine(hash, rootParams[i].ParameterType);
-        boost::hash_combine(hash, rootParams[i].ShaderVisibility);
+        hasher.Update(rootParams[i].ParameterType);
+        hasher.Update(rootParams[i].ShaderVisibility);
 
         for (uint32_t j = 0; j < rootParams[i].DescriptorTable.NumDescriptorRanges; ++j)
         {
-            boost::hash_combine(hash, rootParams[i].DescriptorTable.pDescriptorRanges[j].RangeType);
-            boost::hash_combine(hash, rootParams[i].DescriptorTable.pDescriptorRanges[j].NumDescriptors);
-            boost::hash_combine(hash, rootParams[i].DescriptorTable.pDescriptorRanges[j].BaseShaderRegister);
-            boost::hash_combine(hash, rootParams[i].DescriptorTable.pDescriptorRanges[j].RegisterSpace);
-            boost::hash_combine(hash, rootParams[i].DescriptorTable.pDescriptorRanges[j].Flags);
+            const D3D12_DESCRIPTOR_RANGE1& range = rootParams[i].DescriptorTable.pDescriptorRanges[j];
+            hasher.Update(range.RangeType);
+            hasher.Update(range.NumDescriptors);
+            hasher.Update(range.BaseShaderRegister);
+            hasher.Update(range.RegisterSpace);
+            hasher.Update(range.Flags);
         }
     }
+    const std::size_t hash = hasher.Finalize();
 
     bbeAutoLockWrite(m_CachedRootSigsRWLock);
     assert(m_CachedRootSigs.size() < NbMaxRootSigs);
@@ -17,7 +17,7 @@ void GfxShader::Initialize(const AutoGenerated::ShaderData& data)
     m_Type = data.m_ShaderType;
 
     assert(m_Hash == 0);
-    m_Hash = boost::hash_range(data.m_ByteCodeArray, data.m_ByteCodeArray + data.m_ByteCodeSize);
+    m_Hash = HashUtils::XXH3_64(data.m_ByteCodeArray, data.m_ByteCodeSize);
 }
 
 void GfxShaderManager::Initialize()
@@ -30,8 +30,10 @@ void GfxShaderManager::Initialize()
         m_ShaderContainers[data.m_ShaderType][data.m_BaseShaderID][data.m_ShaderKey];
     }
 
-    for (const AutoGenerated::ShaderData& data : AutoGenerated::gs_AllShadersData)
-    {
-        g_TasksExecutor.silent_async([this, &data] { m_ShaderContainers[data.m_ShaderType][data.m_BaseShaderID][data.m_ShaderKey].Initialize(data); });
-    }
+    // few shaders, each copying and hashing its whole byte code: one per chunk
+    ParallelUtils::ParallelFor(0, (uint32_t)std::size(AutoGenerated::gs_AllShadersData), [this](uint32_t i)
+        {
+            const AutoGenerated::ShaderData& data = AutoGenerated::gs_AllShadersData[i];
+            m_ShaderContainers[data.m_ShaderType][data.m_BaseShaderID][data.m_ShaderKey].Initialize(data);
+        }, 1);
 }
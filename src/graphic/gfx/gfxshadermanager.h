@@ -41,7 +41,7 @@ public:
 
 private:
     // key == BaseShaderID, val = { ShaderKey, GfxShader }
-    using ShaderContainer = FlatMap<std::size_t, FlatMap<uint32_t, GfxShader>>;
+    using ShaderContainer = FlatHashMap<std::size_t, FlatHashMap<uint32_t, GfxShader>>;
     ShaderContainer m_ShaderContainers[GfxShaderType_Count];
 };
 #define g_GfxShaderManager GfxShaderManager::GetInstance()
@@ -14,6 +14,7 @@ void GfxResourceBase::Release()
 
     if (m_D3D12MABufferAllocation)
     {
+        g_GfxViewCache.OnResourceReleased(m_D3D12Resource);
         g_GfxMemoryAllocator.ReleaseStatic(m_D3D12MABufferAllocation);
         m_D3D12MABufferAllocation = nullptr;
     }
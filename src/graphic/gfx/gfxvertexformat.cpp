@@ -8,15 +8,18 @@ void GfxVertexFormat::Initialize(const D3D12_INPUT_ELEMENT_DESC (&desc)[NumEleme
     m_Desc.NumElements = NumElements;
     m_Desc.pInputElementDescs = (decltype(m_Desc.pInputElementDescs))&desc;
 
+    HashUtils::Hasher64 hasher;
     for (uint32_t i = 0; i < NumElements; ++i)
     {
-        boost::hash_combine(m_Hash, std::string{ desc[i].SemanticName });
-        boost::hash_combine(m_Hash, desc[i].SemanticIndex);
-        boost::hash_combine(m_Hash, desc[i].InputSlot);
-        boost::hash_combine(m_Hash, desc[i].AlignedByteOffset);
-        boost::hash_combine(m_Hash, desc[i].InputSlotClass);
-        boost::hash_combine(m_Hash, desc[i].InstanceDataStepRate);
+        hasher.Update(desc[i].SemanticName, strlen(desc[i].SemanticName));
+        hasher.Update(desc[i].SemanticIndex);
+        hasher.Update(desc[i].Format);
+        hasher.Update(desc[i].InputSlot);
+        hasher.Update(desc[i].AlignedByteOffset);
+        hasher.Update(desc[i].InputSlotClass);
+        hasher.Update(desc[i].InstanceDataStepRate);
     }
+    m_Hash = hasher.Finalize();
 }
 
 void GfxDefaultVertexFormats::Initialize()
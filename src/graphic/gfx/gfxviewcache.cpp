@@ -0,0 +1,121 @@
+#include <graphic/gfx/gfxviewcache.h>
+#include <graphic/pch.h>
+
+static D3D12_SHADER_RESOURCE_VIEW_DESC CreateSRVDesc(GfxTexture& tex)
+{
+    D3D12_SHADER_RESOURCE_VIEW_DESC SRVDesc{};
+
+    const D3D12_RESOURCE_DESC resourceDesc = tex.GetD3D12Resource()->GetDesc();
+    switch (resourceDesc.Dimension)
+    {
+    case D3D12_RESOURCE_DIMENSION_BUFFER:
+        SRVDesc = CD3D12_SHADER_RESOURCE_VIEW_DESC{ D3D12_SRV_DIMENSION_BUFFER, resourceDesc.Format };
+        if (resourceDesc.Format == DXGI_FORMAT_UNKNOWN)
+        {
+            SRVDesc.Buffer.NumElements = tex.GetNumElements();
+            SRVDesc.Buffer.StructureByteStride = tex.GetStructureByteStride();
+        }
+        break;
+    case D3D12_RESOURCE_DIMENSION_TEXTURE2D:
+        SRVDesc = CD3D12_SHADER_RESOURCE_VIEW_DESC{ D3D12_SRV_DIMENSION_TEXTURE2D, resourceDesc.Format };
+        SRVDesc.Texture2D.MipLevels = 1; // TODO: Mips
+        break;
+
+        // TODO: Other dimensions when needed
+    default: assert(false);
+    }
+
+    return SRVDesc;
+}
+
+static D3D12_UNORDERED_ACCESS_VIEW_DESC CreateUAVDesc(GfxTexture& tex)
+{
+    D3D12_UNORDERED_ACCESS_VIEW_DESC UAVDesc{};
+
+    const D3D12_RESOURCE_DESC resourceDesc = tex.GetD3D12Resource()->GetDesc();
+    switch (resourceDesc.Dimension)
+    {
+    case D3D12_RESOURCE_DIMENSION_BUFFER:
+        UAVDesc = CD3D12_UNORDERED_ACCESS_VIEW_DESC{ D3D12_UAV_DIMENSION_BUFFER, resourceDesc.Format };
+        if (resourceDesc.Format == DXGI_FORMAT_UNKNOWN)
+        {
+            UAVDesc.Buffer.NumElements = tex.m_NumElements;
+            UAVDesc.Buffer.StructureByteStride = tex.m_StructureByteStride;
+        }
+        break;
+    case D3D12_RESOURCE_DIMENSION_TEXTURE2D:
+        UAVDesc = CD3D12_UNORDERED_ACCESS_VIEW_DESC{ D3D12_UAV_DIMENSION_TEXTURE2D, resourceDesc.Format };
+        break;
+
+        // TODO: Other dimensions when needed
+    default: assert(false);
+    }
+
+    return UAVDesc;
+}
+
+void GfxViewCache::Initialize()
+{
+    m_Views.Initialize([](uint32_t heapType) { return g_GfxCPUDescriptorAllocator.AllocatePage((D3D12_DESCRIPTOR_HEAP_TYPE)heapType); });
+}
+
+template <typename CreateViewFunc>
+CD3DX12_CPU_DESCRIPTOR_HANDLE GfxViewCache::GetOrCreateView(GfxTexture& tex, ViewType type, DXGI_FORMAT format, uint32_t flags, CreateViewFunc&& createViewFunc)
+{
+    D3D12_DESCRIPTOR_HEAP_TYPE heapType = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+    switch (type)
+    {
+    case ViewType::RTV: heapType = D3D12_DESCRIPTOR_HEAP_TYPE_RTV; break;
+    case ViewType::DSV: heapType = D3D12_DESCRIPTOR_HEAP_TYPE_DSV; break;
+    default: break;
+    }
+
+    auto GetCPUHandle = [heapType](uint32_t descriptorIdx)
+    {
+        return g_GfxCPUDescriptorAllocator.GetCPUHandle(heapType, descriptorIdx / GfxDescriptorPagePool::NbDescriptorsPerPage, descriptorIdx % GfxDescriptorPagePool::NbDescriptorsPerPage);
+    };
+
+    const GfxViewTable::ViewKey key{ tex.GetD3D12Resource(), (uint32_t)type, (uint32_t)format, flags };
+    const uint32_t descriptorIdx = m_Views.GetOrCreateView(key, heapType, [&](uint32_t newDescriptorIdx) { createViewFunc(GetCPUHandle(newDescriptorIdx)); });
+
+    return GetCPUHandle(descriptorIdx);
+}
+
+CD3DX12_CPU_DESCRIPTOR_HANDLE GfxViewCache::GetSRV(GfxTexture& tex)
+{
+    return GetOrCreateView(tex, ViewType::SRV, DXGI_FORMAT_UNKNOWN, 0, [&tex](D3D12_CPU_DESCRIPTOR_HANDLE destHandle)
+        {
+            const D3D12_SHADER_RESOURCE_VIEW_DESC SRVDesc = CreateSRVDesc(tex);
+            g_GfxManager.GetGfxDevice().Dev()->CreateShaderResourceView(tex.GetD3D12Resource(), &SRVDesc, destHandle);
+        });
+}
+
+CD3DX12_CPU_DESCRIPTOR_HANDLE GfxViewCache::GetUAV(GfxTexture& tex)
+{
+    return GetOrCreateView(tex, ViewType::UAV, DXGI_FORMAT_UNKNOWN, 0, [&tex](D3D12_CPU_DESCRIPTOR_HANDLE destHandle)
+        {
+            const D3D12_UNORDERED_ACCESS_VIEW_DESC UAVDesc = CreateUAVDesc(tex);
+
+            static ID3D12Resource* pCounterResource = nullptr; // TODO
+            g_GfxManager.GetGfxDevice().Dev()->CreateUnorderedAccessView(tex.GetD3D12Resource(), pCounterResource, &UAVDesc, destHandle);
+        });
+}
+
+CD3DX12_CPU_DESCRIPTOR_HANDLE GfxViewCache::GetRTV(GfxTexture& tex, DXGI_FORMAT format)
+{
+    return GetOrCreateView(tex, ViewType::RTV, format, 0, [&tex, format](D3D12_CPU_DESCRIPTOR_HANDLE destHandle)
+        {
+            // TODO: Any other dimensions for RTV other than Texture2D?
+            const CD3D12_RENDER_TARGET_VIEW_DESC RTVDesc{ D3D12_RTV_DIMENSION_TEXTURE2D, format };
+            g_GfxManager.GetGfxDevice().Dev()->CreateRenderTargetView(tex.GetD3D12Resource(), &RTVDesc, destHandle);
+        });
+}
+
+CD3DX12_CPU_DESCRIPTOR_HANDLE GfxViewCache::GetDSV(GfxTexture& tex, D3D12_DSV_FLAGS flags)
+{
+    return GetOrCreateView(tex, ViewType::DSV, tex.GetFormat(), (uint32_t)flags, [&tex, flags](D3D12_CPU_DESCRIPTOR_HANDLE destHandle)
+        {
+            const D3D12_DEPTH_STENCIL_VIEW_DESC DSVDesc{ tex.GetFormat(), D3D12_DSV_DIMENSION_TEXTURE2D, flags };
+            g_GfxManager.GetGfxDevice().Dev()->CreateDepthStencilView(tex.GetD3D12Resource(), &DSVDesc, destHandle);
+        });
+}
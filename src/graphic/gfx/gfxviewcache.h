@@ -0,0 +1,36 @@
+#pragma once
+
+#include <graphic/gfx/gfxviewtable.h>
+
+class GfxTexture;
+
+// Persistent CPU descriptors for resource views, keyed by resource and view description. Views are created on first use and dropped when their resource is released, so staging a view is a hash lookup.
+// View descriptions are derived from the resource itself: on top of the resource, only the view type, format and flags are needed to tell them apart
+class GfxViewCache
+{
+    DeclareSingletonFunctions(GfxViewCache);
+
+public:
+    void Initialize();
+
+    CD3DX12_CPU_DESCRIPTOR_HANDLE GetSRV(GfxTexture&);
+    CD3DX12_CPU_DESCRIPTOR_HANDLE GetUAV(GfxTexture&);
+    CD3DX12_CPU_DESCRIPTOR_HANDLE GetRTV(GfxTexture&, DXGI_FORMAT);
+    CD3DX12_CPU_DESCRIPTOR_HANDLE GetDSV(GfxTexture&, D3D12_DSV_FLAGS);
+
+    void OnResourceReleased(D3D12Resource* resource) { m_Views.OnResourceReleased(resource); }
+
+    uint64_t GetNumHits() const { return m_Views.GetNumHits(); }
+    uint64_t GetNumMisses() const { return m_Views.GetNumMisses(); }
+    uint32_t GetNumViews() const { return m_Views.GetNumViews(); }
+    uint32_t GetNumReleases() const { return m_Views.GetNumReleases(); }
+
+private:
+    enum class ViewType : uint32_t { SRV, UAV, RTV, DSV };
+
+    template <typename CreateViewFunc>
+    CD3DX12_CPU_DESCRIPTOR_HANDLE GetOrCreateView(GfxTexture&, ViewType, DXGI_FORMAT, uint32_t flags, CreateViewFunc&&);
+
+    GfxViewTable m_Views;
+};
+#define g_GfxViewCache GfxViewCache::GetInstance()
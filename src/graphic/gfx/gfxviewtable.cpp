@@ -0,0 +1,58 @@
+#include <graphic/gfx/gfxviewtable.h>
+
+std::size_t GfxViewTable::ViewKeyHash::operator()(const ViewKey& key) const
+{
+    uint64_t hash = HashUtils::Combine((uint64_t)key.m_Resource, key.m_Type);
+    hash = HashUtils::Combine(hash, key.m_Format);
+    return (std::size_t)HashUtils::Combine(hash, key.m_Flags);
+}
+
+void GfxViewTable::Initialize(PageAllocator&& allocatePage)
+{
+    m_AllocatePage = std::move(allocatePage);
+}
+
+uint32_t GfxViewTable::AllocateDescriptor(uint32_t heapType)
+{
+    DescriptorPool& pool = m_DescriptorPools[heapType];
+
+    if (!pool.m_FreeDescriptors.empty())
+    {
+        const uint32_t descriptorIdx = pool.m_FreeDescriptors.back();
+        pool.m_FreeDescriptors.pop_back();
+        return descriptorIdx;
+    }
+
+    if (pool.m_NumUsedInLastPage == GfxDescriptorPagePool::NbDescriptorsPerPage)
+    {
+        pool.m_Pages.push_back(m_AllocatePage(heapType));
+        pool.m_NumUsedInLastPage = 0;
+    }
+
+    return pool.m_Pages.back() * GfxDescriptorPagePool::NbDescriptorsPerPage + pool.m_NumUsedInLastPage++;
+}
+
+void GfxViewTable::OnResourceReleased(const void* resource)
+{
+    bbeAutoLock(m_ViewsLock);
+
+    auto it = m_ViewsPerResource.find(resource);
+    if (it == m_ViewsPerResource.end())
+        return;
+
+    for (const ViewKey& key : it->second)
+    {
+        CachedView view;
+        if (!m_Views.find(key, view))
+        {
+            assert(false);
+            continue;
+        }
+
+        m_Views.erase(key);
+        m_DescriptorPools[view.m_HeapType].m_FreeDescriptors.push_back(view.m_DescriptorIdx);
+    }
+    m_NumViews.fetch_sub((uint32_t)it->second.size(), std::memory_order_relaxed);
+    m_ViewsPerResource.erase(it);
+    m_NumReleases.fetch_add(1, std::memory_order_release);
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <graphic/gfx/gfxdescriptorpagepool.h>
+
+// Persistent descriptor indices for resource views, keyed by resource and view description. Knows nothing about D3D12: descriptor pages come from a callback, and views are written by the caller on a miss.
+// Lookups only take a shard's reader lock. Creating and dropping views take one lock, so each view is created exactly once
+class GfxViewTable
+{
+public:
+    // Pages of GfxDescriptorPagePool::NbDescriptorsPerPage descriptors, from the heap of type 'heapType'
+    using PageAllocator = InplaceFunction<uint32_t(uint32_t heapType), 16>;
+
+    struct ViewKey
+    {
+        const void* m_Resource = nullptr;
+        uint32_t m_Type = 0;
+        uint32_t m_Format = 0;
+        uint32_t m_Flags = 0;
+
+        bool operator==(const ViewKey& other) const { return m_Resource == other.m_Resource && m_Type == other.m_Type && m_Format == other.m_Format && m_Flags == other.m_Flags; }
+    };
+
+    void Initialize(PageAllocator&& allocatePage);
+
+    // Returns the view's descriptor index in its heap: page * NbDescriptorsPerPage + index in page. 'createView(descriptorIdx)' is only called on the view's first use
+    template <typename CreateViewFunc>
+    uint32_t GetOrCreateView(const ViewKey&, uint32_t heapType, CreateViewFunc&&);
+
+    // Must be called before the resource is destroyed, so that its address can not alias a new resource's stale views. Its descriptors are recycled right away
+    void OnResourceReleased(const void* resource);
+
+    uint64_t GetNumHits() const { return m_NumHits.load(std::memory_order_relaxed); }
+    uint64_t GetNumMisses() const { return m_NumMisses.load(std::memory_order_relaxed); }
+    uint32_t GetNumViews() const { return m_NumViews.load(std::memory_order_relaxed); }
+
+    // Bumped whenever descriptors are recycled: anything remembering what a descriptor held must forget it
+    uint32_t GetNumReleases() const { return m_NumReleases.load(std::memory_order_acquire); }
+
+private:
+    struct ViewKeyHash
+    {
+        std::size_t operator()(const ViewKey& key) const;
+    };
+
+    struct CachedView
+    {
+        uint32_t m_HeapType = 0;
+        uint32_t m_DescriptorIdx = 0;
+    };
+
+    // Descriptors are carved out of pages, and recycled through a free list
+    struct DescriptorPool
+    {
+        std::vector<uint32_t> m_Pages;
+        uint32_t m_NumUsedInLastPage = GfxDescriptorPagePool::NbDescriptorsPerPage;
+        std::vector<uint32_t> m_FreeDescriptors;
+    };
+
+    uint32_t AllocateDescriptor(uint32_t heapType);
+
+    PageAllocator m_AllocatePage;
+
+    ConcurrentUnorderedMap<ViewKey, CachedView, ViewKeyHash> m_Views;
+
+    // Only taken when creating or dropping views
+    std::mutex m_ViewsLock;
+    FlatHashMap<const void*, InplaceArray<ViewKey, 2>> m_ViewsPerResource;
+    DescriptorPool m_DescriptorPools[GfxDescriptorPagePool::NbMaxPools];
+
+    std::atomic<uint64_t> m_NumHits = 0;
+    std::atomic<uint64_t> m_NumMisses = 0;
+    std::atomic<uint32_t> m_NumViews = 0;
+    std::atomic<uint32_t> m_NumReleases = 0;
+};
+
+template <typename CreateViewFunc>
+uint32_t GfxViewTable::GetOrCreateView(const ViewKey& key, uint32_t heapType, CreateViewFunc&& createViewFunc)
+{
+    assert(key.m_Resource);
+    assert(heapType < GfxDescriptorPagePool::NbMaxPools);
+
+    CachedView view;
+    if (m_Views.find(key, view))
+    {
+        m_NumHits.fetch_add(1, std::memory_order_relaxed);
+        return view.m_DescriptorIdx;
+    }
+
+    bbeAutoLock(m_ViewsLock);
+
+    // another thread may have created it while we were waiting for the lock
+    if (m_Views.find(key, view))
+    {
+        m_NumHits.fetch_add(1, std::memory_order_relaxed);
+        return view.m_DescriptorIdx;
+    }
+
+    bbeProfile("Create View");
+    m_NumMisses.fetch_add(1, std::memory_order_relaxed);
+
+    view.m_HeapType = heapType;
+    view.m_DescriptorIdx = AllocateDescriptor(heapType);
+
+    // written before it's published: other threads never see a view that isn't there yet
+    createViewFunc(view.m_DescriptorIdx);
+
+    m_Views.insert(key, view);
+    m_ViewsPerResource[key.m_Resource].push_back(key);
+    m_NumViews.fetch_add(1, std::memory_order_relaxed);
+
+    return view.m_DescriptorIdx;
+}
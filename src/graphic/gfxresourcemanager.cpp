@@ -8,13 +8,19 @@ template <typename T>
 struct ManagedGfxResources
 {
     using HashedResourceFilePath = std::size_t;
-    std::unordered_map<HashedResourceFilePath, T*> m_ResourceCache;
+    using Finalizer = GfxResourceManager::ResourceLoadingFinalizer<T>;
+
+    FlatHashMap<HashedResourceFilePath, T*> m_ResourceCache;
+
+    // Files being read/decoded/created. Later requests for the same file only queue their finalizer, and share the load in flight
+    FlatHashMap<HashedResourceFilePath, std::vector<Finalizer>> m_InFlightLoads;
     std::shared_mutex m_CacheLock;
 
     ObjectPool<T> m_Pool;
     std::mutex m_PoolLock;
 
-    void Load(const std::string& filePath, const GfxResourceManager::ResourceLoadingFinalizer<T>&);
+    void Load(const std::string& filePath, const AsyncFileIO::ReadResult& fileData);
+    void FinishLoad(const std::string& filePath, T* resource);
     void Release();
 
     static ManagedGfxResources<T>& Get() 
@@ -35,29 +41,91 @@ T* GfxResourceManager::Get(const std::string& filePath, const ResourceLoadingFin
 {
     ManagedGfxResources<T>& resources = ManagedGfxResources<T>::Get();
 
-    // if resource is already loaded in memory, return ptr to resource
     const std::size_t hashedFilePath = std::hash<std::string>{}(filePath);
 
-    bbeAutoLockRead(resources.m_CacheLock);
-    if (resources.m_ResourceCache.count(hashedFilePath))
     {
-        g_Log.info("Retrieved {} from resource cache", filePath.c_str());
-        return resources.m_ResourceCache[hashedFilePath];
+        // if resource is already loaded in memory, return ptr to resource
+        bbeAutoLockRead(resources.m_CacheLock);
+        auto it = resources.m_ResourceCache.find(hashedFilePath);
+        if (it != resources.m_ResourceCache.end())
+        {
+            g_Log.info("Retrieved {} from resource cache", filePath.c_str());
+            return it->second;
+        }
+
+        bbeAutoLockScopedRWUpgrade(resources.m_CacheLock);
+
+        // the load may have completed while upgrading the lock
+        it = resources.m_ResourceCache.find(hashedFilePath);
+        if (it != resources.m_ResourceCache.end())
+            return it->second;
+
+        // already being loaded: the load in flight calls this finalizer too
+        auto inFlightIt = resources.m_InFlightLoads.find(hashedFilePath);
+        if (inFlightIt != resources.m_InFlightLoads.end())
+        {
+            inFlightIt->second.push_back(finalizer);
+            return nullptr;
+        }
+        resources.m_InFlightLoads[hashedFilePath].push_back(finalizer);
     }
 
-    // resource not yet loaded in memory. Load it async in BG thread, and return nullptr
-    g_System.AddBGAsyncCommand([&, filePath, finalizer]() { resources.Load(filePath, finalizer); });
+    // resource not yet loaded in memory. Read it async, decode it in BG thread, and return nullptr
+    std::vector<AsyncFileIO::ReadRequest> readRequests(1);
+    readRequests[0].m_FilePath = filePath;
+    readRequests[0].m_OnComplete = [&resources, filePath](AsyncFileIO::ReadResult& result)
+    {
+        if (!result.m_Success)
+        {
+            g_Log.error("Failed to load {} from disk!", filePath.c_str());
+            resources.FinishLoad(filePath, nullptr);
+            return;
+        }
+
+        // decoding is heavy. Keep it off the tasks executor
+        auto fileData = std::make_shared<AsyncFileIO::ReadResult>(std::move(result));
+        g_System.AddBGAsyncCommand([&resources, filePath, fileData]() { resources.Load(filePath, *fileData); }, BGAsyncWorkerPool::Visible);
+    };
+    g_AsyncFileIO.ReadBatch(std::move(readRequests));
 
     return nullptr;
 }
 
+// Caches the loaded resource & calls the finalizers of every request that shared the load. On failure (nullptr), the next Get() retries
+template <typename T>
+void ManagedGfxResources<T>::FinishLoad(const std::string& filePath, T* resource)
+{
+    const std::size_t hashedFilePath = std::hash<std::string>{}(filePath);
+
+    std::vector<Finalizer> finalizers;
+    {
+        bbeAutoLockWrite(m_CacheLock);
+        if (resource)
+        {
+            m_ResourceCache[hashedFilePath] = resource;
+        }
+
+        auto it = m_InFlightLoads.find(hashedFilePath);
+        assert(it != m_InFlightLoads.end());
+        finalizers = std::move(it->second);
+        m_InFlightLoads.erase(hashedFilePath);
+    }
+
+    if (resource)
+    {
+        for (const Finalizer& finalizer : finalizers)
+        {
+            finalizer(resource);
+        }
+    }
+}
+
 template<>
-void ManagedGfxResources<GfxTexture>::Load(const std::string& filePath, const GfxResourceManager::ResourceLoadingFinalizer<GfxTexture>& finalizer)
+void ManagedGfxResources<GfxTexture>::Load(const std::string& filePath, const AsyncFileIO::ReadResult& fileData)
 {
     bbeProfileFunction();
 
     const std::string fileExt = GetFileExtensionFromPath(filePath);
-    const std::wstring filePathW = StringUtils::Utf8ToWide(filePath);
 
     std::vector<std::byte> decodedData;
     D3D12_RESOURCE_DESC texDesc{};
@@ -68,18 +136,19 @@ void ManagedGfxResources<GfxTexture>::Load(const std::string& filePath, const Gf
     }
     else
     {
-        DirectX::LoadWICTextureFromFileSimple(filePathW.c_str(), decodedData, subResource, texDesc);
+        DirectX::LoadWICTextureFromMemorySimple((const uint8_t*)fileData.m_Data, (size_t)fileData.m_Size, decodedData, subResource, texDesc);
     }
 
     const uint32_t imageBytes = (uint32_t)subResource.SlicePitch;
     if (imageBytes == 0)
     {
         g_Log.error("Failed to load {} from disk!", filePath.c_str());
+        FinishLoad(filePath, nullptr);
         return;
     }
 
     // init and assign gfx texture in the next gfx frame
-    auto CreateGfxTexture = [&, texDesc = std::move(texDesc), initData = std::move(decodedData), filePath, finalizer]()
+    auto CreateGfxTexture = [&, texDesc = std::move(texDesc), initData = std::move(decodedData), filePath]()
     {
         GfxTexture* newTex = [&]()
         {
@@ -89,17 +158,14 @@ void ManagedGfxResources<GfxTexture>::Load(const std::string& filePath, const Gf
         newTex->InitializeTexture(CD3DX12_RESOURCE_DESC1::Tex2D(texDesc.Format, texDesc.Width, texDesc.Height), initData.data(), D3D12_CLEAR_VALUE{}, D3D12_RESOURCE_STATE_GENERIC_READ, true /*immediate*/);
         newTex->SetDebugName(GetFileNameFromPath(filePath).c_str());
 
-        finalizer(newTex);
-
         g_Log.info("Loaded and initialized {}", filePath.c_str());
 
         // finally, cache gfx texture
-        const std::size_t hashedFilePath = std::hash<std::string>{}(filePath);
-
-        bbeAutoLockWrite(m_CacheLock);
-        m_ResourceCache[hashedFilePath] = newTex;
+        FinishLoad(filePath, newTex);
     };
-    g_GfxManager.AddGraphicCommand(CreateGfxTexture);
+    // texture creation + upload is alot heavier than the usual graphic command
+    static const uint32_t CreateGfxTextureCost = 16;
+    g_GfxManager.AddGraphicCommand(CreateGfxTexture, CommandProperties{ CreateGfxTextureCost });
 }
 
 template<>
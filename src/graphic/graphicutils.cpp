@@ -330,19 +330,59 @@ void UploadToGfxResource(D3D12GraphicsCommandList* pCommandList, GfxResourceBase
     assert(slicePitch > 0);
     assert(srcData);
 
-    D3D12MA::Allocation* uploadHeapAlloc = g_GfxMemoryAllocator.AllocateVolatile(D3D12_HEAP_TYPE_UPLOAD, CD3DX12_RESOURCE_DESC1::Buffer(uploadBufferSize));
-    SetD3DDebugName(uploadHeapAlloc->GetResource(), "UpdateSubresources");
+    // texture placement alignment is the strictest of all copy sources
+    const GfxUploadAllocation upload = g_GfxMemoryAllocator.AllocateUpload(uploadBufferSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
 
     bbeScopedD3DResourceState(pCommandList, destResource, currentResourceState, D3D12_RESOURCE_STATE_COPY_DEST);
 
-    // upload init data via CopyTextureRegion/CopyBufferRegion
-    const UINT MaxSubresources = 1;
+    // Same as d3dx12's UpdateSubresources, but with streaming copies into the write-combined upload heap
     const UINT64 IntermediateOffset = 0;
     const UINT FirstSubresource = 0;
     const UINT NumSubresources = 1;
-    const D3D12_SUBRESOURCE_DATA data{ srcData, rowPitch, slicePitch };
-    const UINT64 r = UpdateSubresources<MaxSubresources>(pCommandList, destResource.GetD3D12Resource(), uploadHeapAlloc->GetResource(), IntermediateOffset, FirstSubresource, NumSubresources, &data);
-    assert(r);
+
+    const D3D12_RESOURCE_DESC destDesc = destResource.GetD3D12Resource()->GetDesc();
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT layout{};
+    UINT numRows = 0;
+    UINT64 rowSizeInBytes = 0;
+    UINT64 requiredSize = 0;
+    g_GfxManager.GetGfxDevice().Dev()->GetCopyableFootprints(&destDesc, FirstSubresource, NumSubresources, IntermediateOffset, &layout, &numRows, &rowSizeInBytes, &requiredSize);
+    assert(requiredSize <= uploadBufferSize);
+
+    // footprints are relative to the start of our allocation, not the start of the upload page
+    std::byte* mappedData = upload.m_CPUAddress + layout.Offset;
+    layout.Offset += upload.m_ResourceOffset;
+
+    const std::byte* srcBytes = static_cast<const std::byte*>(srcData);
+    const uint64_t destSlicePitch = (uint64_t)layout.Footprint.RowPitch * numRows;
+    for (UINT z = 0; z < layout.Footprint.Depth; ++z)
+    {
+        std::byte* destSlice = mappedData + destSlicePitch * z;
+        const std::byte* srcSlice = srcBytes + (uint64_t)slicePitch * z;
+
+        // tightly packed rows on both sides: one big copy
+        if (layout.Footprint.RowPitch == rowPitch && rowPitch == rowSizeInBytes)
+        {
+            SIMDMemCopyToWriteCombined(destSlice, srcSlice, rowSizeInBytes * numRows);
+            continue;
+        }
+
+        for (UINT y = 0; y < numRows; ++y)
+        {
+            SIMDMemCopyToWriteCombined(destSlice + (uint64_t)layout.Footprint.RowPitch * y, srcSlice + (uint64_t)rowPitch * y, rowSizeInBytes);
+        }
+    }
+
+    // upload init data via CopyTextureRegion/CopyBufferRegion
+    if (destDesc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+    {
+        pCommandList->CopyBufferRegion(destResource.GetD3D12Resource(), 0, upload.m_Resource, layout.Offset, layout.Footprint.Width);
+    }
+    else
+    {
+        const CD3DX12_TEXTURE_COPY_LOCATION dst{ destResource.GetD3D12Resource(), FirstSubresource };
+        const CD3DX12_TEXTURE_COPY_LOCATION src{ upload.m_Resource, layout };
+        pCommandList->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
+    }
 }
 
 uint32_t CountMips(uint32_t width, uint32_t height)
@@ -22,5 +22,6 @@
 #include <graphic/gfx/gfxshadermanager.h>
 #include <graphic/gfx/gfxtexturesandbuffers.h>
 #include <graphic/gfx/gfxvertexformat.h>
+#include <graphic/gfx/gfxviewcache.h>
 
 #include <graphic/renderers/gfxrendererbase.h>
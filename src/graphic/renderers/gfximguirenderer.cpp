@@ -86,8 +86,8 @@ void GfxIMGUIRenderer::GrowBuffers(const IMGUIDrawData& imguiDrawData)
 
 void GfxIMGUIRenderer::UploadBufferData(GfxContext& context, const IMGUIDrawData& imguiDrawData)
 {
-    std::vector<ImDrawVert> vertices;
-    std::vector<ImDrawIdx> indices;
+    FrameVector<ImDrawVert> vertices;
+    FrameVector<ImDrawIdx> indices;
     vertices.resize(m_VertexBuffer.GetNumVertices());
     indices.resize(m_IndexBuffer.GetNumIndices());
 
@@ -149,7 +149,7 @@ void GfxIMGUIRenderer::PopulateCommandList(GfxContext& context)
     static_assert(sizeof(ImDrawVert) == sizeof(float) * 2 + sizeof(float) * 2 + sizeof(uint32_t)); // Position2f_TexCoord2f_Color4ub
     static_assert(sizeof(ImDrawIdx) == sizeof(uint16_t)); // 2 byte index size
 
-    const IMGUIDrawData imguiDrawData = g_IMGUIManager.GetDrawData();
+    const IMGUIDrawData& imguiDrawData = g_IMGUIManager.GetDrawData();
 
     // Avoid rendering when minimized
     if (imguiDrawData.m_Size.x <= 0.0f || imguiDrawData.m_Size.y <= 0.0f)
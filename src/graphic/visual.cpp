@@ -8,7 +8,11 @@ ForwardDeclareSerializerFunctions(Visual);
 template <typename Archive>
 void Visual::Serialize(Archive& archive)
 {
-
+    archive(CEREAL_NVP(m_Name));
+    archive(CEREAL_NVP(m_UseGlobalPBRConsts));
+    archive(CEREAL_NVP(m_Scale));
+    archive(CEREAL_NVP(m_WorldPosition));
+    archive(CEREAL_NVP(m_Rotation));
 }
 
 void Visual::UpdateIMGUI()
@@ -17,8 +17,12 @@
 #include <array>
 #include <atomic>
 #include <bitset>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <map>
 #include <mutex>
 #include <numeric>
@@ -59,7 +63,6 @@
     #define CEREAL_SERIALIZE_FUNCTION_NAME Serialize
     #include <extern/cereal/types/vector.hpp> // allow Cereal to serialize std::vector
     #include <extern/cereal/types/string.hpp> // allow Cereal to serialize std::string
-    #include <extern/cereal/archives/binary.hpp> // Binary I/O
     #include <extern/cereal/archives/json.hpp> // JSON I/O
 
     // Arg Parse
@@ -121,6 +124,8 @@ using Microsoft::WRL::ComPtr;
 
 #include <system/containers.h>
 #include <system/math.h>
+#include <system/hash.h>
+#include <system/random.h>
 #include <system/utils.h>
 #include <system/timer.h>
 #include <system/system.h>
@@ -129,7 +134,11 @@ using Microsoft::WRL::ComPtr;
 #include <system/criticalsection.h>
 
 #if defined(BBE_ENGINE)
+    #include <system/asyncfileio.h>
+    #include <system/framearena.h>
+    #include <system/mappedbinaryarchive.h>
     #include <system/memcpy.h>
+    #include <system/parallel.h>
     #include <system/serializer.h>
     #include <system/keyboard.h>
     #include <system/mouse.h>
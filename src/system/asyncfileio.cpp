@@ -0,0 +1,475 @@
+#include <system/asyncfileio.h>
+
+#if defined(BBE_ENGINE)
+    #include <system/imguimanager.h>
+#endif
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#if defined(BBE_ENGINE)
+static bool gs_ShowFileIOIMGUIWindow = false;
+#endif
+
+// Pooled buffer sizes are powers of 2, from 64KB to 64MB. Bigger buffers are allocated on demand and not pooled
+static const uint32_t gs_MinBufferSizeLog2 = 16;
+static const uint32_t gs_NbBufferSizeClasses = 11;
+static const uint32_t gs_MaxPooledBuffersPerSizeClass = 8;
+
+// Page aligned, so buffers can also be used for unbuffered IO
+static const std::size_t gs_BufferAlignment = 4096;
+
+static std::mutex gs_BufferPoolLock;
+static std::vector<std::byte*> gs_FreeBuffers[gs_NbBufferSizeClasses];
+
+// Returns gs_NbBufferSizeClasses if the buffer is too big to be pooled
+static uint32_t GetBufferSizeClass(uint64_t size)
+{
+    uint32_t sizeClass = 0;
+    while (sizeClass < gs_NbBufferSizeClasses && (1ULL << (gs_MinBufferSizeLog2 + sizeClass)) < size)
+    {
+        ++sizeClass;
+    }
+    return sizeClass;
+}
+
+static std::byte* AllocateAlignedMemory(uint64_t size)
+{
+#if defined(_WIN32)
+    return (std::byte*)::_aligned_malloc(size, gs_BufferAlignment);
+#else
+    return (std::byte*)::aligned_alloc(gs_BufferAlignment, size);
+#endif
+}
+
+static void FreeAlignedMemory(std::byte* memory)
+{
+#if defined(_WIN32)
+    ::_aligned_free(memory);
+#else
+    ::free(memory);
+#endif
+}
+
+FileIOBuffer& FileIOBuffer::operator=(FileIOBuffer&& other) noexcept
+{
+    if (this != &other)
+    {
+        Release();
+        m_Data = std::exchange(other.m_Data, nullptr);
+        m_Capacity = std::exchange(other.m_Capacity, 0);
+    }
+    return *this;
+}
+
+FileIOBuffer FileIOBuffer::Allocate(uint64_t size)
+{
+    FileIOBuffer newBuffer;
+
+    const uint32_t sizeClass = GetBufferSizeClass(size);
+    if (sizeClass < gs_NbBufferSizeClasses)
+    {
+        newBuffer.m_Capacity = 1ULL << (gs_MinBufferSizeLog2 + sizeClass);
+
+        bbeAutoLock(gs_BufferPoolLock);
+        if (!gs_FreeBuffers[sizeClass].empty())
+        {
+            newBuffer.m_Data = gs_FreeBuffers[sizeClass].back();
+            gs_FreeBuffers[sizeClass].pop_back();
+            return newBuffer;
+        }
+    }
+    else
+    {
+        newBuffer.m_Capacity = AlignUp(size, gs_BufferAlignment);
+    }
+
+    newBuffer.m_Data = AllocateAlignedMemory(newBuffer.m_Capacity);
+    assert(newBuffer.m_Data);
+
+    return newBuffer;
+}
+
+void FileIOBuffer::Release()
+{
+    if (!m_Data)
+        return;
+
+    const uint32_t sizeClass = GetBufferSizeClass(m_Capacity);
+    if (sizeClass < gs_NbBufferSizeClasses)
+    {
+        bbeAutoLock(gs_BufferPoolLock);
+        if (gs_FreeBuffers[sizeClass].size() < gs_MaxPooledBuffersPerSizeClass)
+        {
+            gs_FreeBuffers[sizeClass].push_back(m_Data);
+            m_Data = nullptr;
+        }
+    }
+
+    if (m_Data)
+    {
+        FreeAlignedMemory(m_Data);
+    }
+
+    m_Data = nullptr;
+    m_Capacity = 0;
+}
+
+void AsyncFileIO::Initialize(uint32_t numIOThreads)
+{
+    bbeProfileFunction();
+
+    assert(numIOThreads > 0);
+    assert(m_Workers.empty());
+
+    m_Workers.reserve(numIOThreads);
+    for (uint32_t i = 0; i < numIOThreads; ++i)
+    {
+        m_Workers.emplace_back([this, i] { WorkerLoop(i); });
+    }
+
+#if defined(BBE_ENGINE)
+    g_IMGUIManager.RegisterTopMenu("System", "File IO", &gs_ShowFileIOIMGUIWindow);
+    g_IMGUIManager.RegisterWindowUpdateCB([&]() { UpdateIMGUI(); });
+#endif
+}
+
+void AsyncFileIO::ShutDown()
+{
+    bbeProfileFunction();
+
+    uint32_t nbDroppedBatches = 0;
+    {
+        bbeAutoLock(m_BatchesLock);
+        m_Exit = true;
+
+        nbDroppedBatches = (uint32_t)m_PendingBatches.size();
+        m_PendingBatches.clear();
+    }
+    m_BatchesCV.notify_all();
+
+    for (std::thread& worker : m_Workers)
+    {
+        worker.join();
+    }
+    m_Workers.clear();
+
+    if (nbDroppedBatches > 0)
+    {
+        g_Log.info("AsyncFileIO: dropped {} pending batches on shutdown", nbDroppedBatches);
+    }
+
+    bbeAutoLock(gs_BufferPoolLock);
+    for (std::vector<std::byte*>& freeBuffers : gs_FreeBuffers)
+    {
+        for (std::byte* buffer : freeBuffers)
+        {
+            FreeAlignedMemory(buffer);
+        }
+        freeBuffers.clear();
+    }
+}
+
+void AsyncFileIO::ReadBatch(std::vector<ReadRequest>&& requests)
+{
+    Batch newBatch;
+    newBatch.reserve(requests.size());
+    for (ReadRequest& request : requests)
+    {
+        assert(request.m_OnComplete);
+        newBatch.push_back(PendingRead{ std::move(request) });
+    }
+    requests.clear();
+
+    AddBatch(std::move(newBatch));
+}
+
+std::future<AsyncFileIO::ReadResult> AsyncFileIO::Read(ReadRequest&& request)
+{
+    Batch newBatch;
+    newBatch.push_back(PendingRead{ std::move(request) });
+    newBatch.back().m_Promise = std::make_shared<std::promise<ReadResult>>();
+
+    std::future<ReadResult> future = newBatch.back().m_Promise->get_future();
+    AddBatch(std::move(newBatch));
+
+    return future;
+}
+
+void AsyncFileIO::AddBatch(Batch&& batch)
+{
+    if (batch.empty())
+        return;
+
+    {
+        bbeAutoLock(m_BatchesLock);
+        m_PendingBatches.push_back(std::move(batch));
+    }
+    m_BatchesCV.notify_one();
+}
+
+void AsyncFileIO::WorkerLoop(uint32_t workerIdx)
+{
+    const char* threadName = StringFormat("File IO Worker %u", workerIdx);
+#if defined(BBE_ENGINE)
+    MicroProfileOnThreadCreate(threadName);
+#endif
+    g_TraceRecorder.SetCurrentThreadName(threadName);
+    RandomUtils::SetThreadStream(threadName);
+
+    while (true)
+    {
+        Batch batch;
+        {
+            std::unique_lock<std::mutex> lock{ m_BatchesLock };
+            m_BatchesCV.wait(lock, [&] { return m_Exit || !m_PendingBatches.empty(); });
+
+            if (m_Exit)
+                return;
+
+            batch = std::move(m_PendingBatches.front());
+            m_PendingBatches.pop_front();
+        }
+
+        ProcessBatch(batch);
+        m_NbBatches.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool AsyncFileIO::PrepareDestination(PendingRead& read, uint64_t fileSize)
+{
+    const ReadRequest& request = read.m_Request;
+    if (request.m_Offset > fileSize)
+    {
+        g_Log.error("AsyncFileIO: offset {} is past the end of '{}' ({} bytes)", request.m_Offset, request.m_FilePath, fileSize);
+        return false;
+    }
+
+    // ranges past the end of file are clamped
+    const uint64_t size = std::min(request.m_Size, fileSize - request.m_Offset);
+
+    if (request.m_Dest)
+    {
+        if (size > request.m_DestCapacity)
+        {
+            g_Log.error("AsyncFileIO: {} bytes of '{}' don't fit in the {} bytes destination", size, request.m_FilePath, request.m_DestCapacity);
+            return false;
+        }
+        read.m_Result.m_Data = request.m_Dest;
+    }
+    else
+    {
+        read.m_Result.m_Buffer = FileIOBuffer::Allocate(size);
+        read.m_Result.m_Data = read.m_Result.m_Buffer.GetData();
+    }
+    read.m_Result.m_Size = size;
+
+    return true;
+}
+
+void AsyncFileIO::CompleteRead(PendingRead& read, bool success)
+{
+    m_NbReads.fetch_add(1, std::memory_order_relaxed);
+
+    read.m_Result.m_Success = success;
+    if (success)
+    {
+        m_NbBytesRead.fetch_add(read.m_Result.m_Size, std::memory_order_relaxed);
+    }
+    else
+    {
+        m_NbFailedReads.fetch_add(1, std::memory_order_relaxed);
+        g_Log.error("AsyncFileIO: failed to read '{}'", read.m_Request.m_FilePath);
+
+        read.m_Result.m_Buffer.Release();
+        read.m_Result.m_Data = nullptr;
+        read.m_Result.m_Size = 0;
+    }
+
+    if (read.m_Promise)
+    {
+        read.m_Promise->set_value(std::move(read.m_Result));
+        return;
+    }
+
+    // processing the data is usually a lot heavier than reading it. Don't hold up the IO thread with it
+    auto completedRead = std::make_shared<PendingRead>(std::move(read));
+    g_TasksExecutor.silent_async([completedRead] { completedRead->m_Request.m_OnComplete(completedRead->m_Result); });
+}
+
+#if defined(_WIN32)
+
+// ReadFile takes a 32 bits size. Bigger reads are split into several chunks, all in flight at once
+static const uint64_t gs_MaxReadChunkSize = BBE_MB(64);
+
+struct OverlappedReadChunk
+{
+    OVERLAPPED m_Overlapped = {};
+    uint32_t m_ReadIdx = 0;
+    DWORD m_Size = 0;
+};
+
+void AsyncFileIO::ProcessBatch(Batch& batch)
+{
+    bbeProfileFunction();
+
+    using namespace Microsoft::WRL;
+
+    // every read of the batch completes on this port, in whatever order the disk serves them
+    Wrappers::HandleT<Wrappers::HandleTraits::HANDLENullTraits> ioPort{ ::CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1) };
+    assert(ioPort.IsValid());
+
+    const uint32_t nbReads = (uint32_t)batch.size();
+    std::vector<Wrappers::FileHandle> files(nbReads);
+    std::vector<uint32_t> nbPendingChunks(nbReads, 0);
+    std::vector<bool> readFailed(nbReads, false);
+    std::deque<OverlappedReadChunk> chunks; // deque, so OVERLAPPED addresses are stable
+    uint32_t nbChunksInFlight = 0;
+
+    CREATEFILE2_EXTENDED_PARAMETERS extendedParams = {};
+    extendedParams.dwSize = sizeof(CREATEFILE2_EXTENDED_PARAMETERS);
+    extendedParams.dwFileAttributes = FILE_ATTRIBUTE_NORMAL;
+    extendedParams.dwFileFlags = FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN;
+    extendedParams.dwSecurityQosFlags = SECURITY_ANONYMOUS;
+
+    // kick all reads first
+    for (uint32_t readIdx = 0; readIdx < nbReads; ++readIdx)
+    {
+        PendingRead& read = batch[readIdx];
+
+        Wrappers::FileHandle& file = files[readIdx];
+        file.Attach(::CreateFile2(StringUtils::Utf8ToWide(read.m_Request.m_FilePath), GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, &extendedParams));
+
+        LARGE_INTEGER fileSize = {};
+        if (!file.IsValid() ||
+            !::GetFileSizeEx(file.Get(), &fileSize) ||
+            !PrepareDestination(read, (uint64_t)fileSize.QuadPart) ||
+            !::CreateIoCompletionPort(file.Get(), ioPort.Get(), readIdx, 0))
+        {
+            file.Close();
+            CompleteRead(read, false);
+            continue;
+        }
+
+        for (uint64_t chunkOffset = 0; chunkOffset < read.m_Result.m_Size; chunkOffset += gs_MaxReadChunkSize)
+        {
+            const uint64_t fileOffset = read.m_Request.m_Offset + chunkOffset;
+            const DWORD chunkSize = (DWORD)std::min(gs_MaxReadChunkSize, read.m_Result.m_Size - chunkOffset);
+
+            OverlappedReadChunk& chunk = chunks.emplace_back();
+            chunk.m_Overlapped.Offset = (DWORD)fileOffset;
+            chunk.m_Overlapped.OffsetHigh = (DWORD)(fileOffset >> 32);
+            chunk.m_ReadIdx = readIdx;
+            chunk.m_Size = chunkSize;
+
+            // even when it completes synchronously, a completion packet is queued on the port
+            if (!::ReadFile(file.Get(), read.m_Result.m_Data + chunkOffset, chunkSize, nullptr, &chunk.m_Overlapped) && ::GetLastError() != ERROR_IO_PENDING)
+            {
+                readFailed[readIdx] = true;
+                break;
+            }
+
+            ++nbPendingChunks[readIdx];
+            ++nbChunksInFlight;
+        }
+
+        // nothing in flight for this one (empty range, or the very first chunk failed)
+        if (nbPendingChunks[readIdx] == 0)
+        {
+            file.Close();
+            CompleteRead(read, !readFailed[readIdx]);
+        }
+    }
+
+    // then reap completions as they come
+    while (nbChunksInFlight > 0)
+    {
+        OVERLAPPED_ENTRY entries[64];
+        ULONG nbEntries = 0;
+        if (!::GetQueuedCompletionStatusEx(ioPort.Get(), entries, (ULONG)std::size(entries), &nbEntries, INFINITE, FALSE))
+        {
+            g_Log.error("AsyncFileIO: GetQueuedCompletionStatusEx failed: {}", GetLastErrorAsString());
+            assert(false);
+            break;
+        }
+
+        for (ULONG i = 0; i < nbEntries; ++i)
+        {
+            const OverlappedReadChunk* chunk = CONTAINING_RECORD(entries[i].lpOverlapped, OverlappedReadChunk, m_Overlapped);
+            const uint32_t readIdx = chunk->m_ReadIdx;
+
+            // 'Internal' holds the NTSTATUS of the request. Short reads only happen if the file was truncated under us
+            if (entries[i].Internal != 0 || entries[i].dwNumberOfBytesTransferred != chunk->m_Size)
+            {
+                readFailed[readIdx] = true;
+            }
+
+            --nbChunksInFlight;
+            if (--nbPendingChunks[readIdx] == 0)
+            {
+                files[readIdx].Close();
+                CompleteRead(batch[readIdx], !readFailed[readIdx]);
+            }
+        }
+    }
+}
+
+#else
+
+void AsyncFileIO::ProcessBatch(Batch& batch)
+{
+    bbeProfileFunction();
+
+    // no async IO here: blocking reads. The batch still only stalls this IO thread, and other IO threads keep serving other batches
+    for (PendingRead& read : batch)
+    {
+        const int file = ::open(read.m_Request.m_FilePath.c_str(), O_RDONLY);
+        if (file == -1)
+        {
+            CompleteRead(read, false);
+            continue;
+        }
+
+        struct stat fileStat = {};
+        bool success = ::fstat(file, &fileStat) == 0 && PrepareDestination(read, (uint64_t)fileStat.st_size);
+        if (success)
+        {
+            ::posix_fadvise(file, (off_t)read.m_Request.m_Offset, (off_t)read.m_Result.m_Size, POSIX_FADV_SEQUENTIAL);
+        }
+
+        uint64_t bytesRead = 0;
+        while (success && bytesRead < read.m_Result.m_Size)
+        {
+            const ssize_t result = ::pread(file, read.m_Result.m_Data + bytesRead, read.m_Result.m_Size - bytesRead, (off_t)(read.m_Request.m_Offset + bytesRead));
+            if (result < 0 && errno == EINTR)
+                continue;
+
+            success = result > 0;
+            bytesRead += success ? result : 0;
+        }
+
+        ::close(file);
+        CompleteRead(read, success);
+    }
+}
+
+#endif // #if defined(_WIN32)
+
+#if defined(BBE_ENGINE)
+void AsyncFileIO::UpdateIMGUI()
+{
+    if (!gs_ShowFileIOIMGUIWindow)
+        return;
+
+    ScopedIMGUIWindow window{ "File IO" };
+
+    ImGui::LabelText("IO Threads", "%u", (uint32_t)m_Workers.size());
+    ImGui::LabelText("Batches", "%llu", m_NbBatches.load());
+    ImGui::LabelText("Reads", "%llu", m_NbReads.load());
+    ImGui::LabelText("Failed Reads", "%llu", m_NbFailedReads.load());
+    ImGui::LabelText("Bytes Read", "%.2f MB", BBE_TO_MB(m_NbBytesRead.load()));
+}
+#endif // #if defined(BBE_ENGINE)
@@ -0,0 +1,93 @@
+#pragma once
+
+// Page-aligned buffer from the file IO pool. Goes back to the pool when destroyed
+class FileIOBuffer
+{
+public:
+    FileIOBuffer() = default;
+    FileIOBuffer(FileIOBuffer&& other) noexcept { *this = std::move(other); }
+    FileIOBuffer& operator=(FileIOBuffer&& other) noexcept;
+    ~FileIOBuffer() { Release(); }
+
+    FileIOBuffer(const FileIOBuffer&) = delete;
+    FileIOBuffer& operator=(const FileIOBuffer&) = delete;
+
+    static FileIOBuffer Allocate(uint64_t size);
+    void Release();
+
+    std::byte* GetData() const { return m_Data; }
+    uint64_t GetCapacity() const { return m_Capacity; }
+
+private:
+    std::byte* m_Data = nullptr;
+    uint64_t m_Capacity = 0;
+};
+
+// Batched async file reads. Each batch is handed to a dedicated IO thread, which keeps every read of the batch in flight at once
+// (overlapped IO on Windows) instead of stalling one thread per file. Completions are dispatched to g_TasksExecutor.
+class AsyncFileIO
+{
+    DeclareSingletonFunctions(AsyncFileIO);
+
+public:
+    static const uint64_t WholeFile = UINT64_MAX;
+
+    struct ReadResult
+    {
+        bool m_Success = false;
+        std::byte* m_Data = nullptr; // either the request's m_Dest, or m_Buffer
+        uint64_t m_Size = 0;
+        FileIOBuffer m_Buffer;
+    };
+
+    using CompletionCallback = std::function<void(ReadResult&)>;
+
+    struct ReadRequest
+    {
+        std::string m_FilePath;
+        uint64_t m_Offset = 0;
+        uint64_t m_Size = WholeFile;
+
+        // Optional caller owned destination, to read without any copy. If null, a pooled buffer is used
+        std::byte* m_Dest = nullptr;
+        uint64_t m_DestCapacity = 0;
+
+        CompletionCallback m_OnComplete;
+    };
+
+    void Initialize(uint32_t numIOThreads);
+    void ShutDown();
+
+    void ReadBatch(std::vector<ReadRequest>&& requests);
+    std::future<ReadResult> Read(ReadRequest&& request);
+
+    void UpdateIMGUI();
+
+private:
+    struct PendingRead
+    {
+        ReadRequest m_Request;
+        ReadResult m_Result;
+        std::shared_ptr<std::promise<ReadResult>> m_Promise;
+    };
+    using Batch = std::vector<PendingRead>;
+
+    void AddBatch(Batch&& batch);
+    void WorkerLoop(uint32_t workerIdx);
+    void ProcessBatch(Batch& batch);
+    bool PrepareDestination(PendingRead& read, uint64_t fileSize);
+    void CompleteRead(PendingRead& read, bool success);
+
+    std::mutex m_BatchesLock;
+    std::condition_variable m_BatchesCV;
+    std::deque<Batch> m_PendingBatches;
+    bool m_Exit = false;
+
+    std::vector<std::thread> m_Workers;
+
+    std::atomic<uint64_t> m_NbReads = 0;
+    std::atomic<uint64_t> m_NbFailedReads = 0;
+    std::atomic<uint64_t> m_NbBytesRead = 0;
+    std::atomic<uint64_t> m_NbBatches = 0;
+};
+#define g_AsyncFileIO AsyncFileIO::GetInstance()
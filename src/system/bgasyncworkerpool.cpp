@@ -0,0 +1,116 @@
+#include <system/bgasyncworkerpool.h>
+
+void BGAsyncWorkerPool::Initialize(uint32_t numWorkers)
+{
+    bbeProfileFunction();
+
+    assert(numWorkers > 0);
+    assert(m_Workers.empty());
+
+    m_Workers.reserve(numWorkers);
+    for (uint32_t i = 0; i < numWorkers; ++i)
+    {
+        m_Workers.emplace_back([this, i] { WorkerLoop(i); });
+    }
+}
+
+void BGAsyncWorkerPool::ShutDown()
+{
+    bbeProfileFunction();
+
+    uint32_t nbDroppedJobs = 0;
+    {
+        std::unique_lock<std::mutex> lock{ m_JobsLock };
+        m_Exit = true;
+
+        for (std::deque<Job>& lane : m_PendingJobs)
+        {
+            nbDroppedJobs += (uint32_t)lane.size();
+            lane.clear();
+        }
+    }
+    m_JobsCV.notify_all();
+
+    for (std::thread& worker : m_Workers)
+    {
+        worker.join();
+    }
+    m_Workers.clear();
+
+    if (nbDroppedJobs > 0)
+    {
+        g_Log.info("BGAsyncWorkerPool: dropped {} pending jobs on shutdown", nbDroppedJobs);
+    }
+}
+
+BGAsyncWorkerPool::JobID BGAsyncWorkerPool::AddJobInternal(CommandManager::CommandType&& cmd, Priority priority)
+{
+    assert(priority < NbPriorities);
+
+    JobID newID = InvalidJobID;
+    {
+        bbeAutoLock(m_JobsLock);
+        newID = m_NextJobID++;
+        m_PendingJobs[priority].push_back(Job{ newID, std::move(cmd) });
+    }
+    m_JobsCV.notify_one();
+
+    return newID;
+}
+
+bool BGAsyncWorkerPool::CancelJob(JobID id)
+{
+    bbeAutoLock(m_JobsLock);
+
+    for (std::deque<Job>& lane : m_PendingJobs)
+    {
+        auto it = std::find_if(lane.begin(), lane.end(), [id](const Job& job) { return job.m_ID == id; });
+        if (it != lane.end())
+        {
+            lane.erase(it);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool BGAsyncWorkerPool::PopHighestPriorityJob(Job& outJob)
+{
+    // lanes are ordered from highest to lowest priority
+    for (std::deque<Job>& lane : m_PendingJobs)
+    {
+        if (!lane.empty())
+        {
+            outJob = std::move(lane.front());
+            lane.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void BGAsyncWorkerPool::WorkerLoop(uint32_t workerIdx)
+{
+    const char* threadName = StringFormat("BG Async Worker %u", workerIdx);
+#if defined(BBE_ENGINE)
+    MicroProfileOnThreadCreate(threadName);
+#endif
+    g_TraceRecorder.SetCurrentThreadName(threadName);
+    RandomUtils::SetThreadStream(threadName);
+
+    while (true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock{ m_JobsLock };
+            m_JobsCV.wait(lock, [&] { return m_Exit || PopHighestPriorityJob(job); });
+
+            if (m_Exit)
+                return;
+        }
+
+        job.m_Command();
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <system/commandmanager.h>
+
+// Pool of background threads for long-running async work (i.e. loading stuff from disk).
+// Workers sleep on a condition variable and are woken up as soon as a job is added.
+class BGAsyncWorkerPool
+{
+public:
+    enum Priority { Visible, Default, Prefetch, NbPriorities };
+
+    using JobID = uint64_t;
+    static const JobID InvalidJobID = 0;
+
+    void Initialize(uint32_t numWorkers);
+    void ShutDown();
+
+    template <typename Lambda>
+    JobID AddJob(Lambda&& lambda, Priority priority = Default) { return AddJobInternal(CommandManager::CommandType{ std::forward<Lambda>(lambda) }, priority); }
+
+    // Removes the job if it has not started yet. Returns false if it's already running or done
+    bool CancelJob(JobID id);
+
+private:
+    struct Job
+    {
+        JobID m_ID = InvalidJobID;
+        CommandManager::CommandType m_Command;
+    };
+
+    JobID AddJobInternal(CommandManager::CommandType&& cmd, Priority priority);
+    bool PopHighestPriorityJob(Job& outJob);
+    void WorkerLoop(uint32_t workerIdx);
+
+    std::mutex m_JobsLock;
+    std::condition_variable m_JobsCV;
+    std::deque<Job> m_PendingJobs[NbPriorities];
+    JobID m_NextJobID = InvalidJobID + 1;
+    bool m_Exit = false;
+
+    std::vector<std::thread> m_Workers;
+};
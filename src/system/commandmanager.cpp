@@ -1,34 +1,208 @@
 #include <system/commandmanager.h>
 
-static const uint32_t MaxCommands = 256;
+CommandManager::~CommandManager()
+{
+    GatherOverflowCommands();
+    while (m_OverflowBacklog)
+    {
+        OverflowNode* next = m_OverflowBacklog->m_Next;
+        delete m_OverflowBacklog;
+        m_OverflowBacklog = next;
+    }
+}
+
+void CommandManager::Initialize(uint32_t ringSize)
+{
+    assert(ringSize > 0 && (ringSize & (ringSize - 1)) == 0);
+
+    m_Ring = std::make_unique<RingSlot[]>(ringSize);
+    m_RingMask = ringSize - 1;
+
+    for (uint32_t i = 0; i < ringSize; ++i)
+    {
+        m_Ring[i].m_Sequence.store(i, std::memory_order_relaxed);
+    }
+
+    m_ExecutingCommands.reserve(ringSize);
+    m_ParallelChunks.reserve(ringSize);
+}
+
+void CommandManager::AddCommandInternal(PendingCommand&& newCmd)
+{
+    // Every command gets a unique position, wherever it ends up being stored. The consumer walks positions in order
+    const uint64_t pos = m_EnqueuePos.fetch_add(1, std::memory_order_relaxed);
+
+    // Only this producer can see the slot free for 'pos'
+    RingSlot& slot = m_Ring[pos & m_RingMask];
+    if (slot.m_Sequence.load(std::memory_order_acquire) == pos)
+    {
+        slot.m_Command = std::move(newCmd);
+        slot.m_Sequence.store(pos + 1, std::memory_order_release);
+        return;
+    }
+
+    // Slot still holds a command from a previous lap. Slow path: allocate an overflow node tagged with its position, and push it into the lock-free stack
+    OverflowNode* newNode = new OverflowNode{ std::move(newCmd), pos };
+    newNode->m_Next = m_OverflowHead.load(std::memory_order_relaxed);
+    while (!m_OverflowHead.compare_exchange_weak(newNode->m_Next, newNode, std::memory_order_release, std::memory_order_relaxed)) {}
+}
+
+void CommandManager::GatherOverflowCommands()
+{
+    OverflowNode* node = m_OverflowHead.exchange(nullptr, std::memory_order_acquire);
+
+    // Sort the gathered nodes by position. The stack is LIFO, so they mostly come out in decreasing positions and get inserted at the front
+    OverflowNode* gathered = nullptr;
+    while (node)
+    {
+        OverflowNode* next = node->m_Next;
+
+        OverflowNode** insertPos = &gathered;
+        while (*insertPos && (*insertPos)->m_Position < node->m_Position)
+        {
+            insertPos = &(*insertPos)->m_Next;
+        }
+        node->m_Next = *insertPos;
+        *insertPos = node;
+
+        node = next;
+    }
+
+    // Then merge them into the sorted backlog
+    OverflowNode** mergePos = &m_OverflowBacklog;
+    while (gathered)
+    {
+        while (*mergePos && (*mergePos)->m_Position < gathered->m_Position)
+        {
+            mergePos = &(*mergePos)->m_Next;
+        }
+
+        OverflowNode* next = gathered->m_Next;
+        gathered->m_Next = *mergePos;
+        *mergePos = gathered;
+        mergePos = &gathered->m_Next;
+        gathered = next;
+    }
+}
 
-void CommandManager::Initialize()
+bool CommandManager::PopCommand(uint64_t endPos, PendingCommand& outCmd)
 {
-    m_PendingCommands.set_capacity(MaxCommands);
-    m_ExecutingCommands.set_capacity(MaxCommands);
+    if (m_DequeuePos >= endPos)
+        return false;
+
+    RingSlot& slot = m_Ring[m_DequeuePos & m_RingMask];
+    if (slot.m_Sequence.load(std::memory_order_acquire) == m_DequeuePos + 1)
+    {
+        outCmd = std::move(slot.m_Command);
+    }
+    else
+    {
+        // Not in the ring: either it spilled into the overflow list, or its producer has not finished writing it
+        if (!m_OverflowBacklog || m_OverflowBacklog->m_Position != m_DequeuePos)
+            GatherOverflowCommands();
+
+        // Producer still writing. This command & the ones after it will be picked up in the next consume
+        if (!m_OverflowBacklog || m_OverflowBacklog->m_Position != m_DequeuePos)
+            return false;
+
+        OverflowNode* node = m_OverflowBacklog;
+        m_OverflowBacklog = node->m_Next;
+        outCmd = std::move(node->m_Command);
+        delete node;
+    }
+
+    // Either way, free the slot for the next lap
+    slot.m_Sequence.store(m_DequeuePos + m_RingMask + 1, std::memory_order_release);
+    ++m_DequeuePos;
+
+    return true;
 }
 
-void CommandManager::AddCommand(const std::function<void()>& newCmd)
+void CommandManager::SwapPendingIntoExecutingCommands()
 {
-    assert(m_PendingCommands.size() < MaxCommands);
+    assert(m_ExecutingCommands.empty());
+    assert(m_ExecutingSerialCommands.empty());
+
+    // Only consume what was pushed before this point. Anything added while executing will be consumed in the next call
+    const uint64_t endPos = m_EnqueuePos.load(std::memory_order_acquire);
 
-    bbeAutoLock(m_CommandsLock);
-    m_PendingCommands.push_back(newCmd);
+    PendingCommand cmd;
+    while (PopCommand(endPos, cmd))
+    {
+        if (cmd.m_Properties.m_Serial)
+            m_ExecutingSerialCommands.push_back(std::move(cmd));
+        else
+            m_ExecutingCommands.push_back(std::move(cmd));
+    }
+}
+
+void CommandManager::BuildParallelChunks()
+{
+    assert(m_ParallelChunks.empty());
+
+    // Greedily group consecutive commands until their total cost reaches the grain size
+    uint32_t chunkBegin = 0;
+    uint32_t chunkCost = 0;
+    for (uint32_t i = 0; i < m_ExecutingCommands.size(); ++i)
+    {
+        chunkCost += std::max(m_ExecutingCommands[i].m_Properties.m_Cost, 1U);
+        if (chunkCost >= m_GrainSize)
+        {
+            m_ParallelChunks.push_back({ chunkBegin, i + 1 });
+            chunkBegin = i + 1;
+            chunkCost = 0;
+        }
+    }
+
+    if (chunkBegin < m_ExecutingCommands.size())
+        m_ParallelChunks.push_back({ chunkBegin, (uint32_t)m_ExecutingCommands.size() });
 }
 
 void CommandManager::ConsumeAllCommandsMT(tf::Subflow& subFlow)
 {
     subFlow.emplace([&](tf::Subflow& sf)
         {
+            SwapPendingIntoExecutingCommands();
+            BuildParallelChunks();
+
+            tf::Task clearTask = sf.emplace([this]
+                {
+                    m_ExecutingCommands.clear();
+                    m_ExecutingSerialCommands.clear();
+                    m_ParallelChunks.clear();
+                });
+
+            // Serial commands run after all parallel commands of this consume: they can rely on their results
+            tf::Task parallelDoneTask = clearTask;
+            if (!m_ExecutingSerialCommands.empty())
             {
-                bbeAutoLock(m_CommandsLock);
-                m_ExecutingCommands.swap(m_PendingCommands);
+                parallelDoneTask = sf.emplace([this]
+                    {
+                        bbeProfile("Serial Commands");
+                        for (const PendingCommand& cmd : m_ExecutingSerialCommands)
+                        {
+                            cmd.m_Command();
+                        }
+                    });
+                parallelDoneTask.precede(clearTask);
             }
 
-            tf::Task clearTask = sf.emplace([this] { m_ExecutingCommands.clear(); });
-            for (const std::function<void()>& cmd : m_ExecutingCommands)
+            if (m_ParallelChunks.size() == 1)
             {
-                sf.emplace([this, &cmd] { cmd(); }).precede(clearTask);
+                // no point going through the parallel-for for a single chunk
+                sf.emplace([this] { for (const PendingCommand& cmd : m_ExecutingCommands) { cmd.m_Command(); } }).precede(parallelDoneTask);
+            }
+            else if (!m_ParallelChunks.empty())
+            {
+                auto RunChunk = [this](uint32_t chunkIdx)
+                {
+                    const CommandsChunk& chunk = m_ParallelChunks[chunkIdx];
+                    for (uint32_t i = chunk.m_Begin; i < chunk.m_End; ++i)
+                    {
+                        m_ExecutingCommands[i].m_Command();
+                    }
+                };
+                sf.for_each_index_dynamic(0U, (uint32_t)m_ParallelChunks.size(), 1U, RunChunk).precede(parallelDoneTask);
             }
         });
 }
@@ -37,16 +211,19 @@ void CommandManager::ConsumeAllCommandsST(bool recursive)
 {
     bbeProfileFunction();
 
+    SwapPendingIntoExecutingCommands();
+
+    // Commands are all consumed on this thread anyway, so serial commands do not need special treatment
+    for (const PendingCommand& cmd : m_ExecutingCommands)
     {
-        bbeAutoLock(m_CommandsLock);
-        m_ExecutingCommands.swap(m_PendingCommands);
+        cmd.m_Command();
     }
-
-    for (const std::function<void()>& cmd : m_ExecutingCommands)
+    for (const PendingCommand& cmd : m_ExecutingSerialCommands)
     {
-        cmd();
+        cmd.m_Command();
     }
     m_ExecutingCommands.clear();
+    m_ExecutingSerialCommands.clear();
 
     while (recursive && ConsumeOneCommand()) {}
 }
@@ -55,20 +232,10 @@ bool CommandManager::ConsumeOneCommand()
 {
     bbeProfileFunction();
 
-    std::function<void()> cmd = [&]()
-    {
-        bbeAutoLock(m_CommandsLock);
-        if (m_PendingCommands.empty())
-            return std::function<void()>{};
-
-        std::function<void()> ret = m_PendingCommands.front();
-        m_PendingCommands.pop_front();
-        return ret;
-    }();
-
-    if (cmd)
+    PendingCommand cmd;
+    if (PopCommand(m_EnqueuePos.load(std::memory_order_acquire), cmd))
     {
-        cmd();
+        cmd.m_Command();
         return true;
     }
 
@@ -1,17 +1,87 @@
 #pragma once
 
+struct CommandProperties
+{
+    // Relative cost hint used to group commands into parallel chunks. 1 == a trivial command
+    uint32_t m_Cost = 1;
+
+    // Serial commands are never run in parallel with any other command, and are executed in submission order.
+    // In ConsumeAllCommandsMT, they run once all the parallel commands of the same consume are done
+    bool m_Serial = false;
+};
+
+// Multi-producer/single-consumer command queue.
+// Producers never lock nor allocate: every command takes a position with a single fetch_add, and is stored inplace in a bounded lock-free ring.
+// If its ring slot is still busy, the command spills into a lock-free overflow list instead of asserting. Commands are consumed in position order wherever they are stored.
+// All Consume* functions must be called from one thread/task at a time.
 class CommandManager
 {
 public:
-    void Initialize();
+    static const uint32_t CommandStorageSize = 256;
+    using CommandType = InplaceFunction<void(), CommandStorageSize>;
+
+    // ~280 bytes per slot. Size the ring for the usual per-frame load: spikes go through the overflow list
+    static const uint32_t DefaultRingSize = 64;
+
+    ~CommandManager();
+
+    // 'ringSize' must be a power of 2
+    void Initialize(uint32_t ringSize = DefaultRingSize);
+
+    template <typename Lambda>
+    void AddCommand(Lambda&& newCmd, CommandProperties properties = {}) { AddCommandInternal(PendingCommand{ CommandType{ std::forward<Lambda>(newCmd) }, properties }); }
 
-    void AddCommand(const std::function<void()>& newCmd);
     void ConsumeAllCommandsMT(tf::Subflow& sf);
     void ConsumeAllCommandsST(bool recursive = false);
     bool ConsumeOneCommand();
 
+    // Total cost of commands grouped into 1 parallel task in ConsumeAllCommandsMT. 1 == 1 task per command
+    void SetGrainSize(uint32_t grainSize) { assert(grainSize > 0); m_GrainSize = grainSize; }
+
 private:
-    std::mutex m_CommandsLock;
-    CircularBuffer<std::function<void()>> m_PendingCommands;
-    CircularBuffer<std::function<void()>> m_ExecutingCommands;
+    struct PendingCommand
+    {
+        CommandType m_Command;
+        CommandProperties m_Properties;
+    };
+
+    struct RingSlot
+    {
+        std::atomic<uint64_t> m_Sequence = 0;
+        PendingCommand m_Command;
+    };
+
+    struct OverflowNode
+    {
+        PendingCommand m_Command;
+        uint64_t m_Position = 0;
+        OverflowNode* m_Next = nullptr;
+    };
+
+    struct CommandsChunk
+    {
+        uint32_t m_Begin;
+        uint32_t m_End;
+    };
+
+    void AddCommandInternal(PendingCommand&& newCmd);
+    bool PopCommand(uint64_t endPos, PendingCommand& outCmd);
+    void GatherOverflowCommands();
+    void SwapPendingIntoExecutingCommands();
+    void BuildParallelChunks();
+
+    std::unique_ptr<RingSlot[]> m_Ring;
+    uint64_t m_RingMask = 0;
+
+    // producers
+    alignas(64) std::atomic<uint64_t> m_EnqueuePos = 0;
+    alignas(64) std::atomic<OverflowNode*> m_OverflowHead = nullptr;
+
+    // consumer
+    alignas(64) uint64_t m_DequeuePos = 0;
+    OverflowNode* m_OverflowBacklog = nullptr; // sorted by position
+    uint32_t m_GrainSize = 16;
+    std::vector<PendingCommand> m_ExecutingCommands;
+    std::vector<PendingCommand> m_ExecutingSerialCommands;
+    std::vector<CommandsChunk> m_ParallelChunks;
 };
@@ -0,0 +1,449 @@
+#pragma once
+
+#include <system/flathashmap.h>
+#include <system/futex.h>
+
+// Portable replacements for the PPL concurrent containers. Lower case API, to stay a drop-in for concurrency::concurrent_*
+
+#if defined(_MSC_VER)
+    #pragma warning(push)
+    #pragma warning(disable : 4324) // structure was padded due to alignment specifier: intended, to keep hot atomics on their own cache line
+#endif
+
+static const std::size_t CacheLineSize = 64;
+
+// Bounded lock-free multi-producer multi-consumer queue (Dmitry Vyukov's). Each cell carries a sequence number, so producers and consumers only contend on their own index
+template <typename T>
+class ConcurrentQueue
+{
+public:
+    explicit ConcurrentQueue(std::size_t capacity = 1024)
+        : m_Mask(RoundUpToPowerOfTwo(std::max<std::size_t>(capacity, 2)) - 1)
+        , m_Cells(new Cell[m_Mask + 1])
+    {
+        for (std::size_t i = 0; i <= m_Mask; ++i)
+        {
+            m_Cells[i].m_Sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~ConcurrentQueue()
+    {
+        for (std::size_t pos = m_DequeuePos; pos != m_EnqueuePos; ++pos)
+        {
+            std::launder(reinterpret_cast<T*>(&m_Cells[pos & m_Mask].m_Storage))->~T();
+        }
+    }
+
+    ConcurrentQueue(const ConcurrentQueue&) = delete;
+    ConcurrentQueue& operator=(const ConcurrentQueue&) = delete;
+
+    template <typename... Args>
+    bool try_emplace(Args&&... args)
+    {
+        std::size_t pos = m_EnqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell& cell = m_Cells[pos & m_Mask];
+            const std::size_t sequence = cell.m_Sequence.load(std::memory_order_acquire);
+            const intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+
+            if (diff == 0)
+            {
+                if (m_EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    new (&cell.m_Storage) T(std::forward<Args>(args)...);
+                    cell.m_Sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // full
+            }
+            else
+            {
+                pos = m_EnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_push(const T& value) { return try_emplace(value); }
+    bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+    // Spins while the queue is full, then yields: the consumer may need our core to make room
+    template <typename U>
+    void push(U&& value)
+    {
+        if (FutexUtils::SpinUntil([&] { return try_emplace(std::forward<U>(value)); }))
+            return;
+
+        while (!try_emplace(std::forward<U>(value)))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    bool try_pop(T& out)
+    {
+        std::size_t pos = m_DequeuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell& cell = m_Cells[pos & m_Mask];
+            const std::size_t sequence = cell.m_Sequence.load(std::memory_order_acquire);
+            const intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+
+            if (diff == 0)
+            {
+                if (m_DequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    T* value = std::launder(reinterpret_cast<T*>(&cell.m_Storage));
+                    out = std::move(*value);
+                    value->~T();
+                    cell.m_Sequence.store(pos + m_Mask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // empty
+            }
+            else
+            {
+                pos = m_DequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Approximate when other threads are pushing/popping
+    std::size_t unsafe_size() const { return m_EnqueuePos.load(std::memory_order_relaxed) - m_DequeuePos.load(std::memory_order_relaxed); }
+    bool empty() const { return unsafe_size() == 0; }
+    std::size_t capacity() const { return m_Mask + 1; }
+
+private:
+    static std::size_t RoundUpToPowerOfTwo(std::size_t value)
+    {
+        std::size_t result = 1;
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+
+    struct Cell
+    {
+        std::atomic<std::size_t> m_Sequence;
+        std::aligned_storage_t<sizeof(T), alignof(T)> m_Storage;
+    };
+
+    const std::size_t m_Mask;
+    const std::unique_ptr<Cell[]> m_Cells;
+
+    alignas(CacheLineSize) std::atomic<std::size_t> m_EnqueuePos = 0;
+    alignas(CacheLineSize) std::atomic<std::size_t> m_DequeuePos = 0;
+};
+
+// Growable vector with stable element addresses: storage is a list of segments doubling in size, never reallocated.
+// push_back is lock-free. Like concurrency::concurrent_vector, an element pushed by another thread may be visible in size() before it's constructed
+template <typename T>
+class ConcurrentVector
+{
+public:
+    ConcurrentVector() = default;
+    ~ConcurrentVector() { clear(); }
+
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        const std::size_t index = m_Size.fetch_add(1);
+
+        T* element = GetSlot(index, true /*allocate*/);
+        new (element) T(std::forward<Args>(args)...);
+        return *element;
+    }
+
+    T& push_back(const T& value) { return emplace_back(value); }
+    T& push_back(T&& value) { return emplace_back(std::move(value)); }
+
+    T& operator[](std::size_t index) { assert(index < size()); return *GetSlot(index, false); }
+    const T& operator[](std::size_t index) const { assert(index < size()); return *const_cast<ConcurrentVector*>(this)->GetSlot(index, false); }
+
+    std::size_t size() const { return m_Size.load(std::memory_order_acquire); }
+    bool empty() const { return size() == 0; }
+
+    // Not thread safe
+    void clear()
+    {
+        const std::size_t numElements = m_Size.exchange(0);
+        for (std::size_t i = 0; i < numElements; ++i)
+        {
+            GetSlot(i, false)->~T();
+        }
+
+        for (uint32_t segmentIdx = 0; segmentIdx < NumSegments; ++segmentIdx)
+        {
+            if (T* segment = m_Segments[segmentIdx].exchange(nullptr))
+            {
+                ::operator delete(segment, std::align_val_t{ alignof(T) });
+            }
+        }
+    }
+
+    template <typename Func>
+    void for_each(Func&& func)
+    {
+        const std::size_t numElements = size();
+        for (std::size_t i = 0; i < numElements; ++i)
+        {
+            func((*this)[i]);
+        }
+    }
+
+private:
+    static const uint32_t FirstSegmentSizeLog2 = 5;
+    static const uint32_t NumSegments = 64 - FirstSegmentSizeLog2;
+
+    static uint32_t GetMostSignificantBit(uint64_t value)
+    {
+#if defined(_MSC_VER)
+        unsigned long idx;
+        _BitScanReverse64(&idx, value);
+        return idx;
+#else
+        return 63 - (uint32_t)__builtin_clzll(value);
+#endif
+    }
+
+    T* GetSlot(std::size_t index, bool allocate)
+    {
+        // segment k holds [2^k - 1, 2^(k+1) - 1) * FirstSegmentSize elements
+        const std::size_t biasedIndex = index + ((std::size_t)1 << FirstSegmentSizeLog2);
+        const uint32_t segmentIdx = GetMostSignificantBit(biasedIndex) - FirstSegmentSizeLog2;
+        const std::size_t offset = biasedIndex - ((std::size_t)1 << (segmentIdx + FirstSegmentSizeLog2));
+
+        std::atomic<T*>& segmentPtr = m_Segments[segmentIdx];
+        T* segment = segmentPtr.load(std::memory_order_acquire);
+        if (!segment)
+        {
+            assert(allocate);
+
+            // several threads can race to allocate the same segment: losers free theirs
+            const std::size_t segmentSize = (std::size_t)1 << (segmentIdx + FirstSegmentSizeLog2);
+            T* newSegment = static_cast<T*>(::operator new(segmentSize * sizeof(T), std::align_val_t{ alignof(T) }));
+            if (segmentPtr.compare_exchange_strong(segment, newSegment, std::memory_order_acq_rel))
+            {
+                segment = newSegment;
+            }
+            else
+            {
+                ::operator delete(newSegment, std::align_val_t{ alignof(T) });
+            }
+        }
+
+        return segment + offset;
+    }
+
+    std::atomic<std::size_t> m_Size = 0;
+    std::atomic<T*> m_Segments[NumSegments] = {};
+};
+
+// Hash map split in shards, each a FlatHashMap behind its own reader/writer lock: threads only contend when they hit the same shard.
+// Values are returned by copy, or accessed through a callback while the shard is locked
+template <typename KeyType, typename ValueType, typename Hash = std::hash<KeyType>, typename KeyEqual = std::equal_to<KeyType>>
+class ConcurrentUnorderedMap
+{
+public:
+    ConcurrentUnorderedMap() = default;
+    ConcurrentUnorderedMap(const ConcurrentUnorderedMap&) = delete;
+    ConcurrentUnorderedMap& operator=(const ConcurrentUnorderedMap&) = delete;
+
+    // Returns false if the key already exists
+    bool insert(const KeyType& key, const ValueType& value)
+    {
+        Shard& shard = GetShard(key);
+        std::unique_lock lock{ shard.m_Lock };
+        return shard.m_Map.try_emplace(key, value).second;
+    }
+
+    void insert_or_assign(const KeyType& key, const ValueType& value)
+    {
+        Shard& shard = GetShard(key);
+        std::unique_lock lock{ shard.m_Lock };
+        shard.m_Map.insert_or_assign(key, value);
+    }
+
+    bool find(const KeyType& key, ValueType& out) const
+    {
+        const Shard& shard = GetShard(key);
+        std::shared_lock lock{ shard.m_Lock };
+        auto it = shard.m_Map.find(key);
+        if (it == shard.m_Map.end())
+            return false;
+
+        out = it->second;
+        return true;
+    }
+
+    bool contains(const KeyType& key) const
+    {
+        const Shard& shard = GetShard(key);
+        std::shared_lock lock{ shard.m_Lock };
+        return shard.m_Map.contains(key);
+    }
+
+    // 'func(ValueType&)' runs with the shard exclusively locked. Default constructs the value if the key doesn't exist
+    template <typename Func>
+    void modify(const KeyType& key, Func&& func)
+    {
+        Shard& shard = GetShard(key);
+        std::unique_lock lock{ shard.m_Lock };
+        func(shard.m_Map[key]);
+    }
+
+    bool erase(const KeyType& key)
+    {
+        Shard& shard = GetShard(key);
+        std::unique_lock lock{ shard.m_Lock };
+        return shard.m_Map.erase(key) > 0;
+    }
+
+    // Locks one shard at a time: not a consistent snapshot when other threads are writing
+    template <typename Func>
+    void for_each(Func&& func) const
+    {
+        for (const Shard& shard : m_Shards)
+        {
+            std::shared_lock lock{ shard.m_Lock };
+            for (const auto& pair : shard.m_Map)
+            {
+                func(pair.first, pair.second);
+            }
+        }
+    }
+
+    std::size_t size() const
+    {
+        std::size_t total = 0;
+        for (const Shard& shard : m_Shards)
+        {
+            std::shared_lock lock{ shard.m_Lock };
+            total += shard.m_Map.size();
+        }
+        return total;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    void clear()
+    {
+        for (Shard& shard : m_Shards)
+        {
+            std::unique_lock lock{ shard.m_Lock };
+            shard.m_Map.clear();
+        }
+    }
+
+private:
+    static const uint32_t NumShardsLog2 = 6;
+    static const uint32_t NumShards = 1 << NumShardsLog2;
+
+    // Plain std locks: bbeAutoLock's per call site profiling would cost more than the lookups
+    struct alignas(CacheLineSize) Shard
+    {
+        mutable std::shared_mutex m_Lock;
+        FlatHashMap<KeyType, ValueType, Hash, KeyEqual> m_Map;
+    };
+
+    // top bits pick the shard. FlatHashMap uses the low bits of the same mixed hash, so keys within a shard stay well spread
+    Shard& GetShard(const KeyType& key) { return m_Shards[SwissTablePrivate::MixHash(Hash{}(key)) >> (64 - NumShardsLog2)]; }
+    const Shard& GetShard(const KeyType& key) const { return m_Shards[SwissTablePrivate::MixHash(Hash{}(key)) >> (64 - NumShardsLog2)]; }
+
+    Shard m_Shards[NumShards];
+};
+
+template <typename KeyType, typename Hash = std::hash<KeyType>, typename KeyEqual = std::equal_to<KeyType>>
+class ConcurrentUnorderedSet
+{
+public:
+    ConcurrentUnorderedSet() = default;
+    ConcurrentUnorderedSet(const ConcurrentUnorderedSet&) = delete;
+    ConcurrentUnorderedSet& operator=(const ConcurrentUnorderedSet&) = delete;
+
+    // Returns false if the key already exists
+    bool insert(const KeyType& key)
+    {
+        Shard& shard = GetShard(key);
+        std::unique_lock lock{ shard.m_Lock };
+        return shard.m_Set.insert(key).second;
+    }
+
+    bool contains(const KeyType& key) const
+    {
+        const Shard& shard = GetShard(key);
+        std::shared_lock lock{ shard.m_Lock };
+        return shard.m_Set.contains(key);
+    }
+
+    bool erase(const KeyType& key)
+    {
+        Shard& shard = GetShard(key);
+        std::unique_lock lock{ shard.m_Lock };
+        return shard.m_Set.erase(key) > 0;
+    }
+
+    template <typename Func>
+    void for_each(Func&& func) const
+    {
+        for (const Shard& shard : m_Shards)
+        {
+            std::shared_lock lock{ shard.m_Lock };
+            for (const KeyType& key : shard.m_Set)
+            {
+                func(key);
+            }
+        }
+    }
+
+    std::size_t size() const
+    {
+        std::size_t total = 0;
+        for (const Shard& shard : m_Shards)
+        {
+            std::shared_lock lock{ shard.m_Lock };
+            total += shard.m_Set.size();
+        }
+        return total;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    void clear()
+    {
+        for (Shard& shard : m_Shards)
+        {
+            std::unique_lock lock{ shard.m_Lock };
+            shard.m_Set.clear();
+        }
+    }
+
+private:
+    static const uint32_t NumShardsLog2 = 6;
+    static const uint32_t NumShards = 1 << NumShardsLog2;
+
+    struct alignas(CacheLineSize) Shard
+    {
+        mutable std::shared_mutex m_Lock;
+        FlatHashSet<KeyType, Hash, KeyEqual> m_Set;
+    };
+
+    Shard& GetShard(const KeyType& key) { return m_Shards[SwissTablePrivate::MixHash(Hash{}(key)) >> (64 - NumShardsLog2)]; }
+    const Shard& GetShard(const KeyType& key) const { return m_Shards[SwissTablePrivate::MixHash(Hash{}(key)) >> (64 - NumShardsLog2)]; }
+
+    Shard m_Shards[NumShards];
+};
+
+#if defined(_MSC_VER)
+    #pragma warning(pop)
+#endif
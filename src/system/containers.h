@@ -3,10 +3,9 @@
 // Extended STL
 #include <system/inplace_function.h>
 
-// Windows Concurrent Containers
-#include <concurrent_unordered_map.h>
-#include <concurrent_unordered_set.h>
-#include <concurrent_vector.h>
+// Portable hash & concurrent containers
+#include <system/flathashmap.h>
+#include <system/concurrentcontainers.h>
 
 // Boost Containers
 #include <extern/boost/circular_buffer.hpp>
@@ -19,15 +18,6 @@
 template<typename Signature, uint32_t Capacity>
 using InplaceFunction = stdext::inplace_function<Signature, Capacity>;
 
-template <typename T>
-using ConcurrentVector = concurrency::concurrent_vector<T>;
-
-template <typename KeyType, typename ValueType>
-using ConcurrentUnorderedMap = concurrency::concurrent_unordered_map<KeyType, ValueType>;
-
-template <typename T>
-using ConcurrentUnorderedSet = concurrency::concurrent_unordered_set<T>;
-
 template <typename T, uint32_t N>
 using InplaceArray = boost::container::small_vector<T, N>;
 
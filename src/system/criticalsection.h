@@ -1,36 +1,235 @@
+#include <system/futex.h>
+#include <system/lockcontention.h>
 
+// Same semantics as a Win32 event, without the kernel object: spins briefly, then parks on the state. Signal() only makes a syscall when someone is parked
 class EventLockable
 {
 private:
-    ::HANDLE m_Event;
+    std::atomic<uint32_t> m_State;
+    std::atomic<uint32_t> m_NumWaiters = 0;
+    const bool m_ManualReset;
 
 public:
     EventLockable(const EventLockable&) = delete;
     EventLockable& operator=(const EventLockable&) = delete;
 
-    EventLockable(bool manualReset = true, bool initialState = false) { m_Event = CreateEvent(nullptr, manualReset, initialState, nullptr); assert(m_Event); }
-    ~EventLockable() { ::CloseHandle(m_Event); }
+    EventLockable(bool manualReset = true, bool initialState = false) : m_State(initialState ? 1 : 0), m_ManualReset(manualReset) {}
 
-    void Wait()     { Lock(); }
-    void Signal()   { Unlock(); }
-    void Lock()     { WaitForSingleObject(m_Event, INFINITE); }
-    bool Try_lock() { return WaitForSingleObject(m_Event, 0) == WAIT_OBJECT_0; }
-    void Unlock()   { SetEvent(m_Event); }
-    void Reset()    { ResetEvent(m_Event); }
+    void Wait()   { Lock(); }
+    void Signal() { Unlock(); }
+    void Reset()  { m_State.store(0, std::memory_order_relaxed); }
+
+    bool Try_lock()
+    {
+        if (m_ManualReset)
+            return m_State.load() == 1;
+
+        uint32_t expected = 1;
+        return m_State.compare_exchange_strong(expected, 0);
+    }
+
+    void Lock()
+    {
+        if (FutexUtils::SpinUntil([this] { return Try_lock(); }))
+            return;
+
+        // seq_cst, so either Unlock() sees us waiting, or we see its new state
+        m_NumWaiters.fetch_add(1);
+        while (!Try_lock())
+        {
+            FutexUtils::Wait(m_State, 0);
+        }
+        m_NumWaiters.fetch_sub(1);
+    }
+
+    void Unlock()
+    {
+        m_State.store(1);
+        if (m_NumWaiters.load() > 0)
+        {
+            m_ManualReset ? FutexUtils::WakeAll(m_State) : FutexUtils::WakeOne(m_State);
+        }
+    }
 };
 
+class Semaphore
+{
+private:
+    std::atomic<uint32_t> m_Count;
+    std::atomic<uint32_t> m_NumWaiters = 0;
+
+public:
+    Semaphore(const Semaphore&) = delete;
+    Semaphore& operator=(const Semaphore&) = delete;
+
+    explicit Semaphore(uint32_t initialCount = 0) : m_Count(initialCount) {}
+
+    bool TryAcquire()
+    {
+        uint32_t count = m_Count.load();
+        while (count > 0)
+        {
+            if (m_Count.compare_exchange_weak(count, count - 1))
+                return true;
+        }
+        return false;
+    }
+
+    void Acquire()
+    {
+        if (FutexUtils::SpinUntil([this] { return TryAcquire(); }))
+            return;
+
+        m_NumWaiters.fetch_add(1);
+        while (!TryAcquire())
+        {
+            FutexUtils::Wait(m_Count, 0);
+        }
+        m_NumWaiters.fetch_sub(1);
+    }
+
+    void Release(uint32_t count = 1)
+    {
+        m_Count.fetch_add(count);
+
+        const uint32_t numWaiters = m_NumWaiters.load();
+        if (numWaiters == 0)
+            return;
+
+        if (count >= numWaiters)
+        {
+            FutexUtils::WakeAll(m_Count);
+        }
+        else
+        {
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                FutexUtils::WakeOne(m_Count);
+            }
+        }
+    }
+};
+
+// Single use: Wait() returns once CountDown() brought the count to 0
+class Latch
+{
+private:
+    std::atomic<uint32_t> m_Count;
+    std::atomic<uint32_t> m_NumWaiters = 0;
+
+public:
+    Latch(const Latch&) = delete;
+    Latch& operator=(const Latch&) = delete;
+
+    explicit Latch(uint32_t count) : m_Count(count) {}
+
+    void CountDown(uint32_t n = 1)
+    {
+        const uint32_t prevCount = m_Count.fetch_sub(n);
+        assert(prevCount >= n);
+
+        if (prevCount == n && m_NumWaiters.load() > 0)
+        {
+            FutexUtils::WakeAll(m_Count);
+        }
+    }
+
+    bool TryWait() const { return m_Count.load() == 0; }
+
+    void Wait()
+    {
+        if (FutexUtils::SpinUntil([this] { return TryWait(); }))
+            return;
+
+        m_NumWaiters.fetch_add(1);
+        for (uint32_t count = m_Count.load(); count != 0; count = m_Count.load())
+        {
+            FutexUtils::Wait(m_Count, count);
+        }
+        m_NumWaiters.fetch_sub(1);
+    }
+
+    void ArriveAndWait(uint32_t n = 1)
+    {
+        CountDown(n);
+        Wait();
+    }
+};
+
+// Reusable: each phase completes when 'numThreads' threads called ArriveAndWait()
+class Barrier
+{
+private:
+    std::atomic<uint32_t> m_Phase = 0;
+    std::atomic<uint32_t> m_NumArrived = 0;
+    std::atomic<uint32_t> m_NumWaiters = 0;
+    const uint32_t m_NumThreads;
+
+public:
+    Barrier(const Barrier&) = delete;
+    Barrier& operator=(const Barrier&) = delete;
+
+    explicit Barrier(uint32_t numThreads) : m_NumThreads(numThreads) { assert(numThreads > 0); }
+
+    void ArriveAndWait()
+    {
+        const uint32_t phase = m_Phase.load();
+
+        if (m_NumArrived.fetch_add(1) + 1 == m_NumThreads)
+        {
+            // reset before flipping the phase, so threads racing into the next phase count from 0
+            m_NumArrived.store(0);
+            m_Phase.fetch_add(1);
+
+            if (m_NumWaiters.load() > 0)
+            {
+                FutexUtils::WakeAll(m_Phase);
+            }
+            return;
+        }
+
+        if (FutexUtils::SpinUntil([&] { return m_Phase.load() != phase; }))
+            return;
+
+        m_NumWaiters.fetch_add(1);
+        while (m_Phase.load() == phase)
+        {
+            FutexUtils::Wait(m_Phase, phase);
+        }
+        m_NumWaiters.fetch_sub(1);
+    }
+};
+
+#if defined(BBE_LOCK_CONTENTION_STATS)
+    // One stats entry lookup per call site. The scope object measures wait & hold times around the actual lock/unlock calls
+    #define bbeLockContentionScope(lckName)                                                                                                 \
+        static LockContentionStats& bbeJOIN(lockContentionStats, __LINE__) = g_LockContentionProfiler.GetStats(lckName);                   \
+        LockContentionScope bbeJOIN(lockContentionScope, __LINE__){ bbeJOIN(lockContentionStats, __LINE__) };
+
+    #define bbeLockContentionAcquire(tryLockExpr, lockExpr) bbeJOIN(lockContentionScope, __LINE__).Acquire([&](){ return tryLockExpr; }, [&](){ lockExpr; })
+    #define bbeLockContentionRelease()                      bbeJOIN(lockContentionScope, __LINE__).Release()
+#else
+    #define bbeLockContentionScope(lckName)
+    #define bbeLockContentionAcquire(tryLockExpr, lockExpr) lockExpr
+    #define bbeLockContentionRelease()
+#endif
+
 #define bbeAutoLock(lck) \
-    static_assert(std::is_base_of_v<std::_Mutex_base, std::remove_reference_t<decltype(lck)>>); \
-    AutoScopeCaller bbeUniqueVariable(ScopedLock){ [&](){ bbeProfileLock(lck); lck.lock(); }, [&](){ lck.unlock(); } };
+    static_assert(std::is_same_v<std::mutex, std::remove_reference_t<decltype(lck)>> || std::is_same_v<std::recursive_mutex, std::remove_reference_t<decltype(lck)>>); \
+    bbeLockContentionScope(bbeTOSTRING(lck)); \
+    AutoScopeCaller bbeUniqueVariable(ScopedLock){ [&](){ bbeProfileLock(lck); bbeLockContentionAcquire(lck.try_lock(), lck.lock()); }, [&](){ bbeLockContentionRelease(); lck.unlock(); } };
 
 #define bbeAutoLockRead(lck) \
     static_assert(std::is_same_v<std::shared_mutex, std::remove_reference_t<decltype(lck)>>); \
-    AutoScopeCaller bbeUniqueVariable(ScopedReadLock){ [&](){ bbeProfileLock(lck##_LockRead); lck.lock_shared(); }, [&](){ lck.unlock_shared(); } };
+    bbeLockContentionScope(bbeTOSTRING(lck##_LockRead)); \
+    AutoScopeCaller bbeUniqueVariable(ScopedReadLock){ [&](){ bbeProfileLock(lck##_LockRead); bbeLockContentionAcquire(lck.try_lock_shared(), lck.lock_shared()); }, [&](){ bbeLockContentionRelease(); lck.unlock_shared(); } };
 
 #define bbeAutoLockWrite(lck) \
     static_assert(std::is_same_v<std::shared_mutex, std::remove_reference_t<decltype(lck)>>); \
-    AutoScopeCaller bbeUniqueVariable(ScopedWriteLock){ [&](){ bbeProfileLock(lck##_LockWrite); lck.lock(); }, [&](){ lck.unlock(); } };
+    bbeLockContentionScope(bbeTOSTRING(lck##_LockWrite)); \
+    AutoScopeCaller bbeUniqueVariable(ScopedWriteLock){ [&](){ bbeProfileLock(lck##_LockWrite); bbeLockContentionAcquire(lck.try_lock(), lck.lock()); }, [&](){ bbeLockContentionRelease(); lck.unlock(); } };
 
 #define bbeAutoLockScopedRWUpgrade(lck) \
     static_assert(std::is_same_v<std::shared_mutex, std::remove_reference_t<decltype(lck)>>); \
-    AutoScopeCaller bbeUniqueVariable(ScopedRWLockUpgrade){ [&](){ bbeProfileLock(lck##_LockUpgrade); lck.unlock_shared(); lck.lock(); }, [&](){ lck.unlock(); lck.lock_shared(); } };
+    bbeLockContentionScope(bbeTOSTRING(lck##_LockUpgrade)); \
+    AutoScopeCaller bbeUniqueVariable(ScopedRWLockUpgrade){ [&](){ bbeProfileLock(lck##_LockUpgrade); lck.unlock_shared(); bbeLockContentionAcquire(lck.try_lock(), lck.lock()); }, [&](){ bbeLockContentionRelease(); lck.unlock(); lck.lock_shared(); } };
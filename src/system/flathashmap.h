@@ -0,0 +1,422 @@
+#pragma once
+
+#if defined(_M_X64) || defined(__SSE2__)
+    #include <emmintrin.h>
+    #define BBE_SWISSTABLE_SSE2
+#endif
+
+// Open addressing hash map/set, in the style of Abseil's Swiss tables.
+// One control byte per slot (empty, deleted, or 7 bits of the hash), probed 16 slots at a time: most lookups touch one cache line of control bytes and one slot.
+// Element addresses are stable until the next rehash (insertion past 7/8 load, or reserve())
+namespace SwissTablePrivate
+{
+    static const int8_t Ctrl_Empty = -128; // 0b10000000
+    static const int8_t Ctrl_Deleted = -2; // 0b11111110
+    static const uint32_t GroupWidth = 16;
+
+    inline uint32_t CountTrailingZeros(uint32_t mask)
+    {
+#if defined(_MSC_VER)
+        unsigned long idx;
+        _BitScanForward(&idx, mask);
+        return idx;
+#else
+        return (uint32_t)__builtin_ctz(mask);
+#endif
+    }
+
+    // Bit i set == slot i of the group matches
+    struct Group
+    {
+#if defined(BBE_SWISSTABLE_SSE2)
+        __m128i m_Ctrl;
+
+        explicit Group(const int8_t* ctrl) : m_Ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+        uint32_t Match(int8_t h2) const { return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_Ctrl)); }
+        uint32_t MatchEmpty() const { return Match(Ctrl_Empty); }
+        uint32_t MatchEmptyOrDeleted() const { return (uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), m_Ctrl)); } // both have the sign bit set
+#else
+        int8_t m_Ctrl[GroupWidth];
+
+        explicit Group(const int8_t* ctrl) { memcpy(m_Ctrl, ctrl, GroupWidth); }
+
+        uint32_t Match(int8_t h2) const
+        {
+            uint32_t mask = 0;
+            for (uint32_t i = 0; i < GroupWidth; ++i)
+                mask |= (uint32_t)(m_Ctrl[i] == h2) << i;
+            return mask;
+        }
+        uint32_t MatchEmpty() const { return Match(Ctrl_Empty); }
+        uint32_t MatchEmptyOrDeleted() const
+        {
+            uint32_t mask = 0;
+            for (uint32_t i = 0; i < GroupWidth; ++i)
+                mask |= (uint32_t)(m_Ctrl[i] < 0) << i;
+            return mask;
+        }
+#endif
+    };
+
+    // std::hash is the identity for integers on some STLs: mix it, so both the slot index (high bits) and the 7 bits stored in the control bytes are well distributed
+    inline uint64_t MixHash(std::size_t hash)
+    {
+        const uint64_t h = (uint64_t)hash * 0x9E3779B97F4A7C15ULL;
+        return h ^ (h >> 32);
+    }
+
+    template <typename Key, typename Slot>
+    struct MapPolicy { static const Key& GetKey(const Slot& slot) { return slot.first; } };
+
+    template <typename Key, typename Slot>
+    struct SetPolicy { static const Key& GetKey(const Slot& slot) { return slot; } };
+
+    template <typename Key, typename Slot, typename Hash, typename KeyEqual, typename Policy>
+    class SwissTable
+    {
+    public:
+        using key_type = Key;
+        using value_type = Slot;
+        using size_type = std::size_t;
+
+        template <bool IsConst>
+        class Iterator
+        {
+        public:
+            using TableType = std::conditional_t<IsConst, const SwissTable, SwissTable>;
+            using reference = std::conditional_t<IsConst, const Slot&, Slot&>;
+            using pointer = std::conditional_t<IsConst, const Slot*, Slot*>;
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Slot;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator() = default;
+            Iterator(TableType* table, size_type index) : m_Table(table), m_Index(index) { SkipEmptySlots(); }
+            template <bool C = IsConst, std::enable_if_t<!C, int> = 0>
+            operator Iterator<true>() const { return Iterator<true>{ m_Table, m_Index }; }
+
+            reference operator*() const { return m_Table->m_Slots[m_Index]; }
+            pointer operator->() const { return &m_Table->m_Slots[m_Index]; }
+
+            Iterator& operator++() { ++m_Index; SkipEmptySlots(); return *this; }
+            Iterator operator++(int) { Iterator ret = *this; ++*this; return ret; }
+
+            bool operator==(const Iterator& rhs) const { return m_Index == rhs.m_Index; }
+            bool operator!=(const Iterator& rhs) const { return m_Index != rhs.m_Index; }
+
+        private:
+            void SkipEmptySlots()
+            {
+                while (m_Index < m_Table->m_Capacity && m_Table->m_Ctrl[m_Index] < 0)
+                    ++m_Index;
+            }
+
+            TableType* m_Table = nullptr;
+            size_type m_Index = 0;
+
+            friend class SwissTable;
+        };
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        SwissTable() = default;
+        ~SwissTable() { DestroyAll(); }
+
+        SwissTable(const SwissTable& rhs)
+        {
+            reserve(rhs.size());
+            for (const Slot& slot : rhs)
+                EmplaceSlot(Policy::GetKey(slot), slot);
+        }
+
+        SwissTable(SwissTable&& rhs) noexcept { Swap(rhs); }
+
+        SwissTable& operator=(const SwissTable& rhs)
+        {
+            if (this != &rhs)
+            {
+                SwissTable copy{ rhs };
+                Swap(copy);
+            }
+            return *this;
+        }
+
+        SwissTable& operator=(SwissTable&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                DestroyAll();
+                Swap(rhs);
+            }
+            return *this;
+        }
+
+        iterator begin() { return iterator{ this, 0 }; }
+        iterator end() { return iterator{ this, m_Capacity }; }
+        const_iterator begin() const { return const_iterator{ this, 0 }; }
+        const_iterator end() const { return const_iterator{ this, m_Capacity }; }
+
+        size_type size() const { return m_Size; }
+        bool empty() const { return m_Size == 0; }
+        size_type capacity() const { return m_Capacity; }
+
+        void clear()
+        {
+            for (size_type i = 0; i < m_Capacity; ++i)
+            {
+                if (m_Ctrl[i] >= 0)
+                    m_Slots[i].~Slot();
+            }
+            if (m_Ctrl)
+                memset(m_Ctrl, Ctrl_Empty, m_Capacity + GroupWidth);
+
+            m_Size = 0;
+            m_NumDeleted = 0;
+        }
+
+        void reserve(size_type count)
+        {
+            size_type newCapacity = std::max<size_type>(m_Capacity, GroupWidth);
+            while (count > GetMaxLoad(newCapacity))
+                newCapacity *= 2;
+
+            if (newCapacity != m_Capacity || !m_Ctrl)
+                Rehash(newCapacity);
+        }
+
+        iterator find(const Key& key) { return iterator{ this, FindIndex(key) }; }
+        const_iterator find(const Key& key) const { return const_iterator{ this, FindIndex(key) }; }
+        bool contains(const Key& key) const { return FindIndex(key) != m_Capacity; }
+        size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+        std::pair<iterator, bool> insert(const Slot& slot) { return EmplaceSlot(Policy::GetKey(slot), slot); }
+        std::pair<iterator, bool> insert(Slot&& slot) { return EmplaceSlot(Policy::GetKey(slot), std::move(slot)); }
+
+        size_type erase(const Key& key)
+        {
+            const size_type index = FindIndex(key);
+            if (index == m_Capacity)
+                return 0;
+
+            EraseIndex(index);
+            return 1;
+        }
+
+        void erase(const_iterator it) { EraseIndex(it.m_Index); }
+
+    protected:
+        template <typename... Args>
+        std::pair<iterator, bool> EmplaceSlot(const Key& key, Args&&... args)
+        {
+            const uint64_t hash = MixHash(Hash{}(key));
+
+            const size_type existingIndex = FindIndex(key, hash);
+            if (existingIndex != m_Capacity)
+                return { iterator{ this, existingIndex }, false };
+
+            // tombstones count towards the load: they lengthen probe sequences just like live slots
+            if (m_Size + m_NumDeleted + 1 > GetMaxLoad(m_Capacity))
+            {
+                // mostly tombstones: rehash in place to clean them up, instead of growing
+                const size_type newCapacity = m_Size + 1 > GetMaxLoad(m_Capacity) / 2 ? std::max<size_type>(m_Capacity * 2, GroupWidth) : m_Capacity;
+                Rehash(newCapacity);
+            }
+
+            const size_type index = FindInsertIndex(hash);
+            if (m_Ctrl[index] == Ctrl_Deleted)
+                --m_NumDeleted;
+
+            new (&m_Slots[index]) Slot(std::forward<Args>(args)...);
+            SetCtrl(index, H2(hash));
+            ++m_Size;
+
+            return { iterator{ this, index }, true };
+        }
+
+        size_type FindIndex(const Key& key) const { return FindIndex(key, MixHash(Hash{}(key))); }
+
+        size_type FindIndex(const Key& key, uint64_t hash) const
+        {
+            if (m_Size == 0)
+                return m_Capacity;
+
+            const int8_t h2 = H2(hash);
+            const size_type mask = m_Capacity - 1;
+
+            size_type pos = H1(hash) & mask;
+            for (size_type probe = 1;; ++probe)
+            {
+                const Group group{ m_Ctrl + pos };
+
+                for (uint32_t match = group.Match(h2); match; match &= match - 1)
+                {
+                    const size_type index = (pos + CountTrailingZeros(match)) & mask;
+                    if (KeyEqual{}(Policy::GetKey(m_Slots[index]), key))
+                        return index;
+                }
+
+                // an empty slot ends the probe sequence: the key would have been inserted there
+                if (group.MatchEmpty())
+                    return m_Capacity;
+
+                // triangular probing visits every group when capacity is a power of 2
+                pos = (pos + GroupWidth * probe) & mask;
+            }
+        }
+
+    private:
+        static size_type GetMaxLoad(size_type capacity) { return capacity - capacity / 8; }
+        static size_type H1(uint64_t hash) { return (size_type)(hash >> 7); }
+        static int8_t H2(uint64_t hash) { return (int8_t)(hash & 0x7F); }
+
+        size_type FindInsertIndex(uint64_t hash) const
+        {
+            const size_type mask = m_Capacity - 1;
+
+            size_type pos = H1(hash) & mask;
+            for (size_type probe = 1;; ++probe)
+            {
+                const uint32_t match = Group{ m_Ctrl + pos }.MatchEmptyOrDeleted();
+                if (match)
+                    return (pos + CountTrailingZeros(match)) & mask;
+
+                pos = (pos + GroupWidth * probe) & mask;
+            }
+        }
+
+        void SetCtrl(size_type index, int8_t ctrl)
+        {
+            m_Ctrl[index] = ctrl;
+
+            // the first group is mirrored after the last slot, so groups can be loaded unaligned without wrapping around
+            if (index < GroupWidth)
+                m_Ctrl[m_Capacity + index] = ctrl;
+        }
+
+        void EraseIndex(size_type index)
+        {
+            assert(index < m_Capacity && m_Ctrl[index] >= 0);
+
+            m_Slots[index].~Slot();
+            SetCtrl(index, Ctrl_Deleted);
+            --m_Size;
+            ++m_NumDeleted;
+        }
+
+        void Rehash(size_type newCapacity)
+        {
+            assert((newCapacity & (newCapacity - 1)) == 0 && newCapacity >= GroupWidth);
+
+            int8_t* oldCtrl = m_Ctrl;
+            Slot* oldSlots = m_Slots;
+            const size_type oldCapacity = m_Capacity;
+
+            m_Ctrl = static_cast<int8_t*>(::operator new(newCapacity + GroupWidth));
+            m_Slots = static_cast<Slot*>(::operator new(newCapacity * sizeof(Slot), std::align_val_t{ alignof(Slot) }));
+            m_Capacity = newCapacity;
+            m_NumDeleted = 0;
+            memset(m_Ctrl, Ctrl_Empty, newCapacity + GroupWidth);
+
+            for (size_type i = 0; i < oldCapacity; ++i)
+            {
+                if (oldCtrl[i] < 0)
+                    continue;
+
+                const uint64_t hash = MixHash(Hash{}(Policy::GetKey(oldSlots[i])));
+                const size_type index = FindInsertIndex(hash);
+
+                new (&m_Slots[index]) Slot(std::move(oldSlots[i]));
+                oldSlots[i].~Slot();
+                SetCtrl(index, H2(hash));
+            }
+
+            if (oldCtrl)
+            {
+                ::operator delete(oldCtrl);
+                ::operator delete(oldSlots, std::align_val_t{ alignof(Slot) });
+            }
+        }
+
+        void DestroyAll()
+        {
+            if (!m_Ctrl)
+                return;
+
+            clear();
+            ::operator delete(m_Ctrl);
+            ::operator delete(m_Slots, std::align_val_t{ alignof(Slot) });
+            m_Ctrl = nullptr;
+            m_Slots = nullptr;
+            m_Capacity = 0;
+        }
+
+        void Swap(SwissTable& rhs)
+        {
+            std::swap(m_Ctrl, rhs.m_Ctrl);
+            std::swap(m_Slots, rhs.m_Slots);
+            std::swap(m_Capacity, rhs.m_Capacity);
+            std::swap(m_Size, rhs.m_Size);
+            std::swap(m_NumDeleted, rhs.m_NumDeleted);
+        }
+
+        int8_t* m_Ctrl = nullptr;
+        Slot* m_Slots = nullptr;
+        size_type m_Capacity = 0;
+        size_type m_Size = 0;
+        size_type m_NumDeleted = 0;
+    };
+}
+
+template <typename KeyType, typename ValueType, typename Hash = std::hash<KeyType>, typename KeyEqual = std::equal_to<KeyType>>
+class FlatHashMap : public SwissTablePrivate::SwissTable<KeyType, std::pair<const KeyType, ValueType>, Hash, KeyEqual, SwissTablePrivate::MapPolicy<KeyType, std::pair<const KeyType, ValueType>>>
+{
+public:
+    using mapped_type = ValueType;
+
+    template <typename... Args>
+    auto try_emplace(const KeyType& key, Args&&... args)
+    {
+        return this->EmplaceSlot(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <typename... Args>
+    auto emplace(const KeyType& key, Args&&... args) { return try_emplace(key, std::forward<Args>(args)...); }
+
+    template <typename V>
+    auto insert_or_assign(const KeyType& key, V&& value)
+    {
+        auto result = try_emplace(key, std::forward<V>(value));
+        if (!result.second)
+            result.first->second = std::forward<V>(value);
+        return result;
+    }
+
+    ValueType& operator[](const KeyType& key) { return try_emplace(key).first->second; }
+
+    ValueType& at(const KeyType& key)
+    {
+        auto it = this->find(key);
+        assert(it != this->end());
+        return it->second;
+    }
+
+    const ValueType& at(const KeyType& key) const
+    {
+        auto it = this->find(key);
+        assert(it != this->end());
+        return it->second;
+    }
+};
+
+template <typename KeyType, typename Hash = std::hash<KeyType>, typename KeyEqual = std::equal_to<KeyType>>
+class FlatHashSet : public SwissTablePrivate::SwissTable<KeyType, KeyType, Hash, KeyEqual, SwissTablePrivate::SetPolicy<KeyType, KeyType>>
+{
+public:
+    template <typename... Args>
+    auto emplace(Args&&... args)
+    {
+        KeyType key{ std::forward<Args>(args)... };
+        return this->EmplaceSlot(key, std::move(key));
+    }
+};
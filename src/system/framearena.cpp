@@ -0,0 +1,195 @@
+#include <system/framearena.h>
+
+#include <system/imguimanager.h>
+
+#if !defined(_WIN32)
+    #include <sys/mman.h>
+#endif
+
+thread_local FrameArena::ThreadFrameArena* FrameArena::ms_ThreadFrameArena = nullptr;
+
+static bool gs_ShowFrameArenaIMGUIWindow = false;
+
+void FrameArena::Initialize(bool useHugePages)
+{
+    bbeProfileFunction();
+
+    m_UseHugePages = useHugePages;
+
+#if defined(_WIN32)
+    if (m_UseHugePages)
+    {
+        // Large pages need the "Lock pages in memory" privilege. Without it, VirtualAlloc with MEM_LARGE_PAGES fails and we fall back to regular pages per block
+        const std::size_t largePageSize = ::GetLargePageMinimum();
+        if (largePageSize == 0)
+        {
+            g_Log.warn("FrameArena: large pages not supported. Using regular pages");
+            m_UseHugePages = false;
+        }
+        else
+        {
+            m_BlockSize = AlignUp(m_BlockSize, largePageSize);
+        }
+    }
+#else
+    if (m_UseHugePages)
+    {
+        m_BlockSize = AlignUp(m_BlockSize, BBE_MB(2));
+    }
+#endif
+
+    g_IMGUIManager.RegisterTopMenu("System", "Frame Arena", &gs_ShowFrameArenaIMGUIWindow);
+    g_IMGUIManager.RegisterWindowUpdateCB([&]() { UpdateIMGUI(); });
+}
+
+void FrameArena::ShutDown()
+{
+    bbeProfileFunction();
+
+    bbeAutoLock(m_ThreadArenasLock);
+
+    for (const std::unique_ptr<ThreadFrameArena>& threadArena : m_AllThreadArenas)
+    {
+        for (BufferedFrame& frame : threadArena->m_Frames)
+        {
+            for (const ArenaBlock& block : frame.m_Blocks)
+            {
+                FreeBlock(block);
+            }
+            frame.m_Blocks.clear();
+        }
+    }
+
+    // thread arenas stay alive, since threads still cache a pointer to them
+}
+
+FrameArena::ThreadFrameArena& FrameArena::GetThreadFrameArena()
+{
+    if (!ms_ThreadFrameArena)
+    {
+        std::unique_ptr<ThreadFrameArena> newArena = std::make_unique<ThreadFrameArena>();
+        ms_ThreadFrameArena = newArena.get();
+
+        bbeAutoLock(m_ThreadArenasLock);
+        m_AllThreadArenas.push_back(std::move(newArena));
+    }
+
+    return *ms_ThreadFrameArena;
+}
+
+void* FrameArena::AllocateSlow(BufferedFrame& frame, ThreadFrameArena& threadArena, std::size_t size, std::size_t alignment)
+{
+    // current block is full. Move on to the next one that fits, keeping blocks from previous use of this buffered frame around
+    while (++frame.m_CurrentBlock < frame.m_Blocks.size())
+    {
+        const ArenaBlock& block = frame.m_Blocks[frame.m_CurrentBlock];
+        if (AlignUp(size, alignment) <= block.m_Size)
+        {
+            frame.m_Offset = size;
+            return block.m_Memory;
+        }
+    }
+
+    // out of blocks. Grab a new one from the OS. Big allocations get a dedicated block
+    threadArena.m_NbBlockAllocations.store(threadArena.m_NbBlockAllocations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    const ArenaBlock newBlock = AllocateBlock(size + alignment);
+    frame.m_Blocks.push_back(newBlock);
+    frame.m_CurrentBlock = (uint32_t)frame.m_Blocks.size() - 1;
+    frame.m_Offset = size;
+
+    // OS blocks are page aligned
+    assert(AlignUp((uintptr_t)newBlock.m_Memory, alignment) == (uintptr_t)newBlock.m_Memory);
+    return newBlock.m_Memory;
+}
+
+FrameArena::ArenaBlock FrameArena::AllocateBlock(std::size_t minSize)
+{
+    bbeProfileFunction();
+
+    ArenaBlock newBlock;
+    newBlock.m_Size = AlignUp(std::max(minSize, m_BlockSize), m_BlockSize);
+
+#if defined(_WIN32)
+    if (m_UseHugePages)
+    {
+        newBlock.m_Memory = (std::byte*)::VirtualAlloc(nullptr, newBlock.m_Size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+    }
+    if (!newBlock.m_Memory)
+    {
+        newBlock.m_Memory = (std::byte*)::VirtualAlloc(nullptr, newBlock.m_Size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    }
+#else
+    void* memory = MAP_FAILED;
+    if (m_UseHugePages)
+    {
+        memory = ::mmap(nullptr, newBlock.m_Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+    if (memory == MAP_FAILED)
+    {
+        memory = ::mmap(nullptr, newBlock.m_Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    newBlock.m_Memory = memory != MAP_FAILED ? (std::byte*)memory : nullptr;
+#endif
+    assert(newBlock.m_Memory);
+
+    m_TotalReservedBytes += newBlock.m_Size;
+
+    return newBlock;
+}
+
+void FrameArena::FreeBlock(const ArenaBlock& block)
+{
+#if defined(_WIN32)
+    ::VirtualFree(block.m_Memory, 0, MEM_RELEASE);
+#else
+    ::munmap(block.m_Memory, block.m_Size);
+#endif
+
+    m_TotalReservedBytes -= block.m_Size;
+}
+
+void FrameArena::EndFrame()
+{
+    bbeProfileFunction();
+
+    uint64_t nbAllocations = 0;
+    uint64_t nbAllocatedBytes = 0;
+    uint64_t nbBlockAllocations = 0;
+    {
+        bbeAutoLock(m_ThreadArenasLock);
+        for (const std::unique_ptr<ThreadFrameArena>& threadArena : m_AllThreadArenas)
+        {
+            nbAllocations += threadArena->m_NbAllocations.load(std::memory_order_relaxed);
+            nbAllocatedBytes += threadArena->m_NbAllocatedBytes.load(std::memory_order_relaxed);
+            nbBlockAllocations += threadArena->m_NbBlockAllocations.load(std::memory_order_relaxed);
+        }
+    }
+
+    m_LastFrameNbAllocations = nbAllocations - m_PrevNbAllocations;
+    m_LastFrameNbAllocatedBytes = nbAllocatedBytes - m_PrevNbAllocatedBytes;
+    m_LastFrameNbBlockAllocations = nbBlockAllocations - m_PrevNbBlockAllocations;
+    m_PeakFrameNbAllocatedBytes = std::max(m_PeakFrameNbAllocatedBytes, m_LastFrameNbAllocatedBytes);
+
+    m_PrevNbAllocations = nbAllocations;
+    m_PrevNbAllocatedBytes = nbAllocatedBytes;
+    m_PrevNbBlockAllocations = nbBlockAllocations;
+
+    // this is the whole "free". Every thread rewinds its buffered frame lazily on its next allocation
+    m_FrameIdx.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FrameArena::UpdateIMGUI()
+{
+    if (!gs_ShowFrameArenaIMGUIWindow)
+        return;
+
+    ScopedIMGUIWindow window{ "Frame Arena" };
+
+    ImGui::LabelText("Huge Pages", "%s", m_UseHugePages ? "Yes" : "No");
+    ImGui::LabelText("Allocations / Frame", "%llu", m_LastFrameNbAllocations);
+    ImGui::LabelText("Bytes / Frame", "%.1f KB", BBE_TO_KB(m_LastFrameNbAllocatedBytes));
+    ImGui::LabelText("Peak Bytes / Frame", "%.1f KB", BBE_TO_KB(m_PeakFrameNbAllocatedBytes));
+    ImGui::LabelText("OS Block Allocations / Frame", "%llu", m_LastFrameNbBlockAllocations);
+    ImGui::LabelText("Total Reserved", "%.2f MB", BBE_TO_MB(m_TotalReservedBytes.load()));
+}
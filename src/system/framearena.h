@@ -0,0 +1,135 @@
+#pragma once
+
+// Thread-local linear allocators for transient per-frame data.
+// Every thread bumps a pointer in its own blocks, so allocations never lock. Nothing is freed individually: a frame's memory is recycled as a whole, in O(1), NbBufferedFrames frames later.
+// This means frame data can be kept alive across frames in flight, as long as it is not used for more than NbBufferedFrames - 1 frames after the one it was allocated in.
+class FrameArena
+{
+    DeclareSingletonFunctions(FrameArena);
+
+public:
+    static const uint32_t NbBufferedFrames = 3;
+
+    void Initialize(bool useHugePages);
+    void ShutDown();
+
+    // Call once per frame, after all frame tasks are done
+    void EndFrame();
+
+    void* Allocate(std::size_t size, std::size_t alignment);
+
+    template <typename T, typename... Args>
+    T* New(Args&&... args) { return new (Allocate(sizeof(T), alignof(T))) T{ std::forward<Args>(args)... }; }
+
+    void UpdateIMGUI();
+
+private:
+    struct ArenaBlock
+    {
+        std::byte* m_Memory = nullptr;
+        std::size_t m_Size = 0;
+    };
+
+    struct BufferedFrame
+    {
+        InplaceArray<ArenaBlock, 4> m_Blocks;
+        uint32_t m_CurrentBlock = 0;
+        std::size_t m_Offset = 0;
+        uint64_t m_FrameIdx = UINT64_MAX;
+    };
+
+    // Only written by the owning thread. Stats are cumulative, so EndFrame can diff them without writing to them
+    struct ThreadFrameArena
+    {
+        BufferedFrame m_Frames[NbBufferedFrames];
+        std::atomic<uint64_t> m_NbAllocations = 0;
+        std::atomic<uint64_t> m_NbAllocatedBytes = 0;
+        std::atomic<uint64_t> m_NbBlockAllocations = 0;
+    };
+
+    ThreadFrameArena& GetThreadFrameArena();
+    void* AllocateSlow(BufferedFrame& frame, ThreadFrameArena& threadArena, std::size_t size, std::size_t alignment);
+    ArenaBlock AllocateBlock(std::size_t minSize);
+    void FreeBlock(const ArenaBlock& block);
+
+    static thread_local ThreadFrameArena* ms_ThreadFrameArena;
+
+    std::atomic<uint64_t> m_FrameIdx = 0;
+
+    bool m_UseHugePages = false;
+    std::size_t m_BlockSize = BBE_KB(256);
+
+    std::mutex m_ThreadArenasLock;
+    std::vector<std::unique_ptr<ThreadFrameArena>> m_AllThreadArenas;
+
+    // Per-frame stats, computed in EndFrame
+    uint64_t m_PrevNbAllocations = 0;
+    uint64_t m_PrevNbAllocatedBytes = 0;
+    uint64_t m_PrevNbBlockAllocations = 0;
+    uint64_t m_LastFrameNbAllocations = 0;
+    uint64_t m_LastFrameNbAllocatedBytes = 0;
+    uint64_t m_LastFrameNbBlockAllocations = 0;
+    uint64_t m_PeakFrameNbAllocatedBytes = 0;
+    std::atomic<uint64_t> m_TotalReservedBytes = 0;
+};
+#define g_FrameArena FrameArena::GetInstance()
+
+inline void* FrameArena::Allocate(std::size_t size, std::size_t alignment)
+{
+    ThreadFrameArena& threadArena = GetThreadFrameArena();
+
+    const uint64_t frameIdx = m_FrameIdx.load(std::memory_order_relaxed);
+    BufferedFrame& frame = threadArena.m_Frames[frameIdx % NbBufferedFrames];
+
+    // first allocation on this thread since this buffered frame was recycled. Rewind it
+    if (frame.m_FrameIdx != frameIdx)
+    {
+        frame.m_FrameIdx = frameIdx;
+        frame.m_CurrentBlock = 0;
+        frame.m_Offset = 0;
+    }
+
+    threadArena.m_NbAllocations.store(threadArena.m_NbAllocations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    threadArena.m_NbAllocatedBytes.store(threadArena.m_NbAllocatedBytes.load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+
+    if (frame.m_CurrentBlock < frame.m_Blocks.size())
+    {
+        const ArenaBlock& block = frame.m_Blocks[frame.m_CurrentBlock];
+        const std::size_t alignedOffset = AlignUp(frame.m_Offset, alignment);
+        if (alignedOffset + size <= block.m_Size)
+        {
+            frame.m_Offset = alignedOffset + size;
+            return block.m_Memory + alignedOffset;
+        }
+    }
+
+    return AllocateSlow(frame, threadArena, size, alignment);
+}
+
+// STL-compatible adapter. Deallocation is a no-op: memory goes back to the arena when the frame is recycled
+template <typename T>
+class FrameAllocator
+{
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+
+    FrameAllocator() = default;
+    template <typename U> FrameAllocator(const FrameAllocator<U>&) {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(g_FrameArena.Allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T*, std::size_t) {}
+
+    template <typename U> bool operator==(const FrameAllocator<U>&) const { return true; }
+    template <typename U> bool operator!=(const FrameAllocator<U>&) const { return false; }
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+template <typename T, uint32_t N>
+using FrameInplaceArray = boost::container::small_vector<T, N, FrameAllocator<T>>;
+
+template <typename T>
+using FrameCircularBuffer = boost::circular_buffer<T, FrameAllocator<T>>;
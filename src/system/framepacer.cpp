@@ -0,0 +1,177 @@
+#include <system/framepacer.h>
+
+#include <system/imguimanager.h>
+
+#if defined(_WIN32)
+    #include <intrin.h>
+#else
+    #include <errno.h>
+    #include <time.h>
+#endif
+
+static const uint64_t gs_MinSpinMarginTicks = Timer::MicroSecondsToTicks(50.0);
+static const uint64_t gs_MaxSpinMarginTicks = Timer::MilliSecondsToTicks(4.0);
+
+// weight of the latest sample for the exponential moving averages
+static const double gs_PacerEMAWeight = 0.1;
+
+static bool gs_ShowFramePacerIMGUIWindow = false;
+
+#if defined(_WIN32)
+// QueryThreadCycleTime counts TSC cycles. Calibrated against the QPC at init
+static double gs_ThreadCyclesPerMs = 0.0;
+
+static void CalibrateThreadCyclesFrequency()
+{
+    Timer timer;
+    const uint64_t tscBegin = __rdtsc();
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+    const uint64_t tscEnd = __rdtsc();
+
+    gs_ThreadCyclesPerMs = (double)(tscEnd - tscBegin) / Timer::TicksToMilliSeconds(timer.GetElapsedTicks());
+}
+#endif
+
+void FramePacer::Initialize()
+{
+#if defined(_WIN32)
+    // High resolution waitable timers are available since Win10 1803. Fall back to the regular (~1ms+ granularity) timer otherwise
+    m_WaitableTimer = ::CreateWaitableTimerEx(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (!m_WaitableTimer)
+    {
+        g_Log.warn("FramePacer: High resolution waitable timer not supported. Falling back to regular waitable timer");
+        m_WaitableTimer = ::CreateWaitableTimerEx(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+    }
+    assert(m_WaitableTimer);
+
+    CalibrateThreadCyclesFrequency();
+#endif
+
+    g_IMGUIManager.RegisterTopMenu("System", "FramePacer", &gs_ShowFramePacerIMGUIWindow);
+    g_IMGUIManager.RegisterWindowUpdateCB([&]() { UpdateIMGUI(); });
+}
+
+void FramePacer::ShutDown()
+{
+#if defined(_WIN32)
+    ::CloseHandle(m_WaitableTimer);
+    m_WaitableTimer = nullptr;
+#endif
+}
+
+void FramePacer::SleepForTicks(uint64_t ticks)
+{
+#if defined(_WIN32)
+    // negative == relative time in 100ns units, which is what Timer ticks are
+    static_assert(Timer::TicksPerSecond == 10000000);
+
+    LARGE_INTEGER dueTime{};
+    dueTime.QuadPart = -(LONGLONG)ticks;
+
+    const bool result = ::SetWaitableTimerEx(m_WaitableTimer, &dueTime, 0, nullptr, nullptr, nullptr, 0);
+    assert(result);
+
+    ::WaitForSingleObject(m_WaitableTimer, INFINITE);
+#else
+    const uint64_t ns = ticks * (1000000000ULL / Timer::TicksPerSecond);
+
+    ::timespec req{};
+    req.tv_sec = (time_t)(ns / 1000000000ULL);
+    req.tv_nsec = (long)(ns % 1000000000ULL);
+
+    // retry on signal interruption with the remaining time
+    ::timespec rem{};
+    while (::clock_nanosleep(CLOCK_MONOTONIC, 0, &req, &rem) == EINTR) { req = rem; }
+#endif
+}
+
+double FramePacer::GetThreadCPUTimeMs()
+{
+#if defined(_WIN32)
+    // GetThreadTimes only updates on scheduler ticks (~15.6ms): useless to measure sub-ms waits. Cycle counts are exact
+    ULONG64 cycles = 0;
+    ::QueryThreadCycleTime(::GetCurrentThread(), &cycles);
+    return (double)cycles / gs_ThreadCyclesPerMs;
+#else
+    ::timespec ts{};
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+#endif
+}
+
+void FramePacer::CalibrateSpinMargin(uint64_t requestedTicks, uint64_t actualTicks)
+{
+    const double overshoot = actualTicks > requestedTicks ? (double)(actualTicks - requestedTicks) : 0.0;
+
+    m_AvgOvershootTicks += (overshoot - m_AvgOvershootTicks) * gs_PacerEMAWeight;
+    m_AvgOvershootDeviationTicks += (std::abs(overshoot - m_AvgOvershootTicks) - m_AvgOvershootDeviationTicks) * gs_PacerEMAWeight;
+
+    // wake up early enough to cover nearly all observed overshoots
+    const uint64_t newMargin = (uint64_t)(m_AvgOvershootTicks + 4.0 * m_AvgOvershootDeviationTicks);
+    m_SpinMarginTicks = std::clamp(newMargin, gs_MinSpinMarginTicks, gs_MaxSpinMarginTicks);
+}
+
+void FramePacer::WaitUntilFrameBudget(Timer& frameTimer, uint64_t frameBudgetTicks)
+{
+    bbeProfileFunction();
+
+    const double cpuTimeBegin = GetThreadCPUTimeMs();
+
+    uint64_t elapsedTicks = frameTimer.GetElapsedTicks();
+
+    // sleep for the bulk of the remaining budget
+    if (elapsedTicks + m_SpinMarginTicks < frameBudgetTicks)
+    {
+        bbeProfile("Sleep");
+
+        const uint64_t ticksToSleep = frameBudgetTicks - elapsedTicks - m_SpinMarginTicks;
+        SleepForTicks(ticksToSleep);
+
+        const uint64_t newElapsedTicks = frameTimer.GetElapsedTicks();
+        CalibrateSpinMargin(ticksToSleep, newElapsedTicks - elapsedTicks);
+        elapsedTicks = newElapsedTicks;
+    }
+
+    // spin for the short tail
+    {
+        bbeProfile("Spin");
+        while (elapsedTicks < frameBudgetTicks)
+        {
+            std::this_thread::yield();
+            elapsedTicks = frameTimer.GetElapsedTicks();
+        }
+    }
+
+    const double waitCPUTimeMs = GetThreadCPUTimeMs() - cpuTimeBegin;
+    m_AvgWaitCPUTimeMs += (waitCPUTimeMs - m_AvgWaitCPUTimeMs) * gs_PacerEMAWeight;
+}
+
+void FramePacer::AddFrameTime(double frameTimeMs)
+{
+    m_FrameTimesHistory.push_back(frameTimeMs);
+}
+
+double FramePacer::GetFrameTimeStdDevMs() const
+{
+    if (m_FrameTimesHistory.size() < 2)
+        return 0.0;
+
+    const double mean = std::accumulate(m_FrameTimesHistory.begin(), m_FrameTimesHistory.end(), 0.0) / m_FrameTimesHistory.size();
+    const double sqSum = std::accumulate(m_FrameTimesHistory.begin(), m_FrameTimesHistory.end(), 0.0, [mean](double acc, double v) { return acc + (v - mean) * (v - mean); });
+
+    return std::sqrt(sqSum / (m_FrameTimesHistory.size() - 1));
+}
+
+void FramePacer::UpdateIMGUI()
+{
+    if (!gs_ShowFramePacerIMGUIWindow)
+        return;
+
+    ScopedIMGUIWindow window{ "FramePacer" };
+
+    ImGui::LabelText("FPS Limit", "%u", g_CommandLineOptions.m_FPSLimit);
+    ImGui::LabelText("Spin Margin", "%.1f us", GetSpinMarginMicroSeconds());
+    ImGui::LabelText("Avg Wake-up Overshoot", "%.1f us", Timer::TicksToMicroSeconds((uint64_t)m_AvgOvershootTicks));
+    ImGui::LabelText("Frame Time Std Dev", "%.3f ms", GetFrameTimeStdDevMs());
+    ImGui::LabelText("Wait CPU Time / Frame", "%.3f ms", GetAverageWaitCPUTimeMs());
+}
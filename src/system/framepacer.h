@@ -0,0 +1,37 @@
+#pragma once
+
+// Caps frame rate by sleeping on a high resolution timer for most of the remaining frame budget, then spinning only for a short tail.
+// The spin tail is calibrated from the measured wake-up overshoot of previous sleeps.
+class FramePacer
+{
+public:
+    void Initialize();
+    void ShutDown();
+
+    void WaitUntilFrameBudget(Timer& frameTimer, uint64_t frameBudgetTicks);
+    void AddFrameTime(double frameTimeMs);
+
+    double GetSpinMarginMicroSeconds() const { return Timer::TicksToMicroSeconds(m_SpinMarginTicks); }
+    double GetAverageWaitCPUTimeMs() const { return m_AvgWaitCPUTimeMs; }
+    double GetFrameTimeStdDevMs() const;
+
+    void UpdateIMGUI();
+
+private:
+    void SleepForTicks(uint64_t ticks);
+    void CalibrateSpinMargin(uint64_t requestedTicks, uint64_t actualTicks);
+    static double GetThreadCPUTimeMs();
+
+#if defined(_WIN32)
+    ::HANDLE m_WaitableTimer = nullptr;
+#endif
+
+    // Start conservative. Will adapt after a few frames
+    uint64_t m_SpinMarginTicks = Timer::MilliSecondsToTicks(1.0);
+    double m_AvgOvershootTicks = 0.0;
+    double m_AvgOvershootDeviationTicks = 0.0;
+    double m_AvgWaitCPUTimeMs = 0.0;
+
+    static const uint32_t NbFrameTimesHistory = 128;
+    CircularBuffer<double> m_FrameTimesHistory{ NbFrameTimesHistory };
+};
@@ -0,0 +1,56 @@
+#include <system/futex.h>
+
+#if !defined(_WIN32)
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free, "the OS waits on the raw 32 bits value");
+
+namespace FutexUtils
+{
+    bool IsSpinningUseful()
+    {
+        static const bool s_IsSpinningUseful = std::thread::hardware_concurrency() > 1;
+        return s_IsSpinningUseful;
+    }
+
+#if defined(_WIN32)
+    void Wait(const std::atomic<uint32_t>& value, uint32_t undesiredValue)
+    {
+        ::WaitOnAddress(const_cast<std::atomic<uint32_t>*>(&value), &undesiredValue, sizeof(uint32_t), INFINITE);
+    }
+
+    void WakeOne(std::atomic<uint32_t>& value)
+    {
+        ::WakeByAddressSingle(&value);
+    }
+
+    void WakeAll(std::atomic<uint32_t>& value)
+    {
+        ::WakeByAddressAll(&value);
+    }
+#else
+    static long Futex(const std::atomic<uint32_t>& value, int op, uint32_t val)
+    {
+        return ::syscall(SYS_futex, reinterpret_cast<const uint32_t*>(&value), op, val, nullptr, nullptr, 0);
+    }
+
+    void Wait(const std::atomic<uint32_t>& value, uint32_t undesiredValue)
+    {
+        // EAGAIN if the value changed already, EINTR on signals: both are spurious wake ups for the caller
+        Futex(value, FUTEX_WAIT_PRIVATE, undesiredValue);
+    }
+
+    void WakeOne(std::atomic<uint32_t>& value)
+    {
+        Futex(value, FUTEX_WAKE_PRIVATE, 1);
+    }
+
+    void WakeAll(std::atomic<uint32_t>& value)
+    {
+        Futex(value, FUTEX_WAKE_PRIVATE, INT32_MAX);
+    }
+#endif
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+    #include <immintrin.h>
+#endif
+
+// Park/unpark threads on a 32 bits value: WaitOnAddress on Windows, futex on Linux.
+// Waiting costs nothing when the value already changed, and waking costs a syscall, so primitives only wake when they know someone is parked
+namespace FutexUtils
+{
+    // Good enough for waits expected to finish in a few micro-seconds, before paying for a trip to the kernel
+    static const uint32_t DefaultSpinCount = 1024;
+
+    inline void CPUPause()
+    {
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+        _mm_pause();
+#elif defined(_M_ARM64)
+        __yield();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+
+    // False on single core machines: the thread we spin on can't make progress until we give the core back
+    bool IsSpinningUseful();
+
+    // Returns true if 'predicate' became true within 'numSpins' spins
+    template <typename Predicate>
+    bool SpinUntil(Predicate&& predicate, uint32_t numSpins = DefaultSpinCount)
+    {
+        if (!IsSpinningUseful())
+            return predicate();
+
+        for (uint32_t i = 0; i < numSpins; ++i)
+        {
+            if (predicate())
+                return true;
+
+            CPUPause();
+        }
+        return predicate();
+    }
+
+    // Blocks while 'value' == 'undesiredValue'. Can wake up spuriously, so always re-check the condition
+    void Wait(const std::atomic<uint32_t>& value, uint32_t undesiredValue);
+
+    void WakeOne(std::atomic<uint32_t>& value);
+    void WakeAll(std::atomic<uint32_t>& value);
+}
@@ -0,0 +1,115 @@
+#include <system/hash.h>
+
+#define XXH_IMPLEMENTATION
+#include <extern/xxhash/xxhash.h>
+
+#if defined(__SSE4_2__) || defined(__AVX2__)
+    #include <nmmintrin.h>
+    #define BBE_HW_CRC32C_X86
+#elif defined(__ARM_FEATURE_CRC32)
+    #include <arm_acle.h>
+    #define BBE_HW_CRC32C_ARM
+#endif
+
+namespace HashUtils
+{
+    uint64_t XXH3_64(const void* data, std::size_t size, uint64_t seed)
+    {
+        return XXH3_64bits_withSeed(data, size, seed);
+    }
+
+    Hash128 XXH3_128(const void* data, std::size_t size, uint64_t seed)
+    {
+        const XXH128_hash_t hash = XXH3_128bits_withSeed(data, size, seed);
+        return Hash128{ hash.low64, hash.high64 };
+    }
+
+#if !defined(BBE_HW_CRC32C_X86) && !defined(BBE_HW_CRC32C_ARM)
+    // Reflected Castagnoli polynomial
+    static constexpr std::array<uint32_t, 256> GenerateCRC32CTable()
+    {
+        std::array<uint32_t, 256> table{};
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t crc = i;
+            for (uint32_t j = 0; j < 8; ++j)
+            {
+                crc = (crc >> 1) ^ ((crc & 1) ? 0x82F63B78 : 0);
+            }
+            table[i] = crc;
+        }
+        return table;
+    }
+    static constexpr std::array<uint32_t, 256> gs_CRC32CTable = GenerateCRC32CTable();
+#endif
+
+    uint32_t CRC32C(const void* data, std::size_t size, uint32_t crc)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        uint64_t c = ~crc;
+
+#if defined(BBE_HW_CRC32C_X86)
+        for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), bytes += sizeof(uint64_t))
+        {
+            uint64_t v;
+            memcpy(&v, bytes, sizeof(v));
+            c = _mm_crc32_u64(c, v);
+        }
+        for (; size > 0; --size, ++bytes)
+        {
+            c = _mm_crc32_u8((uint32_t)c, *bytes);
+        }
+#elif defined(BBE_HW_CRC32C_ARM)
+        for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), bytes += sizeof(uint64_t))
+        {
+            uint64_t v;
+            memcpy(&v, bytes, sizeof(v));
+            c = __crc32cd((uint32_t)c, v);
+        }
+        for (; size > 0; --size, ++bytes)
+        {
+            c = __crc32cb((uint32_t)c, *bytes);
+        }
+#else
+        for (; size > 0; --size, ++bytes)
+        {
+            c = gs_CRC32CTable[(c ^ *bytes) & 0xFF] ^ (c >> 8);
+        }
+#endif
+
+        return ~(uint32_t)c;
+    }
+
+    Hasher64::Hasher64(uint64_t seed)
+    {
+        XXH3_INITSTATE(&m_State);
+        XXH3_64bits_reset_withSeed(&m_State, seed);
+    }
+
+    void Hasher64::Update(const void* data, std::size_t size)
+    {
+        XXH3_64bits_update(&m_State, data, size);
+    }
+
+    uint64_t Hasher64::Finalize() const
+    {
+        return XXH3_64bits_digest(&m_State);
+    }
+
+    Hasher128::Hasher128(uint64_t seed)
+    {
+        XXH3_INITSTATE(&m_State);
+        XXH3_128bits_reset_withSeed(&m_State, seed);
+    }
+
+    void Hasher128::Update(const void* data, std::size_t size)
+    {
+        XXH3_128bits_update(&m_State, data, size);
+    }
+
+    Hash128 Hasher128::Finalize() const
+    {
+        const XXH128_hash_t hash = XXH3_128bits_digest(&m_State);
+        return Hash128{ hash.low64, hash.high64 };
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#define XXH_STATIC_LINKING_ONLY // for XXH3_state_t, so streaming hashers can live on the stack
+#include <extern/xxhash/xxhash.h>
+
+// Fast non-cryptographic hashing.
+// Results only depend on the input bytes and seed (never on pointers, platform or run), so they are safe to use as on-disk cache keys.
+struct Hash128
+{
+    uint64_t m_Low = 0;
+    uint64_t m_High = 0;
+
+    bool operator==(const Hash128& rhs) const { return m_Low == rhs.m_Low && m_High == rhs.m_High; }
+    bool operator!=(const Hash128& rhs) const { return !(*this == rhs); }
+};
+
+namespace HashUtils
+{
+    uint64_t XXH3_64(const void* data, std::size_t size, uint64_t seed = 0);
+    Hash128 XXH3_128(const void* data, std::size_t size, uint64_t seed = 0);
+
+    // Hardware accelerated when available (SSE4.2 / ARMv8 CRC). Pass the previous result as 'crc' to continue a checksum
+    uint32_t CRC32C(const void* data, std::size_t size, uint32_t crc = 0);
+
+    // Mixes a 64 bits value into a running hash. Much cheaper than XXH3 when combining a handful of already hashed values
+    constexpr uint64_t Combine(uint64_t seed, uint64_t value)
+    {
+        // boost style combine, followed by XXH3's rrmxmx avalanche
+        uint64_t h = seed ^ (value + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2));
+        h ^= (h << 49 | h >> 15) ^ (h << 24 | h >> 40);
+        h *= 0x9FB21C651E98DF25ULL;
+        h ^= (h >> 35) + 8;
+        h *= 0x9FB21C651E98DF25ULL;
+        return h ^ (h >> 28);
+    }
+
+    // Streaming XXH3. Same results as the one-shot versions for the same concatenated input
+    class Hasher64
+    {
+    public:
+        explicit Hasher64(uint64_t seed = 0);
+
+        void Update(const void* data, std::size_t size);
+
+        template <typename T>
+        void Update(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            Update(&value, sizeof(T));
+        }
+
+        uint64_t Finalize() const;
+
+    private:
+        XXH3_state_t m_State;
+    };
+
+    class Hasher128
+    {
+    public:
+        explicit Hasher128(uint64_t seed = 0);
+
+        void Update(const void* data, std::size_t size);
+
+        template <typename T>
+        void Update(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            Update(&value, sizeof(T));
+        }
+
+        Hash128 Finalize() const;
+
+    private:
+        XXH3_state_t m_State;
+    };
+}
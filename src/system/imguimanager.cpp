@@ -51,6 +51,10 @@ void IMGUIManager::ShutDown()
     bbeProfileFunction();
 
     ImGui::DestroyContext();
+
+    // release draw data before the frame arena goes away
+    m_DrawData[0] = IMGUIDrawData{};
+    m_DrawData[1] = IMGUIDrawData{};
 }
 
 void IMGUIManager::ProcessWindowsMessage(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
@@ -243,8 +247,15 @@ void IMGUIManager::Update()
 
     // This will back up the render data until the next frame.
     SaveDrawData();
+}
 
-    m_DrawDataIdx = 1 - m_DrawDataIdx;
+void IMGUIManager::EndFrame()
+{
+    if (m_NewDrawDataSaved)
+    {
+        m_DrawDataIdx = 1 - m_DrawDataIdx;
+        m_NewDrawDataSaved = false;
+    }
 }
 
 void IMGUIManager::RegisterWindowUpdateCB(const std::function<void()>& cb)
@@ -311,6 +322,7 @@ void IMGUIManager::SaveDrawData()
     }
 
     m_DrawData[1 - m_DrawDataIdx] = std::move(newDrawData);
+    m_NewDrawDataSaved = true;
 }
 
 ScopedIMGUIWindow::ScopedIMGUIWindow(const char* windowName)
@@ -1,15 +1,16 @@
 #pragma once
 
+// Draw data lives in the frame arena. It is produced in one frame and consumed at most in the next one
 struct IMGUICmdList
 {
-    std::vector<ImDrawVert> m_VB;
-    std::vector<ImDrawIdx> m_IB;
-    std::vector<ImDrawCmd> m_DrawCmd;
+    FrameVector<ImDrawVert> m_VB;
+    FrameVector<ImDrawIdx> m_IB;
+    FrameVector<ImDrawCmd> m_DrawCmd;
 };
 
 struct IMGUIDrawData
 {
-    std::vector<IMGUICmdList> m_DrawList;
+    FrameVector<IMGUICmdList> m_DrawList;
     uint32_t                  m_VtxCount = 0;
     uint32_t                  m_IdxCount = 0;
     bbeVector2                m_Pos      = bbeVector2::Zero;
@@ -28,6 +29,9 @@ public:
 
     void ProcessWindowsMessage(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
     void Update();
+
+    // Call once per frame, after all frame tasks are done. Hands the draw data saved by this frame's Update over to the next frame's renderer
+    void EndFrame();
     void RegisterWindowUpdateCB(const std::function<void()>&);
     void RegisterGeneralButtonCB(const std::function<void()>&, bool* triggerBool);
     void RegisterTopMenu(const std::string& mainCategory, const std::string& buttonName, bool* windowToggle = nullptr);
@@ -35,7 +39,7 @@ public:
 
 private:
     void SaveDrawData();
-    IMGUIDrawData GetDrawData() const { return m_DrawData[m_DrawDataIdx]; }
+    const IMGUIDrawData& GetDrawData() const { return m_DrawData[m_DrawDataIdx]; }
 
     bool m_ShowDemoWindow = false;
 
@@ -47,8 +51,10 @@ private:
 
     Timer m_Timer;
 
+    // The renderer reads m_DrawData[m_DrawDataIdx] for the whole frame, while Update fills the other one. Only flipped in EndFrame, when no frame task runs
     IMGUIDrawData m_DrawData[2];
     uint32_t m_DrawDataIdx = 0;
+    bool m_NewDrawDataSaved = false;
 
     friend class cereal::access;
     friend class GfxIMGUIRenderer;
@@ -0,0 +1,206 @@
+#include <system/lockcontention.h>
+
+#if defined(BBE_ENGINE)
+    #include <system/imguimanager.h>
+#endif
+
+#if defined(BBE_ENGINE)
+static bool gs_ShowLockContentionIMGUIWindow = false;
+#endif
+
+static uint32_t GetHoldTimeBucket(uint64_t holdNs)
+{
+    const uint64_t holdUs = holdNs / 1000;
+    if (holdUs == 0)
+        return 0;
+
+    uint32_t bucket = 1;
+    for (uint64_t v = holdUs; v > 1; v >>= 1)
+    {
+        ++bucket;
+    }
+    return std::min(bucket, LockContentionStats::NbHoldTimeBuckets - 1);
+}
+
+// Upper bound of a hold time bucket in us. Used to approximate percentiles from the histogram
+static uint64_t GetHoldTimeBucketUpperBoundUs(uint32_t bucket)
+{
+    return 1ULL << bucket;
+}
+
+static uint64_t GetHoldTimePercentileUs(const LockContentionStats& stats, double percentile)
+{
+    const uint64_t nbSamples = std::accumulate(std::begin(stats.m_HoldTimeHistogram), std::end(stats.m_HoldTimeHistogram), 0ULL, [](uint64_t acc, const std::atomic<uint64_t>& v) { return acc + v.load(std::memory_order_relaxed); });
+    const uint64_t targetSample = (uint64_t)(nbSamples * percentile);
+
+    uint64_t runningCount = 0;
+    for (uint32_t i = 0; i < LockContentionStats::NbHoldTimeBuckets; ++i)
+    {
+        runningCount += stats.m_HoldTimeHistogram[i].load(std::memory_order_relaxed);
+        if (runningCount > targetSample)
+            return GetHoldTimeBucketUpperBoundUs(i);
+    }
+    return 0;
+}
+
+void LockContentionStats::OnAcquire(bool contended, uint64_t waitNs)
+{
+    // For exclusive locks, only the holder touches these. No extra cache line bouncing on top of the lock itself
+    m_NbAcquisitions.fetch_add(1, std::memory_order_relaxed);
+
+    if (!contended)
+        return;
+
+    m_NbContendedAcquisitions.fetch_add(1, std::memory_order_relaxed);
+    m_TotalWaitNs.fetch_add(waitNs, std::memory_order_relaxed);
+
+    uint64_t prevMax = m_MaxWaitNs.load(std::memory_order_relaxed);
+    while (waitNs > prevMax && !m_MaxWaitNs.compare_exchange_weak(prevMax, waitNs, std::memory_order_relaxed)) {}
+}
+
+void LockContentionStats::OnRelease(uint64_t holdNs)
+{
+    m_HoldTimeHistogram[GetHoldTimeBucket(holdNs)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void LockContentionProfiler::Initialize()
+{
+#if defined(BBE_ENGINE)
+    g_IMGUIManager.RegisterTopMenu("System", "Lock Contention", &gs_ShowLockContentionIMGUIWindow);
+    g_IMGUIManager.RegisterWindowUpdateCB([&]() { UpdateIMGUI(); });
+#endif
+}
+
+LockContentionStats& LockContentionProfiler::GetStats(const char* lockName)
+{
+    // "queue.m_ListsLock" & "m_ListsLock" are the same lock as far as stats are concerned
+    std::string_view name{ lockName };
+    const size_t memberAccessPos = name.find_last_of(".>");
+    if (memberAccessPos != std::string_view::npos)
+    {
+        name.remove_prefix(memberAccessPos + 1);
+    }
+
+    std::lock_guard<std::mutex> lock{ m_AllStatsLock };
+
+    LockContentionStats*& stats = m_AllStats[std::string{ name }];
+    if (!stats)
+    {
+        stats = new LockContentionStats;
+        stats->m_Name = name;
+    }
+    return *stats;
+}
+
+void LockContentionProfiler::ResetAllStats()
+{
+    std::lock_guard<std::mutex> lock{ m_AllStatsLock };
+
+    for (auto& [name, stats] : m_AllStats)
+    {
+        stats->m_NbAcquisitions = 0;
+        stats->m_NbContendedAcquisitions = 0;
+        stats->m_TotalWaitNs = 0;
+        stats->m_MaxWaitNs = 0;
+        for (std::atomic<uint64_t>& bucket : stats->m_HoldTimeHistogram)
+        {
+            bucket = 0;
+        }
+    }
+}
+
+void LockContentionProfiler::WriteCSV(const char* filePath)
+{
+    CFileWrapper file{ filePath, false };
+    if (!file)
+    {
+        g_Log.error("LockContentionProfiler: failed to open '{}'", filePath);
+        return;
+    }
+
+    fprintf(file, "Lock,Acquisitions,Contended,Contended %%,Total Wait (ms),Max Wait (us),Hold p50 (us),Hold p99 (us)");
+    for (uint32_t i = 0; i < LockContentionStats::NbHoldTimeBuckets; ++i)
+    {
+        fprintf(file, ",Hold <%llu us", GetHoldTimeBucketUpperBoundUs(i));
+    }
+    fprintf(file, "\n");
+
+    std::lock_guard<std::mutex> lock{ m_AllStatsLock };
+
+    for (const auto& [name, stats] : m_AllStats)
+    {
+        const uint64_t nbAcquisitions = stats->m_NbAcquisitions;
+        const uint64_t nbContended = stats->m_NbContendedAcquisitions;
+
+        fprintf(file, "%s,%llu,%llu,%.2f,%.3f,%.1f,%llu,%llu", name.c_str(), nbAcquisitions, nbContended,
+                nbAcquisitions ? 100.0 * nbContended / nbAcquisitions : 0.0,
+                stats->m_TotalWaitNs / 1000000.0, stats->m_MaxWaitNs / 1000.0,
+                GetHoldTimePercentileUs(*stats, 0.5), GetHoldTimePercentileUs(*stats, 0.99));
+
+        for (const std::atomic<uint64_t>& bucket : stats->m_HoldTimeHistogram)
+        {
+            fprintf(file, ",%llu", bucket.load());
+        }
+        fprintf(file, "\n");
+    }
+
+    g_Log.info("Lock contention stats written to '{}'", filePath);
+}
+
+#if defined(BBE_ENGINE)
+void LockContentionProfiler::UpdateIMGUI()
+{
+    if (!gs_ShowLockContentionIMGUIWindow)
+        return;
+
+    ScopedIMGUIWindow window{ "Lock Contention" };
+
+    bool enabled = IsEnabled();
+    if (ImGui::Checkbox("Enabled", &enabled))
+    {
+        SetEnabled(enabled);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset"))
+    {
+        ResetAllStats();
+    }
+
+    // worst offenders first
+    InplaceArray<const LockContentionStats*, 32> sortedStats;
+    {
+        std::lock_guard<std::mutex> lock{ m_AllStatsLock };
+        for (const auto& [name, stats] : m_AllStats)
+        {
+            sortedStats.push_back(stats);
+        }
+    }
+    std::sort(sortedStats.begin(), sortedStats.end(), [](const LockContentionStats* lhs, const LockContentionStats* rhs) { return lhs->m_TotalWaitNs > rhs->m_TotalWaitNs; });
+
+    ImGui::Columns(7, "LockContentionColumns");
+    ImGui::Separator();
+    ImGui::Text("Lock");          ImGui::NextColumn();
+    ImGui::Text("Acquisitions");  ImGui::NextColumn();
+    ImGui::Text("Contended");     ImGui::NextColumn();
+    ImGui::Text("Total Wait");    ImGui::NextColumn();
+    ImGui::Text("Max Wait");      ImGui::NextColumn();
+    ImGui::Text("Hold p50");      ImGui::NextColumn();
+    ImGui::Text("Hold p99");      ImGui::NextColumn();
+    ImGui::Separator();
+
+    for (const LockContentionStats* stats : sortedStats)
+    {
+        const uint64_t nbAcquisitions = stats->m_NbAcquisitions;
+        const uint64_t nbContended = stats->m_NbContendedAcquisitions;
+
+        ImGui::Text("%s", stats->m_Name.c_str());                                                                        ImGui::NextColumn();
+        ImGui::Text("%llu", nbAcquisitions);                                                                             ImGui::NextColumn();
+        ImGui::Text("%llu (%.1f%%)", nbContended, nbAcquisitions ? 100.0 * nbContended / nbAcquisitions : 0.0);         ImGui::NextColumn();
+        ImGui::Text("%.3f ms", stats->m_TotalWaitNs / 1000000.0);                                                        ImGui::NextColumn();
+        ImGui::Text("%.1f us", stats->m_MaxWaitNs / 1000.0);                                                             ImGui::NextColumn();
+        ImGui::Text("< %llu us", GetHoldTimePercentileUs(*stats, 0.5));                                                  ImGui::NextColumn();
+        ImGui::Text("< %llu us", GetHoldTimePercentileUs(*stats, 0.99));                                                 ImGui::NextColumn();
+    }
+    ImGui::Columns(1);
+}
+#endif // #if defined(BBE_ENGINE)
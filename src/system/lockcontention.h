@@ -0,0 +1,91 @@
+#pragma once
+
+// Per-lock contention statistics, gathered by the bbeAutoLock* macros when BBE_LOCK_CONTENTION_STATS is defined and the profiler is enabled (--lockcontention).
+// Stats are keyed by lock name, so every call site locking "m_ListsLock" adds to the same entry.
+struct LockContentionStats
+{
+    // Bucket 0: < 1us. Bucket i: [2^(i-1), 2^i) us. Last bucket: everything above
+    static const uint32_t NbHoldTimeBuckets = 16;
+
+    void OnAcquire(bool contended, uint64_t waitNs);
+    void OnRelease(uint64_t holdNs);
+
+    std::string m_Name;
+    std::atomic<uint64_t> m_NbAcquisitions = 0;
+    std::atomic<uint64_t> m_NbContendedAcquisitions = 0;
+    std::atomic<uint64_t> m_TotalWaitNs = 0;
+    std::atomic<uint64_t> m_MaxWaitNs = 0;
+    std::atomic<uint64_t> m_HoldTimeHistogram[NbHoldTimeBuckets] = {};
+};
+
+class LockContentionProfiler
+{
+    DeclareSingletonFunctions(LockContentionProfiler);
+
+public:
+    static void SetEnabled(bool enabled) { ms_Enabled.store(enabled, std::memory_order_relaxed); }
+    static bool IsEnabled() { return ms_Enabled.load(std::memory_order_relaxed); }
+
+    static uint64_t GetTimeNs() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+    // Called once per call site (cached in a function static by the lock macros)
+    LockContentionStats& GetStats(const char* lockName);
+
+    void Initialize();
+    void ResetAllStats();
+    void WriteCSV(const char* filePath);
+    void UpdateIMGUI();
+
+private:
+    // Opt-in: when disabled, instrumented locks only pay for this flag's load
+    inline static std::atomic<bool> ms_Enabled = false;
+
+    // Plain mutex: a bbeAutoLock here would recurse into GetStats
+    std::mutex m_AllStatsLock;
+    // Never freed: lock call sites cache references to their stats in function statics, which can still be used during static destruction
+    std::map<std::string, LockContentionStats*> m_AllStats;
+};
+#define g_LockContentionProfiler LockContentionProfiler::GetInstance()
+
+// Lives on the stack for the duration of a bbeAutoLock* scope, to measure wait & hold times
+class LockContentionScope
+{
+public:
+    LockContentionScope(LockContentionStats& stats) : m_Stats(stats) {}
+
+    template <typename TryLockFunc, typename LockFunc>
+    void Acquire(TryLockFunc&& tryLockFunc, LockFunc&& lockFunc)
+    {
+        if (!LockContentionProfiler::IsEnabled())
+        {
+            lockFunc();
+            return;
+        }
+
+        // only pay for the extra timestamp when we actually have to wait
+        if (tryLockFunc())
+        {
+            m_AcquiredNs = LockContentionProfiler::GetTimeNs();
+            m_Stats.OnAcquire(false, 0);
+            return;
+        }
+
+        const uint64_t waitBeginNs = LockContentionProfiler::GetTimeNs();
+        lockFunc();
+        m_AcquiredNs = LockContentionProfiler::GetTimeNs();
+        m_Stats.OnAcquire(true, m_AcquiredNs - waitBeginNs);
+    }
+
+    void Release()
+    {
+        if (m_AcquiredNs)
+        {
+            m_Stats.OnRelease(LockContentionProfiler::GetTimeNs() - m_AcquiredNs);
+            m_AcquiredNs = 0;
+        }
+    }
+
+private:
+    LockContentionStats& m_Stats;
+    uint64_t m_AcquiredNs = 0;
+};
@@ -0,0 +1,205 @@
+#include "system/logger.h"
+
+// How long the BG thread sleeps between batches, unless woken up by a thread whose ring is filling up
+static const std::chrono::milliseconds gs_LoggerBatchInterval{ 10 };
+
+thread_local std::shared_ptr<Logger::ThreadLogRing> Logger::ms_ThreadLogRing;
+
+void Logger::Initialize(const char* path, bool async, OverflowPolicy overflowPolicy)
+{
+    m_Logger = spdlog::basic_logger_mt("file_logger", path, true);
+    spdlog::set_pattern("[%H:%M:%S] [%^%L%$] %v");
+
+    m_Async.store(async, std::memory_order_release);
+    m_OverflowPolicy = overflowPolicy;
+
+    if (!async)
+    {
+        m_Logger->flush_on(spdlog::level::level_enum::trace);
+        return;
+    }
+
+    m_BGThread = std::thread{ [this] { BGThreadLoop(); } };
+
+    // make sure nothing is lost if the app calls exit() without going through ShutDown
+    std::atexit([] { g_Log.Flush(); });
+}
+
+void Logger::ShutDown()
+{
+    // anything logged from here on is written synchronously
+    if (!m_Async.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock{ m_BGThreadLock };
+        m_BGThreadExit = true;
+    }
+    m_BGThreadCV.notify_one();
+    m_BGThread.join();
+
+    bbeAutoLock(m_DrainLock);
+    DrainAllRings();
+    m_Logger->flush_on(spdlog::level::level_enum::trace);
+
+    // Release all rings. Threads still alive only keep theirs until they log asynchronously again, which gives them a new one
+    {
+        bbeAutoLock(m_RingsLock);
+        m_AllRings.clear();
+        ++m_RingsGeneration;
+    }
+    ms_ThreadLogRing.reset();
+}
+
+void Logger::Flush()
+{
+    if (!m_Async.load(std::memory_order_acquire))
+    {
+        m_Logger->flush();
+        return;
+    }
+
+    bbeAutoLock(m_DrainLock);
+    DrainAllRings();
+}
+
+uint32_t Logger::GetNbThreadLogRings()
+{
+    bbeAutoLock(m_RingsLock);
+    return (uint32_t)m_AllRings.size();
+}
+
+Logger::ThreadLogRing& Logger::GetThreadLogRing()
+{
+    const uint32_t generation = m_RingsGeneration.load(std::memory_order_relaxed);
+    if (!ms_ThreadLogRing || ms_ThreadLogRing->m_Generation != generation)
+    {
+        std::shared_ptr<ThreadLogRing> newRing = std::make_shared<ThreadLogRing>();
+        newRing->m_Generation = generation;
+        ms_ThreadLogRing = newRing;
+
+        bbeAutoLock(m_RingsLock);
+        m_AllRings.push_back(std::move(newRing));
+    }
+
+    return *ms_ThreadLogRing;
+}
+
+Logger::LogRecord* Logger::BeginRecord()
+{
+    ThreadLogRing& ring = GetThreadLogRing();
+    const uint32_t writeIdx = ring.m_WriteIdx.load(std::memory_order_relaxed);
+
+    while (writeIdx - ring.m_ReadIdx.load(std::memory_order_acquire) >= ThreadLogRing::NbRecords)
+    {
+        if (m_OverflowPolicy == Drop)
+        {
+            ++m_NbDroppedRecords;
+            return nullptr;
+        }
+
+        m_BGThreadCV.notify_one();
+        std::this_thread::yield();
+    }
+
+    return &ring.m_Records[writeIdx % ThreadLogRing::NbRecords];
+}
+
+void Logger::CommitRecord()
+{
+    // same ring as BeginRecord
+    ThreadLogRing& ring = *ms_ThreadLogRing;
+    const uint32_t writeIdx = ring.m_WriteIdx.load(std::memory_order_relaxed) + 1;
+    ring.m_WriteIdx.store(writeIdx, std::memory_order_release);
+
+    // wake up BG thread early if this ring is filling up
+    if (writeIdx - ring.m_ReadIdx.load(std::memory_order_relaxed) >= ThreadLogRing::NbRecords / 2)
+    {
+        m_BGThreadCV.notify_one();
+    }
+}
+
+void Logger::DrainAllRings()
+{
+    // m_DrainLock must be held by caller
+
+    struct RingReadRange
+    {
+        ThreadLogRing* m_Ring;
+        uint32_t m_End;
+    };
+    InplaceArray<RingReadRange, 64> ringRanges;
+
+    m_DrainBatch.clear();
+    {
+        bbeAutoLock(m_RingsLock);
+        for (uint32_t ringIdx = 0; ringIdx < m_AllRings.size();)
+        {
+            ThreadLogRing* ring = m_AllRings[ringIdx].get();
+            const uint32_t readIdx = ring->m_ReadIdx.load(std::memory_order_relaxed);
+            const uint32_t writeIdx = ring->m_WriteIdx.load(std::memory_order_acquire);
+
+            // only referenced here: its thread exited. Free it once everything it logged has been written
+            if (readIdx == writeIdx && m_AllRings[ringIdx].use_count() == 1)
+            {
+                m_AllRings[ringIdx] = std::move(m_AllRings.back());
+                m_AllRings.pop_back();
+                continue;
+            }
+
+            for (uint32_t i = readIdx; i != writeIdx; ++i)
+            {
+                m_DrainBatch.push_back(&ring->m_Records[i % ThreadLogRing::NbRecords]);
+            }
+            ringRanges.push_back({ ring, writeIdx });
+            ++ringIdx;
+        }
+    }
+
+    if (m_DrainBatch.empty())
+        return;
+
+    // records from different threads are interleaved by time of the log call
+    std::stable_sort(m_DrainBatch.begin(), m_DrainBatch.end(), [](const LogRecord* lhs, const LogRecord* rhs) { return lhs->m_Time < rhs->m_Time; });
+
+    for (LogRecord* record : m_DrainBatch)
+    {
+        m_FormatBuffer.clear();
+        record->m_FormatFunc(*record, m_FormatBuffer);
+
+        const spdlog::details::log_msg msg{ record->m_Time, spdlog::source_loc{}, m_Logger->name(), record->m_Level, spdlog::string_view_t{ m_FormatBuffer.data(), m_FormatBuffer.size() } };
+        for (const spdlog::sink_ptr& sink : m_Logger->sinks())
+        {
+            if (sink->should_log(record->m_Level))
+                sink->log(msg);
+        }
+    }
+
+    // release ring slots only after the records are formatted, since they were read inplace
+    for (const RingReadRange& range : ringRanges)
+    {
+        range.m_Ring->m_ReadIdx.store(range.m_End, std::memory_order_release);
+    }
+
+    for (const spdlog::sink_ptr& sink : m_Logger->sinks())
+    {
+        sink->flush();
+    }
+}
+
+void Logger::BGThreadLoop()
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock{ m_BGThreadLock };
+            if (m_BGThreadExit)
+                return;
+
+            m_BGThreadCV.wait_for(lock, gs_LoggerBatchInterval);
+        }
+
+        bbeAutoLock(m_DrainLock);
+        DrainAllRings();
+    }
+}
@@ -2,21 +2,158 @@
 
 #include "system/utils.h"
 
+namespace LoggerPrivate
+{
+    // Strings are copied into the record, because the caller's buffer will most likely be gone by the time the record is formatted
+    template <typename T>
+    struct LogArgCapture { using Type = std::decay_t<T>; };
+
+    template <> struct LogArgCapture<char*>            { using Type = std::string; };
+    template <> struct LogArgCapture<const char*>      { using Type = std::string; };
+    template <> struct LogArgCapture<std::string_view> { using Type = std::string; };
+
+    template <typename T>
+    using LogArgCaptureType = typename LogArgCapture<std::decay_t<T>>::Type;
+}
+
 class Logger
 {
     DeclareSingletonFunctions(Logger);
 
 public:
-    void Initialize(const char* path)
-    {
-        m_Logger = spdlog::basic_logger_mt("file_logger", path, true);
-        m_Logger->flush_on(spdlog::level::level_enum::trace);
-        spdlog::set_pattern("[%H:%M:%S] [%^%L%$] %v");
-    }
+    using Level = spdlog::level::level_enum;
+
+    // When the thread's ring is full: Drop the record, or Block until the BG thread frees up space
+    enum OverflowPolicy { Drop, Block };
+
+    void Initialize(const char* path, bool async = true, OverflowPolicy overflowPolicy = Block);
+    void ShutDown();
+
+    // Synchronously formats and writes all pending records. Safe to call from any thread (i.e. before crashing/asserting)
+    void Flush();
+
+    template <typename... Args> void trace(const char* format, Args&&... args)    { Log(Level::trace, format, std::forward<Args>(args)...); }
+    template <typename... Args> void debug(const char* format, Args&&... args)    { Log(Level::debug, format, std::forward<Args>(args)...); }
+    template <typename... Args> void info(const char* format, Args&&... args)     { Log(Level::info, format, std::forward<Args>(args)...); }
+    template <typename... Args> void warn(const char* format, Args&&... args)     { Log(Level::warn, format, std::forward<Args>(args)...); }
+    template <typename... Args> void error(const char* format, Args&&... args)    { Log(Level::err, format, std::forward<Args>(args)...); }
+    template <typename... Args> void critical(const char* format, Args&&... args) { Log(Level::critical, format, std::forward<Args>(args)...); }
+
+    template <typename... Args>
+    void Log(Level level, const char* format, Args&&... args);
+
+    uint64_t GetNbDroppedRecords() const { return m_NbDroppedRecords; }
+    uint32_t GetNbThreadLogRings();
 
     spdlog::logger& GetLoggerInternal() { return *m_Logger; }
 
 private:
+    static const uint32_t RecordArgsSize = 192;
+
+    // Compact record: format string ptr + args captured by value. Formatting is deferred to the BG thread
+    struct LogRecord
+    {
+        using FormatFunc = void(*)(LogRecord&, fmt::memory_buffer&);
+
+        FormatFunc m_FormatFunc = nullptr;
+        const char* m_Format = nullptr;
+        Level m_Level = Level::info;
+        spdlog::log_clock::time_point m_Time;
+        alignas(16) std::byte m_Args[RecordArgsSize];
+    };
+
+    // Single-producer/single-consumer ring. One per thread that logs
+    struct ThreadLogRing
+    {
+        static const uint32_t NbRecords = 512;
+
+        LogRecord m_Records[NbRecords];
+        alignas(64) std::atomic<uint32_t> m_WriteIdx = 0;
+        alignas(64) std::atomic<uint32_t> m_ReadIdx = 0;
+        uint32_t m_Generation = 0;
+    };
+
+    template <typename ArgsTuple>
+    static void FormatRecord(LogRecord& record, fmt::memory_buffer& buffer);
+
+    LogRecord* BeginRecord();
+    void CommitRecord();
+    ThreadLogRing& GetThreadLogRing();
+    void DrainAllRings();
+    void BGThreadLoop();
+
     std::shared_ptr<spdlog::logger> m_Logger;
+
+    std::atomic<bool> m_Async = false;
+    OverflowPolicy m_OverflowPolicy = Block;
+    std::atomic<uint64_t> m_NbDroppedRecords = 0;
+
+    // Shared between the logging thread & the logger. A ring is freed once drained after its thread exited, or at ShutDown
+    static thread_local std::shared_ptr<ThreadLogRing> ms_ThreadLogRing;
+
+    std::mutex m_RingsLock;
+    std::vector<std::shared_ptr<ThreadLogRing>> m_AllRings;
+    std::atomic<uint32_t> m_RingsGeneration = 0;
+
+    // Held by whoever is formatting & writing records (BG thread or Flush)
+    std::mutex m_DrainLock;
+    std::vector<LogRecord*> m_DrainBatch;
+    fmt::memory_buffer m_FormatBuffer;
+
+    std::mutex m_BGThreadLock;
+    std::condition_variable m_BGThreadCV;
+    bool m_BGThreadExit = false;
+    std::thread m_BGThread;
 };
-#define g_Log Logger::GetInstance().GetLoggerInternal()
+#define g_Log Logger::GetInstance()
+
+template <typename ArgsTuple>
+void Logger::FormatRecord(LogRecord& record, fmt::memory_buffer& buffer)
+{
+    ArgsTuple& args = *reinterpret_cast<ArgsTuple*>(record.m_Args);
+
+    try
+    {
+        std::apply([&](const auto&... unpackedArgs) { fmt::format_to(buffer, record.m_Format, unpackedArgs...); }, args);
+    }
+    catch (const std::exception& e)
+    {
+        fmt::format_to(buffer, "[Logger] Failed to format '{}': {}", record.m_Format, e.what());
+    }
+
+    args.~ArgsTuple();
+}
+
+template <typename... Args>
+void Logger::Log(Level level, const char* format, Args&&... args)
+{
+    if (!m_Async.load(std::memory_order_acquire))
+    {
+        m_Logger->log(level, format, std::forward<Args>(args)...);
+        return;
+    }
+
+    using ArgsTuple = std::tuple<LoggerPrivate::LogArgCaptureType<Args>...>;
+
+    if constexpr (sizeof(ArgsTuple) > RecordArgsSize || alignof(ArgsTuple) > 16)
+    {
+        // args too big to fit in a record. Format them now and defer the resulting string instead
+        fmt::memory_buffer buffer;
+        fmt::format_to(buffer, format, args...);
+        Log(level, "{}", std::string{ buffer.data(), buffer.size() });
+    }
+    else
+    {
+        LogRecord* record = BeginRecord();
+        if (!record)
+            return;
+
+        record->m_FormatFunc = &FormatRecord<ArgsTuple>;
+        record->m_Format = format;
+        record->m_Level = level;
+        record->m_Time = spdlog::log_clock::now();
+        new (record->m_Args) ArgsTuple{ LoggerPrivate::LogArgCaptureType<Args>(std::forward<Args>(args))... };
+
+        CommitRecord();
+    }
+}
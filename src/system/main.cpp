@@ -137,5 +137,7 @@ int APIENTRY WinMain(::HINSTANCE hInstance,
     }
 #endif
 
+    Logger::GetInstance().ShutDown();
+
     return 0;
 }
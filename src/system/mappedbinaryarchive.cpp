@@ -0,0 +1,160 @@
+#include <system/mappedbinaryarchive.h>
+
+MappedBinaryOutputArchive::MappedBinaryOutputArchive(const char* filePath)
+    : cereal::OutputArchive<MappedBinaryOutputArchive, cereal::AllowEmptyClassElision>(this)
+{
+    m_File.Init(StringUtils::Utf8ToWide(filePath));
+    if (!m_File.IsMapped())
+        return;
+
+    // always start from scratch. The file is never shrunk, the size in the file header tells where the payload ends
+    m_File.SetSize(0);
+
+    const MappedBinaryArchiveHeader header;
+    SaveBinary(&header, sizeof(header));
+}
+
+MappedBinaryOutputArchive::~MappedBinaryOutputArchive()
+{
+    if (m_File.IsMapped())
+    {
+        m_File.SetSize(m_Offset);
+        m_File.Destroy(false);
+    }
+}
+
+std::byte* MappedBinaryOutputArchive::Reserve(std::size_t size)
+{
+    assert(IsValid());
+
+    // geometric growth, so the mapping is rarely re-created
+    if (!m_File.GrowMapping(m_Offset + size))
+    {
+        // drop the archive: the payload size in the file header is still 0, so it won't be read back half written
+        m_File.Destroy(false);
+        return nullptr;
+    }
+
+    std::byte* dest = static_cast<std::byte*>(m_File.GetData()) + m_Offset;
+    m_Offset += size;
+    return dest;
+}
+
+void MappedBinaryOutputArchive::SaveBinary(const void* data, std::size_t size)
+{
+    if (!IsValid() || size == 0)
+        return;
+
+    std::byte* dest = Reserve(size);
+    if (!dest)
+        return;
+
+    // don't pay the dispatch cost for the typical scalar sized writes
+    if (size <= sizeof(bbeVector4))
+        memcpy(dest, data, size);
+    else
+        SIMDMemCopy(dest, data, size);
+}
+
+void MappedBinaryOutputArchive::AlignTo(uint32_t alignment)
+{
+    if (!IsValid())
+        return;
+
+    const uint64_t padding = AlignUp(m_Offset, alignment) - m_Offset;
+    if (padding > 0)
+    {
+        if (std::byte* dest = Reserve(padding))
+            memset(dest, 0, padding);
+    }
+}
+
+MappedBinaryInputArchive::MappedBinaryInputArchive(const char* filePath)
+    : cereal::InputArchive<MappedBinaryInputArchive, cereal::AllowEmptyClassElision>(this)
+{
+    // not an error. Callers typically fall back to defaults when there's nothing saved yet
+    std::error_code errorCode;
+    if (!std::filesystem::exists(filePath, errorCode))
+        return;
+
+    m_File.Init(StringUtils::Utf8ToWide(filePath), 0, MemoryMappedFile::Mode::ReadOnly, MemoryMappedFile::AccessHint::Sequential);
+    if (!m_File.IsMapped())
+        return;
+
+    const std::byte* data = static_cast<const std::byte*>(m_File.GetData());
+    const uint64_t size = m_File.GetSize();
+
+    MappedBinaryArchiveHeader header;
+    if (size < sizeof(header))
+    {
+        g_Log.error("MappedBinaryInputArchive: '{}' is truncated", filePath);
+        return;
+    }
+
+    memcpy(&header, data, sizeof(header));
+
+    const MappedBinaryArchiveHeader expected;
+    if (header.m_Magic != expected.m_Magic || header.m_Version != expected.m_Version || header.m_ArrayAlignment != expected.m_ArrayAlignment || header.m_PointerSize != expected.m_PointerSize)
+    {
+        g_Log.warn("MappedBinaryInputArchive: '{}' has an outdated layout (version {}), ignoring it", filePath, header.m_Version);
+        return;
+    }
+
+    m_Data = data;
+    m_Size = size;
+    m_Offset = sizeof(header);
+
+    // start paging in while the caller does the first reads
+    m_File.Prefetch(0, size);
+}
+
+MappedBinaryInputArchive::~MappedBinaryInputArchive()
+{
+    if (m_File.IsMapped())
+    {
+        m_File.Destroy(false);
+    }
+}
+
+const std::byte* MappedBinaryInputArchive::LoadInPlace(std::size_t size)
+{
+    assert(IsValid());
+
+    if (m_Offset + size > m_Size)
+    {
+        assert(false);
+        throw cereal::Exception(StringFormat("MappedBinaryInputArchive: reading %llu bytes past the end of the archive", (uint64_t)(m_Offset + size - m_Size)));
+    }
+
+    const std::byte* src = m_Data + m_Offset;
+    m_Offset += size;
+    return src;
+}
+
+void MappedBinaryInputArchive::CheckRemainingElements(uint64_t count, std::size_t elementSize) const
+{
+    // division, so huge counts can't overflow
+    // corrupted files are a runtime error, not a bug: no assert, callers catch it
+    if (count > GetNbRemainingBytes() / elementSize)
+    {
+        throw cereal::Exception(StringFormat("MappedBinaryInputArchive: %llu elements of %llu bytes don't fit in the %llu bytes left in the archive", count, (uint64_t)elementSize, GetNbRemainingBytes()));
+    }
+}
+
+void MappedBinaryInputArchive::LoadBinary(void* data, std::size_t size)
+{
+    if (size == 0)
+        return;
+
+    const std::byte* src = LoadInPlace(size);
+
+    if (size <= sizeof(bbeVector4))
+        memcpy(data, src, size);
+    else
+        SIMDMemCopy(data, src, size);
+}
+
+void MappedBinaryInputArchive::AlignTo(uint32_t alignment)
+{
+    m_Offset = AlignUp(m_Offset, alignment);
+}
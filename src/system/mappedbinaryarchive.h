@@ -0,0 +1,187 @@
+#pragma once
+
+#include <system/memorymappedfile.h>
+
+// Types whose in-memory representation is also their binary archive representation.
+// Arrays of them are written & read with a single copy, and can be viewed in place with MappedArrayView
+template <typename T>
+struct IsMemcpySerializable : std::bool_constant<(std::is_arithmetic_v<T> || std::is_enum_v<T>) && !std::is_same_v<T, bool>> {};
+
+// Opt-in for trivially copyable structs. Don't use for types containing pointers or handles
+#define DeclareMemcpySerializable(Type)                                                                 \
+template <> struct IsMemcpySerializable<Type> : std::true_type                                          \
+{                                                                                                       \
+    static_assert(std::is_trivially_copyable_v<Type>, bbeTOSTRING(Type) " must be trivially copyable"); \
+}
+
+// Read-only view of an array stored in a MappedBinaryInputArchive. Points straight into the mapped file, so it's only valid while the archive is alive.
+// Same layout as std::vector<T> in the archive, so either can be written and the other read back
+template <typename T>
+struct MappedArrayView
+{
+    static_assert(IsMemcpySerializable<T>::value);
+
+    const T* m_Data = nullptr;
+    uint64_t m_Size = 0;
+
+    const T* begin() const { return m_Data; }
+    const T* end() const { return m_Data + m_Size; }
+    const T& operator[](uint64_t i) const { assert(i < m_Size); return m_Data[i]; }
+};
+
+// Binary archive layout in the mapped file payload: [ArchiveHeader][data...]
+// Every memcpy-able array is aligned to 'ArrayAlignment' relative to the payload start (which is itself 16 bytes aligned in memory)
+struct MappedBinaryArchiveHeader
+{
+    static const uint32_t Magic = 0x41454242; // "BBEA"
+    static const uint32_t Version = 1;
+    static const uint32_t ArrayAlignment = 16;
+
+    uint32_t m_Magic = Magic;
+    uint32_t m_Version = Version;
+    uint32_t m_ArrayAlignment = ArrayAlignment;
+    uint32_t m_PointerSize = sizeof(void*);
+};
+static_assert(sizeof(MappedBinaryArchiveHeader) == 16);
+
+class MappedBinaryOutputArchive : public cereal::OutputArchive<MappedBinaryOutputArchive, cereal::AllowEmptyClassElision>
+{
+public:
+    explicit MappedBinaryOutputArchive(const char* filePath);
+    ~MappedBinaryOutputArchive();
+
+    bool IsValid() const { return m_File.IsMapped(); }
+
+    void SaveBinary(const void* data, std::size_t size);
+
+    // Pads with zeros up to the next 'alignment' offset
+    void AlignTo(uint32_t alignment);
+
+private:
+    std::byte* Reserve(std::size_t size);
+
+    MemoryMappedFile m_File;
+    uint64_t m_Offset = 0;
+};
+
+class MappedBinaryInputArchive : public cereal::InputArchive<MappedBinaryInputArchive, cereal::AllowEmptyClassElision>
+{
+public:
+    explicit MappedBinaryInputArchive(const char* filePath);
+    ~MappedBinaryInputArchive();
+
+    // False if the file doesn't exist, or was written with a different layout version
+    bool IsValid() const { return m_Data != nullptr; }
+
+    void LoadBinary(void* data, std::size_t size);
+
+    // Returns a pointer to the next 'size' bytes in the mapped file, and skips them
+    const std::byte* LoadInPlace(std::size_t size);
+
+    void AlignTo(uint32_t alignment);
+
+    uint64_t GetNbRemainingBytes() const { return m_Offset < m_Size ? m_Size - m_Offset : 0; }
+
+    // Throws if 'count' elements of 'elementSize' bytes can't be in the rest of the archive. For element counts read from the file, before allocating anything
+    void CheckRemainingElements(uint64_t count, std::size_t elementSize) const;
+
+private:
+    MemoryMappedFile m_File;
+    const std::byte* m_Data = nullptr;
+    uint64_t m_Size = 0;
+    uint64_t m_Offset = 0;
+};
+
+namespace cereal
+{
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic_v<T>> CEREAL_SAVE_FUNCTION_NAME(MappedBinaryOutputArchive& ar, const T& t)
+    {
+        ar.SaveBinary(std::addressof(t), sizeof(t));
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic_v<T>> CEREAL_LOAD_FUNCTION_NAME(MappedBinaryInputArchive& ar, T& t)
+    {
+        ar.LoadBinary(std::addressof(t), sizeof(t));
+    }
+
+    template <typename Archive, typename T>
+    CEREAL_ARCHIVE_RESTRICT(MappedBinaryInputArchive, MappedBinaryOutputArchive)
+    CEREAL_SERIALIZE_FUNCTION_NAME(Archive& ar, NameValuePair<T>& t)
+    {
+        ar(t.value);
+    }
+
+    template <typename Archive, typename T>
+    CEREAL_ARCHIVE_RESTRICT(MappedBinaryInputArchive, MappedBinaryOutputArchive)
+    CEREAL_SERIALIZE_FUNCTION_NAME(Archive& ar, SizeTag<T>& t)
+    {
+        ar(t.size);
+    }
+
+    template <typename T>
+    void CEREAL_SAVE_FUNCTION_NAME(MappedBinaryOutputArchive& ar, const BinaryData<T>& bd)
+    {
+        ar.SaveBinary(bd.data, static_cast<std::size_t>(bd.size));
+    }
+
+    template <typename T>
+    void CEREAL_LOAD_FUNCTION_NAME(MappedBinaryInputArchive& ar, BinaryData<T>& bd)
+    {
+        ar.LoadBinary(bd.data, static_cast<std::size_t>(bd.size));
+    }
+
+    // Memcpy-able arrays: [element count][padding][elements], one copy each way.
+    // More specialized than cereal's generic std::vector overloads, so these win for the mapped archive
+    template <typename T>
+    void SaveMemcpyArray(MappedBinaryOutputArchive& ar, const T* data, uint64_t size)
+    {
+        static_assert(alignof(T) <= MappedBinaryArchiveHeader::ArrayAlignment);
+
+        ar(make_size_tag(static_cast<size_type>(size)));
+        ar.AlignTo(MappedBinaryArchiveHeader::ArrayAlignment);
+        ar.SaveBinary(data, size * sizeof(T));
+    }
+
+    template <typename T, typename A>
+    std::enable_if_t<IsMemcpySerializable<T>::value> CEREAL_SAVE_FUNCTION_NAME(MappedBinaryOutputArchive& ar, const std::vector<T, A>& vector)
+    {
+        SaveMemcpyArray(ar, vector.data(), vector.size());
+    }
+
+    template <typename T, typename A>
+    std::enable_if_t<IsMemcpySerializable<T>::value> CEREAL_LOAD_FUNCTION_NAME(MappedBinaryInputArchive& ar, std::vector<T, A>& vector)
+    {
+        size_type size = 0;
+        ar(make_size_tag(size));
+        ar.AlignTo(MappedBinaryArchiveHeader::ArrayAlignment);
+
+        // a corrupted count must not turn into a huge allocation
+        ar.CheckRemainingElements(size, sizeof(T));
+        vector.resize(static_cast<std::size_t>(size));
+        ar.LoadBinary(vector.data(), static_cast<std::size_t>(size) * sizeof(T));
+    }
+
+    template <typename T>
+    void CEREAL_SAVE_FUNCTION_NAME(MappedBinaryOutputArchive& ar, const MappedArrayView<T>& view)
+    {
+        SaveMemcpyArray(ar, view.m_Data, view.m_Size);
+    }
+
+    template <typename T>
+    void CEREAL_LOAD_FUNCTION_NAME(MappedBinaryInputArchive& ar, MappedArrayView<T>& view)
+    {
+        size_type size = 0;
+        ar(make_size_tag(size));
+        ar.AlignTo(MappedBinaryArchiveHeader::ArrayAlignment);
+
+        ar.CheckRemainingElements(size, sizeof(T));
+        view.m_Size = size;
+        view.m_Data = reinterpret_cast<const T*>(ar.LoadInPlace(static_cast<std::size_t>(size) * sizeof(T)));
+    }
+}
+
+CEREAL_REGISTER_ARCHIVE(MappedBinaryOutputArchive)
+CEREAL_REGISTER_ARCHIVE(MappedBinaryInputArchive)
+CEREAL_SETUP_ARCHIVE_TRAITS(MappedBinaryInputArchive, MappedBinaryOutputArchive)
@@ -1,5 +1,7 @@
 #pragma once
 
+// Tests build without DirectXMath (i.e. on Linux). tests/testpch.h provides plain layouts for the vector types instead
+#if !defined(BBE_TESTS)
 using bbeVector2    = DirectX::SimpleMath::Vector2;
 using bbeVector2I   = DirectX::XMINT2;
 using bbeVector2U   = DirectX::XMUINT2;
@@ -49,6 +51,7 @@ static bbeVector4 Normalize3(const bbeVector4& v4)
     v3.Normalize();
     return bbeVector4{ v3.x, v3.y, v3.z, 1.0f };
 }
+#endif // #if !defined(BBE_TESTS)
 
 #define bbeBIG_Float (1e10f) // use instead of FLT_MAX when overflowing is a concern
 
@@ -159,8 +162,10 @@ constexpr uint32_t bbeGetLog2(uint32_t val)
     return val;
 }
 
+#if !defined(BBE_TESTS)
 bbeMatrix CreateLookAtLH(const bbeVector3& position, const bbeVector3& target, const bbeVector3& up);
 bbeMatrix CreatePerspectiveFieldOfViewLH(float fov, float aspectRatio, float nearPlane, float farPlane);
+#endif
 
 #define bbePI           3.1415926535897932384626433832795f
 #define bbe2PI          6.2831853071795864769252867665590f
@@ -1,120 +1,327 @@
+#include <system/memcpy.h>
 
-// A faster version of memcopy that uses SSE instructions
-void SIMDMemCopy(void* __restrict _Dest, const void* __restrict _Source, size_t NumQuadwords)
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#else
+    #include <cpuid.h>
+#endif
+
+// MSVC lets us use any intrinsic regardless of /arch. Other compilers only get the instruction sets they're allowed to emit
+#if defined(_MSC_VER) || defined(__AVX2__)
+    #define BBE_MEMCPY_AVX2
+#endif
+#if defined(_MSC_VER) || defined(__AVX512F__)
+    #define BBE_MEMCPY_AVX512
+#endif
+
+// Below this, the CRT memcpy is as good as it gets
+static const size_t gs_SmallCopySize = 256;
+
+namespace MemCopyPrivate
 {
-    assert(bbeIsAligned(_Dest, 16));
-    assert(bbeIsAligned(_Source, 16));
+    struct SSE2
+    {
+        using Vec = __m128i;
+        static const size_t Size = sizeof(Vec);
 
-    __m128i* __restrict Dest = (__m128i * __restrict)_Dest;
-    const __m128i* __restrict Source = (const __m128i * __restrict)_Source;
+        static Vec LoadU(const std::byte* p)      { return _mm_loadu_si128((const Vec*)p); }
+        static void StoreU(std::byte* p, Vec v)   { _mm_storeu_si128((Vec*)p, v); }
+        static void Store(std::byte* p, Vec v)    { _mm_store_si128((Vec*)p, v); }
+        static void Stream(std::byte* p, Vec v)   { _mm_stream_si128((Vec*)p, v); }
+        static Vec Broadcast16(const std::byte* p) { return LoadU(p); }
+    };
+
+#if defined(BBE_MEMCPY_AVX2)
+    struct AVX2
+    {
+        using Vec = __m256i;
+        static const size_t Size = sizeof(Vec);
+
+        static Vec LoadU(const std::byte* p)      { return _mm256_loadu_si256((const Vec*)p); }
+        static void StoreU(std::byte* p, Vec v)   { _mm256_storeu_si256((Vec*)p, v); }
+        static void Store(std::byte* p, Vec v)    { _mm256_store_si256((Vec*)p, v); }
+        static void Stream(std::byte* p, Vec v)   { _mm256_stream_si256((Vec*)p, v); }
+        static Vec Broadcast16(const std::byte* p) { return _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)p)); }
+    };
+#endif
+
+#if defined(BBE_MEMCPY_AVX512)
+    struct AVX512
+    {
+        using Vec = __m512i;
+        static const size_t Size = sizeof(Vec);
 
-    // Discover how many quadwords precede a cache line boundary.  Copy them separately.
-    size_t InitialQuadwordCount = (4 - ((size_t)Source >> 4) & 3) & 3;
-    if (InitialQuadwordCount > NumQuadwords)
-        InitialQuadwordCount = NumQuadwords;
+        static Vec LoadU(const std::byte* p)      { return _mm512_loadu_si512(p); }
+        static void StoreU(std::byte* p, Vec v)   { _mm512_storeu_si512(p, v); }
+        static void Store(std::byte* p, Vec v)    { _mm512_store_si512(p, v); }
+        static void Stream(std::byte* p, Vec v)   { _mm512_stream_si512((Vec*)p, v); }
+        static Vec Broadcast16(const std::byte* p) { return _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i*)p)); }
+    };
+#endif
 
-    switch (InitialQuadwordCount)
+    static void CPUID(uint32_t leaf, uint32_t subLeaf, uint32_t regs[4])
     {
-    case 3: _mm_stream_si128(Dest + 2, _mm_load_si128(Source + 2));     // Fall through
-    case 2: _mm_stream_si128(Dest + 1, _mm_load_si128(Source + 1));     // Fall through
-    case 1: _mm_stream_si128(Dest + 0, _mm_load_si128(Source + 0));     // Fall through
-    default:
-        break;
+#if defined(_MSC_VER)
+        __cpuidex((int*)regs, (int)leaf, (int)subLeaf);
+#else
+        __cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
     }
 
-    if (NumQuadwords == InitialQuadwordCount)
-        return;
+    static uint64_t XGETBV0()
+    {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        uint32_t eax, edx;
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return ((uint64_t)edx << 32) | eax;
+#endif
+    }
 
-    Dest += InitialQuadwordCount;
-    Source += InitialQuadwordCount;
-    NumQuadwords -= InitialQuadwordCount;
+    // Largest last level cache found through CPUID's deterministic cache parameters. 0 if unknown
+    static size_t GetLastLevelCacheSize()
+    {
+        uint32_t regs[4]{};
+        CPUID(0, 0, regs);
+        const bool isAMD = regs[1] == 0x68747541; // "Auth"enticAMD
+        const uint32_t cacheLeaf = isAMD ? 0x8000001D : 4;
 
-    size_t CacheLines = NumQuadwords >> 2;
+        size_t largestCacheSize = 0;
+        for (uint32_t subLeaf = 0; subLeaf < 16; ++subLeaf)
+        {
+            CPUID(cacheLeaf, subLeaf, regs);
+
+            const uint32_t cacheType = regs[0] & 0x1F;
+            if (cacheType == 0)
+                break;
+
+            // data or unified caches only
+            if (cacheType == 2)
+                continue;
+
+            const size_t ways = ((regs[1] >> 22) & 0x3FF) + 1;
+            const size_t partitions = ((regs[1] >> 12) & 0x3FF) + 1;
+            const size_t lineSize = (regs[1] & 0xFFF) + 1;
+            const size_t sets = (size_t)regs[2] + 1;
+            largestCacheSize = std::max(largestCacheSize, ways * partitions * lineSize * sets);
+        }
+        return largestCacheSize;
+    }
 
-    switch (CacheLines)
+    template <typename ISA>
+    static void CopyImpl(std::byte* dest, const std::byte* source, size_t numBytes, bool nonTemporal)
     {
-    default:
-    case 10: _mm_prefetch((char*)(Source + 36), _MM_HINT_NTA);    // Fall through
-    case 9:  _mm_prefetch((char*)(Source + 32), _MM_HINT_NTA);    // Fall through
-    case 8:  _mm_prefetch((char*)(Source + 28), _MM_HINT_NTA);    // Fall through
-    case 7:  _mm_prefetch((char*)(Source + 24), _MM_HINT_NTA);    // Fall through
-    case 6:  _mm_prefetch((char*)(Source + 20), _MM_HINT_NTA);    // Fall through
-    case 5:  _mm_prefetch((char*)(Source + 16), _MM_HINT_NTA);    // Fall through
-    case 4:  _mm_prefetch((char*)(Source + 12), _MM_HINT_NTA);    // Fall through
-    case 3:  _mm_prefetch((char*)(Source + 8), _MM_HINT_NTA);    // Fall through
-    case 2:  _mm_prefetch((char*)(Source + 4), _MM_HINT_NTA);    // Fall through
-    case 1:  _mm_prefetch((char*)(Source + 0), _MM_HINT_NTA);    // Fall through
-
-        // Do four quadwords per loop to minimize stalls.
-        for (size_t i = CacheLines; i > 0; --i)
+        using Vec = typename ISA::Vec;
+        const size_t VecSize = ISA::Size;
+
+        assert(numBytes >= VecSize * 2);
+
+        // head & tail: unaligned, overlapping stores. Writing the same bytes twice is cheaper than handling odd sizes
+        const Vec head = ISA::LoadU(source);
+        const Vec tail = ISA::LoadU(source + numBytes - VecSize);
+
+        std::byte* d = (std::byte*)AlignUp((uintptr_t)dest + 1, VecSize);
+        const std::byte* s = source + (d - dest);
+        std::byte* const bodyEnd = (std::byte*)AlignDown((uintptr_t)(dest + numBytes), VecSize);
+
+        if (nonTemporal)
         {
-            // If this is a large copy, start prefetching future cache lines.  This also prefetches the
-            // trailing quadwords that are not part of a whole cache line.
-            if (i >= 10)
-                _mm_prefetch((char*)(Source + 40), _MM_HINT_NTA);
-
-            _mm_stream_si128(Dest + 0, _mm_load_si128(Source + 0));
-            _mm_stream_si128(Dest + 1, _mm_load_si128(Source + 1));
-            _mm_stream_si128(Dest + 2, _mm_load_si128(Source + 2));
-            _mm_stream_si128(Dest + 3, _mm_load_si128(Source + 3));
-
-            Dest += 4;
-            Source += 4;
+            for (; d + VecSize * 4 <= bodyEnd; d += VecSize * 4, s += VecSize * 4)
+            {
+                const Vec v0 = ISA::LoadU(s + VecSize * 0);
+                const Vec v1 = ISA::LoadU(s + VecSize * 1);
+                const Vec v2 = ISA::LoadU(s + VecSize * 2);
+                const Vec v3 = ISA::LoadU(s + VecSize * 3);
+                ISA::Stream(d + VecSize * 0, v0);
+                ISA::Stream(d + VecSize * 1, v1);
+                ISA::Stream(d + VecSize * 2, v2);
+                ISA::Stream(d + VecSize * 3, v3);
+            }
+            for (; d < bodyEnd; d += VecSize, s += VecSize)
+            {
+                ISA::Stream(d, ISA::LoadU(s));
+            }
+            _mm_sfence();
+        }
+        else
+        {
+            for (; d + VecSize * 4 <= bodyEnd; d += VecSize * 4, s += VecSize * 4)
+            {
+                const Vec v0 = ISA::LoadU(s + VecSize * 0);
+                const Vec v1 = ISA::LoadU(s + VecSize * 1);
+                const Vec v2 = ISA::LoadU(s + VecSize * 2);
+                const Vec v3 = ISA::LoadU(s + VecSize * 3);
+                ISA::Store(d + VecSize * 0, v0);
+                ISA::Store(d + VecSize * 1, v1);
+                ISA::Store(d + VecSize * 2, v2);
+                ISA::Store(d + VecSize * 3, v3);
+            }
+            for (; d < bodyEnd; d += VecSize, s += VecSize)
+            {
+                ISA::Store(d, ISA::LoadU(s));
+            }
         }
 
-    case 0:    // No whole cache lines to read
-        break;
+        ISA::StoreU(dest, head);
+        ISA::StoreU(dest + numBytes - VecSize, tail);
     }
 
-    // Copy the remaining quadwords
-    switch (NumQuadwords & 3)
+    // 'pattern' holds the 16 bytes fill pattern twice, so the pattern at any phase can be loaded with a single unaligned load
+    template <typename ISA>
+    static void FillImpl(std::byte* dest, const std::byte* pattern, size_t numBytes, bool nonTemporal)
     {
-    case 3: _mm_stream_si128(Dest + 2, _mm_load_si128(Source + 2));     // Fall through
-    case 2: _mm_stream_si128(Dest + 1, _mm_load_si128(Source + 1));     // Fall through
-    case 1: _mm_stream_si128(Dest + 0, _mm_load_si128(Source + 0));     // Fall through
-    default:
-        break;
+        using Vec = typename ISA::Vec;
+        const size_t VecSize = ISA::Size;
+
+        assert(numBytes >= VecSize * 2);
+
+        // head: 16 bytes at a time, always in phase with dest. May spill over the aligned body, with the same values
+        std::byte* const bodyBegin = (std::byte*)AlignUp((uintptr_t)dest + 1, VecSize);
+        for (std::byte* d = dest; d < bodyBegin; d += 16)
+        {
+            SSE2::StoreU(d, SSE2::LoadU(pattern));
+        }
+
+        const Vec v = ISA::Broadcast16(pattern + (bodyBegin - dest) % 16);
+
+        std::byte* d = bodyBegin;
+        std::byte* const bodyEnd = (std::byte*)AlignDown((uintptr_t)(dest + numBytes), VecSize);
+        if (nonTemporal)
+        {
+            for (; d < bodyEnd; d += VecSize)
+            {
+                ISA::Stream(d, v);
+            }
+            _mm_sfence();
+        }
+        else
+        {
+            for (; d < bodyEnd; d += VecSize)
+            {
+                ISA::Store(d, v);
+            }
+        }
+
+        // tail: same as head, ending with an overlapping store in phase with the end
+        std::byte* const end = dest + numBytes;
+        for (; d + 16 <= end; d += 16)
+        {
+            SSE2::StoreU(d, SSE2::LoadU(pattern + (d - dest) % 16));
+        }
+        SSE2::StoreU(end - 16, SSE2::LoadU(pattern + (numBytes - 16) % 16));
+    }
+
+    using CopyFunc = void(*)(std::byte*, const std::byte*, size_t, bool);
+    using FillFunc = void(*)(std::byte*, const std::byte*, size_t, bool);
+
+    struct Dispatch
+    {
+        CopyFunc m_Copy = &CopyImpl<SSE2>;
+        FillFunc m_Fill = &FillImpl<SSE2>;
+        size_t m_VecSize = SSE2::Size;
+        size_t m_NonTemporalThreshold = BBE_MB(4);
+        const char* m_ISAName = "SSE2";
+    };
+
+    static Dispatch SelectImplementation()
+    {
+        Dispatch dispatch;
+
+        uint32_t regs[4]{};
+        CPUID(1, 0, regs);
+        const bool osxsave = (regs[2] & (1 << 27)) != 0;
+
+        // the OS must save the wide registers on context switches too
+        const uint64_t xcr0 = osxsave ? XGETBV0() : 0;
+        const bool osAVX = (xcr0 & 0x6) == 0x6;
+        const bool osAVX512 = (xcr0 & 0xE6) == 0xE6;
+
+        CPUID(7, 0, regs);
+        const bool cpuAVX2 = (regs[1] & (1 << 5)) != 0;
+        const bool cpuAVX512F = (regs[1] & (1 << 16)) != 0;
+
+#if defined(BBE_MEMCPY_AVX512)
+        if (cpuAVX512F && osAVX512)
+        {
+            dispatch = Dispatch{ &CopyImpl<AVX512>, &FillImpl<AVX512>, AVX512::Size };
+            dispatch.m_ISAName = "AVX-512";
+        }
+        else
+#endif
+#if defined(BBE_MEMCPY_AVX2)
+        if (cpuAVX2 && osAVX)
+        {
+            dispatch = Dispatch{ &CopyImpl<AVX2>, &FillImpl<AVX2>, AVX2::Size };
+            dispatch.m_ISAName = "AVX2";
+        }
+#endif
+
+        // streaming only pays off once the data would not fit in cache anyway. Keep half of it for everyone else
+        if (const size_t lastLevelCacheSize = GetLastLevelCacheSize())
+        {
+            dispatch.m_NonTemporalThreshold = lastLevelCacheSize / 2;
+        }
+
+        return dispatch;
     }
 
-    _mm_sfence();
+    static const Dispatch gs_Dispatch = SelectImplementation();
 }
 
-void SIMDMemFill(void* __restrict _Dest, const bbeVector4& FillVector, size_t NumQuadwords)
+void SIMDMemCopy(void* __restrict dest, const void* __restrict source, size_t numBytes)
 {
-    assert(bbeIsAligned(_Dest, 16));
+    using namespace MemCopyPrivate;
 
-    const __m128i Source = _mm_castps_si128(_mm_set_ps(FillVector.x, FillVector.y, FillVector.z, FillVector.w));
-    __m128i* __restrict Dest = (__m128i * __restrict)_Dest;
-
-    switch (((size_t)Dest >> 4) & 3)
+    if (numBytes < std::max(gs_SmallCopySize, gs_Dispatch.m_VecSize * 2))
     {
-    case 1: _mm_stream_si128(Dest++, Source); --NumQuadwords;     // Fall through
-    case 2: _mm_stream_si128(Dest++, Source); --NumQuadwords;     // Fall through
-    case 3: _mm_stream_si128(Dest++, Source); --NumQuadwords;     // Fall through
-    default:
-        break;
+        memcpy(dest, source, numBytes);
+        return;
     }
 
-    size_t WholeCacheLines = NumQuadwords >> 2;
+    gs_Dispatch.m_Copy((std::byte*)dest, (const std::byte*)source, numBytes, numBytes >= gs_Dispatch.m_NonTemporalThreshold);
+}
+
+void SIMDMemCopyToWriteCombined(void* __restrict dest, const void* __restrict source, size_t numBytes)
+{
+    using namespace MemCopyPrivate;
 
-    // Do four quadwords per loop to minimize stalls.
-    while (WholeCacheLines--)
+    // memcpy never reads from dest, so it's safe for small write-combined copies
+    if (numBytes < gs_Dispatch.m_VecSize * 2)
     {
-        _mm_stream_si128(Dest++, Source);
-        _mm_stream_si128(Dest++, Source);
-        _mm_stream_si128(Dest++, Source);
-        _mm_stream_si128(Dest++, Source);
+        memcpy(dest, source, numBytes);
+        return;
     }
 
-    // Copy the remaining quadwords
-    switch (NumQuadwords & 3)
+    gs_Dispatch.m_Copy((std::byte*)dest, (const std::byte*)source, numBytes, true);
+}
+
+void SIMDMemFill(void* __restrict dest, const bbeVector4& fillVector, size_t numBytes)
+{
+    using namespace MemCopyPrivate;
+
+    static_assert(sizeof(bbeVector4) == 16);
+
+    std::byte pattern[32];
+    memcpy(pattern, &fillVector, 16);
+    memcpy(pattern + 16, &fillVector, 16);
+
+    if (numBytes < gs_Dispatch.m_VecSize * 2)
     {
-    case 3: _mm_stream_si128(Dest++, Source);     // Fall through
-    case 2: _mm_stream_si128(Dest++, Source);     // Fall through
-    case 1: _mm_stream_si128(Dest++, Source);     // Fall through
-    default:
-        break;
+        std::byte* d = (std::byte*)dest;
+        for (size_t offset = 0; offset < numBytes; offset += 16)
+        {
+            memcpy(d + offset, pattern, std::min<size_t>(16, numBytes - offset));
+        }
+        return;
     }
 
-    _mm_sfence();
+    gs_Dispatch.m_Fill((std::byte*)dest, pattern, numBytes, numBytes >= gs_Dispatch.m_NonTemporalThreshold);
+}
+
+const char* GetSIMDMemInstructionSetName()
+{
+    return MemCopyPrivate::gs_Dispatch.m_ISAName;
 }
@@ -1,4 +1,13 @@
 #pragma once
 
-void SIMDMemCopy(void* __restrict Dest, const void* __restrict Source, size_t NumQuadwords);
-void SIMDMemFill(void* __restrict Dest, const bbeVector4& FillVector, size_t NumQuadwords);
+// Copy & fill routines, dispatched at startup to the widest instruction set the CPU supports (SSE2, AVX2 or AVX-512).
+// No alignment requirement, any size. Copies bigger than a fraction of the last level cache use non-temporal stores, so they don't evict the working set.
+void SIMDMemCopy(void* __restrict dest, const void* __restrict source, size_t numBytes);
+
+// For destinations in write-combined memory (i.e. mapped upload heaps): always streams full lines, and never reads back from dest
+void SIMDMemCopyToWriteCombined(void* __restrict dest, const void* __restrict source, size_t numBytes);
+
+// Repeats the 16 bytes of 'fillVector' over dest, starting at dest
+void SIMDMemFill(void* __restrict dest, const bbeVector4& fillVector, size_t numBytes);
+
+const char* GetSIMDMemInstructionSetName();
@@ -11,10 +11,26 @@
 
 #include "system/memorymappedfile.h"
 
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// Mapping sizes are kept multiple of this, so growth never maps partial pages (Windows allocation granularity)
+static const uint64_t gs_MappingGranularity = 64 * 1024;
+
 MemoryMappedFile::MemoryMappedFile() :
+#if defined(_WIN32)
     m_mapFile(INVALID_HANDLE_VALUE),
     m_file(INVALID_HANDLE_VALUE),
+#else
+    m_file(-1),
+#endif
     m_mapAddress(nullptr),
+    m_mode(Mode::ReadWrite),
+    m_accessHint(AccessHint::Normal),
     m_currentFileSize(0)
 {
 }
@@ -23,30 +39,81 @@ MemoryMappedFile::~MemoryMappedFile()
 {
 }
 
-void MemoryMappedFile::Init(const std::wstring& filename, UINT fileSize)
+void MemoryMappedFile::Init(const std::wstring& filename, uint64_t fileSize, Mode mode, AccessHint accessHint)
 {
     m_filename = filename;
-    WIN32_FIND_DATA findFileData;
-    HANDLE handle = FindFirstFileExW(filename.c_str(), FindExInfoBasic, &findFileData, FindExSearchNameMatch, nullptr, 0);
-    bool found = handle != INVALID_HANDLE_VALUE;
+    m_mode = mode;
+    m_accessHint = accessHint;
+
+    if (!OpenFile())
+        return;
+
+    uint64_t mapSize = m_currentFileSize;
+    if (mapSize == 0)
+    {
+        if (m_mode == Mode::ReadOnly)
+        {
+            g_Log.error("MemoryMappedFile: '{}' is empty", StringUtils::WideToUtf8(m_filename));
+            Destroy(false);
+            return;
+        }
+
+        // File mapping files with a size of 0 produces an error.
+        mapSize = AlignUp(std::max<uint64_t>(fileSize, DefaultFileSize), gs_MappingGranularity);
+    }
+    else if (m_mode == Mode::ReadWrite && fileSize > mapSize)
+    {
+        // Grow to the specified size.
+        mapSize = AlignUp(fileSize, gs_MappingGranularity);
+    }
 
-    if (found)
+    if (!MapView(mapSize))
     {
-        FindClose(handle);
+        Destroy(false);
+        return;
     }
 
+    if (m_mode == Mode::ReadWrite)
+    {
+        // New file, or file from an older format. Start from scratch
+        FileHeader* header = GetHeader();
+        if (header->m_Magic != FileHeader::Magic || header->m_Version != FileHeader::Version || header->m_DataSize > GetDataCapacity())
+        {
+            header->m_Magic = FileHeader::Magic;
+            header->m_Version = FileHeader::Version;
+            header->m_DataSize = 0;
+        }
+    }
+    else if (m_currentFileSize < sizeof(FileHeader) || GetHeader()->m_Magic != FileHeader::Magic || GetHeader()->m_Version != FileHeader::Version || GetHeader()->m_DataSize > GetDataCapacity())
+    {
+        g_Log.error("MemoryMappedFile: '{}' is not a valid mapped file", StringUtils::WideToUtf8(m_filename));
+        Destroy(false);
+    }
+}
+
+#if defined(_WIN32)
+
+bool MemoryMappedFile::OpenFile()
+{
+    const bool readOnly = m_mode == Mode::ReadOnly;
+
+    CREATEFILE2_EXTENDED_PARAMETERS params = {};
+    params.dwSize = sizeof(params);
+    params.dwFileAttributes = FILE_ATTRIBUTE_NORMAL;
+    params.dwFileFlags = m_accessHint == AccessHint::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN : m_accessHint == AccessHint::Random ? FILE_FLAG_RANDOM_ACCESS : 0;
+
     m_file = CreateFile2(
-        filename.c_str(),
-        GENERIC_READ | GENERIC_WRITE,
-        0,
-        (found) ? OPEN_EXISTING : CREATE_NEW,
-        nullptr);
+        m_filename.c_str(),
+        readOnly ? GENERIC_READ : GENERIC_READ | GENERIC_WRITE,
+        readOnly ? FILE_SHARE_READ : 0,
+        readOnly ? OPEN_EXISTING : OPEN_ALWAYS,
+        &params);
 
     if (m_file == INVALID_HANDLE_VALUE)
     {
         g_Log.error("m_file is invalid. Error {}.", GetLastError());
-        g_Log.error("Target file is {}", StringUtils::WideToUtf8(filename));
-        return;
+        g_Log.error("Target file is {}", StringUtils::WideToUtf8(m_filename));
+        return false;
     }
 
     LARGE_INTEGER realFileSize = {};
@@ -55,99 +122,273 @@ void MemoryMappedFile::Init(const std::wstring& filename, UINT fileSize)
     {
         g_Log.error("\nError {} occurred in GetFileSizeEx!", GetLastError());
         assert(false);
-        return;
+        return false;
     }
 
-    assert(realFileSize.HighPart == 0);
-    m_currentFileSize = realFileSize.LowPart;
-    if (m_currentFileSize == 0)
+    m_currentFileSize = (uint64_t)realFileSize.QuadPart;
+    return true;
+}
+
+bool MemoryMappedFile::MapView(uint64_t fileSize)
+{
+    const bool readOnly = m_mode == Mode::ReadOnly;
+
+    // failures are reported to the caller: growing a file can legitimately fail (i.e. disk full)
+    m_mapFile = CreateFileMapping(m_file, nullptr, readOnly ? PAGE_READONLY : PAGE_READWRITE, (DWORD)(fileSize >> 32), (DWORD)fileSize, nullptr);
+
+    if (m_mapFile == nullptr)
     {
-        // File mapping files with a size of 0 produces an error.
-        m_currentFileSize = DefaultFileSize;
+        g_Log.error("m_mapFile is NULL: last error: {}", GetLastError());
+        m_mapFile = INVALID_HANDLE_VALUE;
+        return false;
     }
-    else if(fileSize > m_currentFileSize)
+
+    m_mapAddress = MapViewOfFile(m_mapFile, readOnly ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T)fileSize);
+
+    if (m_mapAddress == nullptr)
     {
-        // Grow to the specified size.
-        m_currentFileSize = fileSize;
+        g_Log.error("m_mapAddress is NULL: last error: {}", GetLastError());
+        CloseHandle(m_mapFile);
+        m_mapFile = INVALID_HANDLE_VALUE;
+        return false;
     }
 
-    m_mapFile = CreateFileMapping(m_file, nullptr, PAGE_READWRITE, 0, m_currentFileSize, nullptr);
+    m_currentFileSize = fileSize;
+    ApplyAccessHint();
+    return true;
+}
 
-    if (m_mapFile == nullptr)
+void MemoryMappedFile::UnmapView()
+{
+    if (m_mode == Mode::ReadWrite)
+    {
+        BOOL flag = FlushViewOfFile(m_mapAddress, 0);
+        if (!flag)
+        {
+            g_Log.error("MemoryMappedFile::UnmapView Error: {}", GetLastErrorAsString());
+            assert(false);
+        }
+    }
+
+    BOOL flag = UnmapViewOfFile(m_mapAddress);
+    if (!flag)
     {
-        g_Log.error("m_mapFile is NULL: last error: %d\n", GetLastError());
+        g_Log.error("\nError {} occurred unmapping the view!", GetLastError());
         assert(false);
-        return;
     }
 
-    m_mapAddress = MapViewOfFile(m_mapFile, FILE_MAP_ALL_ACCESS, 0, 0, m_currentFileSize);
+    m_mapAddress = nullptr;
 
-    if (m_mapAddress == nullptr)
+    flag = CloseHandle(m_mapFile);    // Close the file mapping object.
+    if (!flag)
     {
-        g_Log.error("m_mapAddress is NULL: last error: %d\n", GetLastError());
+        g_Log.error("\nError {} occurred closing the mapping object!", GetLastError());
         assert(false);
-        return;
     }
+    m_mapFile = INVALID_HANDLE_VALUE;
+}
+
+void MemoryMappedFile::ApplyAccessHint()
+{
+    // Windows has no per-view equivalent of madvise. The hint was passed at file creation, and we prefetch sequential files up front
+    if (m_accessHint == AccessHint::Sequential)
+    {
+        Prefetch(0, GetSize());
+    }
+}
+
+void MemoryMappedFile::Prefetch(uint64_t offset, uint64_t size) const
+{
+    if (!m_mapAddress || size == 0 || offset >= GetDataCapacity())
+        return;
+
+    WIN32_MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = (std::byte*)GetData() + offset;
+    range.NumberOfBytes = (SIZE_T)std::min(size, GetDataCapacity() - offset);
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
 }
 
 void MemoryMappedFile::Destroy(bool deleteFile)
 {
     if (m_mapAddress)
     {
-        BOOL flag = UnmapViewOfFile(m_mapAddress);
+        UnmapView();
+    }
+
+    if (m_file != INVALID_HANDLE_VALUE)
+    {
+        BOOL flag = CloseHandle(m_file);        // Close the file itself.
         if (!flag)
         {
-            g_Log.error("\nError %ld occurred unmapping the view!", GetLastError());
+            g_Log.error("\nError {} occurred closing the file!", GetLastError());
             assert(false);
         }
+        m_file = INVALID_HANDLE_VALUE;
+    }
 
-        m_mapAddress = nullptr;
+    if (deleteFile)
+    {
+        DeleteFileW(m_filename.c_str());
+    }
+}
 
-        flag = CloseHandle(m_mapFile);    // Close the file mapping object.
-        if (!flag)
-        {
-            g_Log.error("\nError %ld occurred closing the mapping object!", GetLastError());
-            assert(false);
-        }
+#else
 
-        flag = CloseHandle(m_file);        // Close the file itself.
-        if (!flag)
+bool MemoryMappedFile::OpenFile()
+{
+    const bool readOnly = m_mode == Mode::ReadOnly;
+
+    m_file = open(StringUtils::WideToUtf8(m_filename), readOnly ? O_RDONLY : O_RDWR | O_CREAT, 0644);
+    if (m_file == -1)
+    {
+        g_Log.error("m_file is invalid. Error {}.", errno);
+        g_Log.error("Target file is {}", StringUtils::WideToUtf8(m_filename));
+        return false;
+    }
+
+    struct stat fileStat = {};
+    if (fstat(m_file, &fileStat) != 0)
+    {
+        g_Log.error("\nError {} occurred in fstat!", errno);
+        assert(false);
+        return false;
+    }
+
+    m_currentFileSize = (uint64_t)fileStat.st_size;
+    return true;
+}
+
+bool MemoryMappedFile::MapView(uint64_t fileSize)
+{
+    const bool readOnly = m_mode == Mode::ReadOnly;
+
+    // failures are reported to the caller: growing a file can legitimately fail (i.e. disk full)
+    if (!readOnly && ftruncate(m_file, (off_t)fileSize) != 0)
+    {
+        g_Log.error("ftruncate failed: last error: {}", errno);
+        return false;
+    }
+
+    void* address = mmap(nullptr, fileSize, readOnly ? PROT_READ : PROT_READ | PROT_WRITE, MAP_SHARED, m_file, 0);
+    if (address == MAP_FAILED)
+    {
+        g_Log.error("m_mapAddress is NULL: last error: {}", errno);
+        return false;
+    }
+    m_mapAddress = address;
+    m_currentFileSize = fileSize;
+
+    ApplyAccessHint();
+    return true;
+}
+
+void MemoryMappedFile::UnmapView()
+{
+    if (m_mode == Mode::ReadWrite && msync(m_mapAddress, m_currentFileSize, MS_SYNC) != 0)
+    {
+        g_Log.error("MemoryMappedFile::UnmapView msync Error: {}", errno);
+        assert(false);
+    }
+
+    if (munmap(m_mapAddress, m_currentFileSize) != 0)
+    {
+        g_Log.error("\nError {} occurred unmapping the view!", errno);
+        assert(false);
+    }
+
+    m_mapAddress = nullptr;
+}
+
+void MemoryMappedFile::ApplyAccessHint()
+{
+    const int advice = m_accessHint == AccessHint::Sequential ? MADV_SEQUENTIAL : m_accessHint == AccessHint::Random ? MADV_RANDOM : MADV_NORMAL;
+    madvise(m_mapAddress, m_currentFileSize, advice);
+}
+
+void MemoryMappedFile::Prefetch(uint64_t offset, uint64_t size) const
+{
+    if (!m_mapAddress || size == 0 || offset >= GetDataCapacity())
+        return;
+
+    // madvise wants a page aligned address
+    const uint64_t pageSize = (uint64_t)sysconf(_SC_PAGESIZE);
+    const uint64_t begin = AlignDown(sizeof(FileHeader) + offset, pageSize);
+    const uint64_t end = std::min(sizeof(FileHeader) + offset + size, m_currentFileSize);
+    madvise(static_cast<std::byte*>(m_mapAddress) + begin, end - begin, MADV_WILLNEED);
+}
+
+void MemoryMappedFile::Destroy(bool deleteFile)
+{
+    if (m_mapAddress)
+    {
+        UnmapView();
+    }
+
+    if (m_file != -1)
+    {
+        if (close(m_file) != 0)
         {
-            g_Log.error("\nError %ld occurred closing the file!", GetLastError());
+            g_Log.error("\nError {} occurred closing the file!", errno);
             assert(false);
         }
+        m_file = -1;
     }
 
     if (deleteFile)
     {
-        DeleteFileW(m_filename.c_str());
+        unlink(StringUtils::WideToUtf8(m_filename));
     }
 }
 
-void MemoryMappedFile::GrowMapping(UINT size)
+#endif // #if defined(_WIN32)
+
+bool MemoryMappedFile::GrowMapping(uint64_t size)
 {
-    // Add space for the extra size at the beginning of the file.
-    size += sizeof(UINT);
+    assert(m_mode == Mode::ReadWrite);
+    assert(m_mapAddress);
+
+    // Add space for the header at the beginning of the file.
+    const uint64_t neededFileSize = size + sizeof(FileHeader);
 
     // Check the size.
-    if (size <= m_currentFileSize)
+    if (neededFileSize <= m_currentFileSize)
     {
         // Don't shrink.
-        return;
+        return true;
     }
 
-    // Flush.
-    BOOL flag = FlushViewOfFile(m_mapAddress, 0);
-    if (!flag)
+    // Reserve geometrically, so that successive small growths don't each pay for a full remap
+    const uint64_t newFileSize = AlignUp(std::max(neededFileSize, m_currentFileSize * 2), gs_MappingGranularity);
+
+#if !defined(_WIN32)
+    // Linux can grow the mapping in place (or move it) without a full unmap/remap
+    if (ftruncate(m_file, (off_t)newFileSize) == 0)
     {
-        g_Log.error("MemoryMappedFile::GrowMapping Error: {}", GetLastErrorAsString());
-        assert(false);
+        void* newAddress = mremap(m_mapAddress, m_currentFileSize, newFileSize, MREMAP_MAYMOVE);
+        if (newAddress != MAP_FAILED)
+        {
+            m_mapAddress = newAddress;
+            m_currentFileSize = newFileSize;
+            ApplyAccessHint();
+            return true;
+        }
     }
+#endif
 
-    // Close the current mapping.
-    Destroy(false);
+    // Close the current mapping, keeping the file open.
+    UnmapView();
 
-    // Update the size and create a new mapping.
-    m_currentFileSize = size;
-    Init(m_filename, m_currentFileSize);
+    // m_currentFileSize is only updated once the new view is mapped
+    if (MapView(newFileSize))
+        return true;
+
+    g_Log.error("MemoryMappedFile: couldn't grow '{}' from {} to {} bytes", StringUtils::WideToUtf8(m_filename), m_currentFileSize, newFileSize);
+
+    // Back to the previous size, which the data still fits in
+    if (!MapView(m_currentFileSize))
+    {
+        g_Log.error("MemoryMappedFile: couldn't re-map '{}', closing it", StringUtils::WideToUtf8(m_filename));
+        Destroy(false);
+    }
+    return false;
 }
@@ -11,29 +11,42 @@
 
 #pragma once
 
+// File layout: [FileHeader][data...][reserved space]
+// The file is grown geometrically, so the mapping is only re-created O(log(n)) times while the data grows to n bytes.
 class MemoryMappedFile
 {
 public:
+    enum class Mode { ReadWrite, ReadOnly };
+    enum class AccessHint { Normal, Sequential, Random };
+
     MemoryMappedFile();
     ~MemoryMappedFile();
 
-    void Init(const std::wstring& wstring, UINT filesize = DefaultFileSize);
+    // ReadOnly mode maps an existing file as shared & read-only. It will fail if the file doesn't exist
+    void Init(const std::wstring& filename, uint64_t fileSize = DefaultFileSize, Mode mode = Mode::ReadWrite, AccessHint accessHint = AccessHint::Normal);
     void Destroy(bool deleteFile);
-    void GrowMapping(UINT size);
 
-    void SetSize(UINT size)
+    // Returns false if the file couldn't be grown. The previous mapping & data are kept when possible: check IsMapped()
+    bool GrowMapping(uint64_t size);
+
+    // Hint the OS to page in a range of the data ahead of use
+    void Prefetch(uint64_t offset, uint64_t size) const;
+
+    void SetSize(uint64_t size)
     {
-        if(m_mapAddress)
+        if (m_mapAddress)
         {
-            static_cast<UINT*>(m_mapAddress)[0] = size;
+            assert(m_mode == Mode::ReadWrite);
+            assert(size <= GetDataCapacity());
+            GetHeader()->m_DataSize = size;
         }
     }
 
-    UINT GetSize() const
+    uint64_t GetSize() const
     {
         if (m_mapAddress)
         {
-            return static_cast<UINT*>(m_mapAddress)[0];
+            return GetHeader()->m_DataSize;
         }
         return 0;
     }
@@ -42,22 +55,50 @@ public:
     {
         if (m_mapAddress)
         {
-            // The actual data comes after the length.
-            return &static_cast<UINT*>(m_mapAddress)[1];
+            // The actual data comes after the header.
+            return static_cast<std::byte*>(m_mapAddress) + sizeof(FileHeader);
         }
         return nullptr;
     }
 
+    const void* GetData() const { return const_cast<MemoryMappedFile*>(this)->GetData(); }
+
     bool IsMapped() const { return m_mapAddress != nullptr; }
-    UINT GetCurrentFileSize() const { return m_currentFileSize; }
-    
+    uint64_t GetCurrentFileSize() const { return m_currentFileSize; }
+    uint64_t GetDataCapacity() const { return m_currentFileSize > sizeof(FileHeader) ? m_currentFileSize - sizeof(FileHeader) : 0; }
+
 protected:
-    static const UINT DefaultFileSize = 64;
+    struct FileHeader
+    {
+        static const uint32_t Magic = 0x46464D4D; // "MMFF"
+        static const uint32_t Version = 2;
+
+        uint32_t m_Magic;
+        uint32_t m_Version;
+        uint64_t m_DataSize;
+    };
+    static_assert(sizeof(FileHeader) == 16);
+
+    static const uint64_t DefaultFileSize = 64 * 1024;
+
+    FileHeader* GetHeader() const { return static_cast<FileHeader*>(m_mapAddress); }
+
+    bool OpenFile();
+    // Sets m_currentFileSize only once the view of 'fileSize' bytes is mapped
+    bool MapView(uint64_t fileSize);
+    void UnmapView();
+    void ApplyAccessHint();
 
+#if defined(_WIN32)
     HANDLE m_mapFile;
     HANDLE m_file;
-    LPVOID m_mapAddress;
+#else
+    int m_file;
+#endif
+    void* m_mapAddress;
     std::wstring m_filename;
 
-    UINT m_currentFileSize;
+    Mode m_mode;
+    AccessHint m_accessHint;
+    uint64_t m_currentFileSize;
 };
@@ -0,0 +1,72 @@
+#include <system/parallel.h>
+
+namespace ParallelUtils
+{
+    struct ParallelJob
+    {
+        ParallelJob(uint32_t count, uint32_t numChunks, ChunkFunction func, void* context)
+            : m_Func(func)
+            , m_Context(context)
+            , m_Count(count)
+            , m_NumChunks(numChunks)
+            , m_ChunksDone(numChunks)
+        {}
+
+        const ChunkFunction m_Func;
+        void* const m_Context;
+        const uint32_t m_Count;
+        const uint32_t m_NumChunks;
+        std::atomic<uint32_t> m_NextChunk = 0;
+        Latch m_ChunksDone;
+    };
+
+    static void ProcessChunks(ParallelJob& job)
+    {
+        for (uint32_t chunkIdx = job.m_NextChunk.fetch_add(1); chunkIdx < job.m_NumChunks; chunkIdx = job.m_NextChunk.fetch_add(1))
+        {
+            job.m_Func(job.m_Context, chunkIdx, GetChunkBegin(job.m_Count, job.m_NumChunks, chunkIdx), GetChunkBegin(job.m_Count, job.m_NumChunks, chunkIdx + 1));
+            job.m_ChunksDone.CountDown();
+        }
+    }
+
+    uint32_t GetNumChunks(uint32_t count, uint32_t grainSize, uint32_t minGrainSize)
+    {
+        if (count == 0)
+            return 0;
+
+        if (grainSize > 0)
+            return (count + grainSize - 1) / grainSize;
+
+        const uint32_t maxChunks = std::max<uint32_t>(1, (uint32_t)g_TasksExecutor.num_workers() * ChunksPerWorker);
+        return std::clamp(count / std::max(minGrainSize, 1U), 1U, maxChunks);
+    }
+
+    void RunChunks(uint32_t count, uint32_t numChunks, ChunkFunction func, void* context)
+    {
+        assert(numChunks <= count);
+
+        if (numChunks == 0)
+            return;
+
+        if (numChunks == 1)
+        {
+            func(context, 0, 0, count);
+            return;
+        }
+
+        // Helpers may only start running after we're done with all the chunks, so the job must outlive this call. The functor on our stack doesn't need to:
+        // it's only touched by threads that grabbed a chunk, and we wait for all of them
+        const std::shared_ptr<ParallelJob> job = std::make_shared<ParallelJob>(count, numChunks, func, context);
+
+        const uint32_t numHelpers = std::min(numChunks - 1, (uint32_t)g_TasksExecutor.num_workers());
+        for (uint32_t i = 0; i < numHelpers; ++i)
+        {
+            g_TasksExecutor.silent_async([job] { ProcessChunks(*job); });
+        }
+
+        ProcessChunks(*job);
+
+        // All chunks are taken by now: whatever we wait for is already running on another thread, so this can not deadlock
+        job->m_ChunksDone.Wait();
+    }
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+// Data-parallel helpers on top of g_TasksExecutor.
+// Work is split in contiguous chunks that the calling thread and a few helper tasks pull from a shared counter. The caller never blocks on queued work,
+// only on chunks other threads are already running, so all of these can be called from within a running task (corun style) without deadlocking.
+// Nested calls simply degrade to serial loops on the calling thread when every worker is busy.
+namespace ParallelUtils
+{
+    // Chunks per worker with automatic grain sizing, to even out the load when items are not uniform
+    static const uint32_t ChunksPerWorker = 4;
+
+    // Minimum number of items per chunk with automatic grain sizing, so that cheap items are not drowned in scheduling costs
+    static const uint32_t DefaultMinGrainSize = 64;
+
+    // Below this, sorts and scans are not worth splitting
+    static const uint32_t MinItemsPerSortChunk = 2048;
+    static const uint32_t MinItemsPerScanChunk = 1024;
+
+    // 'grainSize' == 0 means automatic: a few chunks per worker, of at least 'minGrainSize' items
+    uint32_t GetNumChunks(uint32_t count, uint32_t grainSize, uint32_t minGrainSize = DefaultMinGrainSize);
+
+    inline uint32_t GetChunkBegin(uint32_t count, uint32_t numChunks, uint32_t chunkIdx)
+    {
+        return (uint32_t)(((uint64_t)count * chunkIdx) / numChunks);
+    }
+
+    using ChunkFunction = void(*)(void* context, uint32_t chunkIdx, uint32_t begin, uint32_t end);
+    void RunChunks(uint32_t count, uint32_t numChunks, ChunkFunction func, void* context);
+
+    // func(uint32_t chunkIdx, uint32_t begin, uint32_t end). Chunk boundaries only depend on 'count' and 'numChunks'
+    template <typename Func>
+    void ParallelForChunks(uint32_t count, uint32_t numChunks, Func&& func)
+    {
+        using FuncType = std::remove_reference_t<Func>;
+        auto Thunk = [](void* context, uint32_t chunkIdx, uint32_t begin, uint32_t end) { (*static_cast<FuncType*>(context))(chunkIdx, begin, end); };
+        RunChunks(count, numChunks, Thunk, const_cast<void*>(static_cast<const void*>(&func)));
+    }
+
+    // func(uint32_t rangeBegin, uint32_t rangeEnd)
+    template <typename Func>
+    void ParallelForRange(uint32_t begin, uint32_t end, Func&& func, uint32_t grainSize = 0)
+    {
+        if (end <= begin)
+            return;
+
+        const uint32_t count = end - begin;
+        ParallelForChunks(count, GetNumChunks(count, grainSize), [begin, &func](uint32_t, uint32_t chunkBegin, uint32_t chunkEnd) { func(begin + chunkBegin, begin + chunkEnd); });
+    }
+
+    // func(uint32_t index)
+    template <typename Func>
+    void ParallelFor(uint32_t begin, uint32_t end, Func&& func, uint32_t grainSize = 0)
+    {
+        ParallelForRange(begin, end, [&func](uint32_t rangeBegin, uint32_t rangeEnd)
+            {
+                for (uint32_t i = rangeBegin; i < rangeEnd; ++i)
+                {
+                    func(i);
+                }
+            }, grainSize);
+    }
+
+    // Returns reduceFunc(...reduceFunc(identity, mapFunc(begin))..., mapFunc(end - 1)).
+    // Partial results are combined in chunk order, so the result is deterministic as long as 'reduceFunc' is associative
+    template <typename T, typename MapFunc, typename ReduceFunc>
+    T ParallelReduce(uint32_t begin, uint32_t end, const T& identity, MapFunc&& mapFunc, ReduceFunc&& reduceFunc, uint32_t grainSize = 0)
+    {
+        if (end <= begin)
+            return identity;
+
+        const uint32_t count = end - begin;
+        const uint32_t numChunks = GetNumChunks(count, grainSize);
+
+        std::vector<T> partialResults(numChunks, identity);
+        ParallelForChunks(count, numChunks, [&](uint32_t chunkIdx, uint32_t chunkBegin, uint32_t chunkEnd)
+            {
+                T result = identity;
+                for (uint32_t i = begin + chunkBegin; i < begin + chunkEnd; ++i)
+                {
+                    result = reduceFunc(result, mapFunc(i));
+                }
+                partialResults[chunkIdx] = std::move(result);
+            });
+
+        T result = identity;
+        for (T& partialResult : partialResults)
+        {
+            result = reduceFunc(result, partialResult);
+        }
+        return result;
+    }
+
+    // Sorts the chunks in parallel, then merges them pairwise: log2(numChunks) rounds, the last one being a single serial merge
+    template <typename RandomIt, typename Compare = std::less<>>
+    void ParallelSort(RandomIt first, RandomIt last, Compare comp = Compare{})
+    {
+        const uint32_t count = (uint32_t)std::distance(first, last);
+        const uint32_t numChunks = GetNumChunks(count, 0, MinItemsPerSortChunk);
+        if (numChunks <= 1)
+        {
+            std::sort(first, last, comp);
+            return;
+        }
+
+        ParallelForChunks(count, numChunks, [first, &comp](uint32_t, uint32_t chunkBegin, uint32_t chunkEnd) { std::sort(first + chunkBegin, first + chunkEnd, comp); });
+
+        for (uint32_t width = 1; width < numChunks; width *= 2)
+        {
+            const uint32_t numMerges = (numChunks + 2 * width - 1) / (2 * width);
+            ParallelFor(0, numMerges, [&](uint32_t mergeIdx)
+                {
+                    const uint32_t loChunk = mergeIdx * 2 * width;
+                    const uint32_t midChunk = loChunk + width;
+                    if (midChunk >= numChunks)
+                        return;
+
+                    const uint32_t hiChunk = std::min(midChunk + width, numChunks);
+                    std::inplace_merge(first + GetChunkBegin(count, numChunks, loChunk),
+                                       first + GetChunkBegin(count, numChunks, midChunk),
+                                       first + GetChunkBegin(count, numChunks, hiChunk), comp);
+                }, 1);
+        }
+    }
+
+    namespace Private
+    {
+        template <bool Inclusive, typename RandomIt, typename OutputIt, typename T, typename BinaryOp>
+        void ParallelScan(RandomIt first, RandomIt last, OutputIt dFirst, const T& init, BinaryOp& op)
+        {
+            const uint32_t count = (uint32_t)std::distance(first, last);
+            const uint32_t numChunks = GetNumChunks(count, 0, MinItemsPerScanChunk);
+
+            auto ScanChunk = [first, dFirst, &op](T sum, uint32_t chunkBegin, uint32_t chunkEnd)
+            {
+                for (uint32_t i = chunkBegin; i < chunkEnd; ++i)
+                {
+                    // read before writing, so that scans can be done in place
+                    T newSum = op(sum, first[i]);
+                    dFirst[i] = Inclusive ? newSum : sum;
+                    sum = std::move(newSum);
+                }
+            };
+
+            if (numChunks <= 1)
+            {
+                ScanChunk(init, 0, count);
+                return;
+            }
+
+            // 1st pass: sum of every chunk but the last, turned into every chunk's starting offset.
+            // Chunk sums start from their first item, not from 'init': 'op' doesn't need an identity element, and 'init' is only applied once
+            std::vector<T> chunkOffsets(numChunks, init);
+            ParallelForChunks(numChunks - 1, numChunks - 1, [&](uint32_t chunkIdx, uint32_t, uint32_t)
+                {
+                    const uint32_t chunkBegin = GetChunkBegin(count, numChunks, chunkIdx);
+                    const uint32_t chunkEnd = GetChunkBegin(count, numChunks, chunkIdx + 1);
+
+                    T sum = first[chunkBegin];
+                    for (uint32_t i = chunkBegin + 1; i < chunkEnd; ++i)
+                    {
+                        sum = op(sum, first[i]);
+                    }
+                    chunkOffsets[chunkIdx + 1] = std::move(sum);
+                });
+
+            for (uint32_t chunkIdx = 1; chunkIdx < numChunks; ++chunkIdx)
+            {
+                chunkOffsets[chunkIdx] = op(chunkOffsets[chunkIdx - 1], chunkOffsets[chunkIdx]);
+            }
+
+            // 2nd pass: scan every chunk from its offset
+            ParallelForChunks(count, numChunks, [&](uint32_t chunkIdx, uint32_t chunkBegin, uint32_t chunkEnd) { ScanChunk(chunkOffsets[chunkIdx], chunkBegin, chunkEnd); });
+        }
+    }
+
+    // Same as std::inclusive_scan: dFirst[i] = op(init, first[0], ..., first[i]). 'op' must be associative. Can be done in place
+    template <typename RandomIt, typename OutputIt, typename T, typename BinaryOp = std::plus<>>
+    void ParallelInclusiveScan(RandomIt first, RandomIt last, OutputIt dFirst, const T& init, BinaryOp op = BinaryOp{})
+    {
+        Private::ParallelScan<true>(first, last, dFirst, init, op);
+    }
+
+    // Same as std::exclusive_scan: dFirst[i] = op(init, first[0], ..., first[i - 1]). 'op' must be associative. Can be done in place
+    template <typename RandomIt, typename OutputIt, typename T, typename BinaryOp = std::plus<>>
+    void ParallelExclusiveScan(RandomIt first, RandomIt last, OutputIt dFirst, const T& init, BinaryOp op = BinaryOp{})
+    {
+        Private::ParallelScan<false>(first, last, dFirst, init, op);
+    }
+}
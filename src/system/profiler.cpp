@@ -1,5 +1,6 @@
 #include <system/profiler.h>
 
+#include <system/imguimanager.h>
 #include <system/logger.h>
 
 #include <graphic/gfx/gfxcontext.h>
@@ -13,11 +14,23 @@ struct GPULog
 };
 thread_local GPULog tl_GPULog;
 
+static bool gs_ShowSpikeCaptureIMGUIWindow = false;
+static bool gs_ShowTraceCaptureIMGUIWindow = false;
+
 void SystemProfiler::Initialize()
 {
     //turn on profiling
     MicroProfileOnThreadCreate("Main");
     MicroProfileSetEnableAllGroups(true);
+
+    g_TraceRecorder.SetCurrentThreadName("Main");
+    TraceRecorder::SetEnabled(g_CommandLineOptions.m_TraceCapture);
+
+    m_SpikeCaptureEnabled = g_CommandLineOptions.m_SpikeCapture;
+
+    g_IMGUIManager.RegisterTopMenu("System", "Spike Capture", &gs_ShowSpikeCaptureIMGUIWindow);
+    g_IMGUIManager.RegisterTopMenu("System", "Trace Capture", &gs_ShowTraceCaptureIMGUIWindow);
+    g_IMGUIManager.RegisterWindowUpdateCB([&]() { UpdateIMGUI(); });
 }
 
 void SystemProfiler::RegisterGPUQueue(void* pDevice, void* pCommandQueue, const char* queueName)
@@ -69,11 +82,167 @@ void SystemProfiler::DumpProfilerBlocks(bool condition, bool immediately)
     }
     else
     {
-        // TODO: support auto dumping on CPU/GPU spike
+        // a spike capture is writing right now. Let it finish instead of stomping on microprofile's dump path
+        if (m_InFlightCaptureID != 0)
+            return;
+
         MicroProfileDumpFile(dumpFilePath.c_str(), nullptr, 0.0f, 0.0f);
     }
 }
 
+void SystemProfiler::WatchScope(const char* group, const char* name)
+{
+    assert(group);
+    assert(name);
+
+    WatchedScope& newScope = m_WatchedScopes.emplace_back();
+    newScope.m_Group = group;
+    newScope.m_Name = name;
+}
+
+void SystemProfiler::OnFrameEnd(double frameTimeMs)
+{
+    bbeProfileFunction();
+
+    // sampling watched scopes grabs microprofile's lock. Don't stall the main thread behind a capture being written
+    if (m_InFlightCaptureID == 0)
+    {
+        for (WatchedScope& scope : m_WatchedScopes)
+        {
+            scope.m_LastTimeMs = MicroProfileGetTime(scope.m_Group.c_str(), scope.m_Name.c_str());
+        }
+    }
+
+    if (m_PostSpikeFramesLeft > 0)
+    {
+        // keep recording a few frames after the spike, then dump. Spike frames are not added to the history
+        if (--m_PostSpikeFramesLeft == 0)
+        {
+            IssueSpikeCapture();
+        }
+        return;
+    }
+
+    const bool canCapture = m_SpikeCaptureEnabled &&
+                            m_InFlightCaptureID == 0 &&
+                            m_NbSpikeCaptures < m_MaxSpikeCapturesPerSession &&
+                            (!m_HadSpikeCapture || m_SpikeCooldownTimer.GetElapsedSeconds() > m_SpikeCooldownSeconds);
+
+    bool spikeDetected = false;
+    if (canCapture)
+    {
+        float thresholdMs = 0.0f;
+        if (frameTimeMs > m_SpikeAbsoluteBudgetMs)
+        {
+            RequestSpikeCapture("Frame", (float)frameTimeMs, m_SpikeAbsoluteBudgetMs);
+            spikeDetected = true;
+        }
+        else if (m_FrameTimesSpikeDetector.IsSpike((float)frameTimeMs, m_SpikeP95Multiplier, thresholdMs))
+        {
+            RequestSpikeCapture("Frame", (float)frameTimeMs, thresholdMs);
+            spikeDetected = true;
+        }
+
+        for (WatchedScope& scope : m_WatchedScopes)
+        {
+            if (!spikeDetected && scope.m_SpikeDetector.IsSpike(scope.m_LastTimeMs, m_SpikeP95Multiplier, thresholdMs))
+            {
+                RequestSpikeCapture(scope.m_Name.c_str(), scope.m_LastTimeMs, thresholdMs);
+                spikeDetected = true;
+            }
+        }
+    }
+
+    // keep outliers out of the history so that one hitch doesn't raise the threshold for the next ones
+    if (!spikeDetected)
+    {
+        m_FrameTimesSpikeDetector.AddValue((float)frameTimeMs);
+        for (WatchedScope& scope : m_WatchedScopes)
+        {
+            scope.m_SpikeDetector.AddValue(scope.m_LastTimeMs);
+        }
+    }
+}
+
+void SystemProfiler::RequestSpikeCapture(const char* source, float valueMs, float thresholdMs)
+{
+    m_LastSpikeReason = StringFormat("%s: %.2f ms (threshold: %.2f ms) at frame %u", source, valueMs, thresholdMs, g_System.GetSystemFrameNumber());
+    g_Log.warn("Spike detected. {}", m_LastSpikeReason);
+
+    m_PostSpikeFramesLeft = NbPostSpikeFrames;
+}
+
+void SystemProfiler::IssueSpikeCapture()
+{
+    bbeProfileFunction();
+
+    ++m_NbSpikeCaptures;
+    m_HadSpikeCapture = true;
+    m_SpikeCooldownTimer.Reset();
+
+    const uint32_t captureID = m_NbSpikeCaptures;
+    m_InFlightCaptureID = captureID;
+
+    // Released when the job is destroyed: after the dump, but also if the job is dropped without running at shutdown.
+    // Only clears its own capture, in case the worker releases the job after the next capture was issued
+    std::shared_ptr<void> inFlightGuard{ nullptr, [this, captureID](void*)
+        {
+            uint32_t expectedID = captureID;
+            m_InFlightCaptureID.compare_exchange_strong(expectedID, 0);
+        } };
+
+    const std::string dumpFilePath = StringFormat("..\\bin\\Profiler_Spike_%s.html", GetTimeStamp());
+    g_Log.info("Dumping spike profile capture {}", dumpFilePath.c_str());
+
+    // Writing the html takes a long time. Do it on a BG worker so the capture doesn't cause its own hitch
+    g_System.AddBGAsyncCommand([dumpFilePath, inFlightGuard]()
+        {
+            bbeProfile("Spike Capture");
+
+            MicroProfileDumpFile(dumpFilePath.c_str(), nullptr, 0.0f, 0.0f);
+        }, BGAsyncWorkerPool::Prefetch);
+}
+
+void SystemProfiler::SaveTrace(bool perfetto, double lastSeconds)
+{
+    const std::string traceFilePath = StringFormat("..\\bin\\Trace_%s.%s", GetTimeStamp(), perfetto ? "perfetto-trace" : "json");
+
+    // the recorder snapshots its rings on the calling thread. No need to block the frame for it
+    g_System.AddBGAsyncCommand([traceFilePath, perfetto, lastSeconds]()
+        {
+            if (perfetto)
+            {
+                g_TraceRecorder.WritePerfettoTrace(traceFilePath.c_str(), lastSeconds);
+            }
+            else
+            {
+                g_TraceRecorder.WriteChromeTrace(traceFilePath.c_str(), lastSeconds);
+            }
+        }, BGAsyncWorkerPool::Prefetch);
+}
+
+void SystemProfiler::UpdateIMGUI()
+{
+    UpdateTraceCaptureIMGUI();
+
+    if (!gs_ShowSpikeCaptureIMGUIWindow)
+        return;
+
+    ScopedIMGUIWindow window{ "Spike Capture" };
+
+    ImGui::Checkbox("Enabled", &m_SpikeCaptureEnabled);
+    ImGui::SliderFloat("P95 Multiplier", &m_SpikeP95Multiplier, 1.1f, 10.0f);
+    ImGui::SliderFloat("Absolute Budget (ms)", &m_SpikeAbsoluteBudgetMs, 5.0f, 500.0f);
+    ImGui::SliderFloat("Cooldown (s)", &m_SpikeCooldownSeconds, 0.0f, 300.0f);
+    ImGui::LabelText("Captures", "%u / %u", m_NbSpikeCaptures, m_MaxSpikeCapturesPerSession);
+    ImGui::LabelText("Last Spike", "%s", m_LastSpikeReason.c_str());
+
+    for (const WatchedScope& scope : m_WatchedScopes)
+    {
+        ImGui::LabelText(scope.m_Name.c_str(), "%.3f ms", scope.m_LastTimeMs);
+    }
+}
+
 int SystemProfiler::GetHandleForQueue(void* pCommandQueue) const
 {
     // Linear search... because we never will have more than 2+ queues
@@ -130,3 +299,30 @@ MicroProfileThreadLogGpu* SystemProfiler::GetGPULogForThread()
 {
     return tl_GPULog.m_GPULog;
 }
+
+void SystemProfiler::UpdateTraceCaptureIMGUI()
+{
+    if (!gs_ShowTraceCaptureIMGUIWindow)
+        return;
+
+    ScopedIMGUIWindow window{ "Trace Capture" };
+
+    bool traceEnabled = TraceRecorder::IsEnabled();
+    if (ImGui::Checkbox("Enabled", &traceEnabled))
+    {
+        TraceRecorder::SetEnabled(traceEnabled);
+    }
+
+    static float s_LastSeconds = 5.0f;
+    ImGui::SliderFloat("Last N Seconds", &s_LastSeconds, 0.0f, 60.0f);
+
+    if (ImGui::Button("Save Chrome Trace"))
+    {
+        SaveTrace(false, s_LastSeconds);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Save Perfetto Trace"))
+    {
+        SaveTrace(true, s_LastSeconds);
+    }
+}
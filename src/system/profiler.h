@@ -1,5 +1,8 @@
 #pragma once
 
+#include <system/spikedetector.h>
+#include <system/tracerecorder.h>
+
 struct MicroProfileThreadLogGpu;
 class GfxContext;
 class GfxCommandList;
@@ -14,6 +17,17 @@ public:
     void ShutDown();
     void OnFlip();
     void DumpProfilerBlocks(bool condition, bool immediately = false);
+
+    // Call once per frame after OnFlip. Feeds the spike detector & triggers a capture on CPU/GPU spikes
+    void OnFrameEnd(double frameTimeMs);
+
+    // Track the per-frame duration of a named scope (CPU or GPU). A spike in any watched scope also triggers a capture
+    void WatchScope(const char* group, const char* name);
+
+    // Saves the recorded timelines of the last 'lastSeconds' seconds on a BG thread. See TraceRecorder
+    void SaveTrace(bool perfetto, double lastSeconds);
+
+    void UpdateIMGUI();
     void SubmitGPULog();
     void ResetAllGPULogs();
     void BeginGPURecording(const GfxCommandList& cmdList);
@@ -23,6 +37,18 @@ public:
 private:
     int GetHandleForQueue(void*) const;
 
+    struct WatchedScope
+    {
+        std::string m_Group;
+        std::string m_Name;
+        float m_LastTimeMs = 0.0f;
+        SpikeDetector m_SpikeDetector;
+    };
+
+    void RequestSpikeCapture(const char* source, float valueMs, float thresholdMs);
+    void IssueSpikeCapture();
+    void UpdateTraceCaptureIMGUI();
+
     struct GPUQueueAndHandle
     {
         void* m_Queue;
@@ -31,25 +57,49 @@ private:
 
     InplaceArray<GPUQueueAndHandle, 2> m_GPUProfileHandles;
     InplaceArray<MicroProfileThreadLogGpu*, 16> m_AllGPULogs;
+
+    // Spike detector settings. Exposed in IMGUI
+    bool m_SpikeCaptureEnabled = false;
+    float m_SpikeP95Multiplier = 2.0f;
+    float m_SpikeAbsoluteBudgetMs = 50.0f;
+    float m_SpikeCooldownSeconds = 30.0f;
+    uint32_t m_MaxSpikeCapturesPerSession = 5;
+
+    // Frames to keep recording after the spike so the capture shows what came after it. Must stay well below MICROPROFILE_WEBSERVER_MAXFRAMES
+    static const uint32_t NbPostSpikeFrames = 10;
+
+    SpikeDetector m_FrameTimesSpikeDetector;
+    InplaceArray<WatchedScope, 8> m_WatchedScopes;
+
+    uint32_t m_NbSpikeCaptures = 0;
+    uint32_t m_PostSpikeFramesLeft = 0;
+    Timer m_SpikeCooldownTimer;
+    bool m_HadSpikeCapture = false;
+    std::string m_LastSpikeReason;
+
+    // microprofile holds its global lock while writing. Only one dump at a time. 0 == no capture in flight
+    std::atomic<uint32_t> m_InFlightCaptureID = 0;
 };
 #define g_Profiler SystemProfiler::GetInstance()
 
 #if defined(BBE_ENGINE)
     #define bbeDefineProfilerToken(var, group, name, color) MICROPROFILE_DEFINE(var, group, name, color)
-    #define bbeProfile(str)                                 MICROPROFILE_SCOPEI("", str, GetCompileTimeCRC32(str))
+    #define bbeProfile(str)                                 MICROPROFILE_SCOPEI("", str, GetCompileTimeCRC32(str)); const ScopedTraceEvent bbeUniqueVariable(traceEvent){ str, TraceRecorder::Scope }
     #define bbeProfileToken(token)                          MICROPROFILE_SCOPE(token)
-    #define bbeProfileFunction()                            MICROPROFILE_SCOPEI("", __FUNCTION__, GetCompileTimeCRC32(__FUNCTION__))
+    #define bbeProfileFunction()                            MICROPROFILE_SCOPEI("", __FUNCTION__, GetCompileTimeCRC32(__FUNCTION__)); const ScopedTraceEvent bbeUniqueVariable(traceEvent){ __FUNCTION__, TraceRecorder::Scope }
+    #define bbeProfileGroup(group, str)                     MICROPROFILE_SCOPEI(group, str, GetCompileTimeCRC32(str)); const ScopedTraceEvent bbeUniqueVariable(traceEvent){ str, TraceRecorder::Scope }
     #define bbeConditionalProfile(condition, name)          MICROPROFILE_CONDITIONAL_SCOPEI(condition, name, name, GetCompileTimeCRC32(name))
     #define bbeProfileBlockEnd()                            MICROPROFILE_LEAVE()
-    #define bbeProfileLock(lck)                             MICROPROFILE_SCOPEI("Locks", bbeTOSTRING(lck), 0xFF0000);
+    #define bbeProfileLock(lck)                             MICROPROFILE_SCOPEI("Locks", bbeTOSTRING(lck), 0xFF0000); const ScopedTraceEvent bbeUniqueVariable(traceEvent){ bbeTOSTRING(lck), TraceRecorder::Lock }
 #else
-    #define bbeDefineProfilerToken(var, group, name, color) __noop
-    #define bbeProfile(str)                                 __noop
-    #define bbeProfileToken(token)                          __noop
-    #define bbeProfileFunction()                            __noop
-    #define bbeConditionalProfile(condition, name)          __noop
-    #define bbeProfileBlockEnd()                            __noop
-    #define bbeProfileLock(lck)                             __noop
+    #define bbeDefineProfilerToken(var, group, name, color) ((void)0)
+    #define bbeProfile(str)                                 ((void)0)
+    #define bbeProfileToken(token)                          ((void)0)
+    #define bbeProfileFunction()                            ((void)0)
+    #define bbeProfileGroup(group, str)                     ((void)0)
+    #define bbeConditionalProfile(condition, name)          ((void)0)
+    #define bbeProfileBlockEnd()                            ((void)0)
+    #define bbeProfileLock(lck)                             ((void)0)
 #endif
 
 #if defined(BBE_USE_GPU_PROFILER)
@@ -0,0 +1,330 @@
+#include <system/random.h>
+
+// Float transforms are fused multiply-adds on both paths, so they round the same whatever the compiler contracts. Every AVX2 CPU has FMA3
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+    #define BBE_RANDOM_AVX2
+    #include <immintrin.h>
+#endif
+
+static uint64_t RotL(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+// Only used to expand seeds: consecutive seeds give uncorrelated states
+static uint64_t SplitMix64(uint64_t& state)
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void RandomGenerator::Seed(uint64_t seed)
+{
+    for (uint64_t& s : m_State)
+    {
+        s = SplitMix64(seed);
+    }
+}
+
+uint64_t RandomGenerator::Next()
+{
+    const uint64_t result = RotL(m_State[1] * 5, 7) * 9;
+    const uint64_t t = m_State[1] << 17;
+
+    m_State[2] ^= m_State[0];
+    m_State[3] ^= m_State[1];
+    m_State[1] ^= m_State[2];
+    m_State[0] ^= m_State[3];
+    m_State[2] ^= t;
+    m_State[3] = RotL(m_State[3], 45);
+
+    return result;
+}
+
+void RandomGenerator::Jump()
+{
+    static const uint64_t JumpPolynomial[] = { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+
+    uint64_t s[4]{};
+    for (uint64_t poly : JumpPolynomial)
+    {
+        for (int b = 0; b < 64; ++b)
+        {
+            if (poly & (1ULL << b))
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    s[i] ^= m_State[i];
+                }
+            }
+            Next();
+        }
+    }
+    memcpy(m_State, s, sizeof(s));
+}
+
+float RandomGenerator::NextFloat()
+{
+    // top 24 bits: every representable value is equally likely
+    return (Next() >> 40) * (1.0f / (1 << 24));
+}
+
+uint32_t RandomGenerator::NextUInt(uint32_t range)
+{
+    // Lemire's multiply-shift: no division, bias is at most range/2^32
+    return (uint32_t)(((Next() >> 32) * range) >> 32);
+}
+
+namespace RandomPrivate
+{
+    // Batches run 4 interleaved xoshiro256** streams, seeded from the caller's generator.
+    // Each step produces 4x64 bits, consumed as 8x32 bits in memory order. The scalar path emulates the exact same lanes, and handles the tails
+    static const uint32_t NumLanes = 4;
+    static const uint32_t ValuesPerStep = NumLanes * 2;
+
+    struct LaneStates
+    {
+        alignas(32) uint64_t m_S[4][NumLanes]; // [state word][lane], to load each word of all lanes at once
+
+        explicit LaneStates(RandomGenerator& gen)
+        {
+            for (uint32_t lane = 0; lane < NumLanes; ++lane)
+            {
+                uint64_t seed = gen.Next();
+                for (uint32_t word = 0; word < 4; ++word)
+                {
+                    m_S[word][lane] = SplitMix64(seed);
+                }
+            }
+        }
+
+        void NextScalar(uint32_t (&out)[ValuesPerStep])
+        {
+            for (uint32_t lane = 0; lane < NumLanes; ++lane)
+            {
+                uint64_t& s0 = m_S[0][lane];
+                uint64_t& s1 = m_S[1][lane];
+                uint64_t& s2 = m_S[2][lane];
+                uint64_t& s3 = m_S[3][lane];
+
+                const uint64_t result = RotL(s1 * 5, 7) * 9;
+                const uint64_t t = s1 << 17;
+                s2 ^= s0;
+                s3 ^= s1;
+                s1 ^= s2;
+                s0 ^= s3;
+                s2 ^= t;
+                s3 = RotL(s3, 45);
+
+                out[lane * 2 + 0] = (uint32_t)result;
+                out[lane * 2 + 1] = (uint32_t)(result >> 32);
+            }
+        }
+    };
+
+#if defined(BBE_RANDOM_AVX2)
+    template <int K>
+    static __m256i RotL256(__m256i x)
+    {
+        return _mm256_or_si256(_mm256_slli_epi64(x, K), _mm256_srli_epi64(x, 64 - K));
+    }
+
+    static __m256i Next256(__m256i& s0, __m256i& s1, __m256i& s2, __m256i& s3)
+    {
+        // x*5 = (x<<2)+x, x*9 = (x<<3)+x. AVX2 has no 64 bits multiply
+        const __m256i s1x5 = _mm256_add_epi64(_mm256_slli_epi64(s1, 2), s1);
+        const __m256i rotated = RotL256<7>(s1x5);
+        const __m256i result = _mm256_add_epi64(_mm256_slli_epi64(rotated, 3), rotated);
+
+        const __m256i t = _mm256_slli_epi64(s1, 17);
+        s2 = _mm256_xor_si256(s2, s0);
+        s3 = _mm256_xor_si256(s3, s1);
+        s1 = _mm256_xor_si256(s1, s2);
+        s0 = _mm256_xor_si256(s0, s3);
+        s2 = _mm256_xor_si256(s2, t);
+        s3 = RotL256<45>(s3);
+
+        return result;
+    }
+#endif
+
+    // Maps raw bits to [min, max)
+    struct FloatTransform
+    {
+        using OutputType = float;
+
+        float m_Scale;
+        float m_Offset;
+
+        FloatTransform(float min, float max) : m_Scale((max - min) * (1.0f / (1 << 24))), m_Offset(min) {}
+
+        float operator()(uint32_t bits) const { return std::fma((float)(bits >> 8), m_Scale, m_Offset); }
+
+#if defined(BBE_RANDOM_AVX2)
+        void Store(float* out, __m256i bits) const
+        {
+            // < 2^24, so the int -> float conversion is exact. Fused, like the scalar path
+            const __m256 values = _mm256_cvtepi32_ps(_mm256_srli_epi32(bits, 8));
+            _mm256_storeu_ps(out, _mm256_fmadd_ps(values, _mm256_set1_ps(m_Scale), _mm256_set1_ps(m_Offset)));
+        }
+#endif
+    };
+
+    // Maps raw bits to [0, range), Lemire's multiply-shift
+    struct UIntTransform
+    {
+        using OutputType = uint32_t;
+
+        uint32_t m_Range;
+
+        uint32_t operator()(uint32_t bits) const { return (uint32_t)(((uint64_t)bits * m_Range) >> 32); }
+
+#if defined(BBE_RANDOM_AVX2)
+        void Store(uint32_t* out, __m256i bits) const
+        {
+            // _mm256_mul_epu32 only multiplies the even 32 bits lanes
+            const __m256i range = _mm256_set1_epi64x(m_Range);
+            const __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(bits, range), 32);
+            const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(bits, 32), range);
+            _mm256_storeu_si256((__m256i*)out, _mm256_blend_epi32(even, odd, 0b10101010));
+        }
+#endif
+    };
+
+    template <typename Transform>
+    static void FillBatch(RandomGenerator& gen, typename Transform::OutputType* out, std::size_t count, const Transform& transform)
+    {
+        LaneStates lanes{ gen };
+
+        std::size_t i = 0;
+
+#if defined(BBE_RANDOM_AVX2)
+        __m256i s0 = _mm256_load_si256((const __m256i*)lanes.m_S[0]);
+        __m256i s1 = _mm256_load_si256((const __m256i*)lanes.m_S[1]);
+        __m256i s2 = _mm256_load_si256((const __m256i*)lanes.m_S[2]);
+        __m256i s3 = _mm256_load_si256((const __m256i*)lanes.m_S[3]);
+
+        for (; i + ValuesPerStep <= count; i += ValuesPerStep)
+        {
+            transform.Store(out + i, Next256(s0, s1, s2, s3));
+        }
+
+        // hand the state over to the scalar path for the tail
+        _mm256_store_si256((__m256i*)lanes.m_S[0], s0);
+        _mm256_store_si256((__m256i*)lanes.m_S[1], s1);
+        _mm256_store_si256((__m256i*)lanes.m_S[2], s2);
+        _mm256_store_si256((__m256i*)lanes.m_S[3], s3);
+#endif
+
+        for (; i < count; i += ValuesPerStep)
+        {
+            uint32_t bits[ValuesPerStep];
+            lanes.NextScalar(bits);
+
+            const std::size_t numValues = std::min<std::size_t>(ValuesPerStep, count - i);
+            for (std::size_t j = 0; j < numValues; ++j)
+            {
+                out[i + j] = transform(bits[j]);
+            }
+        }
+    }
+}
+
+void RandomGenerator::FillFloats(float* out, std::size_t count, float min, float max)
+{
+    RandomPrivate::FillBatch(*this, out, count, RandomPrivate::FloatTransform{ min, max });
+}
+
+void RandomGenerator::FillUInts(uint32_t* out, std::size_t count, uint32_t range)
+{
+    RandomPrivate::FillBatch(*this, out, count, RandomPrivate::UIntTransform{ range });
+}
+
+void RandomGenerator::FillVector3s(bbeVector3* out, std::size_t count, const bbeVector3& min, const bbeVector3& max)
+{
+    static_assert(sizeof(bbeVector3) == sizeof(float) * 3);
+
+    float* outFloats = reinterpret_cast<float*>(out);
+    FillFloats(outFloats, count * 3);
+
+    const float mins[3] = { min.x, min.y, min.z };
+    const float extents[3] = { max.x - min.x, max.y - min.y, max.z - min.z };
+    for (std::size_t i = 0; i < count * 3; ++i)
+    {
+        outFloats[i] = std::fma(outFloats[i], extents[i % 3], mins[i % 3]);
+    }
+}
+
+namespace RandomUtils
+{
+    static std::atomic<uint64_t> gs_MasterSeed = []
+    {
+        std::random_device randomDevice;
+        return ((uint64_t)randomDevice() << 32) | randomDevice();
+    }();
+    static std::atomic<uint32_t> gs_SeedGeneration = 0;
+
+    static std::atomic<WorkerIndexGetter> gs_WorkerIndexGetter = nullptr;
+
+    static const uint64_t InvalidStream = UINT64_MAX;
+
+    struct ThreadGenerator
+    {
+        RandomGenerator m_Generator;
+        uint64_t m_Stream = InvalidStream;
+        uint32_t m_SeedGeneration = UINT32_MAX;
+    };
+    static thread_local ThreadGenerator tl_Generator;
+
+    void SetMasterSeed(uint64_t seed)
+    {
+        gs_MasterSeed = seed;
+        gs_SeedGeneration++;
+    }
+
+    uint64_t GetMasterSeed()
+    {
+        return gs_MasterSeed;
+    }
+
+    void SetThreadStream(uint64_t stream)
+    {
+        assert(stream != InvalidStream);
+
+        // re-seeded on next use
+        tl_Generator.m_Stream = stream;
+        tl_Generator.m_SeedGeneration = UINT32_MAX;
+    }
+
+    void SetThreadStream(const char* threadName)
+    {
+        SetThreadStream(HashUtils::XXH3_64(threadName, strlen(threadName)));
+    }
+
+    void SetWorkerIndexGetter(WorkerIndexGetter getter)
+    {
+        gs_WorkerIndexGetter = getter;
+    }
+
+    RandomGenerator& GetThreadGenerator()
+    {
+        const uint32_t seedGeneration = gs_SeedGeneration.load(std::memory_order_acquire);
+        if (tl_Generator.m_SeedGeneration != seedGeneration)
+        {
+            if (tl_Generator.m_Stream == InvalidStream)
+            {
+                // never from the order threads show up in: that changes from run to run
+                const WorkerIndexGetter workerIndexGetter = gs_WorkerIndexGetter;
+                const int workerIdx = workerIndexGetter ? workerIndexGetter() : -1;
+                tl_Generator.m_Stream = workerIdx >= 0 ? (uint64_t)workerIdx + 1 : MainThreadStream;
+            }
+
+            tl_Generator.m_SeedGeneration = seedGeneration;
+            tl_Generator.m_Generator.Seed(HashUtils::Combine(gs_MasterSeed, tl_Generator.m_Stream));
+        }
+
+        return tl_Generator.m_Generator;
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+// xoshiro256** (Blackman & Vigna): 32 bytes of state, a handful of ALU ops per value. Not for cryptography
+class RandomGenerator
+{
+public:
+    using result_type = uint64_t;
+
+    explicit RandomGenerator(uint64_t seed = 0) { Seed(seed); }
+
+    void Seed(uint64_t seed);
+
+    // Advances the state by 2^128 values. Calling it N times on copies of a generator gives N non-overlapping streams
+    void Jump();
+
+    uint64_t Next();
+    float NextFloat();                  // [0, 1)
+    uint32_t NextUInt(uint32_t range);  // [0, range)
+
+    // Batch versions, AVX2 when available. Results only depend on the generator state, not on the instruction set or the compiler's FP contraction settings
+    void FillFloats(float* out, std::size_t count, float min = 0.0f, float max = 1.0f);
+    void FillUInts(uint32_t* out, std::size_t count, uint32_t range);
+    void FillVector3s(bbeVector3* out, std::size_t count, const bbeVector3& min, const bbeVector3& max);
+
+    // UniformRandomBitGenerator, so it works with <random> distributions & std::shuffle
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+    result_type operator()() { return Next(); }
+
+private:
+    uint64_t m_State[4];
+};
+
+namespace RandomUtils
+{
+    // Every thread's generator is seeded from the master seed & the thread's stream, so a given seed replays the same values on the same threads, whatever order they start in.
+    // Changing it re-seeds all thread generators on their next use
+    void SetMasterSeed(uint64_t seed);
+    uint64_t GetMasterSeed();
+
+    // Streams: tasks executor workers use their worker index, other threads use MainThreadStream unless they pick their own (i.e. from their thread name)
+    static const uint64_t MainThreadStream = 0;
+    void SetThreadStream(uint64_t stream);
+    void SetThreadStream(const char* threadName);
+
+    // Set by the owner of the tasks executor: returns the calling thread's worker index, or -1 if it's not one of its workers
+    using WorkerIndexGetter = int(*)();
+    void SetWorkerIndexGetter(WorkerIndexGetter getter);
+
+    // Lock-free, one per thread
+    RandomGenerator& GetThreadGenerator();
+}
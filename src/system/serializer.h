@@ -11,7 +11,7 @@ public:
     bool Read(ArchiveType archiveType, const char* fileName, T&& var)
     {
         if (archiveType == Binary)
-            return ReadInternal<cereal::BinaryInputArchive>(fileName, std::forward<T>(var));
+            return ReadInternal<MappedBinaryInputArchive>(fileName, std::forward<T>(var));
         else
             return ReadInternal<cereal::JSONInputArchive>(fileName, std::forward<T>(var));
     }
@@ -20,7 +20,7 @@ public:
     void Write(ArchiveType archiveType, const char* fileName, T&& var)
     {
         if (archiveType == Binary)
-            WriteInternal<cereal::BinaryOutputArchive>(fileName, std::forward<T>(var));
+            WriteInternal<MappedBinaryOutputArchive>(fileName, std::forward<T>(var));
         else
             WriteInternal<cereal::JSONOutputArchive>(fileName, std::forward<T>(var));
     }
@@ -32,10 +32,10 @@ public:
     static bool IsWriting() { return std::is_base_of_v<cereal::detail::OutputArchiveBase, CerealArchiveType>; }
 
     template <typename CerealArchiveType>
-    static bool IsBinaryArchive() { return std::is_same_v<CerealArchiveType, cereal::BinaryInputArchive> || std::is_same_v<CerealArchiveType, cereal::BinaryOutputArchive>; }
+    static constexpr bool IsBinaryArchive() { return std::is_same_v<CerealArchiveType, MappedBinaryInputArchive> || std::is_same_v<CerealArchiveType, MappedBinaryOutputArchive>; }
 
     template <typename CerealArchiveType>
-    static bool IsJSONArchive() { return std::is_same_v<CerealArchiveType, cereal::JSONInputArchive> || std::is_same_v<CerealArchiveType, cereal::JSONOutputArchive>; }
+    static constexpr bool IsJSONArchive() { return std::is_same_v<CerealArchiveType, cereal::JSONInputArchive> || std::is_same_v<CerealArchiveType, cereal::JSONOutputArchive>; }
 
 private:
     template <typename CerealArchiveType>
@@ -47,11 +47,34 @@ private:
     template <typename CerealArchiveType, typename T>
     bool ReadInternal(const char* fileName, T&& var)
     {
-        std::ifstream stream{ (m_AssetsDir + fileName + GetFileExtention<CerealArchiveType>()).c_str() };
-        if (stream)
+        const std::string filePath = m_AssetsDir + fileName + GetFileExtention<CerealArchiveType>();
+
+        if constexpr (IsBinaryArchive<CerealArchiveType>())
         {
-            CerealArchiveType{ stream }(std::forward<T>(var));
-            return true;
+            // binary files are mapped, and memcpy-able arrays are read with a single copy
+            CerealArchiveType archive{ filePath.c_str() };
+            if (archive.IsValid())
+            {
+                // corrupted or truncated files: report it, the caller falls back to defaults
+                try
+                {
+                    archive(std::forward<T>(var));
+                    return true;
+                }
+                catch (const cereal::Exception& e)
+                {
+                    g_Log.error("Failed to read '{}': {}", filePath, e.what());
+                }
+            }
+        }
+        else
+        {
+            std::ifstream stream{ filePath.c_str() };
+            if (stream)
+            {
+                CerealArchiveType{ stream }(std::forward<T>(var));
+                return true;
+            }
         }
         return false;
     }
@@ -59,14 +82,42 @@ private:
     template <typename CerealArchiveType, typename T>
     void WriteInternal(const char* fileName, T&& var)
     {
-        std::ofstream stream{ (m_AssetsDir + fileName + GetFileExtention<CerealArchiveType>()).c_str() };
-        CerealArchiveType{ stream }(std::forward<T>(var));
+        const std::string filePath = m_AssetsDir + fileName + GetFileExtention<CerealArchiveType>();
+
+        if constexpr (IsBinaryArchive<CerealArchiveType>())
+        {
+            CerealArchiveType archive{ filePath.c_str() };
+            if (archive.IsValid())
+            {
+                archive(std::forward<T>(var));
+            }
+        }
+        else
+        {
+            std::ofstream stream{ filePath.c_str() };
+            CerealArchiveType{ stream }(std::forward<T>(var));
+        }
     }
 
     const std::string& m_AssetsDir = GetAssetsDirectory();
 };
 #define g_Serializer Serializer::GetInstance()
 
+// math types are plain floats & ints: binary archives copy them, and arrays of them, as a whole
+DeclareMemcpySerializable(bbeVector2);
+DeclareMemcpySerializable(bbeVector2I);
+DeclareMemcpySerializable(bbeVector2U);
+DeclareMemcpySerializable(bbeVector3);
+DeclareMemcpySerializable(bbeVector3I);
+DeclareMemcpySerializable(bbeVector3U);
+DeclareMemcpySerializable(bbeVector4);
+DeclareMemcpySerializable(bbeVector4I);
+DeclareMemcpySerializable(bbeVector4U);
+DeclareMemcpySerializable(bbePlane);
+DeclareMemcpySerializable(bbeQuaternion);
+DeclareMemcpySerializable(bbeColor);
+DeclareMemcpySerializable(bbeMatrix);
+
 // helper Serialization functions for math types
 namespace cereal
 {
@@ -78,8 +129,15 @@ namespace cereal
                                                                      > = traits::sfinae>
     void Serialize(Archive& ar, VectorType& vec)
     {
-        ar(vec.x);
-        ar(vec.y);
+        if constexpr (Serializer::IsBinaryArchive<Archive>())
+        {
+            ar(binary_data(&vec, sizeof(vec)));
+        }
+        else
+        {
+            ar(vec.x);
+            ar(vec.y);
+        }
     }
 
     // 3D vector types
@@ -90,9 +148,16 @@ namespace cereal
                                                                      > = traits::sfinae>
     void Serialize(Archive& ar, VectorType& vec)
     {
-        ar(vec.x);
-        ar(vec.y);
-        ar(vec.z);
+        if constexpr (Serializer::IsBinaryArchive<Archive>())
+        {
+            ar(binary_data(&vec, sizeof(vec)));
+        }
+        else
+        {
+            ar(vec.x);
+            ar(vec.y);
+            ar(vec.z);
+        }
     }
 
     // 4D vector types
@@ -106,10 +171,17 @@ namespace cereal
                                                                      > = traits::sfinae>
     void Serialize(Archive& ar, VectorType& vec)
     {
-        ar(vec.x);
-        ar(vec.y);
-        ar(vec.z);
-        ar(vec.w);
+        if constexpr (Serializer::IsBinaryArchive<Archive>())
+        {
+            ar(binary_data(&vec, sizeof(vec)));
+        }
+        else
+        {
+            ar(vec.x);
+            ar(vec.y);
+            ar(vec.z);
+            ar(vec.w);
+        }
     }
 
     // Matrix type
@@ -121,7 +193,7 @@ namespace cereal
 }
 
 #define ForwardDeclareSerializerFunctions(ClassName)                                           \
-template void ClassName::Serialize<cereal::BinaryInputArchive>(cereal::BinaryInputArchive&);   \
-template void ClassName::Serialize<cereal::BinaryOutputArchive>(cereal::BinaryOutputArchive&); \
+template void ClassName::Serialize<MappedBinaryInputArchive>(MappedBinaryInputArchive&);       \
+template void ClassName::Serialize<MappedBinaryOutputArchive>(MappedBinaryOutputArchive&);     \
 template void ClassName::Serialize<cereal::JSONInputArchive>(cereal::JSONInputArchive&);       \
 template void ClassName::Serialize<cereal::JSONOutputArchive>(cereal::JSONOutputArchive&);
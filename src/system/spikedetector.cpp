@@ -0,0 +1,16 @@
+#include <system/spikedetector.h>
+
+bool SpikeDetector::IsSpike(float value, float p95Multiplier, float& outThreshold)
+{
+    if (m_History.size() < MinValuesBeforeDetection)
+        return false;
+
+    // rolling p95 of the history, excluding the current value
+    m_PercentileScratch.assign(m_History.begin(), m_History.end());
+
+    const size_t p95Idx = (m_PercentileScratch.size() * 95) / 100;
+    std::nth_element(m_PercentileScratch.begin(), m_PercentileScratch.begin() + p95Idx, m_PercentileScratch.end());
+
+    outThreshold = m_PercentileScratch[p95Idx] * p95Multiplier;
+    return value > outThreshold;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+// Flags values above a multiple of the rolling p95 of the previous values. Used by the profiler to trigger spike captures
+class SpikeDetector
+{
+public:
+    static const uint32_t NbHistoryValues = 256;
+
+    // Don't trust the rolling p95 until enough values were seen (i.e. skip loading hitches at boot)
+    static const uint32_t MinValuesBeforeDetection = 64;
+
+    bool IsSpike(float value, float p95Multiplier, float& outThreshold);
+
+    // Only add values that are not spikes: one hitch must not raise the threshold for the next ones
+    void AddValue(float value) { m_History.push_back(value); }
+
+private:
+    CircularBuffer<float> m_History{ NbHistoryValues };
+    std::vector<float> m_PercentileScratch;
+};
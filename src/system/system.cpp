@@ -59,55 +59,37 @@ void System::ProcessWindowsMessage(HWND hWnd, UINT message, WPARAM wParam, LPARA
     g_IMGUIManager.ProcessWindowsMessage(hWnd, message, wParam, lParam);
 }
 
-static void BusyWaitUntilFPSLimit(Timer& timer)
+void System::BuildFrameTaskflow()
 {
     bbeProfileFunction();
 
-    const uint64_t ticksToFPSLimit = Timer::MilliSecondsToTicks(1000.0 / g_CommandLineOptions.m_FPSLimit);
+    // Built once, and re-run every frame. Anything that varies per frame must be expressed inside the tasks (i.e. subflows or condition tasks)
+    m_FrameTaskflow.clear();
 
-    // TODO: Find a way to NOT spin wait to fps cap
-#if 0
-    const uint64_t ticksSoFar = timer.GetElapsedTicks();
+    // run System commands first
+    tf::Task systemCommandsGate = m_FrameTaskflow.emplace([this](tf::Subflow& subFlow) { m_SystemCommandManager.ConsumeAllCommandsMT(subFlow); });
 
-    // beyond FPS limit... return
-    if (ticksSoFar >= ticksToFPSLimit)
-        return;
-
-    // ticks left
-    LARGE_INTEGER liDueTime{};
-    liDueTime.QuadPart = -(LONGLONG)(ticksToFPSLimit - ticksSoFar);
-
-    static ::HANDLE FPSTimer = ::CreateWaitableTimer(nullptr, true, nullptr);
-    bool result = ::SetWaitableTimer(FPSTimer, &liDueTime, 0, NULL, NULL, 0);
-    assert(result);
-
-    // wait until fps cap
-    WaitForSingleObject(FPSTimer, INFINITE);
-#endif
-
-    while (timer.GetElapsedTicks() < ticksToFPSLimit) { std::this_thread::yield(); }
+    m_FrameTaskflow.emplace([](tf::Subflow& subFlow) { UpdateGraphic(subFlow); }).succeed(systemCommandsGate);
+    m_FrameTaskflow.emplace([](tf::Subflow& subFlow) { UpdateApplicationLayer(subFlow); }).succeed(systemCommandsGate);
+    m_FrameTaskflow.emplace([]() { g_IMGUIManager.Update(); }).succeed(systemCommandsGate);
 }
 
 void System::Loop()
 {
     g_Log.info("Entering main loop");
 
+    BuildFrameTaskflow();
+
     do
     {
         Timer frameTimer;
 
         RunKeyboardCommands();
 
-        // run System commnads first
-        tf::Taskflow tf;
-        tf.emplace([this](tf::Subflow& subFlow) { m_SystemCommandManager.ConsumeAllCommandsMT(subFlow); });
-        m_Executor.run(tf).wait();
-        tf.clear();
+        m_Executor.run(m_FrameTaskflow).wait();
 
-        tf.emplace([](tf::Subflow& subFlow) { UpdateGraphic(subFlow); });
-        tf.emplace([](tf::Subflow& subFlow) { UpdateApplicationLayer(subFlow); });
-        tf.emplace([]() { g_IMGUIManager.Update(); });
-        m_Executor.run(tf).wait();
+        g_IMGUIManager.EndFrame();
+        g_FrameArena.EndFrame();
 
         // make sure I/O ticks happen last
         g_Keyboard.Tick();
@@ -116,11 +98,13 @@ void System::Loop()
 
         g_Profiler.OnFlip();
 
-        BusyWaitUntilFPSLimit(frameTimer);
+        m_FramePacer.WaitUntilFrameBudget(frameTimer, Timer::MilliSecondsToTicks(1000.0 / g_CommandLineOptions.m_FPSLimit));
 
         const double elapsedMS = frameTimer.GetElapsedMilliSeconds();
         g_System.m_FrameTimeMs = elapsedMS;
         g_System.m_FPS = 1000.0 / elapsedMS;
+        m_FramePacer.AddFrameTime(elapsedMS);
+        g_Profiler.OnFrameEnd(elapsedMS);
     } while (!m_Exit);
 
     g_Log.info("Exiting main loop");
@@ -131,28 +115,30 @@ void System::RunKeyboardCommands()
     g_Profiler.DumpProfilerBlocks(g_Keyboard.IsKeyPressed(Keyboard::KEY_P));
 }
 
-void System::BGAsyncThreadLoop()
-{
-    MicroProfileOnThreadCreate("BG Async Thread");
-
-    do
-    {
-        const bool ConsumeAllCmdsRecursive = true;
-        m_BGAsyncCommandManager.ConsumeAllCommandsST(ConsumeAllCmdsRecursive);
-
-        ::Sleep(1);
-    }while (!m_BGAsyncThreadExit);
-}
-
 void System::Initialize()
 {
     g_Profiler.Initialize();
+    g_Profiler.WatchScope("Graphic", "GfxManager::ScheduleGraphicTasks");
 
     {
         bbeProfileFunction();
 
-        m_BGAsyncCommandManager.Initialize();
-        m_BGAsyncThread = std::thread([&]() { BGAsyncThreadLoop(); });
+        g_Log.info("SIMD memcpy using {}", GetSIMDMemInstructionSetName());
+
+        // per thread random streams follow the workers' indices, not the order they first ask for values in
+        RandomUtils::SetWorkerIndexGetter([] { return g_TasksExecutor.this_worker_id(); });
+        if (g_CommandLineOptions.m_RandomSeed != 0)
+        {
+            RandomUtils::SetMasterSeed(g_CommandLineOptions.m_RandomSeed);
+        }
+        g_Log.info("Random master seed: {}", RandomUtils::GetMasterSeed());
+
+        g_FrameArena.Initialize(g_CommandLineOptions.m_ArenaHugePages);
+        m_BGAsyncWorkerPool.Initialize(g_CommandLineOptions.m_BGAsyncWorkers);
+        g_AsyncFileIO.Initialize(g_CommandLineOptions.m_FileIOWorkers);
+        m_FramePacer.Initialize();
+        LockContentionProfiler::SetEnabled(g_CommandLineOptions.m_LockContention);
+        g_LockContentionProfiler.Initialize();
 
         m_SystemCommandManager.Initialize();
 
@@ -177,20 +163,27 @@ void System::Shutdown()
         const bool ConsumeAllCmdsRecursive = true;
         m_SystemCommandManager.ConsumeAllCommandsST(ConsumeAllCmdsRecursive);
 
+        // no more reads completing into systems that are shutting down
+        g_AsyncFileIO.ShutDown();
+
         g_IMGUIManager.ShutDown();
         ShutdownApplicationLayer();
         ShutdownGraphic();
 
-        {
-            bbeProfile("Wait BG Async Thread Done");
+        m_BGAsyncWorkerPool.ShutDown();
+        m_FramePacer.ShutDown();
 
-            m_BGAsyncThreadExit = true;
-            m_BGAsyncThread.join();
-        }
+        // BG jobs may still allocate from the frame arena until the pool is shut down
+        g_FrameArena.ShutDown();
     }
 
     g_Profiler.DumpProfilerBlocks(g_CommandLineOptions.m_ProfileShutdown, true);
     g_Profiler.ShutDown();
+
+#if defined(BBE_LOCK_CONTENTION_STATS)
+    if (LockContentionProfiler::IsEnabled())
+        g_LockContentionProfiler.WriteCSV(StringFormat("..\\bin\\LockContention_%s.csv", GetTimeStamp()));
+#endif
 }
 
 void CommandLineOptions::Parse()
@@ -198,9 +191,16 @@ void CommandLineOptions::Parse()
     ArgumentParser parser("Argument Parser");
 
     parser.add_argument("--fpslimit", "fpslimit");
+    parser.add_argument("--bgasyncworkers", "bgasyncworkers");
+    parser.add_argument("--fileioworkers", "fileioworkers");
+    parser.add_argument("--randomseed", "randomseed");
     parser.add_argument("--pixcapture", "pixcapture");
     parser.add_argument("--profileinit", "profileinit");
     parser.add_argument("--profileshutdown", "profileshutdown");
+    parser.add_argument("--spikecapture", "spikecapture");
+    parser.add_argument("--tracecapture", "tracecapture");
+    parser.add_argument("--lockcontention", "lockcontention");
+    parser.add_argument("--arenahugepages", "arenahugepages");
     parser.add_argument("--resolution", "resolution");
     parser.add_argument("--gfxdebuglayer", "gfxdebuglayer");
 
@@ -216,12 +216,31 @@ void CommandLineOptions::Parse()
     m_PIXCapture      = parser.exists("pixcapture");
     m_ProfileInit     = parser.exists("profileinit");
     m_ProfileShutdown = parser.exists("profileshutdown");
+    m_SpikeCapture    = parser.exists("spikecapture");
+    m_TraceCapture    = parser.exists("tracecapture");
+    m_LockContention  = parser.exists("lockcontention");
+    m_ArenaHugePages  = parser.exists("arenahugepages");
 
     if (parser.exists("fpslimit"))
     {
         m_FPSLimit = parser.get<uint32_t>("fpslimit");
     }
 
+    if (parser.exists("bgasyncworkers"))
+    {
+        m_BGAsyncWorkers = std::max(parser.get<uint32_t>("bgasyncworkers"), 1U);
+    }
+
+    if (parser.exists("fileioworkers"))
+    {
+        m_FileIOWorkers = std::max(parser.get<uint32_t>("fileioworkers"), 1U);
+    }
+
+    if (parser.exists("randomseed"))
+    {
+        m_RandomSeed = parser.get<uint32_t>("randomseed");
+    }
+
     if (parser.exists("resolution"))
     {
         const std::vector<uint32_t> resolution = parser.getv<uint32_t>("resolution");
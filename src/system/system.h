@@ -1,6 +1,8 @@
 #pragma once
 
+#include <system/bgasyncworkerpool.h>
 #include <system/commandmanager.h>
+#include <system/framepacer.h>
 
 class System
 {
@@ -13,10 +15,12 @@ public:
     void Loop();
 
     template <typename Lambda>
-    void AddSystemCommand(Lambda&& lambda) { m_SystemCommandManager.AddCommand(std::forward<Lambda>(lambda)); }
+    void AddSystemCommand(Lambda&& lambda, CommandProperties properties = {}) { m_SystemCommandManager.AddCommand(std::forward<Lambda>(lambda), properties); }
 
     template <typename Lambda>
-    void AddBGAsyncCommand(Lambda&& lambda) { m_BGAsyncCommandManager.AddCommand(std::forward<Lambda>(lambda)); }
+    BGAsyncWorkerPool::JobID AddBGAsyncCommand(Lambda&& lambda, BGAsyncWorkerPool::Priority priority = BGAsyncWorkerPool::Default) { return m_BGAsyncWorkerPool.AddJob(std::forward<Lambda>(lambda), priority); }
+
+    bool CancelBGAsyncCommand(BGAsyncWorkerPool::JobID id) { return m_BGAsyncWorkerPool.CancelJob(id); }
 
     double GetFrameTimeMs() { return m_FrameTimeMs; }
     double GetFPS()         { return m_FPS; }
@@ -30,21 +34,21 @@ public:
 
 private:
     void RunKeyboardCommands();
-    void BGAsyncThreadLoop();
+    void BuildFrameTaskflow();
 
     CommandManager m_SystemCommandManager;
-    CommandManager m_BGAsyncCommandManager;
+    BGAsyncWorkerPool m_BGAsyncWorkerPool;
+    FramePacer m_FramePacer;
 
     ::HWND m_EngineWindowHandle = nullptr;
 
     bool m_Exit = false;
-    bool m_BGAsyncThreadExit = false;
 
     double m_FPS = 0.0;
     double m_FrameTimeMs = 0.0;
 
     tf::Executor m_Executor;
-    std::thread m_BGAsyncThread;
+    tf::Taskflow m_FrameTaskflow;
 
     uint32_t m_SystemFrameNumber = 0;
 };
@@ -58,9 +62,16 @@ struct CommandLineOptions
     void Parse();
 
     uint32_t m_FPSLimit        = 200;
+    uint32_t m_BGAsyncWorkers  = 2;
+    uint32_t m_FileIOWorkers   = 2;
+    uint32_t m_RandomSeed      = 0; // 0: random master seed
     bool     m_PIXCapture      = false;
     bool     m_ProfileInit     = false;
     bool     m_ProfileShutdown = false;
+    bool     m_SpikeCapture    = false;
+    bool     m_TraceCapture    = false;
+    bool     m_LockContention  = false;
+    bool     m_ArenaHugePages  = false;
     uint32_t m_WindowWidth     = 1600;
     uint32_t m_WindowHeight    = 900;
 
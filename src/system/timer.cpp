@@ -4,24 +4,39 @@ struct StepTimerStaticsInitializer
 {
     StepTimerStaticsInitializer()
     {
-        QueryPerformanceFrequency(&Timer::ms_QPCFrequency);
+#if defined(_WIN32)
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        Timer::ms_CounterFrequency = frequency.QuadPart;
+#else
+        Timer::ms_CounterFrequency = std::chrono::steady_clock::period::den / std::chrono::steady_clock::period::num;
+#endif
     }
 };
 static StepTimerStaticsInitializer g_StepTimerStaticsInitializer;
 
+uint64_t Timer::ReadCounter()
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return counter.QuadPart;
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
 uint64_t Timer::Tick()
 {
     // Query the current time.
-    LARGE_INTEGER currentTime;
-    QueryPerformanceCounter(&currentTime);
+    const uint64_t currentCounter = ReadCounter();
 
-    uint64_t timeDelta = currentTime.QuadPart - m_QPCStartTime.QuadPart;
+    uint64_t timeDelta = currentCounter - m_StartCounter;
 
-    m_QPCStartTime = currentTime;
+    m_StartCounter = currentCounter;
 
-    // Convert QPC units into a canonical tick format
-    timeDelta *= TicksPerSecond;
-    timeDelta /= ms_QPCFrequency.QuadPart;
+    // Convert QPC units into a canonical tick format. Whole seconds first, so nanosecond counters don't overflow
+    timeDelta = (timeDelta / ms_CounterFrequency) * TicksPerSecond + ((timeDelta % ms_CounterFrequency) * TicksPerSecond) / ms_CounterFrequency;
 
     // Variable timestep update logic.
     m_ElapsedTicks += timeDelta;
@@ -8,7 +8,7 @@ public:
 
     void Reset() 
     {
-        QueryPerformanceCounter(&m_QPCStartTime);
+        m_StartCounter = ReadCounter();
         m_ElapsedTicks = 0;
     }
 
@@ -32,10 +32,12 @@ public:
     uint64_t Tick();
 
 protected:
+    // QPC on Windows, steady_clock elsewhere
+    static uint64_t ReadCounter();
 
     // Source timing data uses QPC units.
-    inline static LARGE_INTEGER ms_QPCFrequency;
-    LARGE_INTEGER               m_QPCStartTime;
+    inline static uint64_t ms_CounterFrequency;
+    uint64_t               m_StartCounter;
 
     // Derived timing data uses a canonical tick format.
     uint64_t m_ElapsedTicks = 0;
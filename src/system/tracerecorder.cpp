@@ -0,0 +1,298 @@
+#include <system/tracerecorder.h>
+
+thread_local TraceRecorder::ThreadTraceRing* TraceRecorder::ms_ThreadTraceRing = nullptr;
+
+static const char* gs_TraceCategoryNames[] = { "Scope", "Lock" };
+static_assert(std::size(gs_TraceCategoryNames) == TraceRecorder::NbCategories);
+
+// Every thread is reported under the same fake process
+static const uint32_t gs_TracePID = 1;
+
+namespace TraceRecorderPrivate
+{
+    // Minimal protobuf encoder for the few Perfetto messages we need
+    class ProtoWriter
+    {
+    public:
+        enum WireType : uint32_t { VarInt = 0, LengthDelimited = 2 };
+
+        void VarIntValue(uint64_t v)
+        {
+            while (v >= 0x80)
+            {
+                m_Buffer.push_back((char)((v & 0x7F) | 0x80));
+                v >>= 7;
+            }
+            m_Buffer.push_back((char)v);
+        }
+
+        void Tag(uint32_t field, WireType wireType) { VarIntValue((field << 3) | wireType); }
+        void UInt(uint32_t field, uint64_t v)       { Tag(field, VarInt); VarIntValue(v); }
+
+        void String(uint32_t field, std::string_view str)
+        {
+            Tag(field, LengthDelimited);
+            VarIntValue(str.size());
+            m_Buffer.append(str.data(), str.size());
+        }
+
+        template <typename Lambda>
+        void Message(uint32_t field, Lambda&& writeBody)
+        {
+            ProtoWriter nested;
+            writeBody(nested);
+            String(field, nested.m_Buffer);
+        }
+
+        void Clear() { m_Buffer.clear(); }
+        const std::string& GetBuffer() const { return m_Buffer; }
+
+    private:
+        std::string m_Buffer;
+    };
+
+    // Perfetto field numbers. See perfetto/protos/perfetto/trace/trace_packet.proto & track_event/*.proto
+    namespace Perfetto
+    {
+        enum TraceFields                 { Trace_Packet = 1 };
+        enum TracePacketFields           { Packet_Timestamp = 8, Packet_TrustedPacketSequenceID = 10, Packet_TrackEvent = 11, Packet_TrackDescriptor = 60 };
+        enum TrackDescriptorFields       { Track_UUID = 1, Track_Thread = 4 };
+        enum ThreadDescriptorFields      { Thread_PID = 1, Thread_TID = 2, Thread_Name = 5 };
+        enum TrackEventFields            { Event_Type = 9, Event_TrackUUID = 11, Event_Categories = 22, Event_Name = 23 };
+        enum TrackEventType              { SliceBegin = 1, SliceEnd = 2 };
+    }
+
+    static void WriteJSONString(FILE* file, const char* str)
+    {
+        fputc('"', file);
+        for (; *str; ++str)
+        {
+            if (*str == '"' || *str == '\\')
+                fputc('\\', file);
+            fputc(*str, file);
+        }
+        fputc('"', file);
+    }
+}
+
+void TraceRecorder::SetCurrentThreadName(const char* name)
+{
+    ThreadTraceRing& ring = GetThreadTraceRing();
+
+    std::lock_guard<std::mutex> lock{ m_RingsLock };
+    ring.m_ThreadName = name;
+}
+
+TraceRecorder::ThreadTraceRing& TraceRecorder::GetThreadTraceRing()
+{
+    if (!ms_ThreadTraceRing)
+    {
+        std::unique_ptr<ThreadTraceRing> newRing = std::make_unique<ThreadTraceRing>();
+        ms_ThreadTraceRing = newRing.get();
+
+        std::lock_guard<std::mutex> lock{ m_RingsLock };
+        newRing->m_ThreadIdx = (uint32_t)m_AllRings.size() + 1;
+        newRing->m_ThreadName = StringFormat("Thread %u", newRing->m_ThreadIdx);
+        m_AllRings.push_back(std::move(newRing));
+    }
+
+    return *ms_ThreadTraceRing;
+}
+
+uint32_t TraceRecorder::GetNbAllocatedRings()
+{
+    std::lock_guard<std::mutex> lock{ m_RingsLock };
+    return (uint32_t)std::count_if(m_AllRings.begin(), m_AllRings.end(), [](const std::unique_ptr<ThreadTraceRing>& ring) { return ring->m_Events != nullptr; });
+}
+
+void TraceRecorder::RecordEvent(const char* name, Category category, uint64_t beginNs, uint64_t endNs)
+{
+    ThreadTraceRing& ring = GetThreadTraceRing();
+
+    // only this thread writes the pointer. Snapshots read it under the lock
+    if (!ring.m_Events)
+    {
+        std::unique_ptr<TraceEvent[]> events = std::make_unique<TraceEvent[]>(ThreadTraceRing::NbEvents);
+
+        std::lock_guard<std::mutex> lock{ m_RingsLock };
+        ring.m_Events = std::move(events);
+    }
+
+    const uint64_t writeIdx = ring.m_WriteIdx.load(std::memory_order_relaxed);
+    ring.m_Events[writeIdx % ThreadTraceRing::NbEvents] = TraceEvent{ name, beginNs, endNs, category };
+    ring.m_WriteIdx.store(writeIdx + 1, std::memory_order_release);
+}
+
+void TraceRecorder::TakeSnapshot(std::vector<ThreadSnapshot>& out, double lastSeconds)
+{
+    const uint64_t cutOffNs = lastSeconds > 0.0 ? GetTimeNs() - (uint64_t)(lastSeconds * 1000000000.0) : 0;
+
+    std::lock_guard<std::mutex> lock{ m_RingsLock };
+
+    out.reserve(m_AllRings.size());
+    for (const std::unique_ptr<ThreadTraceRing>& ring : m_AllRings)
+    {
+        ThreadSnapshot& snapshot = out.emplace_back();
+        snapshot.m_ThreadIdx = ring->m_ThreadIdx;
+        snapshot.m_ThreadName = ring->m_ThreadName;
+
+        if (!ring->m_Events)
+            continue;
+
+        // Only slots committed before this acquire are copied. The writer publishes each slot with a release store of the index
+        const uint64_t endIdx = ring->m_WriteIdx.load(std::memory_order_acquire);
+        const uint64_t beginIdx = endIdx > ThreadTraceRing::NbEvents ? endIdx - ThreadTraceRing::NbEvents : 0;
+
+        snapshot.m_Events.reserve(endIdx - beginIdx);
+        for (uint64_t i = beginIdx; i < endIdx; ++i)
+        {
+            snapshot.m_Events.push_back(ring->m_Events[i % ThreadTraceRing::NbEvents]);
+        }
+
+        // The owning thread kept recording while we were copying. Discard the slots it may have overwritten, including the one it may be writing right now
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t newEndIdx = ring->m_WriteIdx.load(std::memory_order_relaxed);
+        const uint64_t firstIntactIdx = newEndIdx + 1 > ThreadTraceRing::NbEvents ? newEndIdx + 1 - ThreadTraceRing::NbEvents : 0;
+        const uint64_t nbOverwritten = std::min<uint64_t>(firstIntactIdx > beginIdx ? firstIntactIdx - beginIdx : 0, snapshot.m_Events.size());
+        snapshot.m_Events.erase(snapshot.m_Events.begin(), snapshot.m_Events.begin() + nbOverwritten);
+
+        snapshot.m_Events.erase(std::remove_if(snapshot.m_Events.begin(), snapshot.m_Events.end(), [cutOffNs](const TraceEvent& e) { return e.m_EndNs < cutOffNs; }), snapshot.m_Events.end());
+
+        // scopes are recorded when they end. Sort by begin time, outer scopes first
+        std::sort(snapshot.m_Events.begin(), snapshot.m_Events.end(), [](const TraceEvent& lhs, const TraceEvent& rhs)
+            {
+                return lhs.m_BeginNs != rhs.m_BeginNs ? lhs.m_BeginNs < rhs.m_BeginNs : lhs.m_EndNs > rhs.m_EndNs;
+            });
+    }
+}
+
+bool TraceRecorder::WriteChromeTrace(const char* filePath, double lastSeconds)
+{
+    std::vector<ThreadSnapshot> snapshots;
+    TakeSnapshot(snapshots, lastSeconds);
+
+    CFileWrapper file{ filePath, false };
+    if (!file)
+    {
+        g_Log.error("TraceRecorder: failed to open '{}'", filePath);
+        return false;
+    }
+
+    uint32_t nbEvents = 0;
+    const char* separator = "";
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (const ThreadSnapshot& snapshot : snapshots)
+    {
+        fprintf(file, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":", separator, gs_TracePID, snapshot.m_ThreadIdx);
+        TraceRecorderPrivate::WriteJSONString(file, snapshot.m_ThreadName.c_str());
+        fprintf(file, "}}");
+        separator = ",\n";
+
+        // events are streamed straight to the file. No intermediate document
+        for (const TraceEvent& e : snapshot.m_Events)
+        {
+            fprintf(file, "%s{\"ph\":\"X\",\"name\":", separator);
+            TraceRecorderPrivate::WriteJSONString(file, e.m_Name);
+            fprintf(file, ",\"cat\":\"%s\",\"pid\":%u,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    gs_TraceCategoryNames[e.m_Category], gs_TracePID, snapshot.m_ThreadIdx,
+                    e.m_BeginNs / 1000.0, (e.m_EndNs - e.m_BeginNs) / 1000.0);
+        }
+        nbEvents += (uint32_t)snapshot.m_Events.size();
+    }
+    fprintf(file, "\n]}\n");
+
+    g_Log.info("TraceRecorder: wrote {} events from {} threads to '{}'", nbEvents, snapshots.size(), filePath);
+    return true;
+}
+
+bool TraceRecorder::WritePerfettoTrace(const char* filePath, double lastSeconds)
+{
+    using namespace TraceRecorderPrivate;
+    using namespace TraceRecorderPrivate::Perfetto;
+
+    std::vector<ThreadSnapshot> snapshots;
+    TakeSnapshot(snapshots, lastSeconds);
+
+    // binary mode. CFileWrapper opens in text mode, which would mangle the protobuf on Windows
+    FILE* file = fopen(filePath, "wb");
+    if (!file)
+    {
+        g_Log.error("TraceRecorder: failed to open '{}'", filePath);
+        return false;
+    }
+
+    // The Trace message is just a sequence of TracePacket fields, so packets can be streamed one by one
+    ProtoWriter packet;
+    ProtoWriter traceField;
+    auto FlushPacket = [&]()
+    {
+        traceField.Clear();
+        traceField.String(Trace_Packet, packet.GetBuffer());
+        fwrite(traceField.GetBuffer().data(), 1, traceField.GetBuffer().size(), file);
+        packet.Clear();
+    };
+
+    auto WriteSliceEvent = [&](uint64_t trackUUID, TrackEventType type, uint64_t timeNs, const TraceEvent* e)
+    {
+        packet.UInt(Packet_Timestamp, timeNs);
+        packet.UInt(Packet_TrustedPacketSequenceID, 1);
+        packet.Message(Packet_TrackEvent, [&](ProtoWriter& trackEvent)
+            {
+                trackEvent.UInt(Event_Type, type);
+                trackEvent.UInt(Event_TrackUUID, trackUUID);
+                if (e)
+                {
+                    trackEvent.String(Event_Categories, gs_TraceCategoryNames[e->m_Category]);
+                    trackEvent.String(Event_Name, e->m_Name);
+                }
+            });
+        FlushPacket();
+    };
+
+    uint32_t nbEvents = 0;
+    std::vector<const TraceEvent*> openSlices;
+    for (const ThreadSnapshot& snapshot : snapshots)
+    {
+        const uint64_t trackUUID = snapshot.m_ThreadIdx;
+
+        packet.Message(Packet_TrackDescriptor, [&](ProtoWriter& trackDesc)
+            {
+                trackDesc.UInt(Track_UUID, trackUUID);
+                trackDesc.Message(Track_Thread, [&](ProtoWriter& threadDesc)
+                    {
+                        threadDesc.UInt(Thread_PID, gs_TracePID);
+                        threadDesc.UInt(Thread_TID, snapshot.m_ThreadIdx);
+                        threadDesc.String(Thread_Name, snapshot.m_ThreadName);
+                    });
+            });
+        FlushPacket();
+
+        // scopes on a thread are strictly nested. Convert complete events into begin/end pairs
+        openSlices.clear();
+        for (const TraceEvent& e : snapshot.m_Events)
+        {
+            while (!openSlices.empty() && openSlices.back()->m_EndNs <= e.m_BeginNs)
+            {
+                WriteSliceEvent(trackUUID, SliceEnd, openSlices.back()->m_EndNs, nullptr);
+                openSlices.pop_back();
+            }
+
+            WriteSliceEvent(trackUUID, SliceBegin, e.m_BeginNs, &e);
+            openSlices.push_back(&e);
+        }
+
+        while (!openSlices.empty())
+        {
+            WriteSliceEvent(trackUUID, SliceEnd, openSlices.back()->m_EndNs, nullptr);
+            openSlices.pop_back();
+        }
+
+        nbEvents += (uint32_t)snapshot.m_Events.size();
+    }
+
+    fclose(file);
+
+    g_Log.info("TraceRecorder: wrote {} events from {} threads to '{}'", nbEvents, snapshots.size(), filePath);
+    return true;
+}
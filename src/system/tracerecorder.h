@@ -0,0 +1,93 @@
+#pragma once
+
+// Lightweight timeline recorder fed by the bbeProfile* macros, independent from microprofile.
+// Every thread records completed scopes into its own ring buffer, so the last N seconds can be exported at any time as Chrome Trace Event JSON or Perfetto protobuf.
+// Only depends on the STL, so it is usable headless (i.e. tools & Linux builds)
+class TraceRecorder
+{
+    DeclareSingletonFunctions(TraceRecorder);
+
+public:
+    enum Category : uint8_t { Scope, Lock, NbCategories };
+
+    static void SetEnabled(bool enabled) { ms_Enabled.store(enabled, std::memory_order_relaxed); }
+    static bool IsEnabled() { return ms_Enabled.load(std::memory_order_relaxed); }
+
+    static uint64_t GetTimeNs() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+    // 'name' must outlive the recorder (i.e. string literals, __FUNCTION__)
+    void RecordEvent(const char* name, Category category, uint64_t beginNs, uint64_t endNs);
+    void SetCurrentThreadName(const char* name);
+
+    // Export events that ended within the last 'lastSeconds' seconds. 0 == everything still in the rings
+    bool WriteChromeTrace(const char* filePath, double lastSeconds = 0.0);
+    bool WritePerfettoTrace(const char* filePath, double lastSeconds = 0.0);
+
+    // Rings are only allocated by threads that record while tracing is enabled
+    uint32_t GetNbAllocatedRings();
+
+private:
+    struct TraceEvent
+    {
+        const char* m_Name = nullptr;
+        uint64_t m_BeginNs = 0;
+        uint64_t m_EndNs = 0;
+        Category m_Category = Scope;
+    };
+
+    // Single writer (owning thread). Oldest events are overwritten, so capture is continuous.
+    // Events (~1MB) are allocated on the first recorded event: threads that never record while tracing only cost their name
+    struct ThreadTraceRing
+    {
+        static const uint32_t NbEvents = 1 << 15;
+
+        std::unique_ptr<TraceEvent[]> m_Events;
+        std::atomic<uint64_t> m_WriteIdx = 0;
+        uint32_t m_ThreadIdx = 0;
+        std::string m_ThreadName;
+    };
+
+    struct ThreadSnapshot
+    {
+        uint32_t m_ThreadIdx = 0;
+        std::string m_ThreadName;
+        std::vector<TraceEvent> m_Events;
+    };
+
+    ThreadTraceRing& GetThreadTraceRing();
+    void TakeSnapshot(std::vector<ThreadSnapshot>& out, double lastSeconds);
+
+    inline static std::atomic<bool> ms_Enabled = false;
+    static thread_local ThreadTraceRing* ms_ThreadTraceRing;
+
+    // Not a bbeAutoLock: lock scopes are recorded by this class, which would recurse into it
+    std::mutex m_RingsLock;
+    std::vector<std::unique_ptr<ThreadTraceRing>> m_AllRings;
+};
+#define g_TraceRecorder TraceRecorder::GetInstance()
+
+class ScopedTraceEvent
+{
+public:
+    ScopedTraceEvent(const char* name, TraceRecorder::Category category)
+        : m_Name(name)
+        , m_Category(category)
+        , m_BeginNs(TraceRecorder::IsEnabled() ? TraceRecorder::GetTimeNs() : 0)
+    {}
+
+    ~ScopedTraceEvent()
+    {
+        if (m_BeginNs)
+        {
+            g_TraceRecorder.RecordEvent(m_Name, m_Category, m_BeginNs, TraceRecorder::GetTimeNs());
+        }
+    }
+
+    ScopedTraceEvent(const ScopedTraceEvent&) = delete;
+    ScopedTraceEvent& operator=(const ScopedTraceEvent&) = delete;
+
+private:
+    const char* m_Name;
+    TraceRecorder::Category m_Category;
+    uint64_t m_BeginNs;
+};
@@ -1,12 +1,18 @@
 #include <system/utils.h>
 
+#if !defined(_WIN32)
+    #include <errno.h>
+    #include <signal.h>
+    #include <unistd.h>
+#endif
+
 const char* StringFormat(const char* format, ...)
 {
     thread_local char buffer[BBE_KB(1)]{};
 
     va_list marker;
     va_start(marker, format);
-    _vsnprintf_s(buffer, BBE_KB(1), BBE_KB(1), format, marker);
+    vsnprintf(buffer, sizeof(buffer), format, marker);
     va_end(marker);
 
     return buffer;
@@ -14,6 +20,10 @@ const char* StringFormat(const char* format, ...)
 
 void BreakIntoDebugger()
 {
+    // don't lose pending async log records if we're about to abort
+    g_Log.Flush();
+
+#if defined(_WIN32)
     if (!::IsDebuggerPresent())
     {
         if (::MessageBox(nullptr, "Attach your debugger *before* pressing OK to debug\r\nor press Cancel to skip the debug request.", "Assert!", MB_OKCANCEL | MB_ICONEXCLAMATION | MB_SETFOREGROUND) != IDOK)
@@ -22,6 +32,10 @@ void BreakIntoDebugger()
         }
     }
     __debugbreak();
+#else
+    // no debugger attached: default SIGTRAP action terminates the process
+    ::raise(SIGTRAP);
+#endif
 }
 
 const char* GetTimeStamp()
@@ -36,6 +50,7 @@ const char* GetTimeStamp()
 
 const char* GetLastErrorAsString()
 {
+#if defined(_WIN32)
     // Get the error message, if any.
     const DWORD errorMessageID = ::GetLastError();
     if (errorMessageID == 0)
@@ -45,6 +60,9 @@ const char* GetLastErrorAsString()
     FormatMessageA(FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS, NULL, errorMessageID, MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT), buffer, sizeof(buffer), NULL);
 
     return buffer;
+#else
+    return errno ? ::strerror(errno) : "";
+#endif
 }
 
 const char* GetApplicationDirectory()
@@ -52,7 +70,11 @@ const char* GetApplicationDirectory()
     static StaticString<BBE_KB(1)> s_AppDir = []()
     {
         char fileName[BBE_KB(1)]{};
+#if defined(_WIN32)
         ::GetModuleFileNameA(NULL, fileName, sizeof(fileName));
+#else
+        ::readlink("/proc/self/exe", fileName, sizeof(fileName) - 1);
+#endif
         return GetDirectoryFromPath(fileName).c_str();
     }();
 
@@ -87,6 +109,7 @@ void SplitPath(const std::string& fullPath, std::string& dir, std::string& fileN
 
 void GetFilesInDirectory(std::vector<std::string>& out, const std::string& directory)
 {
+#if defined(_WIN32)
     ::HANDLE dir;
     ::WIN32_FIND_DATA file_data;
 
@@ -109,6 +132,15 @@ void GetFilesInDirectory(std::vector<std::string>& out, const std::string& direc
     } while (FindNextFile(dir, &file_data));
 
     FindClose(dir);
+#else
+    std::error_code errorCode;
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator{ directory, errorCode })
+    {
+        const std::string fileName = entry.path().filename().string();
+        if (fileName[0] != '.')
+            out.push_back(directory + "/" + fileName);
+    }
+#endif
 }
 
 const std::string GetFileNameFromPath(const std::string& fullPath)
@@ -149,6 +181,7 @@ void ReadDataFromFile(const char* filename, std::vector<std::byte>& data)
 
     assert(data.empty());
 
+#if defined(_WIN32)
     using namespace Microsoft::WRL;
 
     CREATEFILE2_EXTENDED_PARAMETERS extendedParams = {};
@@ -171,15 +204,53 @@ void ReadDataFromFile(const char* filename, std::vector<std::byte>& data)
         assert(false);
     }
 
-    assert(fileInfo.EndOfFile.HighPart == 0);
-
-    const uint32_t size = fileInfo.EndOfFile.LowPart;
+    const uint64_t size = (uint64_t)fileInfo.EndOfFile.QuadPart;
     data.resize(size);
 
-    if (!ReadFile(file.Get(), data.data(), fileInfo.EndOfFile.LowPart, nullptr, nullptr))
+    // ReadFile takes a 32 bits size
+    for (uint64_t offset = 0; offset < size;)
     {
-        assert(false);
+        DWORD bytesRead = 0;
+        if (!ReadFile(file.Get(), data.data() + offset, (DWORD)std::min<uint64_t>(size - offset, UINT32_MAX), &bytesRead, nullptr) || bytesRead == 0)
+        {
+            assert(false);
+            break;
+        }
+        offset += bytesRead;
     }
+#else
+    FILE* file = fopen(filename, "rb");
+    if (!file)
+        return;
+
+    fseeko(file, 0, SEEK_END);
+    const uint64_t size = (uint64_t)ftello(file);
+    fseeko(file, 0, SEEK_SET);
+
+    data.resize(size);
+    const std::size_t bytesRead = fread(data.data(), 1, size, file);
+    assert(bytesRead == size);
+
+    fclose(file);
+#endif
+}
+
+ObjectID GenerateObjectID()
+{
+    static const uint64_t s_SessionSalt = []
+    {
+        std::random_device randomDevice;
+        return ((uint64_t)randomDevice() << 32) | randomDevice();
+    }();
+
+    // starts at 1, so we never generate ID_InvalidObject
+    static std::atomic<uint64_t> s_Counter = 1;
+    const uint64_t counter = s_Counter.fetch_add(1, std::memory_order_relaxed);
+
+    ObjectID id;
+    memcpy(id.begin(), &s_SessionSalt, sizeof(s_SessionSalt));
+    memcpy(id.begin() + sizeof(s_SessionSalt), &counter, sizeof(counter));
+    return id;
 }
 
 std::size_t GetFileContentsHash(const char* dir)
@@ -189,7 +260,7 @@ std::size_t GetFileContentsHash(const char* dir)
     ReadDataFromFile(dir, fileBytes);
 
     // hash entire array of bytes
-    return boost::hash_range(fileBytes.begin(), fileBytes.end());
+    return HashUtils::XXH3_64(fileBytes.data(), fileBytes.size());
 }
 
 namespace StringUtils
@@ -225,40 +296,17 @@ namespace StringUtils
     }
 }
 
-template<typename T>
-static T GetRandomValue(T range)
-{
-    static std::random_device randomDevice;
-    static std::mt19937_64 randomEngine(randomDevice());
-
-    using distribution = typename std::conditional< std::is_floating_point_v<T>, std::uniform_real_distribution<T>, std::uniform_int_distribution<T>>::type;
-    static distribution randomValue(0, std::numeric_limits<T>::max());
-
-    T toret = randomValue(randomEngine);
-    if (std::is_floating_point_v<T>)
-    {
-        toret /= std::numeric_limits<T>::max();
-        toret *= range;
-    }
-    else
-    {
-        T temp = toret / range;
-        toret -= (temp * range);
-    }
-    return toret;
-}
-
 float RandomFloat(float range)
 {
-    return GetRandomValue<float>(range);
+    return RandomUtils::GetThreadGenerator().NextFloat() * range;
 }
 
 uint32_t RandomUInt(uint32_t range)
 {
-    return GetRandomValue<uint32_t>(range);
+    return RandomUtils::GetThreadGenerator().NextUInt(range);
 }
 
 int32_t RandomInt(uint32_t range)
 {
-    return GetRandomValue<int32_t>(range);
+    return (int32_t)RandomUtils::GetThreadGenerator().NextUInt(range);
 }
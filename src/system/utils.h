@@ -127,7 +127,8 @@ public:
     }
 
 private:
-    ExitLamda&& m_ExitLambda;
+    // by value: the lambda passed in is a temporary that dies at the end of the constructor call
+    ExitLamda m_ExitLambda;
 };
 
 #define bbeOnExitScope(lambda) const AutoScopeCaller bbeUniqueVariable(AutoOnExitVar){ [](){}, lambda };
@@ -183,9 +184,11 @@ void SplitPath(const std::string& fullPath, std::string& dir, std::string& fileN
 void GetFilesInDirectory(std::vector<std::string>& out, const std::string& directory);
 const std::string GetFileNameFromPath(const std::string& fullPath);
 const std::string GetFileExtensionFromPath(const std::string& fullPath);
+// Blocking read. Engine code should prefer g_AsyncFileIO
 void ReadDataFromFile(const char* filename, std::vector<std::byte>& data);
 std::size_t GetFileContentsHash(const char* dir);
 
+#if defined(_WIN32)
 struct WindowsHandleWrapper
 {
     WindowsHandleWrapper(::HANDLE hdl = nullptr)
@@ -202,6 +205,7 @@ struct WindowsHandleWrapper
 
     ::HANDLE m_Handle = nullptr;
 };
+#endif // #if defined(_WIN32)
 
 struct CFileWrapper
 {
@@ -237,25 +241,25 @@ private:
     static MultithreadDetector __s_bbe_MTDetector__; \
     const AutoScopeCaller bbeUniqueVariable(mtDetectorScoped){ [&](){ __s_bbe_MTDetector__.Enter(std::this_thread::get_id()); }, [&](){ __s_bbe_MTDetector__.Exit(); } }; 
 
-// generic hasher func that uses Boost lib to hash the entire type. 
+// generic hasher func that hashes the raw bytes of the entire type
 template <typename T>
 static std::size_t GenericTypeHash(const T& s)
 {
-    const std::byte* rawMem = reinterpret_cast<const std::byte*>(&s);
-    return boost::hash_range(rawMem, rawMem + sizeof(T));
+    return HashUtils::XXH3_64(&s, sizeof(T));
 }
 
 template <typename Functor, bool ForwardScan = true>
 static void RunOnAllBits(uint32_t mask, Functor&& func)
 {
-    std::bitset<sizeof(uint32_t) * CHAR_BIT> bitSet{ mask };
-    unsigned long idx;
-    auto ForwardScanFunc = [&]() { return _BitScanForward(&idx, bitSet.to_ulong()); };
-    auto ReverseScanFunc = [&]() { return _BitScanReverse(&idx, bitSet.to_ulong()); };
-
-    while (ForwardScan ? ForwardScanFunc() : ReverseScanFunc())
+    while (mask)
     {
-        bitSet.set(idx, false);
+#if defined(_MSC_VER)
+        unsigned long idx;
+        ForwardScan ? _BitScanForward(&idx, mask) : _BitScanReverse(&idx, mask);
+#else
+        const uint32_t idx = ForwardScan ? __builtin_ctz(mask) : 31 - __builtin_clz(mask);
+#endif
+        mask &= ~(1U << idx);
         func(idx);
     }
 }
@@ -288,10 +292,21 @@ static void RunOnAllBits(uint32_t mask, Functor&& func)
         return s_StrToEnumMap.at(str);                                                       \
     }
 
-static ObjectID GenerateObjectID() { return boost::uuids::random_generator{}(); }
+// Per-session random salt + sequential counter. Unique across sessions, without hitting the OS entropy source on every call
+ObjectID GenerateObjectID();
 static const ObjectID ID_InvalidObject = boost::uuids::nil_generator{}();
 static std::string ToString(ObjectID id) { return boost::uuids::to_string(id); }
 
+struct ObjectIDHash
+{
+    std::size_t operator()(const ObjectID& id) const
+    {
+        uint64_t halves[2];
+        memcpy(halves, id.begin(), sizeof(halves));
+        return HashUtils::Combine(halves[0], halves[1]);
+    }
+};
+
 namespace StringUtils
 {
     const wchar_t* Utf8ToWide(std::string_view strView);
@@ -306,7 +321,7 @@ namespace StringUtils
     template <typename T>
     static void TransformStrInplace(T& str, ConvertFuncType converterFunc)
     {
-        using CharType = T::traits_type::char_type;
+        using CharType = typename T::traits_type::char_type;
         static_assert(std::is_same_v<CharType, char> || std::is_same_v<CharType, wchar_t>);
 
         using IntType = std::conditional_t<std::is_same_v<CharType, char>, uint8_t, wchar_t>;
@@ -320,6 +335,7 @@ namespace StringUtils
     static void ToUpper(StringType& str) { TransformStrInplace(str, std::toupper); }
 }
 
+// Thread safe, backed by RandomUtils::GetThreadGenerator()
 float RandomFloat(float range = 1.0f);
 uint32_t RandomUInt(uint32_t range = std::numeric_limits<uint32_t>::max());
 int32_t RandomInt(uint32_t range = std::numeric_limits<int32_t>::max());
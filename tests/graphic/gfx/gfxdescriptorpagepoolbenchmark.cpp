@@ -0,0 +1,98 @@
+#include <graphic/gfx/gfxdescriptorpagepool.h>
+
+// Staging descriptor page alloc/free from 1 to 16 threads: a single mutex guarded free list against GfxDescriptorPagePool and its per-thread caches
+
+static const uint32_t NbPages = GfxDescriptorPagePool::NbPagesPerHeap * 16;
+
+// One lock around one free list, what every allocation would pay without the thread caches
+class LockedFreeList
+{
+public:
+    LockedFreeList()
+    {
+        for (uint32_t i = NbPages; i > 0; --i)
+        {
+            m_FreePages.push_back(i - 1);
+        }
+    }
+
+    uint32_t AllocatePage()
+    {
+        std::lock_guard<std::mutex> lock{ m_Lock };
+        const uint32_t page = m_FreePages.back();
+        m_FreePages.pop_back();
+        return page;
+    }
+
+    void FreePage(uint32_t page)
+    {
+        std::lock_guard<std::mutex> lock{ m_Lock };
+        m_FreePages.push_back(page);
+    }
+
+private:
+    std::mutex m_Lock;
+    std::vector<uint32_t> m_FreePages;
+};
+
+// Every thread allocates then frees 2 pages per "context", like a context's CBV_SRV_UAV staging descriptors. Returns M alloc/free pairs per second, all threads
+template <typename Allocator>
+static double MeasureMPagesPerSecond(uint32_t nbThreads, uint32_t nbContextsPerThread, Allocator& allocator)
+{
+    std::vector<std::thread> threads;
+    Barrier startBarrier{ nbThreads + 1 };
+
+    for (uint32_t t = 0; t < nbThreads; ++t)
+    {
+        threads.emplace_back([&]
+            {
+                uint32_t sink = 0;
+
+                startBarrier.ArriveAndWait();
+                for (uint32_t i = 0; i < nbContextsPerThread; ++i)
+                {
+                    const uint32_t page0 = allocator.AllocatePage();
+                    const uint32_t page1 = allocator.AllocatePage();
+                    sink += page0 + page1;
+                    allocator.FreePage(page1);
+                    allocator.FreePage(page0);
+                }
+                TestUtils::DoNotOptimize(sink);
+            });
+    }
+
+    const double seconds = TestUtils::MeasureSeconds([&]
+        {
+            startBarrier.ArriveAndWait();
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+        });
+
+    return (double)nbThreads * nbContextsPerThread * 2 / seconds / 1e6;
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestUtils::ParseQuickArg(argc, argv);
+    const uint32_t nbContextsPerThread = quick ? 20000 : 2000000;
+
+    LockedFreeList lockedFreeList;
+
+    // heaps are free: only the allocation path is measured
+    GfxDescriptorPagePool pool;
+    pool.Initialize(0, [](uint32_t, uint32_t) {});
+
+    TestUtils::PrintBenchmarkHeader("Staging descriptor pages (M alloc/free pairs/s, all threads)");
+    printf("%-8s %16s %16s\n", "threads", "locked list", "page pool");
+
+    for (uint32_t nbThreads : { 1U, 2U, 4U, 8U, 16U })
+    {
+        const double locked = MeasureMPagesPerSecond(nbThreads, nbContextsPerThread, lockedFreeList);
+        const double pooled = MeasureMPagesPerSecond(nbThreads, nbContextsPerThread, pool);
+        printf("%-8u %16.1f %16.1f\n", nbThreads, locked, pooled);
+    }
+
+    return 0;
+}
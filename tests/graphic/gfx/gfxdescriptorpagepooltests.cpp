@@ -0,0 +1,157 @@
+#include <graphic/gfx/gfxdescriptorpagepool.h>
+
+// GfxDescriptorPagePool with a fake heap creator: pages are unique while allocated, come back when freed, and never leak between pools through the per-thread caches
+
+static const uint32_t NbThreads = 8;
+
+// Records the heaps the pool asked for, in place of the D3D12 heaps
+struct FakeHeaps
+{
+    std::atomic<uint32_t> m_NbHeaps = 0;
+    std::atomic<uint32_t> m_NbWrongHeaps = 0;
+
+    GfxDescriptorPagePool::HeapCreator GetCreator()
+    {
+        return [this](uint32_t heapIdx, uint32_t numDescriptors)
+        {
+            m_NbWrongHeaps += heapIdx != m_NbHeaps || numDescriptors != GfxDescriptorPagePool::NbPagesPerHeap * GfxDescriptorPagePool::NbDescriptorsPerPage;
+            ++m_NbHeaps;
+        };
+    }
+};
+
+static void TestPagesAreHandedOutInOrder()
+{
+    FakeHeaps heaps;
+    GfxDescriptorPagePool pool;
+    pool.Initialize(0, heaps.GetCreator());
+    bbeTestCheck(heaps.m_NbHeaps == 1);
+    bbeTestCheck(pool.GetNumFreePages() == GfxDescriptorPagePool::NbPagesPerHeap);
+
+    // a whole heap, then one more page grows the pool by one heap
+    for (uint32_t i = 0; i <= GfxDescriptorPagePool::NbPagesPerHeap; ++i)
+    {
+        bbeTestCheck(pool.AllocatePage() == i);
+    }
+    bbeTestCheck(heaps.m_NbHeaps == 2);
+    bbeTestCheck(heaps.m_NbWrongHeaps == 0);
+    bbeTestCheck(pool.GetNumHeaps() == 2);
+
+    const uint32_t lastPage = GfxDescriptorPagePool::NbPagesPerHeap;
+    bbeTestCheck(GfxDescriptorPagePool::GetHeapIndex(lastPage) == 1);
+    bbeTestCheck(GfxDescriptorPagePool::GetOffsetInHeap(lastPage, 3) == 3);
+    bbeTestCheck(GfxDescriptorPagePool::GetOffsetInHeap(lastPage - 1, 3) == (GfxDescriptorPagePool::NbPagesPerHeap - 1) * GfxDescriptorPagePool::NbDescriptorsPerPage + 3);
+}
+
+static void TestFreedPagesAreReused()
+{
+    FakeHeaps heaps;
+    GfxDescriptorPagePool pool;
+    pool.Initialize(0, heaps.GetCreator());
+
+    // more than the thread cache holds, so pages go through both the cache & the free list
+    static const uint32_t NbPages = GfxDescriptorPagePool::NbCachedPagesPerThread * 4;
+    for (uint32_t frame = 0; frame < 100; ++frame)
+    {
+        std::vector<uint32_t> pages;
+        for (uint32_t i = 0; i < NbPages; ++i)
+        {
+            pages.push_back(pool.AllocatePage());
+        }
+
+        std::sort(pages.begin(), pages.end());
+        bbeTestCheck(std::adjacent_find(pages.begin(), pages.end()) == pages.end());
+
+        for (uint32_t page : pages)
+        {
+            pool.FreePage(page);
+        }
+    }
+    bbeTestCheck(heaps.m_NbHeaps == 1);
+    bbeTestCheck(pool.GetNumFreePages() + GfxDescriptorPagePool::NbCachedPagesPerThread == GfxDescriptorPagePool::NbPagesPerHeap);
+}
+
+static void TestConcurrentPagesAreUnique()
+{
+    // threads keep a few pages each "for a frame", then give them back, while other threads grab them
+    FakeHeaps heaps;
+    GfxDescriptorPagePool pool;
+    pool.Initialize(1, heaps.GetCreator());
+
+    static const uint32_t NbPagesPerFrame = 12;
+    static const uint32_t NbFrames = 500;
+
+    std::vector<std::atomic<uint32_t>> nbOwners(GfxDescriptorPagePool::NbMaxHeaps * GfxDescriptorPagePool::NbPagesPerHeap);
+    std::atomic<uint32_t> nbViolations = 0;
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < NbThreads; ++t)
+    {
+        threads.emplace_back([&]
+            {
+                for (uint32_t frame = 0; frame < NbFrames; ++frame)
+                {
+                    uint32_t pages[NbPagesPerFrame];
+                    for (uint32_t& page : pages)
+                    {
+                        page = pool.AllocatePage();
+                        nbViolations += nbOwners[page]++ != 0;
+                    }
+                    for (uint32_t page : pages)
+                    {
+                        nbViolations += --nbOwners[page] != 0;
+                        pool.FreePage(page);
+                    }
+                }
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    bbeTestCheck(nbViolations == 0);
+    bbeTestCheck(heaps.m_NbWrongHeaps == 0);
+
+    // at most every thread's pages plus its cache in flight at once
+    bbeTestCheck(pool.GetNumHeaps() * GfxDescriptorPagePool::NbPagesPerHeap >= NbPagesPerFrame);
+    bbeTestCheck(pool.GetNumHeaps() * GfxDescriptorPagePool::NbPagesPerHeap <= NbThreads * (NbPagesPerFrame + GfxDescriptorPagePool::NbCachedPagesPerThread) + GfxDescriptorPagePool::NbPagesPerHeap);
+}
+
+static void TestPoolsSharingASlotDontShareCachedPages()
+{
+    // a pool destroyed with pages in this thread's cache, and a new one in the same slot: the new pool must not hand out the old pool's pages
+    FakeHeaps heaps;
+    auto oldPool = std::make_unique<GfxDescriptorPagePool>();
+    oldPool->Initialize(2, heaps.GetCreator());
+
+    // pages from the end of the heap, which the new pool only hands out last
+    std::vector<uint32_t> oldPages;
+    for (uint32_t i = 0; i < GfxDescriptorPagePool::NbPagesPerHeap; ++i)
+    {
+        oldPages.push_back(oldPool->AllocatePage());
+    }
+    for (uint32_t i = 0; i < GfxDescriptorPagePool::NbCachedPagesPerThread; ++i)
+    {
+        oldPool->FreePage(oldPages.back());
+        oldPages.pop_back();
+    }
+    oldPool.reset();
+
+    GfxDescriptorPagePool newPool;
+    newPool.Initialize(2, heaps.GetCreator());
+    for (uint32_t i = 0; i < GfxDescriptorPagePool::NbCachedPagesPerThread; ++i)
+    {
+        bbeTestCheck(newPool.AllocatePage() == i);
+    }
+}
+
+int main()
+{
+    return TestUtils::RunTests({
+        { "PagesAreHandedOutInOrder", TestPagesAreHandedOutInOrder },
+        { "FreedPagesAreReused", TestFreedPagesAreReused },
+        { "ConcurrentPagesAreUnique", TestConcurrentPagesAreUnique },
+        { "PoolsSharingASlotDontShareCachedPages", TestPoolsSharingASlotDontShareCachedPages },
+    });
+}
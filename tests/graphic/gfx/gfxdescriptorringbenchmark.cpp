@@ -0,0 +1,95 @@
+#include <graphic/gfx/gfxdescriptorring.h>
+
+// Shader visible descriptor allocations from 1 to 16 recording threads: the mutex guarded rotation GfxDescriptorRing replaced, the ring's shared head, and the ring through per-context blocks
+
+// The ring only hands out indices: it can be as big as a whole measurement, so it never stalls. The old rotation wrapped at 1024
+static const uint32_t RingCapacity = 1U << 30;
+static const uint32_t RotationCapacity = 1024;
+static const uint32_t BlockSize = 128;
+
+// What GfxGPUDescriptorAllocator used to do: one lock around a rotating index
+class LockedRotation
+{
+public:
+    uint32_t Allocate(uint32_t numDescriptors)
+    {
+        std::lock_guard<std::mutex> lock{ m_Lock };
+        if (m_Next + numDescriptors > RotationCapacity)
+            m_Next = 0;
+
+        const uint32_t offset = m_Next;
+        m_Next += numDescriptors;
+        return offset;
+    }
+
+private:
+    std::mutex m_Lock;
+    uint32_t m_Next = 0;
+};
+
+// Every thread records 'nbTablesPerThread' tables of 1 to 8 descriptors, and the GPU is never behind: only the allocation path is measured. Returns M tables/s, all threads
+template <typename AllocateFunc>
+static double MeasureMTablesPerSecond(uint32_t nbThreads, uint32_t nbTablesPerThread, AllocateFunc&& allocate)
+{
+    std::vector<std::thread> threads;
+    Barrier startBarrier{ nbThreads + 1 };
+
+    for (uint32_t t = 0; t < nbThreads; ++t)
+    {
+        threads.emplace_back([&, t]
+            {
+                GfxShaderVisibleDescriptorBlock block;
+                uint32_t sink = 0;
+
+                startBarrier.ArriveAndWait();
+                for (uint32_t i = 0; i < nbTablesPerThread; ++i)
+                {
+                    sink += allocate(block, 1 + ((i + t) & 7));
+                }
+                TestUtils::DoNotOptimize(sink);
+            });
+    }
+
+    const double seconds = TestUtils::MeasureSeconds([&]
+        {
+            startBarrier.ArriveAndWait();
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+        });
+
+    return (double)nbThreads * nbTablesPerThread / seconds / 1e6;
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestUtils::ParseQuickArg(argc, argv);
+    const uint32_t nbTablesPerThread = quick ? 20000 : 2000000;
+
+    // the simulated GPU is always done: the ring retires everything at EndFrame
+    GfxDescriptorRing ring;
+    ring.Initialize(RingCapacity, [] { return UINT64_MAX; });
+    uint64_t frame = 0;
+
+    LockedRotation lockedRotation;
+
+    TestUtils::PrintBenchmarkHeader("Shader visible descriptor allocation (M tables/s, all threads)");
+    printf("%-8s %16s %16s %16s\n", "threads", "locked rotation", "ring", "ring + blocks");
+
+    for (uint32_t nbThreads : { 1U, 2U, 4U, 8U, 16U })
+    {
+        // one frame per measurement, like the renderer: the ring's in flight frames get retired in between
+        auto EndFrame = [&] { ring.EndFrame(++frame); };
+
+        const double locked = MeasureMTablesPerSecond(nbThreads, nbTablesPerThread, [&](GfxShaderVisibleDescriptorBlock&, uint32_t n) { return lockedRotation.Allocate(n); });
+        const double shared = MeasureMTablesPerSecond(nbThreads, nbTablesPerThread, [&](GfxShaderVisibleDescriptorBlock&, uint32_t n) { return ring.Allocate(n); });
+        EndFrame();
+        const double blocks = MeasureMTablesPerSecond(nbThreads, nbTablesPerThread, [&](GfxShaderVisibleDescriptorBlock& block, uint32_t n) { return ring.Allocate(block, n, BlockSize); });
+        EndFrame();
+
+        printf("%-8u %16.1f %16.1f %16.1f\n", nbThreads, locked, shared, blocks);
+    }
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <graphic/gfx/gfxdescriptorring.h>
+
+// GfxDescriptorRing driven by a simulated GPU fence: descriptors are never handed out while a frame still in flight owns them
+
+static const uint32_t NbThreads = 8;
+
+// Stands in for the frame fence: the "GPU" completes frames whenever the test says so
+struct SimulatedFence
+{
+    std::atomic<uint64_t> m_CompletedValue = 0;
+
+    GfxDescriptorRing::FenceValueGetter GetCompletedValueGetter() { return [this] { return m_CompletedValue.load(); }; }
+};
+
+static void TestRangesAreContiguous()
+{
+    // odd sizes, so ranges regularly cross the end of the ring
+    SimulatedFence fence;
+    GfxDescriptorRing ring;
+    ring.Initialize(1000, fence.GetCompletedValueGetter());
+
+    RandomGenerator random{ 1 };
+    for (uint64_t frame = 1; frame <= 100; ++frame)
+    {
+        for (uint32_t i = 0; i < 20; ++i)
+        {
+            const uint32_t numDescriptors = 1 + random.NextUInt(37);
+            const uint32_t offset = ring.Allocate(numDescriptors);
+            bbeTestCheck(offset + numDescriptors <= ring.GetCapacity());
+        }
+        ring.EndFrame(frame);
+        fence.m_CompletedValue = frame;
+    }
+    bbeTestCheck(ring.GetNumStalls() == 0);
+}
+
+static void TestNeverHandsOutInFlightDescriptors()
+{
+    // GPU 2 frames behind, every frame using over half of the ring: frames constantly wrap into the ones still in flight
+    static const uint32_t Capacity = 4096;
+    static const uint64_t NbFrames = 200;
+    static const uint64_t GPULatency = 2;
+
+    SimulatedFence fence;
+    GfxDescriptorRing ring;
+    ring.Initialize(Capacity, fence.GetCompletedValueGetter());
+
+    // frame that last owned each descriptor
+    std::vector<std::atomic<uint64_t>> owners(Capacity);
+    std::atomic<uint32_t> nbViolations = 0;
+    std::atomic<bool> gpuDone = false;
+
+    std::atomic<uint64_t> lastSubmittedFrame = 0;
+    std::thread gpu{ [&]
+        {
+            while (!gpuDone)
+            {
+                const uint64_t submitted = lastSubmittedFrame.load();
+                if (submitted > fence.m_CompletedValue + GPULatency || (submitted > fence.m_CompletedValue && ring.GetNumStalls() > 0))
+                    fence.m_CompletedValue.fetch_add(1);
+
+                std::this_thread::sleep_for(std::chrono::microseconds{ 50 });
+            }
+        } };
+
+    for (uint64_t frame = 1; frame <= NbFrames; ++frame)
+    {
+        std::vector<std::thread> recorders;
+        for (uint32_t t = 0; t < NbThreads; ++t)
+        {
+            recorders.emplace_back([&, t]
+                {
+                    RandomGenerator random{ frame * NbThreads + t };
+                    GfxShaderVisibleDescriptorBlock block;
+                    for (uint32_t i = 0; i < 60; ++i)
+                    {
+                        const uint32_t numDescriptors = 1 + random.NextUInt(8);
+                        const uint32_t offset = ring.Allocate(block, numDescriptors, 32);
+
+                        for (uint32_t d = offset; d < offset + numDescriptors; ++d)
+                        {
+                            const uint64_t previousOwner = owners[d].exchange(frame);
+
+                            // the previous owner must be done on the GPU, or be this very frame (which would be a double allocation)
+                            if (previousOwner == frame || previousOwner > fence.m_CompletedValue)
+                                ++nbViolations;
+                        }
+                    }
+                });
+        }
+        for (std::thread& recorder : recorders)
+        {
+            recorder.join();
+        }
+
+        ring.EndFrame(frame);
+        lastSubmittedFrame = frame;
+    }
+
+    gpuDone = true;
+    gpu.join();
+
+    bbeTestCheck(nbViolations == 0);
+    bbeTestCheck(ring.GetNumStalls() > 0);
+}
+
+static void TestStallsUntilFenceCompletes()
+{
+    SimulatedFence fence;
+    GfxDescriptorRing ring;
+    ring.Initialize(256, fence.GetCompletedValueGetter());
+
+    ring.Allocate(200);
+    ring.EndFrame(1);
+
+    // fits next to frame 1's range: no stall
+    bbeTestCheck(ring.Allocate(50) == 200);
+    bbeTestCheck(ring.GetNumStalls() == 0);
+
+    // wraps into frame 1, which only completes 20ms later
+    std::atomic<bool> completed = false;
+    std::thread gpu{ [&]
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 20 });
+            completed = true;
+            fence.m_CompletedValue = 1;
+        } };
+
+    const uint32_t offset = ring.Allocate(100);
+    bbeTestCheck(completed);
+    bbeTestCheck(offset == 0);
+    bbeTestCheck(ring.GetNumStalls() == 1);
+
+    gpu.join();
+}
+
+int main()
+{
+    return TestUtils::RunTests({
+        { "RangesAreContiguous", TestRangesAreContiguous },
+        { "NeverHandsOutInFlightDescriptors", TestNeverHandsOutInFlightDescriptors },
+        { "StallsUntilFenceCompletes", TestStallsUntilFenceCompletes },
+    });
+}
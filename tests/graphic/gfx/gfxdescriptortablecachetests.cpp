@@ -0,0 +1,96 @@
+#include <graphic/gfx/gfxdescriptortablecache.h>
+#include <graphic/gfx/gfxviewtable.h>
+
+// GfxDescriptorTableCache with fake descriptor handles: identical tables hit, anything else misses, even on a hash collision
+
+struct FakeHandle
+{
+    uint64_t ptr = 0;
+};
+
+static void TestIdenticalTablesHit()
+{
+    GfxDescriptorTableCache cache;
+
+    const FakeHandle table[] = { { 0x100 }, { 0x200 }, { 0x300 } };
+    uint64_t hash = 0;
+    bbeTestCheck(cache.Find(table, 3, hash) == 0);
+    cache.Add(hash, table, 3, 0xABC0);
+
+    // a copy of the table, not the same array
+    const FakeHandle sameTable[] = { { 0x100 }, { 0x200 }, { 0x300 } };
+    uint64_t sameHash = 0;
+    bbeTestCheck(cache.Find(sameTable, 3, sameHash) == 0xABC0);
+    bbeTestCheck(sameHash == hash);
+
+    bbeTestCheck(cache.GetNumHits() == 1);
+    bbeTestCheck(cache.GetNumMisses() == 1);
+}
+
+static void TestDifferentTablesMiss()
+{
+    GfxDescriptorTableCache cache;
+
+    const FakeHandle table[] = { { 0x100 }, { 0x200 }, { 0x300 } };
+    uint64_t hash = 0;
+    cache.Find(table, 3, hash);
+    cache.Add(hash, table, 3, 0xABC0);
+
+    // order, length & contents all matter
+    const FakeHandle swapped[] = { { 0x200 }, { 0x100 }, { 0x300 } };
+    const FakeHandle other[] = { { 0x100 }, { 0x200 }, { 0x400 } };
+    bbeTestCheck(cache.Find(swapped, 3, hash) == 0);
+    bbeTestCheck(cache.Find(other, 3, hash) == 0);
+    bbeTestCheck(cache.Find(table, 2, hash) == 0);
+    bbeTestCheck(cache.GetNumHits() == 0);
+
+    cache.Clear();
+    bbeTestCheck(cache.Find(table, 3, hash) == 0);
+}
+
+static void TestHashCollisionsDontAlias()
+{
+    // another table stored under this table's hash, as a real collision would
+    GfxDescriptorTableCache cache;
+
+    const FakeHandle table[] = { { 0x100 }, { 0x200 } };
+    const FakeHandle collidingTable[] = { { 0x500 }, { 0x600 } };
+
+    uint64_t hash = 0;
+    cache.Find(table, 2, hash);
+    cache.Add(hash, collidingTable, 2, 0xDEF0);
+
+    uint64_t newHash = 0;
+    bbeTestCheck(cache.Find(table, 2, newHash) == 0);
+
+    // committing the real table replaces the colliding one
+    cache.Add(newHash, table, 2, 0xABC0);
+    bbeTestCheck(cache.Find(table, 2, newHash) == 0xABC0);
+}
+
+static void TestViewReleasesAreCounted()
+{
+    // contexts forget their tables when the view cache recycles descriptors: only actual releases count
+    uint32_t nextPage = 0;
+    GfxViewTable views;
+    views.Initialize([&](uint32_t) { return nextPage++; });
+
+    static uint32_t s_Resources[2];
+    views.GetOrCreateView({ &s_Resources[0] }, 0, [](uint32_t) {});
+
+    views.OnResourceReleased(&s_Resources[1]);
+    bbeTestCheck(views.GetNumReleases() == 0);
+
+    views.OnResourceReleased(&s_Resources[0]);
+    bbeTestCheck(views.GetNumReleases() == 1);
+}
+
+int main()
+{
+    return TestUtils::RunTests({
+        { "IdenticalTablesHit", TestIdenticalTablesHit },
+        { "DifferentTablesMiss", TestDifferentTablesMiss },
+        { "HashCollisionsDontAlias", TestHashCollisionsDontAlias },
+        { "ViewReleasesAreCounted", TestViewReleasesAreCounted },
+    });
+}
@@ -0,0 +1,142 @@
+#include <graphic/gfx/gfxlinearallocator.h>
+
+// Constant buffer uploads of a draw loop, on fake pages with a simulated frame fence: upload resources created per frame when every CBV gets its own committed resource, against GfxLinearAllocator's pages.
+// Then the cost of the bump itself, from 1 to 16 recording threads
+
+static const uint32_t PageSize = 4 * 1024 * 1024;
+static const uint64_t GPULatency = 2;
+
+// Stands in for D3D12MA upload heaps: counts the resources created, and backs them with plain memory so the copies are real
+struct FakeUploadPages
+{
+    std::vector<std::byte> m_Memory[GfxLinearAllocator::NbMaxPages];
+    uint32_t m_NbCreated = 0;
+    uint64_t m_CompletedFenceValue = 0;
+
+    void Initialize(GfxLinearAllocator& allocator)
+    {
+        allocator.Initialize(PageSize,
+            [this](uint32_t pageIdx, uint32_t pageSize) { m_Memory[pageIdx].resize(pageSize); ++m_NbCreated; },
+            [this](uint32_t pageIdx) { m_Memory[pageIdx] = {}; },
+            [this] { return m_CompletedFenceValue; });
+    }
+};
+
+// What every draw uploads in GfxForwardLightingPass: a world matrix & a few flags, padded to 256 bytes
+struct PerInstanceConsts
+{
+    float m_WorldMatrix[16];
+    uint32_t m_Flags[4];
+};
+
+template <typename Func>
+static double MeasureNsPerAllocation(uint32_t nbThreads, uint32_t nbAllocationsPerThread, Func&& allocate)
+{
+    std::vector<std::thread> threads;
+    Barrier startBarrier{ nbThreads + 1 };
+
+    for (uint32_t t = 0; t < nbThreads; ++t)
+    {
+        threads.emplace_back([&]
+            {
+                uint32_t sink = 0;
+
+                startBarrier.ArriveAndWait();
+                for (uint32_t i = 0; i < nbAllocationsPerThread; ++i)
+                {
+                    sink += allocate();
+                }
+                TestUtils::DoNotOptimize(sink);
+            });
+    }
+
+    const double seconds = TestUtils::MeasureSeconds([&]
+        {
+            startBarrier.ArriveAndWait();
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+        });
+
+    return seconds * 1e9 / ((double)nbThreads * nbAllocationsPerThread);
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestUtils::ParseQuickArg(argc, argv);
+    const uint32_t nbFrames = quick ? 8 : 100;
+
+    TestUtils::PrintBenchmarkHeader(StringFormat("CBV uploads per frame, GPU %u frames behind", (uint32_t)GPULatency));
+    printf("%-8s %22s %18s %16s %12s\n", "draws", "resources (1 per CBV)", "pages created", "pages used", "us/frame");
+
+    const PerInstanceConsts consts{};
+    for (uint32_t nbDraws : { 100U, 1000U, 10000U, 50000U })
+    {
+        FakeUploadPages pages;
+        GfxLinearAllocator allocator;
+        pages.Initialize(allocator);
+
+        uint64_t frame = 0;
+        auto RunFrame = [&]
+        {
+            // per frame consts, then one per instance CBV per draw
+            for (uint32_t i = 0; i <= nbDraws; ++i)
+            {
+                const GfxLinearAllocator::Allocation allocation = allocator.Allocate(AlignUp((uint32_t)sizeof(consts), GfxLinearAllocator::DefaultAlignment));
+                memcpy(pages.m_Memory[allocation.m_PageIdx].data() + allocation.m_Offset, &consts, sizeof(consts));
+            }
+            allocator.EndFrame(++frame);
+
+            if (frame > GPULatency)
+                pages.m_CompletedFenceValue = frame - GPULatency;
+        };
+
+        // the first frames in flight create their pages: not timed
+        for (uint64_t i = 0; i <= GPULatency; ++i)
+        {
+            RunFrame();
+        }
+        const uint32_t nbCreatedWarmingUp = pages.m_NbCreated;
+
+        const double seconds = TestUtils::MeasureSeconds([&]
+            {
+                for (uint32_t i = 0; i < nbFrames; ++i)
+                {
+                    RunFrame();
+                }
+            });
+
+        // once warmed up, pages only get created again if a frame needs more than the ones in flight
+        const std::string created = StringFormat("%u, then %.1f", nbCreatedWarmingUp, (double)(pages.m_NbCreated - nbCreatedWarmingUp) / nbFrames);
+        printf("%-8u %22u %18s %16u %12.1f\n", nbDraws, nbDraws + 1, created.c_str(), allocator.GetNumPagesUsedLastFrame(), seconds * 1e6 / nbFrames);
+
+        allocator.ShutDown();
+    }
+
+    TestUtils::PrintBenchmarkHeader("GfxLinearAllocator::Allocate, 256 bytes (ns per allocation, all threads)");
+    printf("%-8s %12s\n", "threads", "ns");
+
+    // all in one frame: at most 16 * 100000 * 256 bytes, 100 pages
+    const uint32_t nbAllocationsPerThread = quick ? 20000 : 100000;
+    for (uint32_t nbThreads : { 1U, 2U, 4U, 8U, 16U })
+    {
+        FakeUploadPages pages;
+        pages.m_CompletedFenceValue = UINT64_MAX;
+        GfxLinearAllocator allocator;
+        pages.Initialize(allocator);
+
+        auto Allocate = [&] { return allocator.Allocate(256).m_Offset; };
+
+        // creates the pages, then recycles them all: only the bump & page switches are timed
+        MeasureNsPerAllocation(nbThreads, nbAllocationsPerThread, Allocate);
+        allocator.EndFrame(1);
+
+        const double ns = MeasureNsPerAllocation(nbThreads, nbAllocationsPerThread, Allocate);
+        printf("%-8u %12.1f\n", nbThreads, ns);
+
+        allocator.ShutDown();
+    }
+
+    return 0;
+}
@@ -0,0 +1,225 @@
+#include <graphic/gfx/gfxlinearallocator.h>
+
+// GfxLinearAllocator on fake pages with a simulated frame fence: allocations never overlap, and pages are only reused once the GPU is done with their frame
+
+static const uint32_t NbThreads = 8;
+static const uint32_t PageSize = 64 * 1024;
+
+// Tracks the pages the allocator creates & destroys, in place of persistently mapped upload heaps
+struct FakePages
+{
+    uint32_t m_PageSizes[GfxLinearAllocator::NbMaxPages] = {};
+    uint32_t m_NbCreated = 0;
+    uint32_t m_NbDestroyed = 0;
+    uint32_t m_NbWrongCalls = 0;
+
+    std::atomic<uint64_t> m_CompletedFenceValue = 0;
+
+    void Initialize(GfxLinearAllocator& allocator, uint32_t pageSize = PageSize)
+    {
+        allocator.Initialize(pageSize,
+            [this](uint32_t pageIdx, uint32_t pageSize)
+            {
+                m_NbWrongCalls += m_PageSizes[pageIdx] != 0;
+                m_PageSizes[pageIdx] = pageSize;
+                ++m_NbCreated;
+            },
+            [this](uint32_t pageIdx)
+            {
+                m_NbWrongCalls += m_PageSizes[pageIdx] == 0;
+                m_PageSizes[pageIdx] = 0;
+                ++m_NbDestroyed;
+            },
+            [this] { return m_CompletedFenceValue.load(); });
+    }
+};
+
+static void TestAllocationsAreAligned()
+{
+    FakePages pages;
+    GfxLinearAllocator allocator;
+    pages.Initialize(allocator);
+
+    for (uint32_t size : { 1U, 16U, 255U, 256U, 257U, 1000U })
+    {
+        const GfxLinearAllocator::Allocation allocation = allocator.Allocate(size);
+        bbeTestCheck(bbeIsAligned(allocation.m_Offset, GfxLinearAllocator::DefaultAlignment));
+        bbeTestCheck(allocation.m_Offset + size <= pages.m_PageSizes[allocation.m_PageIdx]);
+    }
+
+    // texture placement alignment
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        const GfxLinearAllocator::Allocation allocation = allocator.Allocate(300, 512);
+        bbeTestCheck(bbeIsAligned(allocation.m_Offset, 512));
+        bbeTestCheck(allocation.m_Offset + 300 <= pages.m_PageSizes[allocation.m_PageIdx]);
+    }
+
+    allocator.ShutDown();
+    bbeTestCheck(pages.m_NbDestroyed == pages.m_NbCreated);
+    bbeTestCheck(pages.m_NbWrongCalls == 0);
+}
+
+static void TestPagesAreRecycledAfterTheirFrame()
+{
+    // each frame fills 3 pages. The GPU is 2 frames behind: pages come back 2 frames later, and no more than 3 frames' worth are ever created
+    static const uint64_t GPULatency = 2;
+    static const uint32_t NbAllocationsPerFrame = 3 * PageSize / 1024;
+
+    FakePages pages;
+    GfxLinearAllocator allocator;
+    pages.Initialize(allocator);
+
+    // page -> last frame it was used in
+    std::vector<uint64_t> pageFrames(GfxLinearAllocator::NbMaxPages, 0);
+    uint32_t nbReusedTooEarly = 0;
+
+    for (uint64_t frame = 1; frame <= 50; ++frame)
+    {
+        for (uint32_t i = 0; i < NbAllocationsPerFrame; ++i)
+        {
+            const GfxLinearAllocator::Allocation allocation = allocator.Allocate(1024);
+
+            uint64_t& pageFrame = pageFrames[allocation.m_PageIdx];
+            nbReusedTooEarly += pageFrame != 0 && pageFrame != frame && pageFrame > pages.m_CompletedFenceValue;
+            pageFrame = frame;
+        }
+        allocator.EndFrame(frame);
+        bbeTestCheck(allocator.GetNumPagesUsedLastFrame() == 3);
+
+        if (frame > GPULatency)
+            pages.m_CompletedFenceValue = frame - GPULatency;
+    }
+
+    bbeTestCheck(nbReusedTooEarly == 0);
+    bbeTestCheck(allocator.GetNumPages() == 3 * (GPULatency + 1));
+    bbeTestCheck(pages.m_NbCreated == 3 * (GPULatency + 1));
+
+    // GPU stalls: the frame after the last completed one's pages are reused, then new pages are created instead
+    const uint32_t nbCreated = pages.m_NbCreated;
+    for (uint64_t frame = 51; frame <= 52; ++frame)
+    {
+        for (uint32_t i = 0; i < NbAllocationsPerFrame; ++i)
+        {
+            allocator.Allocate(1024);
+        }
+        allocator.EndFrame(frame);
+    }
+    bbeTestCheck(pages.m_NbCreated == nbCreated + 3);
+
+    allocator.ShutDown();
+    bbeTestCheck(pages.m_NbWrongCalls == 0);
+}
+
+static void TestBigAllocationsGetDedicatedPages()
+{
+    FakePages pages;
+    GfxLinearAllocator allocator;
+    pages.Initialize(allocator);
+
+    const GfxLinearAllocator::Allocation small = allocator.Allocate(256);
+    const GfxLinearAllocator::Allocation big = allocator.Allocate(PageSize * 3 + 1);
+    bbeTestCheck(big.m_PageIdx != small.m_PageIdx);
+    bbeTestCheck(big.m_Offset == 0);
+    bbeTestCheck(pages.m_PageSizes[big.m_PageIdx] >= PageSize * 3 + 1);
+
+    // the shared page carries on
+    bbeTestCheck(allocator.Allocate(256).m_PageIdx == small.m_PageIdx);
+
+    allocator.EndFrame(1);
+    bbeTestCheck(pages.m_NbDestroyed == 0);
+
+    // destroyed once its frame is done, and its slot reused
+    pages.m_CompletedFenceValue = 1;
+    allocator.EndFrame(2);
+    bbeTestCheck(pages.m_NbDestroyed == 1);
+    bbeTestCheck(pages.m_PageSizes[big.m_PageIdx] == 0);
+    bbeTestCheck(allocator.GetNumPages() == 1);
+    bbeTestCheck(allocator.Allocate(PageSize * 2).m_PageIdx == big.m_PageIdx);
+
+    allocator.ShutDown();
+    bbeTestCheck(pages.m_NbWrongCalls == 0);
+}
+
+static void TestConcurrentAllocationsDontOverlap()
+{
+    // several recording threads, odd sizes: small pages, so they switch pages all the time. ~100 pages per frame, well under NbMaxPages for 2 frames
+    static const uint32_t SmallPageSize = 16 * 1024;
+    static const uint32_t NbAllocationsPerThread = 150;
+
+    FakePages pages;
+    GfxLinearAllocator allocator;
+    pages.Initialize(allocator, SmallPageSize);
+
+    struct Range
+    {
+        uint32_t m_PageIdx;
+        uint32_t m_Begin;
+        uint32_t m_End;
+
+        bool operator<(const Range& other) const { return m_PageIdx != other.m_PageIdx ? m_PageIdx < other.m_PageIdx : m_Begin < other.m_Begin; }
+    };
+    std::vector<Range> ranges[NbThreads];
+
+    for (uint64_t frame = 1; frame <= 2; ++frame)
+    {
+        for (std::vector<Range>& threadRanges : ranges)
+        {
+            threadRanges.reserve(threadRanges.size() + NbAllocationsPerThread);
+        }
+
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < NbThreads; ++t)
+        {
+            threads.emplace_back([&, t]
+                {
+                    RandomGenerator random{ t };
+                    for (uint32_t i = 0; i < NbAllocationsPerThread; ++i)
+                    {
+                        const uint32_t size = 1 + random.NextUInt(2000);
+                        const uint32_t alignment = (i % 16) ? GfxLinearAllocator::DefaultAlignment : 1024;
+                        const GfxLinearAllocator::Allocation allocation = allocator.Allocate(size, alignment);
+                        ranges[t].push_back({ allocation.m_PageIdx, allocation.m_Offset, allocation.m_Offset + size });
+                    }
+                });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        // nobody's done: every page of both frames stays in use
+        allocator.EndFrame(frame);
+    }
+
+    std::vector<Range> allRanges;
+    for (const std::vector<Range>& threadRanges : ranges)
+    {
+        allRanges.insert(allRanges.end(), threadRanges.begin(), threadRanges.end());
+    }
+    std::sort(allRanges.begin(), allRanges.end());
+
+    uint32_t nbOverlaps = 0;
+    uint32_t nbOutOfPage = 0;
+    for (uint32_t i = 0; i < allRanges.size(); ++i)
+    {
+        nbOutOfPage += allRanges[i].m_End > SmallPageSize;
+        if (i > 0 && allRanges[i].m_PageIdx == allRanges[i - 1].m_PageIdx)
+            nbOverlaps += allRanges[i].m_Begin < allRanges[i - 1].m_End;
+    }
+    bbeTestCheck(nbOverlaps == 0);
+    bbeTestCheck(nbOutOfPage == 0);
+
+    allocator.ShutDown();
+    bbeTestCheck(pages.m_NbWrongCalls == 0);
+}
+
+int main()
+{
+    return TestUtils::RunTests({
+        { "AllocationsAreAligned", TestAllocationsAreAligned },
+        { "PagesAreRecycledAfterTheirFrame", TestPagesAreRecycledAfterTheirFrame },
+        { "BigAllocationsGetDedicatedPages", TestBigAllocationsGetDedicatedPages },
+        { "ConcurrentAllocationsDontOverlap", TestConcurrentAllocationsDontOverlap },
+    });
+}
@@ -0,0 +1,168 @@
+#include <graphic/gfx/gfxviewtable.h>
+
+// GfxViewTable with fake descriptor pages: each view is created once, distinct descriptions get distinct descriptors, and released resources give theirs back
+
+static const uint32_t NbThreads = 8;
+
+// Hands out consecutive pages per heap type, in place of g_GfxCPUDescriptorAllocator
+struct FakePages
+{
+    std::atomic<uint32_t> m_NbPages[GfxDescriptorPagePool::NbMaxPools] = {};
+
+    GfxViewTable::PageAllocator GetAllocator() { return [this](uint32_t heapType) { return m_NbPages[heapType]++; }; }
+};
+
+// Stands in for resources: only their addresses matter
+static uint32_t gs_Resources[256];
+
+static void TestViewsAreCreatedOnce()
+{
+    FakePages pages;
+    GfxViewTable table;
+    table.Initialize(pages.GetAllocator());
+
+    uint32_t nbCreated = 0;
+    auto CreateView = [&](uint32_t) { ++nbCreated; };
+
+    // same texture staged for every visual, every frame
+    const GfxViewTable::ViewKey key{ &gs_Resources[0], 0 };
+    const uint32_t descriptorIdx = table.GetOrCreateView(key, 0, CreateView);
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        bbeTestCheck(table.GetOrCreateView(key, 0, CreateView) == descriptorIdx);
+    }
+    bbeTestCheck(nbCreated == 1);
+    bbeTestCheck(table.GetNumMisses() == 1);
+    bbeTestCheck(table.GetNumHits() == 100);
+    bbeTestCheck(table.GetNumViews() == 1);
+}
+
+static void TestDistinctDescriptionsGetDistinctDescriptors()
+{
+    FakePages pages;
+    GfxViewTable table;
+    table.Initialize(pages.GetAllocator());
+
+    // type, format & flags each make a different view of the same resource
+    const GfxViewTable::ViewKey keys[] =
+    {
+        { &gs_Resources[0], 0, 0, 0 },
+        { &gs_Resources[0], 1, 0, 0 },
+        { &gs_Resources[0], 0, 28, 0 },
+        { &gs_Resources[0], 0, 0, 2 },
+        { &gs_Resources[1], 0, 0, 0 },
+    };
+
+    std::vector<uint32_t> descriptors;
+    for (const GfxViewTable::ViewKey& key : keys)
+    {
+        descriptors.push_back(table.GetOrCreateView(key, 0, [](uint32_t) {}));
+    }
+    std::sort(descriptors.begin(), descriptors.end());
+    bbeTestCheck(std::adjacent_find(descriptors.begin(), descriptors.end()) == descriptors.end());
+    bbeTestCheck(table.GetNumViews() == std::size(keys));
+
+    // heap types have their own pages: the first descriptor of another heap is that heap's page 0
+    bbeTestCheck(table.GetOrCreateView({ &gs_Resources[2], 2 }, 2, [](uint32_t) {}) == 0);
+    bbeTestCheck(pages.m_NbPages[0] == 1);
+    bbeTestCheck(pages.m_NbPages[2] == 1);
+
+    // one page per NbDescriptorsPerPage views
+    for (uint32_t i = 3; i < std::size(gs_Resources); ++i)
+    {
+        table.GetOrCreateView({ &gs_Resources[i], 0 }, 0, [](uint32_t) {});
+    }
+    const uint32_t nbViews = std::size(keys) + std::size(gs_Resources) - 3;
+    bbeTestCheck(pages.m_NbPages[0] == (nbViews + GfxDescriptorPagePool::NbDescriptorsPerPage - 1) / GfxDescriptorPagePool::NbDescriptorsPerPage);
+}
+
+static void TestReleasedResourcesAreInvalidated()
+{
+    FakePages pages;
+    GfxViewTable table;
+    table.Initialize(pages.GetAllocator());
+
+    const GfxViewTable::ViewKey SRV{ &gs_Resources[0], 0 };
+    const GfxViewTable::ViewKey UAV{ &gs_Resources[0], 1 };
+    const GfxViewTable::ViewKey otherSRV{ &gs_Resources[1], 0 };
+
+    const uint32_t SRVIdx = table.GetOrCreateView(SRV, 0, [](uint32_t) {});
+    const uint32_t UAVIdx = table.GetOrCreateView(UAV, 0, [](uint32_t) {});
+    const uint32_t otherSRVIdx = table.GetOrCreateView(otherSRV, 0, [](uint32_t) {});
+
+    table.OnResourceReleased(&gs_Resources[0]);
+    table.OnResourceReleased(&gs_Resources[2]); // never had views
+    bbeTestCheck(table.GetNumViews() == 1);
+
+    // a new resource at the same address: its views are created again, in the released descriptors
+    uint32_t nbCreated = 0;
+    const uint32_t newSRVIdx = table.GetOrCreateView(SRV, 0, [&](uint32_t) { ++nbCreated; });
+    const uint32_t newUAVIdx = table.GetOrCreateView(UAV, 0, [&](uint32_t) { ++nbCreated; });
+    bbeTestCheck(nbCreated == 2);
+    bbeTestCheck((newSRVIdx == SRVIdx && newUAVIdx == UAVIdx) || (newSRVIdx == UAVIdx && newUAVIdx == SRVIdx));
+
+    // untouched
+    bbeTestCheck(table.GetOrCreateView(otherSRV, 0, [&](uint32_t) { ++nbCreated; }) == otherSRVIdx);
+    bbeTestCheck(nbCreated == 2);
+    bbeTestCheck(pages.m_NbPages[0] == 1);
+}
+
+static void TestConcurrentLookups()
+{
+    // every thread stages the same views in a different order: each view is created exactly once, and everyone gets the same descriptor
+    FakePages pages;
+    GfxViewTable table;
+    table.Initialize(pages.GetAllocator());
+
+    static const uint32_t NbViews = std::size(gs_Resources);
+    static const uint32_t NbRounds = 20;
+
+    std::vector<std::atomic<uint32_t>> nbCreated(NbViews);
+    std::vector<std::atomic<uint32_t>> descriptors(NbViews);
+    for (std::atomic<uint32_t>& descriptorIdx : descriptors)
+    {
+        descriptorIdx = UINT32_MAX;
+    }
+    std::atomic<uint32_t> nbMismatches = 0;
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < NbThreads; ++t)
+    {
+        threads.emplace_back([&, t]
+            {
+                for (uint32_t round = 0; round < NbRounds; ++round)
+                {
+                    for (uint32_t i = 0; i < NbViews; ++i)
+                    {
+                        const uint32_t viewIdx = (i * 7 + t * 31) % NbViews;
+                        const uint32_t descriptorIdx = table.GetOrCreateView({ &gs_Resources[viewIdx], 0 }, 0, [&](uint32_t) { ++nbCreated[viewIdx]; });
+
+                        uint32_t expected = UINT32_MAX;
+                        if (!descriptors[viewIdx].compare_exchange_strong(expected, descriptorIdx))
+                        {
+                            nbMismatches += expected != descriptorIdx;
+                        }
+                    }
+                }
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    bbeTestCheck(nbMismatches == 0);
+    bbeTestCheck(std::all_of(nbCreated.begin(), nbCreated.end(), [](const std::atomic<uint32_t>& n) { return n == 1; }));
+    bbeTestCheck(table.GetNumMisses() == NbViews);
+    bbeTestCheck(table.GetNumHits() == (uint64_t)NbThreads * NbRounds * NbViews - NbViews);
+}
+
+int main()
+{
+    return TestUtils::RunTests({
+        { "ViewsAreCreatedOnce", TestViewsAreCreatedOnce },
+        { "DistinctDescriptionsGetDistinctDescriptors", TestDistinctDescriptionsGetDistinctDescriptors },
+        { "ReleasedResourcesAreInvalidated", TestReleasedResourcesAreInvalidated },
+        { "ConcurrentLookups", TestConcurrentLookups },
+    });
+}
@@ -0,0 +1,92 @@
+#include <system/asyncfileio.h>
+
+// Reading many small files & a few large ones: blocking ReadDataFromFile on the calling thread vs AsyncFileIO batches.
+// Files are on tmpfs, so this measures the per-file overhead & copies, not the disk
+
+static std::vector<std::string> WriteFiles(const char* prefix, uint32_t nbFiles, uint64_t fileSize)
+{
+    const std::vector<char> contents(fileSize, 'x');
+
+    std::vector<std::string> paths;
+    for (uint32_t i = 0; i < nbFiles; ++i)
+    {
+        paths.push_back(TestUtils::GetTempFilePath(StringFormat("%s%u.bin", prefix, i)));
+        std::ofstream out{ paths.back(), std::ios::binary | std::ios::trunc };
+        out.write(contents.data(), contents.size());
+    }
+    return paths;
+}
+
+static double ReadBlocking(const std::vector<std::string>& paths)
+{
+    return TestUtils::MeasureSeconds([&]
+        {
+            for (const std::string& path : paths)
+            {
+                std::vector<std::byte> data;
+                ReadDataFromFile(path.c_str(), data);
+                TestUtils::DoNotOptimize(data);
+            }
+        });
+}
+
+static double ReadAsync(const std::vector<std::string>& paths, uint32_t batchSize)
+{
+    std::atomic<uint32_t> nbCompleted = 0;
+    return TestUtils::MeasureSeconds([&]
+        {
+            for (uint32_t first = 0; first < paths.size(); first += batchSize)
+            {
+                std::vector<AsyncFileIO::ReadRequest> requests(std::min<std::size_t>(batchSize, paths.size() - first));
+                for (uint32_t i = 0; i < requests.size(); ++i)
+                {
+                    requests[i].m_FilePath = paths[first + i];
+                    requests[i].m_OnComplete = [&](AsyncFileIO::ReadResult& result)
+                    {
+                        TestUtils::DoNotOptimize(result.m_Data);
+                        nbCompleted.fetch_add(1, std::memory_order_release);
+                    };
+                }
+                g_AsyncFileIO.ReadBatch(std::move(requests));
+            }
+
+            while (nbCompleted.load(std::memory_order_acquire) < paths.size())
+            {
+                std::this_thread::yield();
+            }
+        });
+}
+
+static void RunCase(const char* name, const char* prefix, uint32_t nbFiles, uint64_t fileSize)
+{
+    const std::vector<std::string> paths = WriteFiles(prefix, nbFiles, fileSize);
+    const double totalMB = (double)nbFiles * fileSize / (1024.0 * 1024.0);
+
+    const double blockingSeconds = ReadBlocking(paths);
+    const double batch1Seconds = ReadAsync(paths, 1);
+    const double batch64Seconds = ReadAsync(paths, 64);
+
+    printf("%-24s %12.1f MB/s %12.1f MB/s %12.1f MB/s\n", name, totalMB / blockingSeconds, totalMB / batch1Seconds, totalMB / batch64Seconds);
+
+    for (const std::string& path : paths)
+    {
+        std::filesystem::remove(path);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestUtils::ParseQuickArg(argc, argv);
+
+    g_Log.Initialize(TestUtils::GetTempFilePath("asyncfileiobenchmark.txt").c_str(), false);
+    g_AsyncFileIO.Initialize(2);
+
+    TestUtils::PrintBenchmarkHeader("File reads: blocking ReadDataFromFile vs AsyncFileIO batches");
+    printf("%-24s %17s %17s %17s\n", "files", "blocking", "async, batch 1", "async, batch 64");
+
+    RunCase(quick ? "256 x 16KB" : "4096 x 16KB", "afio_small", quick ? 256 : 4096, 16 * 1024);
+    RunCase(quick ? "4 x 4MB" : "4 x 128MB", "afio_large", 4, quick ? (4ULL << 20) : (128ULL << 20));
+
+    g_AsyncFileIO.ShutDown();
+    return 0;
+}
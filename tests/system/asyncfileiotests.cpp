@@ -0,0 +1,172 @@
+#include <system/asyncfileio.h>
+
+// The portable backend: blocking pread on the IO threads, completions dispatched to the tasks executor
+
+static std::string WriteTestFile(const char* fileName, uint64_t size)
+{
+    std::vector<uint8_t> contents(size);
+    for (uint64_t i = 0; i < size; ++i)
+    {
+        contents[i] = (uint8_t)(i * 13 + 5);
+    }
+
+    const std::string path = TestUtils::GetTempFilePath(fileName);
+    std::ofstream out{ path, std::ios::binary | std::ios::trunc };
+    out.write((const char*)contents.data(), contents.size());
+    return path;
+}
+
+static bool CheckContents(const AsyncFileIO::ReadResult& result, uint64_t fileOffset)
+{
+    for (uint64_t i = 0; i < result.m_Size; ++i)
+    {
+        if ((uint8_t)result.m_Data[i] != (uint8_t)((fileOffset + i) * 13 + 5))
+            return false;
+    }
+    return true;
+}
+
+static AsyncFileIO::ReadResult ReadSync(const std::string& path, uint64_t offset = 0, uint64_t size = AsyncFileIO::WholeFile, std::byte* dest = nullptr, uint64_t destCapacity = 0)
+{
+    AsyncFileIO::ReadRequest request;
+    request.m_FilePath = path;
+    request.m_Offset = offset;
+    request.m_Size = size;
+    request.m_Dest = dest;
+    request.m_DestCapacity = destCapacity;
+    return g_AsyncFileIO.Read(std::move(request)).get();
+}
+
+static void TestWholeFileAndRanges()
+{
+    const uint64_t fileSize = 300'000;
+    const std::string path = WriteTestFile("asyncfileio_ranges.bin", fileSize);
+
+    AsyncFileIO::ReadResult whole = ReadSync(path);
+    bbeTestCheck(whole.m_Success);
+    bbeTestCheck(whole.m_Size == fileSize);
+    bbeTestCheck(whole.m_Data == whole.m_Buffer.GetData());
+    bbeTestCheck(((uintptr_t)whole.m_Data % 4096) == 0);
+    bbeTestCheck(CheckContents(whole, 0));
+
+    AsyncFileIO::ReadResult range = ReadSync(path, 12345, 1000);
+    bbeTestCheck(range.m_Success);
+    bbeTestCheck(range.m_Size == 1000);
+    bbeTestCheck(CheckContents(range, 12345));
+
+    // clamped to the end of file
+    AsyncFileIO::ReadResult tail = ReadSync(path, fileSize - 10, 1000);
+    bbeTestCheck(tail.m_Success);
+    bbeTestCheck(tail.m_Size == 10);
+    bbeTestCheck(CheckContents(tail, fileSize - 10));
+
+    AsyncFileIO::ReadResult pastEnd = ReadSync(path, fileSize + 1, 10);
+    bbeTestCheck(!pastEnd.m_Success);
+    bbeTestCheck(pastEnd.m_Data == nullptr);
+
+    std::filesystem::remove(path);
+}
+
+static void TestCallerDestination()
+{
+    const std::string path = WriteTestFile("asyncfileio_dest.bin", 5000);
+
+    std::vector<std::byte> dest(8000);
+    AsyncFileIO::ReadResult result = ReadSync(path, 0, AsyncFileIO::WholeFile, dest.data(), dest.size());
+    bbeTestCheck(result.m_Success);
+    bbeTestCheck(result.m_Data == dest.data());
+    bbeTestCheck(result.m_Buffer.GetData() == nullptr);
+    bbeTestCheck(CheckContents(result, 0));
+
+    // doesn't fit
+    AsyncFileIO::ReadResult tooSmall = ReadSync(path, 0, AsyncFileIO::WholeFile, dest.data(), 100);
+    bbeTestCheck(!tooSmall.m_Success);
+
+    std::filesystem::remove(path);
+}
+
+static void TestMissingFile()
+{
+    AsyncFileIO::ReadResult result = ReadSync(TestUtils::GetTempFilePath("asyncfileio_missing.bin"));
+    bbeTestCheck(!result.m_Success);
+    bbeTestCheck(result.m_Size == 0);
+}
+
+static void TestBatchCallbacks()
+{
+    static const uint32_t NbFiles = 64;
+
+    std::vector<std::string> paths;
+    for (uint32_t i = 0; i < NbFiles; ++i)
+    {
+        paths.push_back(WriteTestFile(StringFormat("asyncfileio_batch%u.bin", i), 1000 + i * 100));
+    }
+
+    std::atomic<uint32_t> nbCompleted = 0;
+    std::atomic<uint32_t> nbValid = 0;
+
+    // several batches in flight at once, across all IO threads. The last one has a missing file
+    for (uint32_t batchIdx = 0; batchIdx < 4; ++batchIdx)
+    {
+        std::vector<AsyncFileIO::ReadRequest> requests(NbFiles / 4 + (batchIdx == 3));
+        for (uint32_t i = 0; i < requests.size(); ++i)
+        {
+            const uint32_t fileIdx = batchIdx * (NbFiles / 4) + i;
+            const bool isMissing = fileIdx == NbFiles;
+
+            requests[i].m_FilePath = isMissing ? TestUtils::GetTempFilePath("asyncfileio_missing.bin") : paths[fileIdx];
+            requests[i].m_OnComplete = [&, fileIdx, isMissing](AsyncFileIO::ReadResult& result)
+            {
+                const bool expectedResult = isMissing ? !result.m_Success : (result.m_Success && result.m_Size == 1000 + fileIdx * 100 && CheckContents(result, 0));
+                nbValid += expectedResult;
+                ++nbCompleted;
+            };
+        }
+        g_AsyncFileIO.ReadBatch(std::move(requests));
+    }
+
+    while (nbCompleted < NbFiles + 1)
+    {
+        std::this_thread::yield();
+    }
+    bbeTestCheck(nbValid == NbFiles + 1);
+
+    for (const std::string& path : paths)
+    {
+        std::filesystem::remove(path);
+    }
+}
+
+static void TestPooledBuffers()
+{
+    // released buffers go back to their size class, and are handed out again
+    std::byte* data = nullptr;
+    {
+        FileIOBuffer buffer = FileIOBuffer::Allocate(100'000);
+        bbeTestCheck(buffer.GetCapacity() == 128 * 1024);
+        data = buffer.GetData();
+    }
+    FileIOBuffer buffer = FileIOBuffer::Allocate(70'000);
+    bbeTestCheck(buffer.GetData() == data);
+
+    // too big to be pooled: page aligned size
+    FileIOBuffer bigBuffer = FileIOBuffer::Allocate((64ULL << 20) + 1);
+    bbeTestCheck(bigBuffer.GetCapacity() == (64ULL << 20) + 4096);
+}
+
+int main()
+{
+    g_Log.Initialize(TestUtils::GetTempFilePath("asyncfileiotests.txt").c_str(), false);
+    g_AsyncFileIO.Initialize(2);
+
+    const int result = TestUtils::RunTests({
+        { "WholeFileAndRanges", TestWholeFileAndRanges },
+        { "CallerDestination", TestCallerDestination },
+        { "MissingFile", TestMissingFile },
+        { "BatchCallbacks", TestBatchCallbacks },
+        { "PooledBuffers", TestPooledBuffers },
+    });
+
+    g_AsyncFileIO.ShutDown();
+    return result;
+}
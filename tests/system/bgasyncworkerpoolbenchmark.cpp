@@ -0,0 +1,99 @@
+#include <system/bgasyncworkerpool.h>
+
+// Enqueue-to-start latency of 1 job on an idle pool, and throughput of batches of small jobs
+
+static void MeasureLatency(uint32_t nbJobs)
+{
+    BGAsyncWorkerPool pool;
+    pool.Initialize(2);
+
+    std::vector<double> latenciesUs;
+    latenciesUs.reserve(nbJobs);
+
+    for (uint32_t i = 0; i < nbJobs; ++i)
+    {
+        // let the workers go back to sleep: measure the wake up, not a spinning worker
+        std::this_thread::sleep_for(std::chrono::microseconds{ 200 });
+
+        std::atomic<bool> started = false;
+        double startTime = 0.0;
+
+        const double enqueueTime = TestUtils::GetTimeSeconds();
+        pool.AddJob([&]
+            {
+                startTime = TestUtils::GetTimeSeconds();
+                started.store(true, std::memory_order_release);
+            });
+
+        while (!started.load(std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+        latenciesUs.push_back((startTime - enqueueTime) * 1e6);
+    }
+    pool.ShutDown();
+
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+    auto Percentile = [&](double p) { return latenciesUs[std::min((size_t)(p * latenciesUs.size()), latenciesUs.size() - 1)]; };
+    printf("enqueue-to-start latency: median %.1f us, p90 %.1f us, p99 %.1f us, max %.1f us\n", Percentile(0.5), Percentile(0.9), Percentile(0.99), latenciesUs.back());
+}
+
+static void MeasureThroughput(uint32_t nbWorkers, uint32_t batchSize, uint32_t nbBatches)
+{
+    BGAsyncWorkerPool pool;
+    pool.Initialize(nbWorkers);
+
+    std::atomic<uint64_t> sink = 0;
+    std::atomic<uint32_t> nbDone = 0;
+
+    const double seconds = TestUtils::MeasureSeconds([&]
+        {
+            for (uint32_t batch = 0; batch < nbBatches; ++batch)
+            {
+                nbDone = 0;
+                for (uint32_t i = 0; i < batchSize; ++i)
+                {
+                    pool.AddJob([&, i]
+                        {
+                            // ~1us of work
+                            uint64_t value = i;
+                            for (uint32_t j = 0; j < 500; ++j)
+                            {
+                                value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+                            }
+                            sink.fetch_add(value, std::memory_order_relaxed);
+                            nbDone.fetch_add(1, std::memory_order_release);
+                        });
+                }
+
+                while (nbDone.load(std::memory_order_acquire) < batchSize)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    pool.ShutDown();
+
+    const double nbJobs = (double)batchSize * nbBatches;
+    printf("%-8u %-10u %12.2f M jobs/s %12.2f us/batch\n", nbWorkers, batchSize, nbJobs / seconds / 1e6, seconds * 1e6 / nbBatches);
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestUtils::ParseQuickArg(argc, argv);
+
+    TestUtils::PrintBenchmarkHeader("BGAsyncWorkerPool");
+
+    MeasureLatency(quick ? 100 : 5000);
+
+    printf("%-8s %-10s %20s %20s\n", "workers", "batch", "throughput", "batch time");
+    for (uint32_t nbWorkers : { 1U, 2U, 4U })
+    {
+        for (uint32_t batchSize : { 16U, 256U, 4096U })
+        {
+            MeasureThroughput(nbWorkers, batchSize, std::max((quick ? 20000U : 1000000U) / batchSize, 1U));
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <system/bgasyncworkerpool.h>
+
+// The profiler's spike capture relies on jobs being destroyed on every path (run, cancelled, dropped at shutdown) to clear its in-flight flag
+static std::shared_ptr<void> MakeReleaseCounter(std::atomic<uint32_t>& nbReleased)
+{
+    return std::shared_ptr<void>{ nullptr, [&nbReleased](void*) { ++nbReleased; } };
+}
+
+static void TestJobsRun()
+{
+    BGAsyncWorkerPool pool;
+    pool.Initialize(2);
+
+    std::atomic<uint32_t> nbRun = 0;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        pool.AddJob([&] { ++nbRun; });
+    }
+    while (nbRun < 100)
+    {
+        std::this_thread::yield();
+    }
+    pool.ShutDown();
+
+    bbeTestCheck(nbRun == 100);
+}
+
+static void TestJobsReleasedOnEveryPath()
+{
+    BGAsyncWorkerPool pool;
+    pool.Initialize(1);
+
+    std::atomic<uint32_t> nbReleased = 0;
+
+    // executed
+    std::atomic<bool> done = false;
+    pool.AddJob([guard = MakeReleaseCounter(nbReleased), &done] { done = true; });
+    while (!done)
+    {
+        std::this_thread::yield();
+    }
+
+    // block the only worker, so the next jobs stay pending
+    std::atomic<bool> unblock = false;
+    std::atomic<bool> blocked = false;
+    pool.AddJob([&] { blocked = true; while (!unblock) { std::this_thread::yield(); } });
+    while (!blocked)
+    {
+        std::this_thread::yield();
+    }
+
+    // cancelled
+    const BGAsyncWorkerPool::JobID cancelledID = pool.AddJob([guard = MakeReleaseCounter(nbReleased)] {});
+    bbeTestCheck(pool.CancelJob(cancelledID));
+
+    // dropped at shutdown
+    pool.AddJob([guard = MakeReleaseCounter(nbReleased)] {}, BGAsyncWorkerPool::Prefetch);
+
+    // worker releases the executed job right after running it
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+    bbeTestCheck(nbReleased == 2);
+
+    // the dropped job never runs, but is released all the same
+    std::thread unblocker{ [&] { std::this_thread::sleep_for(std::chrono::milliseconds{ 10 }); unblock = true; } };
+    pool.ShutDown();
+    unblocker.join();
+
+    bbeTestCheck(nbReleased == 3);
+}
+
+int main()
+{
+    // ShutDown logs the dropped jobs
+    g_Log.Initialize(TestUtils::GetTempFilePath("bgasyncworkerpooltests.txt").c_str(), false);
+
+    return TestUtils::RunTests({
+        { "JobsRun", TestJobsRun },
+        { "JobsReleasedOnEveryPath", TestJobsReleasedOnEveryPath },
+    });
+}
@@ -0,0 +1,82 @@
+#include <system/commandmanager.h>
+
+// ConsumeAllCommandsMT dispatch cost: 1 task per command vs commands grouped into chunks, from 10 to 10,000 small commands
+
+static void SmallWork(uint64_t& value)
+{
+    // ~100ns of work: a typical small command
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+}
+
+static double RunPerCommandTasks(uint32_t nbCommands, uint32_t nbRuns, std::vector<uint64_t>& values)
+{
+    return TestUtils::MeasureSeconds([&]
+        {
+            for (uint32_t run = 0; run < nbRuns; ++run)
+            {
+                tf::Taskflow taskflow;
+                taskflow.emplace([&](tf::Subflow& sf)
+                    {
+                        for (uint32_t i = 0; i < nbCommands; ++i)
+                        {
+                            sf.emplace([&values, i] { SmallWork(values[i]); });
+                        }
+                    });
+                g_TasksExecutor.run(taskflow).wait();
+            }
+        });
+}
+
+static double RunCommandManager(uint32_t nbCommands, uint32_t nbRuns, uint32_t grainSize, std::vector<uint64_t>& values)
+{
+    CommandManager manager;
+    manager.Initialize(1024);
+    manager.SetGrainSize(grainSize);
+
+    return TestUtils::MeasureSeconds([&]
+        {
+            for (uint32_t run = 0; run < nbRuns; ++run)
+            {
+                for (uint32_t i = 0; i < nbCommands; ++i)
+                {
+                    manager.AddCommand([&values, i] { SmallWork(values[i]); });
+                }
+
+                tf::Taskflow taskflow;
+                taskflow.emplace([&](tf::Subflow& sf) { manager.ConsumeAllCommandsMT(sf); });
+                g_TasksExecutor.run(taskflow).wait();
+            }
+        });
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestUtils::ParseQuickArg(argc, argv);
+    const uint32_t nbCommandsTotal = quick ? 20000 : 1000000;
+
+    TestUtils::PrintBenchmarkHeader("CommandManager: per-command tasks vs chunked dispatch");
+    printf("%-10s %16s %16s %16s %16s\n", "commands", "task/command", "grain 1", "grain 16", "grain 64");
+
+    std::vector<uint64_t> values;
+    for (uint32_t nbCommands : { 10U, 100U, 1000U, 10000U })
+    {
+        values.assign(nbCommands, 1);
+        const uint32_t nbRuns = std::max(nbCommandsTotal / nbCommands, 1U);
+
+        // ns per command, dispatch overhead included
+        auto ToNs = [&](double seconds) { return seconds * 1e9 / ((double)nbCommands * nbRuns); };
+
+        const double perTaskNs = ToNs(RunPerCommandTasks(nbCommands, nbRuns, values));
+        const double grain1Ns = ToNs(RunCommandManager(nbCommands, nbRuns, 1, values));
+        const double grain16Ns = ToNs(RunCommandManager(nbCommands, nbRuns, 16, values));
+        const double grain64Ns = ToNs(RunCommandManager(nbCommands, nbRuns, 64, values));
+
+        printf("%-10u %13.1f ns %13.1f ns %13.1f ns %13.1f ns\n", nbCommands, perTaskNs, grain1Ns, grain16Ns, grain64Ns);
+    }
+    TestUtils::DoNotOptimize(values);
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include <system/commandmanager.h>
+
+// N producer threads vs 1 consumer thread, against a mutex protected std::vector<std::function> baseline
+
+struct MutexCommandQueue
+{
+    void AddCommand(std::function<void()>&& cmd)
+    {
+        std::lock_guard<std::mutex> lock{ m_Lock };
+        m_Pending.push_back(std::move(cmd));
+    }
+
+    void ConsumeAllCommandsST()
+    {
+        {
+            std::lock_guard<std::mutex> lock{ m_Lock };
+            m_Pending.swap(m_Executing);
+        }
+        for (const std::function<void()>& cmd : m_Executing)
+        {
+            cmd();
+        }
+        m_Executing.clear();
+    }
+
+    std::mutex m_Lock;
+    std::vector<std::function<void()>> m_Pending;
+    std::vector<std::function<void()>> m_Executing;
+};
+
+template <typename Queue>
+static double RunContention(Queue& queue, uint32_t nbProducers, uint32_t nbCommandsPerProducer)
+{
+    // 32 bytes of captures: a typical small command
+    uint64_t sink[4] = {};
+    std::atomic<uint32_t> nbProducersDone = 0;
+    std::atomic<bool> start = false;
+
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < nbProducers; ++p)
+    {
+        producers.emplace_back([&, p]
+            {
+                while (!start) { std::this_thread::yield(); }
+                for (uint32_t i = 0; i < nbCommandsPerProducer; ++i)
+                {
+                    queue.AddCommand([&sink, p, i, a = (uint64_t)i * 3, b = (uint64_t)p * 7] { sink[p & 3] += a + b + i; });
+                }
+                ++nbProducersDone;
+            });
+    }
+
+    const double seconds = TestUtils::MeasureSeconds([&]
+        {
+            start = true;
+            while (nbProducersDone < nbProducers)
+            {
+                queue.ConsumeAllCommandsST();
+            }
+            queue.ConsumeAllCommandsST();
+        });
+
+    for (std::thread& t : producers)
+    {
+        t.join();
+    }
+    TestUtils::DoNotOptimize(sink);
+
+    return seconds;
+}
+
+// Push & consume on the same thread: cost of the queue itself, without any contention
+template <typename Queue>
+static double RunUncontended(Queue& queue, uint32_t nbCommands)
+{
+    uint64_t sink = 0;
+    const double seconds = TestUtils::MeasureSeconds([&]
+        {
+            for (uint32_t i = 0; i < nbCommands; ++i)
+            {
+                queue.AddCommand([&sink, i, a = (uint64_t)i * 3] { sink += a + i; });
+                if ((i & 63) == 63)
+                    queue.ConsumeAllCommandsST();
+            }
+            queue.ConsumeAllCommandsST();
+        });
+    TestUtils::DoNotOptimize(sink);
+
+    return seconds;
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestUtils::ParseQuickArg(argc, argv);
+    const uint32_t nbCommandsPerProducer = quick ? 10000 : 500000;
+
+    TestUtils::PrintBenchmarkHeader("CommandManager: N producers vs 1 consumer");
+    printf("%-10s %-12s %16s %16s\n", "producers", "ring size", "CommandManager", "mutex+function");
+
+    {
+        CommandManager manager;
+        manager.Initialize(CommandManager::DefaultRingSize);
+        MutexCommandQueue baseline;
+        const uint32_t nbCommands = nbCommandsPerProducer * 4;
+        printf("%-10s %-12u %11.2f M/s %11.2f M/s\n", "none", CommandManager::DefaultRingSize,
+            nbCommands / RunUncontended(manager, nbCommands) / 1e6, nbCommands / RunUncontended(baseline, nbCommands) / 1e6);
+    }
+
+    for (uint32_t nbProducers : { 1U, 2U, 4U, 8U })
+    {
+        for (uint32_t ringSize : { 64U, 1024U })
+        {
+            CommandManager manager;
+            manager.Initialize(ringSize);
+            const double managerSeconds = RunContention(manager, nbProducers, nbCommandsPerProducer);
+
+            MutexCommandQueue baseline;
+            const double baselineSeconds = RunContention(baseline, nbProducers, nbCommandsPerProducer);
+
+            const double nbCommands = (double)nbProducers * nbCommandsPerProducer;
+            printf("%-10u %-12u %11.2f M/s %11.2f M/s\n", nbProducers, ringSize, nbCommands / managerSeconds / 1e6, nbCommands / baselineSeconds / 1e6);
+        }
+    }
+
+    return 0;
+}
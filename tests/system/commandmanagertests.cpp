@@ -0,0 +1,236 @@
+#include <system/commandmanager.h>
+
+static void RunMT(CommandManager& manager)
+{
+    tf::Taskflow taskflow;
+    taskflow.emplace([&](tf::Subflow& sf) { manager.ConsumeAllCommandsMT(sf); });
+    g_TasksExecutor.run(taskflow).wait();
+}
+
+static void TestOrderAcrossRingAndOverflow()
+{
+    // tiny ring: most commands spill into the overflow list
+    CommandManager manager;
+    manager.Initialize(4);
+
+    std::vector<uint32_t> executed;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        manager.AddCommand([&executed, i] { executed.push_back(i); });
+    }
+    manager.ConsumeAllCommandsST();
+
+    bbeTestCheck(executed.size() == 100);
+    for (uint32_t i = 0; i < executed.size(); ++i)
+    {
+        bbeTestCheck(executed[i] == i);
+    }
+}
+
+static void TestOrderWithPartialConsumes()
+{
+    // slots get freed in the middle of a lap, while older positions are still in the overflow list
+    CommandManager manager;
+    manager.Initialize(4);
+
+    std::vector<uint32_t> executed;
+    uint32_t nextIdx = 0;
+    auto Push = [&](uint32_t count)
+    {
+        for (uint32_t i = 0; i < count; ++i, ++nextIdx)
+        {
+            manager.AddCommand([&executed, idx = nextIdx] { executed.push_back(idx); });
+        }
+    };
+
+    Push(6);
+    bbeTestCheck(manager.ConsumeOneCommand());
+    bbeTestCheck(manager.ConsumeOneCommand());
+    Push(3);
+    bbeTestCheck(manager.ConsumeOneCommand());
+    Push(10);
+    manager.ConsumeAllCommandsST();
+    Push(2);
+    manager.ConsumeAllCommandsST();
+    bbeTestCheck(!manager.ConsumeOneCommand());
+
+    bbeTestCheck(executed.size() == nextIdx);
+    for (uint32_t i = 0; i < executed.size(); ++i)
+    {
+        bbeTestCheck(executed[i] == i);
+    }
+}
+
+static void TestConsumeStopsAtEndPos()
+{
+    // commands added while consuming must wait for the next consume, whether they land in the ring or in the overflow list
+    CommandManager manager;
+    manager.Initialize(2);
+
+    uint32_t nbExecuted = 0;
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        manager.AddCommand([&]
+            {
+                ++nbExecuted;
+                manager.AddCommand([&] { ++nbExecuted; });
+            });
+    }
+
+    manager.ConsumeAllCommandsST();
+    bbeTestCheck(nbExecuted == 8);
+
+    manager.ConsumeAllCommandsST();
+    bbeTestCheck(nbExecuted == 16);
+
+    manager.ConsumeAllCommandsST();
+    bbeTestCheck(nbExecuted == 16);
+}
+
+static void TestConcurrentProducers()
+{
+    static const uint32_t NbProducers = 4;
+    static const uint32_t NbCommandsPerProducer = 20000;
+
+    CommandManager manager;
+    manager.Initialize(16);
+
+    // only the consumer thread writes these
+    std::vector<uint32_t> lastSeen(NbProducers, 0);
+    uint32_t nbOutOfOrder = 0;
+    uint32_t nbExecuted = 0;
+
+    std::atomic<uint32_t> nbProducersDone = 0;
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < NbProducers; ++p)
+    {
+        producers.emplace_back([&, p]
+            {
+                for (uint32_t i = 1; i <= NbCommandsPerProducer; ++i)
+                {
+                    manager.AddCommand([&, p, i]
+                        {
+                            nbOutOfOrder += (i != lastSeen[p] + 1);
+                            lastSeen[p] = i;
+                            ++nbExecuted;
+                        });
+                }
+                ++nbProducersDone;
+            });
+    }
+
+    while (nbProducersDone < NbProducers)
+    {
+        manager.ConsumeAllCommandsST();
+    }
+    manager.ConsumeAllCommandsST();
+
+    for (std::thread& t : producers)
+    {
+        t.join();
+    }
+
+    bbeTestCheck(nbOutOfOrder == 0);
+    bbeTestCheck(nbExecuted == NbProducers * NbCommandsPerProducer);
+}
+
+static void TestConsumeMT()
+{
+    CommandManager manager;
+    manager.Initialize(8);
+    manager.SetGrainSize(4);
+
+    static const uint32_t NbCommands = 1000;
+    std::vector<std::atomic<uint32_t>> executedCount(NbCommands);
+    std::vector<uint32_t> serialOrder;
+
+    for (uint32_t i = 0; i < NbCommands; ++i)
+    {
+        const bool serial = (i % 10) == 0;
+        manager.AddCommand([&, i, serial]
+            {
+                ++executedCount[i];
+                if (serial)
+                    serialOrder.push_back(i);
+            }, CommandProperties{ 1, serial });
+    }
+    RunMT(manager);
+
+    bool allOnce = true;
+    for (const std::atomic<uint32_t>& count : executedCount)
+    {
+        allOnce &= (count == 1);
+    }
+    bbeTestCheck(allOnce);
+
+    bbeTestCheck(serialOrder.size() == NbCommands / 10);
+    for (uint32_t i = 0; i < serialOrder.size(); ++i)
+    {
+        bbeTestCheck(serialOrder[i] == i * 10);
+    }
+
+    // executing buffers must be cleared for the next frame
+    uint32_t nbExecuted = 0;
+    manager.AddCommand([&] { ++nbExecuted; });
+    RunMT(manager);
+    bbeTestCheck(nbExecuted == 1);
+}
+
+static void TestSerialCommandsRunAfterParallelCommands()
+{
+    TestUtils::ResetTasksExecutor(4);
+
+    CommandManager manager;
+    manager.Initialize();
+    manager.SetGrainSize(1);
+
+    static const uint32_t NbParallelCommands = 200;
+    std::atomic<uint32_t> nbParallelDone = 0;
+    uint32_t nbParallelSeenBySerial = 0;
+
+    for (uint32_t i = 0; i < NbParallelCommands; ++i)
+    {
+        // serial command in the middle of the submissions
+        if (i == NbParallelCommands / 2)
+            manager.AddCommand([&] { nbParallelSeenBySerial = nbParallelDone; }, CommandProperties{ 1, true });
+
+        manager.AddCommand([&]
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds{ 10 });
+                ++nbParallelDone;
+            });
+    }
+    RunMT(manager);
+
+    bbeTestCheck(nbParallelSeenBySerial == NbParallelCommands);
+
+    TestUtils::ResetTasksExecutor(std::thread::hardware_concurrency());
+}
+
+static void TestPendingCommandsFreedOnDestruction()
+{
+    auto sharedObj = std::make_shared<uint32_t>(0);
+    {
+        CommandManager manager;
+        manager.Initialize(2);
+        for (uint32_t i = 0; i < 10; ++i)
+        {
+            manager.AddCommand([sharedObj] { ++*sharedObj; });
+        }
+        bbeTestCheck(sharedObj.use_count() == 11);
+    }
+    bbeTestCheck(sharedObj.use_count() == 1);
+}
+
+int main()
+{
+    return TestUtils::RunTests({
+        { "OrderAcrossRingAndOverflow", TestOrderAcrossRingAndOverflow },
+        { "OrderWithPartialConsumes", TestOrderWithPartialConsumes },
+        { "ConsumeStopsAtEndPos", TestConsumeStopsAtEndPos },
+        { "ConcurrentProducers", TestConcurrentProducers },
+        { "ConsumeMT", TestConsumeMT },
+        { "SerialCommandsRunAfterParallelCommands", TestSerialCommandsRunAfterParallelCommands },
+        { "PendingCommandsFreedOnDestruction", TestPendingCommandsFreedOnDestruction },
+    });
+}
@@ -0,0 +1,156 @@
+// ConcurrentQueue, ConcurrentVector & ConcurrentUnorderedMap/Set hammered by several threads: nothing lost, nothing duplicated, addresses stay put
+
+static const uint32_t NbThreads = 8;
+
+template <typename Func>
+static void RunOnThreads(Func&& func)
+{
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < NbThreads; ++t)
+    {
+        threads.emplace_back([&, t] { func(t); });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+static void TestQueueMPMC()
+{
+    // small queue, so producers regularly find it full & consumers find it empty
+    static const uint32_t NbValuesPerProducer = 50000;
+    static const uint32_t NbProducers = NbThreads / 2;
+
+    ConcurrentQueue<uint32_t> queue{ 64 };
+    std::vector<std::atomic<uint32_t>> nbPopped(NbValuesPerProducer * NbProducers);
+    std::atomic<uint32_t> nbPoppedTotal = 0;
+
+    RunOnThreads([&](uint32_t t)
+        {
+            if (t < NbProducers)
+            {
+                for (uint32_t i = 0; i < NbValuesPerProducer; ++i)
+                {
+                    queue.push(t * NbValuesPerProducer + i);
+                }
+                return;
+            }
+
+            while (nbPoppedTotal < NbValuesPerProducer * NbProducers)
+            {
+                uint32_t value;
+                if (queue.try_pop(value))
+                {
+                    ++nbPopped[value];
+                    ++nbPoppedTotal;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+    uint32_t nbWrongCounts = 0;
+    for (const std::atomic<uint32_t>& count : nbPopped)
+    {
+        nbWrongCounts += count != 1;
+    }
+    bbeTestCheck(nbWrongCounts == 0);
+    bbeTestCheck(queue.empty());
+}
+
+static void TestQueueDestroysLeftovers()
+{
+    std::weak_ptr<uint32_t> leftover;
+    {
+        ConcurrentQueue<std::shared_ptr<uint32_t>> queue{ 4 };
+        std::shared_ptr<uint32_t> value = std::make_shared<uint32_t>(1);
+        leftover = value;
+
+        bbeTestCheck(queue.try_push(std::move(value)));
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            bbeTestCheck(queue.try_push(nullptr));
+        }
+        bbeTestCheck(!queue.try_push(nullptr));
+    }
+    bbeTestCheck(leftover.expired());
+}
+
+static void TestVectorStableAddresses()
+{
+    static const uint32_t NbValuesPerThread = 20000;
+
+    ConcurrentVector<uint64_t> vector;
+    std::vector<std::vector<const uint64_t*>> addresses(NbThreads);
+
+    RunOnThreads([&](uint32_t t)
+        {
+            for (uint32_t i = 0; i < NbValuesPerThread; ++i)
+            {
+                addresses[t].push_back(&vector.push_back(((uint64_t)t << 32) | i));
+            }
+        });
+
+    bbeTestCheck(vector.size() == NbThreads * NbValuesPerThread);
+
+    // every element still where it was pushed, with its value
+    uint32_t nbMismatches = 0;
+    for (uint32_t t = 0; t < NbThreads; ++t)
+    {
+        for (uint32_t i = 0; i < NbValuesPerThread; ++i)
+        {
+            nbMismatches += *addresses[t][i] != (((uint64_t)t << 32) | i);
+        }
+    }
+    bbeTestCheck(nbMismatches == 0);
+
+    std::vector<uint64_t> values;
+    vector.for_each([&](uint64_t value) { values.push_back(value); });
+    std::sort(values.begin(), values.end());
+    bbeTestCheck(std::adjacent_find(values.begin(), values.end()) == values.end());
+}
+
+static void TestShardedMap()
+{
+    static const uint32_t NbKeys = 10000;
+
+    ConcurrentUnorderedMap<uint32_t, uint32_t> map;
+    ConcurrentUnorderedSet<uint32_t> set;
+
+    // every thread races on the same keys: exactly one insert per key wins, and every increment lands
+    std::atomic<uint32_t> nbInserted = 0;
+    RunOnThreads([&](uint32_t t)
+        {
+            for (uint32_t key = 0; key < NbKeys; ++key)
+            {
+                nbInserted += map.insert(key, 0);
+                map.modify(key, [](uint32_t& value) { ++value; });
+                set.insert(key ^ t);
+            }
+        });
+
+    bbeTestCheck(nbInserted == NbKeys);
+    bbeTestCheck(map.size() == NbKeys);
+    bbeTestCheck(set.size() == NbKeys); // NbKeys is a multiple of 8: xor-ing the 3 low bits stays in [0, NbKeys)
+
+    uint32_t nbWrongCounts = 0;
+    map.for_each([&](uint32_t, uint32_t count) { nbWrongCounts += count != NbThreads; });
+    bbeTestCheck(nbWrongCounts == 0);
+
+    uint32_t value = 0;
+    bbeTestCheck(map.find(42, value) && value == NbThreads);
+    bbeTestCheck(map.erase(42) && !map.contains(42));
+}
+
+int main()
+{
+    return TestUtils::RunTests({
+        { "QueueMPMC", TestQueueMPMC },
+        { "QueueDestroysLeftovers", TestQueueDestroysLeftovers },
+        { "VectorStableAddresses", TestVectorStableAddresses },
+        { "ShardedMap", TestShardedMap },
+    });
+}
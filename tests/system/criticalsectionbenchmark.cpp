@@ -0,0 +1,97 @@
+// Ping-pong wake latency of EventLockable vs a mutex + condition variable event: back to back round trips (the waiter is still spinning), and round trips after the waiter parked
+
+// What EventLockable replaced on Linux: always goes through the kernel when it has to wait
+class CondVarEvent
+{
+public:
+    void Wait()
+    {
+        std::unique_lock<std::mutex> lock{ m_Lock };
+        m_CondVar.wait(lock, [this] { return m_Signaled; });
+        m_Signaled = false;
+    }
+
+    void Signal()
+    {
+        {
+            std::lock_guard<std::mutex> lock{ m_Lock };
+            m_Signaled = true;
+        }
+        m_CondVar.notify_one();
+    }
+
+private:
+    std::mutex m_Lock;
+    std::condition_variable m_CondVar;
+    bool m_Signaled = false;
+};
+
+struct AutoResetEvent : EventLockable
+{
+    AutoResetEvent() : EventLockable{ false } {}
+};
+
+// Returns the round trip times in micro-seconds, sorted
+template <typename EventType>
+static std::vector<double> MeasureRoundTrips(uint32_t nbRoundTrips, std::chrono::microseconds pauseBetweenTrips)
+{
+    EventType ping;
+    EventType pong;
+
+    std::thread ponger{ [&]
+        {
+            for (uint32_t i = 0; i < nbRoundTrips; ++i)
+            {
+                ping.Wait();
+                pong.Signal();
+            }
+        } };
+
+    std::vector<double> roundTripsUs;
+    roundTripsUs.reserve(nbRoundTrips);
+
+    for (uint32_t i = 0; i < nbRoundTrips; ++i)
+    {
+        if (pauseBetweenTrips.count() > 0)
+            std::this_thread::sleep_for(pauseBetweenTrips);
+
+        roundTripsUs.push_back(TestUtils::MeasureSeconds([&]
+            {
+                ping.Signal();
+                pong.Wait();
+            }) * 1e6);
+    }
+    ponger.join();
+
+    std::sort(roundTripsUs.begin(), roundTripsUs.end());
+    return roundTripsUs;
+}
+
+template <typename EventType>
+static void PrintRoundTrips(const char* name, uint32_t nbRoundTrips, std::chrono::microseconds pauseBetweenTrips)
+{
+    const std::vector<double> roundTripsUs = MeasureRoundTrips<EventType>(nbRoundTrips, pauseBetweenTrips);
+
+    auto Percentile = [&](double p) { return roundTripsUs[std::min((size_t)(p * roundTripsUs.size()), roundTripsUs.size() - 1)]; };
+    printf("%-28s %-10s %10.2f %10.2f %10.2f\n", name, pauseBetweenTrips.count() > 0 ? "parked" : "spinning", Percentile(0.5), Percentile(0.9), Percentile(0.99));
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestUtils::ParseQuickArg(argc, argv);
+    const uint32_t nbBackToBack = quick ? 1000 : 200000;
+    const uint32_t nbParked = quick ? 50 : 5000;
+
+    // longer than the spin phase, so the ponger is parked in the kernel when pinged
+    const std::chrono::microseconds parkPause{ 200 };
+
+    TestUtils::PrintBenchmarkHeader("Event ping-pong round trip (us)");
+    printf("%-28s %-10s %10s %10s %10s\n", "event", "waiter", "median", "p90", "p99");
+
+    PrintRoundTrips<AutoResetEvent>("EventLockable", nbBackToBack, std::chrono::microseconds{ 0 });
+    PrintRoundTrips<CondVarEvent>("mutex + condition_variable", nbBackToBack, std::chrono::microseconds{ 0 });
+    PrintRoundTrips<AutoResetEvent>("EventLockable", nbParked, parkPause);
+    PrintRoundTrips<CondVarEvent>("mutex + condition_variable", nbParked, parkPause);
+
+    return 0;
+}
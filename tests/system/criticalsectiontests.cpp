@@ -0,0 +1,188 @@
+// EventLockable, Semaphore, Latch & Barrier under contention. Short hold times & yields, so both the spin & the park paths get exercised
+
+static const uint32_t NbThreads = 8;
+
+static void TestEventPingPong()
+{
+    // auto reset events: each side only wakes the other once, missed or doubled signals hang or break the count
+    static const uint32_t NbRoundTrips = 20000;
+
+    EventLockable ping{ false };
+    EventLockable pong{ false };
+    uint32_t nbPongs = 0;
+
+    std::thread ponger{ [&]
+        {
+            for (uint32_t i = 0; i < NbRoundTrips; ++i)
+            {
+                ping.Wait();
+                ++nbPongs;
+                pong.Signal();
+            }
+        } };
+
+    for (uint32_t i = 0; i < NbRoundTrips; ++i)
+    {
+        ping.Signal();
+        pong.Wait();
+
+        // sleep from time to time, so the other side parks instead of spinning
+        if ((i & 1023) == 0)
+            std::this_thread::sleep_for(std::chrono::microseconds{ 100 });
+    }
+    ponger.join();
+
+    bbeTestCheck(nbPongs == NbRoundTrips);
+    bbeTestCheck(!ping.Try_lock());
+    bbeTestCheck(!pong.Try_lock());
+}
+
+static void TestManualResetEventWakesAll()
+{
+    EventLockable event;
+    std::atomic<uint32_t> nbWoken = 0;
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < NbThreads; ++i)
+    {
+        threads.emplace_back([&]
+            {
+                event.Wait();
+                ++nbWoken;
+            });
+    }
+
+    // long enough for the waiters to park
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 20 });
+    bbeTestCheck(nbWoken == 0);
+
+    event.Signal();
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    bbeTestCheck(nbWoken == NbThreads);
+
+    // stays signaled until reset
+    bbeTestCheck(event.Try_lock());
+    event.Reset();
+    bbeTestCheck(!event.Try_lock());
+}
+
+static void TestSemaphoreBoundsConcurrency()
+{
+    static const uint32_t NbSlots = 3;
+    static const uint32_t NbIterations = 2000;
+
+    Semaphore semaphore{ NbSlots };
+    std::atomic<uint32_t> nbInside = 0;
+    std::atomic<uint32_t> maxInside = 0;
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < NbThreads; ++t)
+    {
+        threads.emplace_back([&]
+            {
+                for (uint32_t i = 0; i < NbIterations; ++i)
+                {
+                    semaphore.Acquire();
+
+                    const uint32_t inside = ++nbInside;
+                    uint32_t prevMax = maxInside;
+                    while (inside > prevMax && !maxInside.compare_exchange_weak(prevMax, inside)) {}
+                    if ((i & 63) == 0)
+                        std::this_thread::yield();
+                    --nbInside;
+
+                    semaphore.Release();
+                }
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    bbeTestCheck(maxInside <= NbSlots);
+
+    // every slot was given back
+    for (uint32_t i = 0; i < NbSlots; ++i)
+    {
+        bbeTestCheck(semaphore.TryAcquire());
+    }
+    bbeTestCheck(!semaphore.TryAcquire());
+}
+
+static void TestLatch()
+{
+    Latch latch{ NbThreads };
+    std::atomic<uint32_t> nbArrived = 0;
+    std::atomic<bool> allArrivedBeforeRelease = true;
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < NbThreads; ++i)
+    {
+        threads.emplace_back([&, i]
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds{ i });
+                ++nbArrived;
+                latch.ArriveAndWait();
+
+                if (nbArrived != NbThreads)
+                    allArrivedBeforeRelease = false;
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    bbeTestCheck(allArrivedBeforeRelease);
+    bbeTestCheck(latch.TryWait());
+}
+
+static void TestBarrierPhases()
+{
+    // nobody can start a phase before everyone finished the previous one
+    static const uint32_t NbPhases = 2000;
+
+    Barrier barrier{ NbThreads };
+    std::vector<std::atomic<uint32_t>> nbArrivedPerPhase(NbPhases);
+    std::atomic<bool> phaseOverlap = false;
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < NbThreads; ++t)
+    {
+        threads.emplace_back([&, t]
+            {
+                for (uint32_t phase = 0; phase < NbPhases; ++phase)
+                {
+                    if (phase > 0 && nbArrivedPerPhase[phase - 1] != NbThreads)
+                        phaseOverlap = true;
+
+                    ++nbArrivedPerPhase[phase];
+                    if (((phase + t) & 127) == 0)
+                        std::this_thread::yield();
+
+                    barrier.ArriveAndWait();
+                }
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    bbeTestCheck(!phaseOverlap);
+}
+
+int main()
+{
+    return TestUtils::RunTests({
+        { "EventPingPong", TestEventPingPong },
+        { "ManualResetEventWakesAll", TestManualResetEventWakesAll },
+        { "SemaphoreBoundsConcurrency", TestSemaphoreBoundsConcurrency },
+        { "Latch", TestLatch },
+        { "BarrierPhases", TestBarrierPhases },
+    });
+}
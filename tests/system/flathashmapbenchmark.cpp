@@ -0,0 +1,100 @@
+// Insert, lookup & iterate: FlatHashMap vs boost flat_map (FlatMap) & std::unordered_map, at the sizes of the engine's maps (a shader's permutations, the resource cache, the scene's visuals)
+
+struct Timings
+{
+    double m_InsertNs = 0.0;
+    double m_HitNs = 0.0;
+    double m_MissNs = 0.0;
+    double m_IterateNs = 0.0;
+};
+
+template <typename MapType>
+static Timings Measure(const std::vector<uint64_t>& keys, const std::vector<uint64_t>& shuffledKeys, const std::vector<uint64_t>& missingKeys, uint32_t nbRepeats)
+{
+    Timings timings;
+    uint64_t sink = 0;
+
+    for (uint32_t repeat = 0; repeat < nbRepeats; ++repeat)
+    {
+        MapType map;
+        timings.m_InsertNs += TestUtils::MeasureSeconds([&]
+            {
+                for (uint64_t key : keys)
+                {
+                    map.emplace(key, key);
+                }
+            });
+
+        timings.m_HitNs += TestUtils::MeasureSeconds([&]
+            {
+                // lookups don't follow the insertion order
+                for (uint64_t key : shuffledKeys)
+                {
+                    sink += map.find(key)->second;
+                }
+            });
+
+        timings.m_MissNs += TestUtils::MeasureSeconds([&]
+            {
+                for (uint64_t key : missingKeys)
+                {
+                    sink += map.find(key) == map.end();
+                }
+            });
+
+        timings.m_IterateNs += TestUtils::MeasureSeconds([&]
+            {
+                for (const auto& pair : map)
+                {
+                    sink += pair.second;
+                }
+            });
+    }
+    TestUtils::DoNotOptimize(sink);
+
+    const double toNsPerElement = 1e9 / ((double)nbRepeats * keys.size());
+    timings.m_InsertNs *= toNsPerElement;
+    timings.m_HitNs *= toNsPerElement;
+    timings.m_MissNs *= toNsPerElement;
+    timings.m_IterateNs *= toNsPerElement;
+    return timings;
+}
+
+static void PrintTimings(const char* name, std::size_t size, const Timings& timings)
+{
+    printf("%-20s %-8zu %10.2f %10.2f %10.2f %10.2f\n", name, size, timings.m_InsertNs, timings.m_HitNs, timings.m_MissNs, timings.m_IterateNs);
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestUtils::ParseQuickArg(argc, argv);
+    const uint64_t nbElementsTotal = quick ? (1ULL << 16) : (1ULL << 24);
+
+    TestUtils::PrintBenchmarkHeader("Hash maps, uint64_t -> uint64_t (ns per element)");
+    printf("%-20s %-8s %10s %10s %10s %10s\n", "map", "size", "insert", "hit", "miss", "iterate");
+
+    RandomGenerator random{ 0 };
+    for (std::size_t size : { 16, 256, 4096, 65536 })
+    {
+        // boost flat_map inserts are O(n): cap the largest size in quick mode
+        if (quick && size > 4096)
+            break;
+
+        std::vector<uint64_t> keys(size);
+        std::vector<uint64_t> missingKeys(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            keys[i] = random.Next() | 1;
+            missingKeys[i] = random.Next() & ~1ULL;
+        }
+        std::vector<uint64_t> shuffledKeys = keys;
+        std::shuffle(shuffledKeys.begin(), shuffledKeys.end(), random);
+
+        const uint32_t nbRepeats = (uint32_t)std::max<uint64_t>(nbElementsTotal / size, 1);
+        PrintTimings("FlatHashMap", size, Measure<FlatHashMap<uint64_t, uint64_t>>(keys, shuffledKeys, missingKeys, nbRepeats));
+        PrintTimings("FlatMap (boost)", size, Measure<FlatMap<uint64_t, uint64_t>>(keys, shuffledKeys, missingKeys, std::max(nbRepeats / 16, 1U)));
+        PrintTimings("std::unordered_map", size, Measure<std::unordered_map<uint64_t, uint64_t>>(keys, shuffledKeys, missingKeys, nbRepeats));
+    }
+
+    return 0;
+}
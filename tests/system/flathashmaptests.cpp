@@ -0,0 +1,168 @@
+// FlatHashMap/FlatHashSet against std::unordered_map: random inserts, erases & lookups, through growth and tombstone clean-ups
+
+// Every key lands in the same few groups: long probe sequences, and lots of matching control bytes that aren't the key
+struct CollidingHash
+{
+    std::size_t operator()(uint32_t key) const { return key & 3; }
+};
+
+// Counts live instances, to catch leaks & double destructions through rehashes
+struct TrackedValue
+{
+    static inline int64_t ms_NbAlive = 0;
+
+    uint32_t m_Value = 0;
+
+    TrackedValue() { ++ms_NbAlive; }
+    TrackedValue(uint32_t value) : m_Value(value) { ++ms_NbAlive; }
+    TrackedValue(const TrackedValue& rhs) : m_Value(rhs.m_Value) { ++ms_NbAlive; }
+    TrackedValue(TrackedValue&& rhs) noexcept : m_Value(rhs.m_Value) { ++ms_NbAlive; }
+    TrackedValue& operator=(const TrackedValue& rhs) = default;
+    ~TrackedValue() { --ms_NbAlive; }
+};
+
+template <typename MapType>
+static void RunAgainstReference(uint32_t nbOperations, uint32_t keyRange, uint64_t seed)
+{
+    MapType map;
+    std::unordered_map<uint32_t, uint32_t> reference;
+    RandomGenerator random{ seed };
+
+    uint32_t nbMismatches = 0;
+    for (uint32_t i = 0; i < nbOperations; ++i)
+    {
+        const uint32_t key = random.NextUInt(keyRange);
+        switch (random.NextUInt(4))
+        {
+        case 0:
+        case 1:
+        {
+            const bool inserted = map.try_emplace(key, i).second;
+            nbMismatches += inserted != reference.try_emplace(key, i).second;
+            break;
+        }
+        case 2:
+            nbMismatches += map.erase(key) != reference.erase(key);
+            break;
+        case 3:
+        {
+            auto it = map.find(key);
+            auto refIt = reference.find(key);
+            nbMismatches += (it == map.end()) != (refIt == reference.end());
+            if (it != map.end() && refIt != reference.end())
+                nbMismatches += it->second.m_Value != refIt->second;
+            break;
+        }
+        }
+    }
+    bbeTestCheck(nbMismatches == 0);
+    bbeTestCheck(map.size() == reference.size());
+
+    // iteration visits every element once
+    std::size_t nbIterated = 0;
+    for (const auto& pair : map)
+    {
+        auto refIt = reference.find(pair.first);
+        bbeTestCheck(refIt != reference.end() && refIt->second == pair.second.m_Value);
+        ++nbIterated;
+    }
+    bbeTestCheck(nbIterated == reference.size());
+}
+
+static void TestAgainstUnorderedMap()
+{
+    // dense key range: lots of erases & re-inserts, so tombstones pile up
+    RunAgainstReference<FlatHashMap<uint32_t, TrackedValue>>(200000, 1000, 1);
+    RunAgainstReference<FlatHashMap<uint32_t, TrackedValue>>(200000, 100000, 2);
+    RunAgainstReference<FlatHashMap<uint32_t, TrackedValue, CollidingHash>>(20000, 500, 3);
+
+    bbeTestCheck(TrackedValue::ms_NbAlive == 0);
+}
+
+static void TestTombstonesDontGrowTable()
+{
+    // insert/erase churn at a constant size must clean up its tombstones in place, not keep growing the table.
+    // 100 live elements in 128 slots is close to the max load: allow for one growth
+    FlatHashMap<uint32_t, uint32_t> map;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        map[i] = i;
+    }
+    const std::size_t capacity = map.capacity() * 2;
+
+    for (uint32_t i = 100; i < 100000; ++i)
+    {
+        map.erase(i - 100);
+        map[i] = i;
+    }
+    bbeTestCheck(map.size() == 100);
+    bbeTestCheck(map.capacity() <= capacity);
+
+    for (uint32_t i = 100000 - 100; i < 100000; ++i)
+    {
+        bbeTestCheck(map.contains(i));
+    }
+}
+
+static void TestCopyMoveClear()
+{
+    {
+        FlatHashMap<std::string, TrackedValue> map;
+        for (uint32_t i = 0; i < 1000; ++i)
+        {
+            map.try_emplace(std::to_string(i), i);
+        }
+
+        FlatHashMap<std::string, TrackedValue> copy{ map };
+        bbeTestCheck(copy.size() == 1000 && copy.at("123").m_Value == 123);
+
+        FlatHashMap<std::string, TrackedValue> moved{ std::move(map) };
+        bbeTestCheck(moved.size() == 1000 && map.empty());
+        bbeTestCheck(moved.find("999") != moved.end());
+
+        copy = moved;
+        copy.clear();
+        bbeTestCheck(copy.empty() && copy.find("0") == copy.end());
+
+        // cleared tables are reusable
+        copy.try_emplace("a", 1);
+        bbeTestCheck(copy.size() == 1 && copy.at("a").m_Value == 1);
+    }
+    bbeTestCheck(TrackedValue::ms_NbAlive == 0);
+}
+
+static void TestSet()
+{
+    FlatHashSet<uint64_t> set;
+    std::unordered_set<uint64_t> reference;
+    RandomGenerator random{ 4 };
+
+    for (uint32_t i = 0; i < 50000; ++i)
+    {
+        const uint64_t key = random.Next() & 0xFFFF;
+        if (random.NextUInt(3) == 0)
+        {
+            bbeTestCheck(set.erase(key) == reference.erase(key));
+        }
+        else
+        {
+            bbeTestCheck(set.insert(key).second == reference.insert(key).second);
+        }
+    }
+
+    bbeTestCheck(set.size() == reference.size());
+    for (uint64_t key : reference)
+    {
+        bbeTestCheck(set.contains(key));
+    }
+}
+
+int main()
+{
+    return TestUtils::RunTests({
+        { "AgainstUnorderedMap", TestAgainstUnorderedMap },
+        { "TombstonesDontGrowTable", TestTombstonesDontGrowTable },
+        { "CopyMoveClear", TestCopyMoveClear },
+        { "Set", TestSet },
+    });
+}
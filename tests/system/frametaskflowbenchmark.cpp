@@ -0,0 +1,75 @@
+// Cost of rebuilding the frame taskflow every frame vs building it once and re-running it, with null workloads.
+// Same shape as System::BuildFrameTaskflow: 1 gate task, then N tasks depending on it. Optionally, each task spawns a subflow
+
+static void BuildFrameGraph(tf::Taskflow& taskflow, uint32_t nbTasks, uint32_t nbSubTasks)
+{
+    taskflow.clear();
+
+    tf::Task gate = taskflow.emplace([] {});
+    for (uint32_t i = 0; i < nbTasks; ++i)
+    {
+        if (nbSubTasks == 0)
+        {
+            taskflow.emplace([] {}).succeed(gate);
+        }
+        else
+        {
+            taskflow.emplace([nbSubTasks](tf::Subflow& sf)
+                {
+                    for (uint32_t j = 0; j < nbSubTasks; ++j)
+                    {
+                        sf.emplace([] {});
+                    }
+                }).succeed(gate);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestUtils::ParseQuickArg(argc, argv);
+    const uint32_t nbTasksTotal = quick ? 20000 : 2000000;
+
+    TestUtils::PrintBenchmarkHeader("Frame taskflow: rebuild every run vs build once & re-run (null tasks)");
+    printf("%-8s %-10s %18s %18s %18s\n", "tasks", "subtasks", "build only", "build + run", "re-run only");
+
+    for (uint32_t nbSubTasks : { 0U, 4U })
+    {
+        for (uint32_t nbTasks : { 4U, 32U, 256U, 2048U })
+        {
+            const uint32_t nbRuns = std::max(nbTasksTotal / (nbTasks * (nbSubTasks + 1)), 10U);
+
+            tf::Taskflow taskflow;
+            const double buildSeconds = TestUtils::MeasureSeconds([&]
+                {
+                    for (uint32_t run = 0; run < nbRuns; ++run)
+                    {
+                        BuildFrameGraph(taskflow, nbTasks, nbSubTasks);
+                    }
+                });
+
+            const double buildAndRunSeconds = TestUtils::MeasureSeconds([&]
+                {
+                    for (uint32_t run = 0; run < nbRuns; ++run)
+                    {
+                        BuildFrameGraph(taskflow, nbTasks, nbSubTasks);
+                        g_TasksExecutor.run(taskflow).wait();
+                    }
+                });
+
+            BuildFrameGraph(taskflow, nbTasks, nbSubTasks);
+            const double rerunSeconds = TestUtils::MeasureSeconds([&]
+                {
+                    for (uint32_t run = 0; run < nbRuns; ++run)
+                    {
+                        g_TasksExecutor.run(taskflow).wait();
+                    }
+                });
+
+            auto ToUs = [nbRuns](double seconds) { return seconds * 1e6 / nbRuns; };
+            printf("%-8u %-10u %13.2f us/f %13.2f us/f %13.2f us/f\n", nbTasks, nbSubTasks, ToUs(buildSeconds), ToUs(buildAndRunSeconds), ToUs(rerunSeconds));
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,52 @@
+// Hashing throughput from small keys to multi-megabyte buffers (shader bytecode, file contents):
+// HashUtils' XXH3 & CRC32C vs the bytewise boost::hash_range they replaced
+
+static const uint32_t gs_Sizes[] = { 16, 64, 256, 4 * 1024, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024 };
+
+template <typename HashFunc>
+static double MeasureGBPerSecond(const std::vector<uint8_t>& data, uint32_t size, uint64_t nbBytesTotal, HashFunc&& hashFunc)
+{
+    const uint64_t nbIterations = std::max<uint64_t>(nbBytesTotal / size, 1);
+
+    uint64_t sink = 0;
+    const double seconds = TestUtils::MeasureSeconds([&]
+        {
+            for (uint64_t i = 0; i < nbIterations; ++i)
+            {
+                // vary the start, so the compiler can't hoist the hash out of the loop
+                sink += hashFunc(data.data() + (i & 15), size);
+            }
+        });
+    TestUtils::DoNotOptimize(sink);
+
+    return (double)nbIterations * size / seconds / 1e9;
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestUtils::ParseQuickArg(argc, argv);
+    const uint64_t nbBytesTotal = quick ? (16ULL << 20) : (2ULL << 30);
+
+    std::vector<uint8_t> data(gs_Sizes[std::size(gs_Sizes) - 1] + 16);
+    RandomGenerator rng{ 42 };
+    for (uint8_t& byte : data)
+    {
+        byte = (uint8_t)rng.Next();
+    }
+
+    TestUtils::PrintBenchmarkHeader("Hashing throughput (GB/s)");
+    printf("%-10s %14s %14s %14s %14s\n", "bytes", "hash_range", "XXH3_64", "XXH3_128", "CRC32C");
+
+    for (uint32_t size : gs_Sizes)
+    {
+        // boost is ~1 byte/cycle: don't let it take the whole run
+        const double boostGBs = MeasureGBPerSecond(data, size, nbBytesTotal / 8, [](const uint8_t* bytes, uint32_t n) { return (uint64_t)boost::hash_range(bytes, bytes + n); });
+        const double xxh64GBs = MeasureGBPerSecond(data, size, nbBytesTotal, [](const uint8_t* bytes, uint32_t n) { return HashUtils::XXH3_64(bytes, n); });
+        const double xxh128GBs = MeasureGBPerSecond(data, size, nbBytesTotal, [](const uint8_t* bytes, uint32_t n) { return HashUtils::XXH3_128(bytes, n).m_Low; });
+        const double crcGBs = MeasureGBPerSecond(data, size, nbBytesTotal, [](const uint8_t* bytes, uint32_t n) { return (uint64_t)HashUtils::CRC32C(bytes, n); });
+
+        printf("%-10u %14.2f %14.2f %14.2f %14.2f\n", size, boostGBs, xxh64GBs, xxh128GBs, crcGBs);
+    }
+
+    return 0;
+}
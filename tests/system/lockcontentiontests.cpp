@@ -0,0 +1,158 @@
+// Stress test of the lock contention stats, with locks named & used like the engine's hot ones:
+// m_CommandsLock (mutex protected command list), m_ListsLock (command lists, locked both as a member & through 'queue.'), m_FreePagesLock (descriptor allocator)
+
+static const uint32_t NbThreads = 8;
+static const uint32_t NbIterations = 2000;
+
+struct FakeCommandListQueue
+{
+    std::mutex m_ListsLock;
+    std::vector<uint32_t> m_FreeLists;
+
+    void ReleaseList(uint32_t list)
+    {
+        bbeAutoLock(m_ListsLock);
+        m_FreeLists.push_back(list);
+    }
+};
+
+static void LockCommandListQueue(FakeCommandListQueue& queue)
+{
+    bbeAutoLock(queue.m_ListsLock);
+    if (!queue.m_FreeLists.empty())
+        queue.m_FreeLists.pop_back();
+}
+
+struct FakeDescriptorAllocator
+{
+    std::mutex m_FreePagesLock;
+    uint32_t m_NbFreePages = 0;
+
+    void AllocatePage()
+    {
+        bbeAutoLock(m_FreePagesLock);
+
+        // hold it a little, so threads actually collide
+        for (uint32_t i = 0; i < 100; ++i)
+        {
+            TestUtils::DoNotOptimize(++m_NbFreePages);
+        }
+    }
+};
+
+static std::mutex m_CommandsLock;
+static std::vector<uint32_t> gs_Commands;
+
+static void AddCommand(uint32_t cmd)
+{
+    bbeAutoLock(m_CommandsLock);
+    gs_Commands.push_back(cmd);
+    if ((cmd & 7) == 0)
+        std::this_thread::yield();
+}
+
+static uint64_t GetNbHoldSamples(const LockContentionStats& stats)
+{
+    uint64_t nbSamples = 0;
+    for (const std::atomic<uint64_t>& bucket : stats.m_HoldTimeHistogram)
+    {
+        nbSamples += bucket;
+    }
+    return nbSamples;
+}
+
+static void RunStress(FakeCommandListQueue& queue, FakeDescriptorAllocator& allocator)
+{
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < NbThreads; ++t)
+    {
+        threads.emplace_back([&, t]
+            {
+                for (uint32_t i = 0; i < NbIterations; ++i)
+                {
+                    AddCommand(t * NbIterations + i);
+                    queue.ReleaseList(i);
+                    LockCommandListQueue(queue);
+                    allocator.AllocatePage();
+                }
+            });
+    }
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+}
+
+static void TestDisabledByDefault()
+{
+    bbeTestCheck(!LockContentionProfiler::IsEnabled());
+
+    FakeCommandListQueue queue;
+    FakeDescriptorAllocator allocator;
+    RunStress(queue, allocator);
+
+    bbeTestCheck(g_LockContentionProfiler.GetStats("m_CommandsLock").m_NbAcquisitions == 0);
+    bbeTestCheck(g_LockContentionProfiler.GetStats("m_ListsLock").m_NbAcquisitions == 0);
+    bbeTestCheck(g_LockContentionProfiler.GetStats("m_FreePagesLock").m_NbAcquisitions == 0);
+}
+
+static void TestStatsUnderContention()
+{
+    LockContentionProfiler::SetEnabled(true);
+    g_LockContentionProfiler.ResetAllStats();
+
+    FakeCommandListQueue queue;
+    FakeDescriptorAllocator allocator;
+    RunStress(queue, allocator);
+
+    LockContentionProfiler::SetEnabled(false);
+
+    const uint64_t nbLocksPerSite = NbThreads * NbIterations;
+
+    const LockContentionStats& commandsStats = g_LockContentionProfiler.GetStats("m_CommandsLock");
+    bbeTestCheck(commandsStats.m_NbAcquisitions == nbLocksPerSite);
+    bbeTestCheck(GetNbHoldSamples(commandsStats) == nbLocksPerSite);
+
+    // "queue.m_ListsLock" & "m_ListsLock" are the same entry: 2 call sites
+    const LockContentionStats& listsStats = g_LockContentionProfiler.GetStats("m_ListsLock");
+    bbeTestCheck(&listsStats == &g_LockContentionProfiler.GetStats("queue.m_ListsLock"));
+    bbeTestCheck(listsStats.m_NbAcquisitions == 2 * nbLocksPerSite);
+    bbeTestCheck(GetNbHoldSamples(listsStats) == 2 * nbLocksPerSite);
+
+    const LockContentionStats& pagesStats = g_LockContentionProfiler.GetStats("m_FreePagesLock");
+    bbeTestCheck(pagesStats.m_NbAcquisitions == nbLocksPerSite);
+    bbeTestCheck(GetNbHoldSamples(pagesStats) == nbLocksPerSite);
+
+    // yielding while holding m_CommandsLock guarantees collisions, even on a single core
+    for (const LockContentionStats* stats : { &commandsStats, &listsStats, &pagesStats })
+    {
+        bbeTestCheck(stats->m_NbContendedAcquisitions <= stats->m_NbAcquisitions);
+        bbeTestCheck(stats->m_MaxWaitNs <= stats->m_TotalWaitNs);
+        bbeTestCheck(stats->m_NbContendedAcquisitions == 0 || stats->m_TotalWaitNs > 0);
+    }
+    bbeTestCheck(commandsStats.m_NbContendedAcquisitions > 0);
+
+    // CSV has one line per lock
+    const std::string csvPath = TestUtils::GetTempFilePath("lockcontention.csv");
+    g_LockContentionProfiler.WriteCSV(csvPath.c_str());
+
+    uint32_t nbLockLines = 0;
+    std::ifstream csv{ csvPath };
+    for (std::string line; std::getline(csv, line);)
+    {
+        nbLockLines += line.rfind("m_CommandsLock,", 0) == 0 || line.rfind("m_ListsLock,", 0) == 0 || line.rfind("m_FreePagesLock,", 0) == 0;
+    }
+    csv.close();
+    std::filesystem::remove(csvPath);
+    bbeTestCheck(nbLockLines == 3);
+}
+
+int main()
+{
+    g_Log.Initialize(TestUtils::GetTempFilePath("lockcontentiontests.txt").c_str(), false);
+
+    return TestUtils::RunTests({
+        { "DisabledByDefault", TestDisabledByDefault },
+        { "StatsUnderContention", TestStatsUnderContention },
+    });
+}
@@ -0,0 +1,106 @@
+static const uint32_t NbThreads = 4;
+static const uint32_t NbRecordsPerThread = 2000;
+
+static std::vector<std::string> ReadLines(const std::string& path)
+{
+    std::vector<std::string> lines;
+    std::ifstream file{ path };
+    for (std::string line; std::getline(file, line);)
+    {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+static void TestAsyncRecordsWrittenInOrder()
+{
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < NbThreads; ++t)
+    {
+        threads.emplace_back([t]
+            {
+                for (uint32_t i = 0; i < NbRecordsPerThread; ++i)
+                {
+                    // strings are captured by copy: the buffer dies right after the call
+                    const std::string tag = StringFormat("thread%u", t);
+                    g_Log.info("{} {}", tag.c_str(), i);
+                }
+            });
+    }
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+    g_Log.Flush();
+
+    std::vector<uint32_t> nextIdx(NbThreads, 0);
+    uint32_t nbOutOfOrder = 0;
+    for (const std::string& line : ReadLines(TestUtils::GetTempFilePath("logger.txt")))
+    {
+        uint32_t threadIdx = 0, recordIdx = 0;
+        const size_t tagPos = line.find("thread");
+        if (tagPos == std::string::npos || sscanf(line.c_str() + tagPos, "thread%u %u", &threadIdx, &recordIdx) != 2 || threadIdx >= NbThreads)
+            continue;
+
+        nbOutOfOrder += (recordIdx != nextIdx[threadIdx]);
+        nextIdx[threadIdx] = recordIdx + 1;
+    }
+
+    bbeTestCheck(nbOutOfOrder == 0);
+    for (uint32_t t = 0; t < NbThreads; ++t)
+    {
+        bbeTestCheck(nextIdx[t] == NbRecordsPerThread);
+    }
+    bbeTestCheck(g_Log.GetNbDroppedRecords() == 0);
+}
+
+static void TestExitedThreadsRingsFreed()
+{
+    // rings of the threads of the previous test are drained by now
+    g_Log.Flush();
+    bbeTestCheck(g_Log.GetNbThreadLogRings() == 0);
+
+    std::thread{ [] { g_Log.info("from a short-lived thread"); } }.join();
+
+    // first drain writes its record, then sees the ring unreferenced & empty
+    g_Log.Flush();
+    g_Log.Flush();
+    bbeTestCheck(g_Log.GetNbThreadLogRings() == 0);
+
+    // this thread's ring stays alive
+    g_Log.info("from the main thread");
+    g_Log.Flush();
+    bbeTestCheck(g_Log.GetNbThreadLogRings() == 1);
+}
+
+static void TestShutDown()
+{
+    g_Log.info("before shutdown");
+    g_Log.ShutDown();
+    bbeTestCheck(g_Log.GetNbThreadLogRings() == 0);
+
+    // synchronous from now on
+    g_Log.info("after shutdown");
+
+    const std::vector<std::string> lines = ReadLines(TestUtils::GetTempFilePath("logger.txt"));
+    bbeTestCheck(lines.size() >= 2);
+    if (lines.size() >= 2)
+    {
+        bbeTestCheck(lines[lines.size() - 2].find("before shutdown") != std::string::npos);
+        bbeTestCheck(lines.back().find("after shutdown") != std::string::npos);
+    }
+}
+
+int main()
+{
+    g_Log.Initialize(TestUtils::GetTempFilePath("logger.txt").c_str());
+
+    const int result = TestUtils::RunTests({
+        { "AsyncRecordsWrittenInOrder", TestAsyncRecordsWrittenInOrder },
+        { "ExitedThreadsRingsFreed", TestExitedThreadsRingsFreed },
+        { "ShutDown", TestShutDown },
+    });
+
+    std::filesystem::remove(TestUtils::GetTempFilePath("logger.txt"));
+    return result;
+}
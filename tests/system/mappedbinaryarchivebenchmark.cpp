@@ -0,0 +1,112 @@
+#include <system/mappedbinaryarchive.h>
+
+#include <extern/cereal/archives/binary.hpp>
+
+// Saving & loading 100k elements: the mapped archive vs cereal's stream based binary archive.
+// Memcpy-able arrays are one copy each way with the mapped archive. Strings go element by element with both
+
+struct BenchmarkParticle
+{
+    bbeVector3 m_Position;
+    bbeVector3 m_Velocity;
+    float m_Age;
+    uint32_t m_Color;
+
+    bool operator==(const BenchmarkParticle& rhs) const { return memcmp(this, &rhs, sizeof(*this)) == 0; }
+
+    // stream archive only: one binary blob per element. The mapped archive copies the whole array at once
+    template <typename Archive>
+    void Serialize(Archive& ar) { ar(cereal::binary_data(this, sizeof(*this))); }
+};
+DeclareMemcpySerializable(BenchmarkParticle);
+
+template <typename T>
+static void RunCase(const char* name, const std::vector<T>& data, uint32_t nbRuns)
+{
+    const std::string mappedPath = TestUtils::GetTempFilePath("archive_benchmark_mapped.bin");
+    const std::string streamPath = TestUtils::GetTempFilePath("archive_benchmark_stream.bin");
+
+    const double mappedSaveSeconds = TestUtils::MeasureSeconds([&]
+        {
+            for (uint32_t run = 0; run < nbRuns; ++run)
+            {
+                MappedBinaryOutputArchive archive{ mappedPath.c_str() };
+                archive(data);
+            }
+        });
+
+    std::vector<T> loaded;
+    const double mappedLoadSeconds = TestUtils::MeasureSeconds([&]
+        {
+            for (uint32_t run = 0; run < nbRuns; ++run)
+            {
+                loaded.clear();
+                MappedBinaryInputArchive archive{ mappedPath.c_str() };
+                archive(loaded);
+            }
+        });
+    bbeTestCheck(loaded == data);
+
+    const double streamSaveSeconds = TestUtils::MeasureSeconds([&]
+        {
+            for (uint32_t run = 0; run < nbRuns; ++run)
+            {
+                std::ofstream stream{ streamPath, std::ios::binary | std::ios::trunc };
+                cereal::BinaryOutputArchive archive{ stream };
+                archive(data);
+            }
+        });
+
+    const double streamLoadSeconds = TestUtils::MeasureSeconds([&]
+        {
+            for (uint32_t run = 0; run < nbRuns; ++run)
+            {
+                loaded.clear();
+                std::ifstream stream{ streamPath, std::ios::binary };
+                cereal::BinaryInputArchive archive{ stream };
+                archive(loaded);
+            }
+        });
+    bbeTestCheck(loaded == data);
+
+    auto ToMs = [nbRuns](double seconds) { return seconds * 1e3 / nbRuns; };
+    printf("%-24s %12.3f ms %12.3f ms %12.3f ms %12.3f ms\n", name, ToMs(mappedSaveSeconds), ToMs(mappedLoadSeconds), ToMs(streamSaveSeconds), ToMs(streamLoadSeconds));
+
+    std::filesystem::remove(mappedPath);
+    std::filesystem::remove(streamPath);
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestUtils::ParseQuickArg(argc, argv);
+    const uint32_t nbRuns = quick ? 3 : 100;
+    static const uint32_t NbElements = 100'000;
+
+    g_Log.Initialize(TestUtils::GetTempFilePath("mappedbinaryarchivebenchmark.txt").c_str(), false);
+
+    RandomGenerator rng{ 42 };
+
+    std::vector<float> floats(NbElements);
+    rng.FillFloats(floats.data(), floats.size());
+
+    std::vector<BenchmarkParticle> particles(NbElements);
+    for (BenchmarkParticle& particle : particles)
+    {
+        particle = BenchmarkParticle{ { rng.NextFloat(), rng.NextFloat(), rng.NextFloat() }, {}, rng.NextFloat(), (uint32_t)rng.Next() };
+    }
+
+    std::vector<std::string> strings(NbElements);
+    for (std::string& str : strings)
+    {
+        str = StringFormat("object_%llu", rng.Next());
+    }
+
+    TestUtils::PrintBenchmarkHeader("Save/load 100k elements: mapped binary archive vs cereal binary stream archive");
+    printf("%-24s %15s %15s %15s %15s\n", "elements", "mapped save", "mapped load", "stream save", "stream load");
+
+    RunCase("100k floats", floats, nbRuns);
+    RunCase("100k 32 bytes structs", particles, nbRuns);
+    RunCase("100k strings", strings, nbRuns);
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include <system/mappedbinaryarchive.h>
+
+struct TestParticle
+{
+    bbeVector3 m_Position;
+    float m_Age;
+    uint32_t m_Color;
+};
+DeclareMemcpySerializable(TestParticle);
+
+// MemoryMappedFile header, then the archive header: the first array's element count comes right after
+static const uint64_t gs_FileHeaderSize = 16;
+static const uint64_t gs_FirstArrayCountOffset = gs_FileHeaderSize + sizeof(MappedBinaryArchiveHeader);
+
+static void PatchFile(const std::string& path, uint64_t offset, uint64_t value, uint32_t nbBytes)
+{
+    std::fstream file{ path, std::ios::binary | std::ios::in | std::ios::out };
+    file.seekp(offset);
+    file.write((const char*)&value, nbBytes);
+}
+
+static void WriteTestArchive(const std::string& path, const std::vector<float>& floats)
+{
+    MappedBinaryOutputArchive archive{ path.c_str() };
+    bbeTestCheck(archive.IsValid());
+    archive(floats);
+}
+
+static void TestRoundTrip()
+{
+    const std::string path = TestUtils::GetTempFilePath("archive_roundtrip.bin");
+
+    std::vector<float> floats(1000);
+    std::iota(floats.begin(), floats.end(), 0.5f);
+
+    std::vector<TestParticle> particles(333);
+    for (uint32_t i = 0; i < particles.size(); ++i)
+    {
+        particles[i] = TestParticle{ { (float)i, 2.0f * i, -1.0f }, 0.25f * i, i * 0x01010101U };
+    }
+    const std::vector<std::string> names = { "a", "", "some longer name, to not fit in the small string buffer" };
+    const int32_t scalar = -1234;
+    const uint8_t oddSizedScalar = 7;
+
+    {
+        MappedBinaryOutputArchive archive{ path.c_str() };
+        archive(oddSizedScalar, floats, names, particles, scalar);
+    }
+
+    MappedBinaryInputArchive archive{ path.c_str() };
+    bbeTestCheck(archive.IsValid());
+
+    uint8_t loadedOddSizedScalar = 0;
+    std::vector<float> loadedFloats;
+    std::vector<std::string> loadedNames;
+    MappedArrayView<TestParticle> particlesView;
+    int32_t loadedScalar = 0;
+    archive(loadedOddSizedScalar, loadedFloats, loadedNames, particlesView, loadedScalar);
+
+    bbeTestCheck(loadedOddSizedScalar == oddSizedScalar);
+    bbeTestCheck(loadedFloats == floats);
+    bbeTestCheck(loadedNames == names);
+    bbeTestCheck(loadedScalar == scalar);
+    bbeTestCheck(archive.GetNbRemainingBytes() == 0);
+
+    // viewed in place, aligned
+    bbeTestCheck(particlesView.m_Size == particles.size());
+    bbeTestCheck(((uintptr_t)particlesView.m_Data % MappedBinaryArchiveHeader::ArrayAlignment) == 0);
+    bbeTestCheck(memcmp(particlesView.m_Data, particles.data(), particles.size() * sizeof(TestParticle)) == 0);
+}
+
+static void TestMissingAndOutdatedFiles()
+{
+    MappedBinaryInputArchive missingArchive{ TestUtils::GetTempFilePath("archive_missing.bin").c_str() };
+    bbeTestCheck(!missingArchive.IsValid());
+
+    const std::string path = TestUtils::GetTempFilePath("archive_outdated.bin");
+
+    // older MemoryMappedFile layout
+    WriteTestArchive(path, { 1.0f, 2.0f });
+    PatchFile(path, 4, 1, sizeof(uint32_t));
+    {
+        MappedBinaryInputArchive archive{ path.c_str() };
+        bbeTestCheck(!archive.IsValid());
+    }
+
+    // older archive layout
+    WriteTestArchive(path, { 1.0f, 2.0f });
+    PatchFile(path, gs_FileHeaderSize + 4, MappedBinaryArchiveHeader::Version + 1, sizeof(uint32_t));
+    {
+        MappedBinaryInputArchive archive{ path.c_str() };
+        bbeTestCheck(!archive.IsValid());
+    }
+}
+
+static void TestCorruptedElementCount()
+{
+    const std::string path = TestUtils::GetTempFilePath("archive_corrupted.bin");
+
+    for (uint64_t corruptedCount : std::initializer_list<uint64_t>{ 3, 1ULL << 40, UINT64_MAX / 2 })
+    {
+        WriteTestArchive(path, { 1.0f, 2.0f });
+        PatchFile(path, gs_FirstArrayCountOffset, corruptedCount, sizeof(uint64_t));
+
+        // throws before allocating: no bad_alloc, no read past the mapping
+        MappedBinaryInputArchive archive{ path.c_str() };
+        bbeTestCheck(archive.IsValid());
+
+        bool threw = false;
+        try
+        {
+            std::vector<float> loadedFloats;
+            archive(loadedFloats);
+        }
+        catch (const cereal::Exception&)
+        {
+            threw = true;
+        }
+        bbeTestCheck(threw);
+    }
+}
+
+int main()
+{
+    g_Log.Initialize(TestUtils::GetTempFilePath("mappedbinaryarchivetests.txt").c_str(), false);
+
+    const int result = TestUtils::RunTests({
+        { "RoundTrip", TestRoundTrip },
+        { "MissingAndOutdatedFiles", TestMissingAndOutdatedFiles },
+        { "CorruptedElementCount", TestCorruptedElementCount },
+    });
+
+    for (const char* fileName : { "archive_roundtrip.bin", "archive_outdated.bin", "archive_corrupted.bin" })
+    {
+        std::filesystem::remove(TestUtils::GetTempFilePath(fileName));
+    }
+    return result;
+}
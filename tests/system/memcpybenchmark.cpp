@@ -0,0 +1,48 @@
+// Copy bandwidth of SIMDMemCopy vs memcpy, from cache resident copies to streaming ones, aligned & misaligned
+
+static double MeasureGBPerSecond(uint8_t* dest, const uint8_t* source, size_t size, uint64_t nbBytesTotal, void(*copyFunc)(void*, const void*, size_t))
+{
+    const uint64_t nbIterations = std::max<uint64_t>(nbBytesTotal / size, 2);
+
+    // warm up: page faults & first touch out of the measurement
+    copyFunc(dest, source, size);
+
+    const double seconds = TestUtils::MeasureSeconds([&]
+        {
+            for (uint64_t i = 0; i < nbIterations; ++i)
+            {
+                copyFunc(dest, source, size);
+                TestUtils::DoNotOptimize(dest[i % size]);
+            }
+        });
+
+    return (double)nbIterations * size / seconds / 1e9;
+}
+
+static void CRTMemCopy(void* dest, const void* source, size_t size) { memcpy(dest, source, size); }
+static void SIMDCopy(void* dest, const void* source, size_t size) { SIMDMemCopy(dest, source, size); }
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestUtils::ParseQuickArg(argc, argv);
+    const uint64_t nbBytesTotal = quick ? (64ULL << 20) : (8ULL << 30);
+    const size_t maxSize = quick ? (16ULL << 20) : (256ULL << 20);
+
+    std::vector<uint8_t> source(maxSize + 64, 1);
+    std::vector<uint8_t> dest(maxSize + 64, 0);
+
+    TestUtils::PrintBenchmarkHeader(StringFormat("Copy bandwidth (GB/s), SIMD routines: %s", GetSIMDMemInstructionSetName()));
+    printf("%-12s %14s %14s %16s %16s\n", "bytes", "memcpy", "SIMDMemCopy", "memcpy +7/+3", "SIMDMemCopy +7/+3");
+
+    for (size_t size = 64; size <= maxSize; size *= 4)
+    {
+        const double crtGBs = MeasureGBPerSecond(dest.data(), source.data(), size, nbBytesTotal, CRTMemCopy);
+        const double simdGBs = MeasureGBPerSecond(dest.data(), source.data(), size, nbBytesTotal, SIMDCopy);
+        const double crtMisalignedGBs = MeasureGBPerSecond(dest.data() + 7, source.data() + 3, size, nbBytesTotal, CRTMemCopy);
+        const double simdMisalignedGBs = MeasureGBPerSecond(dest.data() + 7, source.data() + 3, size, nbBytesTotal, SIMDCopy);
+
+        printf("%-12zu %14.2f %14.2f %16.2f %16.2f\n", size, crtGBs, simdGBs, crtMisalignedGBs, simdMisalignedGBs);
+    }
+
+    return 0;
+}
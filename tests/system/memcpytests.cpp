@@ -0,0 +1,139 @@
+// SIMDMemCopy & friends vs memcpy, on random sizes & alignments. Bytes around the destination must never be touched
+
+static const size_t gs_MaxAlignmentOffset = 64;
+static const size_t gs_GuardSize = 128;
+static const uint8_t gs_GuardValue = 0xCD;
+
+struct CopyBuffers
+{
+    std::vector<uint8_t> m_Source;
+    std::vector<uint8_t> m_Dest;
+    std::vector<uint8_t> m_Expected;
+
+    explicit CopyBuffers(size_t maxSize)
+    {
+        const size_t bufferSize = maxSize + gs_MaxAlignmentOffset + 2 * gs_GuardSize;
+        m_Source.resize(bufferSize);
+        m_Dest.resize(bufferSize);
+        m_Expected.resize(bufferSize);
+
+        RandomGenerator rng{ 1234 };
+        for (uint8_t& byte : m_Source)
+        {
+            byte = (uint8_t)rng.Next();
+        }
+    }
+
+    // returns the number of bytes that differ from what memcpy would have produced, guards included
+    template <typename CopyFunc>
+    size_t Check(size_t size, size_t sourceOffset, size_t destOffset, CopyFunc&& copyFunc)
+    {
+        std::fill(m_Dest.begin(), m_Dest.end(), gs_GuardValue);
+        std::fill(m_Expected.begin(), m_Expected.end(), gs_GuardValue);
+
+        uint8_t* dest = m_Dest.data() + gs_GuardSize + destOffset;
+        const uint8_t* source = m_Source.data() + sourceOffset;
+
+        memcpy(m_Expected.data() + gs_GuardSize + destOffset, source, size);
+        copyFunc(dest, source, size);
+
+        size_t nbDiffs = 0;
+        for (size_t i = 0; i < m_Dest.size(); ++i)
+        {
+            nbDiffs += m_Dest[i] != m_Expected[i];
+        }
+        return nbDiffs;
+    }
+};
+
+static size_t RandomSize(RandomGenerator& rng, size_t maxSize)
+{
+    // mostly around the dispatch thresholds & vector multiples, where tails are handled
+    switch (rng.NextUInt(4))
+    {
+    case 0:  return rng.NextUInt(600);
+    case 1:  return AlignUp<size_t>(rng.NextUInt(4096) + 32, 32) + rng.NextUInt(3) - 1;
+    case 2:  return rng.NextUInt(64 * 1024);
+    default: return rng.NextUInt((uint32_t)maxSize);
+    }
+}
+
+static void TestCopyRandomSizesAndAlignments()
+{
+    static const size_t MaxSize = 256 * 1024;
+    CopyBuffers buffers{ MaxSize };
+
+    RandomGenerator rng{ 42 };
+    size_t nbFailedCopies = 0;
+    size_t nbFailedWCCopies = 0;
+    for (uint32_t i = 0; i < 3000; ++i)
+    {
+        const size_t size = std::min(RandomSize(rng, MaxSize), MaxSize);
+        const size_t sourceOffset = rng.NextUInt(gs_MaxAlignmentOffset);
+        const size_t destOffset = rng.NextUInt(gs_MaxAlignmentOffset);
+
+        nbFailedCopies += buffers.Check(size, sourceOffset, destOffset, [](void* d, const void* s, size_t n) { SIMDMemCopy(d, s, n); }) != 0;
+        nbFailedWCCopies += buffers.Check(size, sourceOffset, destOffset, [](void* d, const void* s, size_t n) { SIMDMemCopyToWriteCombined(d, s, n); }) != 0;
+    }
+    bbeTestCheck(nbFailedCopies == 0);
+    bbeTestCheck(nbFailedWCCopies == 0);
+}
+
+static void TestNonTemporalCopies()
+{
+    // well past half of any last level cache: the streaming path
+    static const size_t MaxSize = 96ULL << 20;
+    CopyBuffers buffers{ MaxSize };
+
+    RandomGenerator rng{ 7 };
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        const size_t size = MaxSize - rng.NextUInt(4096);
+        const size_t sourceOffset = rng.NextUInt(gs_MaxAlignmentOffset);
+        const size_t destOffset = rng.NextUInt(gs_MaxAlignmentOffset);
+
+        bbeTestCheck(buffers.Check(size, sourceOffset, destOffset, [](void* d, const void* s, size_t n) { SIMDMemCopy(d, s, n); }) == 0);
+    }
+}
+
+static void TestFill()
+{
+    static const size_t MaxSize = 64 * 1024;
+    std::vector<uint8_t> buffer(MaxSize + gs_MaxAlignmentOffset + 2 * gs_GuardSize);
+
+    const bbeVector4 fillVector{ 1.0f, -2.0f, 3.5f, 1e-3f };
+    uint8_t pattern[16];
+    memcpy(pattern, &fillVector, sizeof(pattern));
+
+    RandomGenerator rng{ 99 };
+    size_t nbFailedFills = 0;
+    for (uint32_t i = 0; i < 2000; ++i)
+    {
+        const size_t size = std::min(RandomSize(rng, MaxSize), MaxSize);
+        const size_t destOffset = rng.NextUInt(gs_MaxAlignmentOffset);
+
+        std::fill(buffer.begin(), buffer.end(), gs_GuardValue);
+        SIMDMemFill(buffer.data() + gs_GuardSize + destOffset, fillVector, size);
+
+        bool valid = true;
+        for (size_t j = 0; j < buffer.size(); ++j)
+        {
+            const bool isFilled = j >= gs_GuardSize + destOffset && j < gs_GuardSize + destOffset + size;
+            const uint8_t expected = isFilled ? pattern[(j - gs_GuardSize - destOffset) % 16] : gs_GuardValue;
+            valid &= buffer[j] == expected;
+        }
+        nbFailedFills += !valid;
+    }
+    bbeTestCheck(nbFailedFills == 0);
+}
+
+int main()
+{
+    printf("SIMD mem routines: %s\n", GetSIMDMemInstructionSetName());
+
+    return TestUtils::RunTests({
+        { "CopyRandomSizesAndAlignments", TestCopyRandomSizesAndAlignments },
+        { "NonTemporalCopies", TestNonTemporalCopies },
+        { "Fill", TestFill },
+    });
+}
@@ -0,0 +1,59 @@
+#include <system/memorymappedfile.h>
+
+// Appending to a MemoryMappedFile in chunks of various sizes (geometric growth + remaps included), then reading it back sequentially.
+// On tmpfs, so this measures the mapping code & page faults, not the disk
+
+static void AppendAndRead(uint64_t totalSize, uint64_t chunkSize)
+{
+    const std::wstring path = StringUtils::Utf8ToWide(TestUtils::GetTempFilePath("mmf_benchmark.bin"));
+    const std::vector<uint8_t> chunk(chunkSize, 0xAB);
+
+    MemoryMappedFile file;
+    uint64_t size = 0;
+    const double writeSeconds = TestUtils::MeasureSeconds([&]
+        {
+            file.Init(path);
+            while (size < totalSize)
+            {
+                file.GrowMapping(size + chunkSize);
+                memcpy(static_cast<uint8_t*>(file.GetData()) + size, chunk.data(), chunkSize);
+                size += chunkSize;
+            }
+            file.SetSize(size);
+            file.Destroy(false);
+        });
+
+    uint64_t checksum = 0;
+    const double readSeconds = TestUtils::MeasureSeconds([&]
+        {
+            file.Init(path, 0, MemoryMappedFile::Mode::ReadOnly, MemoryMappedFile::AccessHint::Sequential);
+            const uint64_t* data = static_cast<const uint64_t*>(file.GetData());
+            for (uint64_t i = 0; i < file.GetSize() / sizeof(uint64_t); ++i)
+            {
+                checksum += data[i];
+            }
+            file.Destroy(true);
+        });
+    TestUtils::DoNotOptimize(checksum);
+
+    const double sizeMB = (double)size / (1024.0 * 1024.0);
+    printf("%-10llu %-12llu %12.1f MB/s %12.1f MB/s\n", (unsigned long long)(size >> 20), (unsigned long long)chunkSize, sizeMB / writeSeconds, sizeMB / readSeconds);
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestUtils::ParseQuickArg(argc, argv);
+
+    g_Log.Initialize(TestUtils::GetTempFilePath("memorymappedfilebenchmark.txt").c_str(), false);
+
+    TestUtils::PrintBenchmarkHeader("MemoryMappedFile: append in chunks, then sequential read");
+    printf("%-10s %-12s %17s %17s\n", "size (MB)", "chunk", "append", "read");
+
+    const uint64_t totalSize = quick ? (8ULL << 20) : (512ULL << 20);
+    for (uint64_t chunkSize : { 64ULL, 4096ULL, 1ULL << 20 })
+    {
+        AppendAndRead(totalSize, chunkSize);
+    }
+
+    return 0;
+}
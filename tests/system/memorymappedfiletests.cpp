@@ -0,0 +1,155 @@
+#include <system/memorymappedfile.h>
+
+#if !defined(_WIN32)
+    #include <signal.h>
+    #include <sys/resource.h>
+#endif
+
+// Files live on tmpfs (see TestUtils::GetTempFilePath), which is where the POSIX mmap/mremap paths are exercised
+
+static std::wstring GetTestFilePath(const char* fileName)
+{
+    return StringUtils::Utf8ToWide(TestUtils::GetTempFilePath(fileName));
+}
+
+static void FillPattern(MemoryMappedFile& file, uint64_t begin, uint64_t end)
+{
+    uint8_t* data = static_cast<uint8_t*>(file.GetData());
+    for (uint64_t i = begin; i < end; ++i)
+    {
+        data[i] = (uint8_t)(i * 31 + 7);
+    }
+}
+
+static bool CheckPattern(const MemoryMappedFile& file, uint64_t begin, uint64_t end)
+{
+    const uint8_t* data = static_cast<const uint8_t*>(file.GetData());
+    for (uint64_t i = begin; i < end; ++i)
+    {
+        if (data[i] != (uint8_t)(i * 31 + 7))
+            return false;
+    }
+    return true;
+}
+
+static void TestCreateGrowAndReopen()
+{
+    const std::wstring path = GetTestFilePath("mmf_grow.bin");
+
+    MemoryMappedFile file;
+    file.Init(path);
+    bbeTestCheck(file.IsMapped());
+    bbeTestCheck(file.GetSize() == 0);
+    bbeTestCheck(file.GetCurrentFileSize() % (64 * 1024) == 0);
+
+    // several growths, data written before each one must survive it
+    uint64_t size = 0;
+    for (uint64_t newSize : { 1000ULL, 100'000ULL, 100'001ULL, 3'000'000ULL })
+    {
+        bbeTestCheck(file.GrowMapping(newSize));
+        bbeTestCheck(file.GetDataCapacity() >= newSize);
+        bbeTestCheck(CheckPattern(file, 0, size));
+
+        FillPattern(file, size, newSize);
+        size = newSize;
+        file.SetSize(size);
+    }
+
+    // growth is geometric: a small increment doesn't re-create the mapping
+    const uint64_t capacity = file.GetDataCapacity();
+    bbeTestCheck(file.GrowMapping(size + 1));
+    bbeTestCheck(file.GetDataCapacity() == capacity);
+
+    file.Destroy(false);
+    bbeTestCheck(!file.IsMapped());
+    bbeTestCheck(std::filesystem::file_size(TestUtils::GetTempFilePath("mmf_grow.bin")) == capacity + 16);
+
+    MemoryMappedFile readOnlyFile;
+    readOnlyFile.Init(path, 0, MemoryMappedFile::Mode::ReadOnly, MemoryMappedFile::AccessHint::Sequential);
+    bbeTestCheck(readOnlyFile.IsMapped());
+    bbeTestCheck(readOnlyFile.GetSize() == size);
+    bbeTestCheck(CheckPattern(readOnlyFile, 0, size));
+    readOnlyFile.Prefetch(0, size);
+    readOnlyFile.Destroy(true);
+
+    bbeTestCheck(!std::filesystem::exists(TestUtils::GetTempFilePath("mmf_grow.bin")));
+}
+
+static void TestReadOnlyRejectsInvalidFiles()
+{
+    const std::string path = TestUtils::GetTempFilePath("mmf_invalid.bin");
+
+    MemoryMappedFile missingFile;
+    missingFile.Init(StringUtils::Utf8ToWide(path), 0, MemoryMappedFile::Mode::ReadOnly);
+    bbeTestCheck(!missingFile.IsMapped());
+
+    for (uint64_t fileSize : { 0ULL, 8ULL, 4096ULL })
+    {
+        {
+            std::ofstream out{ path, std::ios::binary | std::ios::trunc };
+            const std::vector<char> garbage(fileSize, 'x');
+            out.write(garbage.data(), garbage.size());
+        }
+
+        MemoryMappedFile file;
+        file.Init(StringUtils::Utf8ToWide(path), 0, MemoryMappedFile::Mode::ReadOnly);
+        bbeTestCheck(!file.IsMapped());
+        file.Destroy(false);
+    }
+    std::filesystem::remove(path);
+}
+
+#if !defined(_WIN32)
+static void TestFailedGrowthKeepsMapping()
+{
+    const std::wstring path = GetTestFilePath("mmf_limit.bin");
+
+    MemoryMappedFile file;
+    file.Init(path);
+    bbeTestCheck(file.IsMapped());
+
+    const uint64_t dataSize = 1000;
+    FillPattern(file, 0, dataSize);
+    file.SetSize(dataSize);
+    const uint64_t fileSize = file.GetCurrentFileSize();
+
+    // files can't grow past the current size anymore: ftruncate fails with EFBIG instead of raising SIGXFSZ
+    rlimit oldLimit = {};
+    getrlimit(RLIMIT_FSIZE, &oldLimit);
+    signal(SIGXFSZ, SIG_IGN);
+    rlimit limit = oldLimit;
+    limit.rlim_cur = fileSize;
+    setrlimit(RLIMIT_FSIZE, &limit);
+
+    const bool grown = file.GrowMapping(fileSize * 4);
+
+    setrlimit(RLIMIT_FSIZE, &oldLimit);
+    signal(SIGXFSZ, SIG_DFL);
+
+    bbeTestCheck(!grown);
+    bbeTestCheck(file.IsMapped());
+    bbeTestCheck(file.GetCurrentFileSize() == fileSize);
+    bbeTestCheck(file.GetSize() == dataSize);
+    bbeTestCheck(CheckPattern(file, 0, dataSize));
+
+    // and it can grow again once the limit is lifted
+    bbeTestCheck(file.GrowMapping(fileSize * 4));
+    bbeTestCheck(file.GetCurrentFileSize() > fileSize);
+    bbeTestCheck(CheckPattern(file, 0, dataSize));
+
+    file.Destroy(true);
+}
+#endif
+
+int main()
+{
+    g_Log.Initialize(TestUtils::GetTempFilePath("memorymappedfiletests.txt").c_str(), false);
+
+    return TestUtils::RunTests({
+        { "CreateGrowAndReopen", TestCreateGrowAndReopen },
+        { "ReadOnlyRejectsInvalidFiles", TestReadOnlyRejectsInvalidFiles },
+#if !defined(_WIN32)
+        { "FailedGrowthKeepsMapping", TestFailedGrowthKeepsMapping },
+#endif
+    });
+}
@@ -0,0 +1,89 @@
+// Creating & looking up 100k objects by ObjectID, headless: same containers as Scene (visuals array + ObjectID -> Visual* index),
+// with a stand-in for Visual. Compared against what it replaced: a random_generator per ID & a linear scan per lookup
+
+struct FakeVisual
+{
+    ObjectID m_ObjectID;
+    uint8_t m_Payload[128];
+};
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestUtils::ParseQuickArg(argc, argv);
+    const uint32_t nbObjects = quick ? 10'000 : 100'000;
+
+    // the linear scan is O(n) per lookup: only sample it
+    const uint32_t nbLinearLookups = quick ? 100 : 1000;
+
+    TestUtils::PrintBenchmarkHeader(StringFormat("ObjectIDs: create & look up %u objects", nbObjects));
+
+    std::vector<ObjectID> ids(nbObjects);
+    const double randomGeneratorSeconds = TestUtils::MeasureSeconds([&]
+        {
+            for (ObjectID& id : ids)
+            {
+                id = boost::uuids::random_generator{}();
+            }
+        });
+    const double generateSeconds = TestUtils::MeasureSeconds([&]
+        {
+            for (ObjectID& id : ids)
+            {
+                id = GenerateObjectID();
+            }
+        });
+
+    std::vector<FakeVisual> visualsPool(nbObjects);
+    std::vector<FakeVisual*> allVisuals;
+    std::unordered_map<ObjectID, FakeVisual*, ObjectIDHash> visualsByID;
+    const double createSeconds = TestUtils::MeasureSeconds([&]
+        {
+            allVisuals.reserve(nbObjects);
+            for (uint32_t i = 0; i < nbObjects; ++i)
+            {
+                FakeVisual* visual = &visualsPool[i];
+                visual->m_ObjectID = GenerateObjectID();
+                visualsByID.emplace(visual->m_ObjectID, visual);
+                allVisuals.push_back(visual);
+            }
+        });
+
+    // lookups in random order, so they don't walk the table sequentially
+    std::vector<ObjectID> lookupIDs;
+    for (const FakeVisual* visual : allVisuals)
+    {
+        lookupIDs.push_back(visual->m_ObjectID);
+    }
+    std::shuffle(lookupIDs.begin(), lookupIDs.end(), RandomGenerator{ 42 });
+
+    uint32_t nbFound = 0;
+    const double indexLookupSeconds = TestUtils::MeasureSeconds([&]
+        {
+            for (const ObjectID& id : lookupIDs)
+            {
+                auto it = visualsByID.find(id);
+                nbFound += it != visualsByID.end() && it->second->m_ObjectID == id;
+            }
+        });
+    bbeTestCheck(nbFound == nbObjects);
+
+    nbFound = 0;
+    const double linearLookupSeconds = TestUtils::MeasureSeconds([&]
+        {
+            for (uint32_t i = 0; i < nbLinearLookups; ++i)
+            {
+                const ObjectID& id = lookupIDs[i];
+                auto it = std::find_if(allVisuals.begin(), allVisuals.end(), [&](const FakeVisual* v) { return v->m_ObjectID == id; });
+                nbFound += it != allVisuals.end();
+            }
+        });
+    bbeTestCheck(nbFound == nbLinearLookups);
+
+    printf("%-40s %12.1f ns/id\n", "boost::uuids::random_generator", randomGeneratorSeconds * 1e9 / nbObjects);
+    printf("%-40s %12.1f ns/id\n", "GenerateObjectID", generateSeconds * 1e9 / nbObjects);
+    printf("%-40s %12.1f ns/object\n", "create + index", createSeconds * 1e9 / nbObjects);
+    printf("%-40s %12.1f ns/lookup\n", "lookup, ObjectID index", indexLookupSeconds * 1e9 / nbObjects);
+    printf("%-40s %12.1f ns/lookup\n", "lookup, linear scan", linearLookupSeconds * 1e9 / nbLinearLookups);
+
+    return 0;
+}
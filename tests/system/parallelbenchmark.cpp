@@ -0,0 +1,74 @@
+// ParallelUtils scaling from 1 to N workers: a transform-like ParallelFor, ParallelReduce, ParallelSort & ParallelInclusiveScan, each against its serial loop
+
+struct Transform
+{
+    float m_Position[3];
+    float m_Scale;
+    float m_World[4];
+};
+
+static void UpdateTransform(Transform& transform)
+{
+    // a few dozen flops, like a local to world update
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        transform.m_World[i] = transform.m_Position[i % 3] * transform.m_Scale + transform.m_World[i] * 0.5f;
+        transform.m_World[i] = std::sqrt(std::abs(transform.m_World[i]) + 1.0f);
+    }
+}
+
+template <typename Func>
+static double MeasureMs(uint32_t nbRepeats, Func&& func)
+{
+    func(); // warm up
+    return TestUtils::MeasureSeconds([&]
+        {
+            for (uint32_t i = 0; i < nbRepeats; ++i)
+            {
+                func();
+            }
+        }) * 1e3 / nbRepeats;
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestUtils::ParseQuickArg(argc, argv);
+    const uint32_t count = quick ? 100000 : 4000000;
+    const uint32_t nbRepeats = quick ? 2 : 20;
+
+    std::vector<Transform> transforms(count);
+    RandomGenerator{ 0 }.FillFloats(reinterpret_cast<float*>(transforms.data()), transforms.size() * sizeof(Transform) / sizeof(float));
+
+    std::vector<uint32_t> unsorted(count);
+    RandomGenerator{ 1 }.FillUInts(unsorted.data(), count, UINT32_MAX);
+    std::vector<uint32_t> sorted(count);
+
+    std::vector<uint64_t> scanned(count);
+
+    TestUtils::PrintBenchmarkHeader(StringFormat("ParallelUtils, %u items (ms per call)", count));
+    printf("%-8s %12s %12s %12s %12s\n", "workers", "for", "reduce", "sort", "scan");
+
+    auto Reduce = [&] { return ParallelUtils::ParallelReduce(0, count, 0.0, [&](uint32_t i) { return (double)transforms[i].m_World[0]; }, std::plus<double>{}); };
+    double reduceSink = 0.0;
+
+    const double serialFor = MeasureMs(nbRepeats, [&] { std::for_each(transforms.begin(), transforms.end(), UpdateTransform); });
+    const double serialReduce = MeasureMs(nbRepeats, [&] { reduceSink += std::accumulate(transforms.begin(), transforms.end(), 0.0, [](double sum, const Transform& t) { return sum + t.m_World[0]; }); });
+    const double serialSort = MeasureMs(nbRepeats, [&] { sorted = unsorted; std::sort(sorted.begin(), sorted.end()); });
+    const double serialScan = MeasureMs(nbRepeats, [&] { std::inclusive_scan(unsorted.begin(), unsorted.end(), scanned.begin(), std::plus<>{}, 0ULL); });
+    printf("%-8s %12.3f %12.3f %12.3f %12.3f\n", "serial", serialFor, serialReduce, serialSort, serialScan);
+
+    const uint32_t maxWorkers = std::max(std::thread::hardware_concurrency(), 1U);
+    for (uint32_t nbWorkers = 1; nbWorkers <= maxWorkers; nbWorkers *= 2)
+    {
+        TestUtils::ResetTasksExecutor(nbWorkers);
+
+        const double parallelFor = MeasureMs(nbRepeats, [&] { ParallelUtils::ParallelFor(0, count, [&](uint32_t i) { UpdateTransform(transforms[i]); }); });
+        const double parallelReduce = MeasureMs(nbRepeats, [&] { reduceSink += Reduce(); });
+        const double parallelSort = MeasureMs(nbRepeats, [&] { sorted = unsorted; ParallelUtils::ParallelSort(sorted.begin(), sorted.end()); });
+        const double parallelScan = MeasureMs(nbRepeats, [&] { ParallelUtils::ParallelInclusiveScan(unsorted.begin(), unsorted.end(), scanned.begin(), 0ULL); });
+        printf("%-8u %12.3f %12.3f %12.3f %12.3f\n", nbWorkers, parallelFor, parallelReduce, parallelSort, parallelScan);
+    }
+    TestUtils::DoNotOptimize(reduceSink);
+
+    return 0;
+}
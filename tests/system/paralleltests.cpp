@@ -0,0 +1,158 @@
+// ParallelUtils against their serial equivalents, with 1 to N workers, and called from within running tasks
+
+static uint32_t GetMaxNbWorkers()
+{
+    return std::max(std::thread::hardware_concurrency(), 4U);
+}
+
+static void TestParallelForVisitsEachIndexOnce()
+{
+    for (uint32_t nbWorkers = 1; nbWorkers <= GetMaxNbWorkers(); nbWorkers *= 2)
+    {
+        TestUtils::ResetTasksExecutor(nbWorkers);
+
+        for (uint32_t count : { 0U, 1U, 63U, 64U, 1000U, 100000U })
+        {
+            std::vector<std::atomic<uint32_t>> nbVisits(count);
+            ParallelUtils::ParallelFor(0, count, [&](uint32_t i) { ++nbVisits[i]; });
+
+            uint32_t nbWrongVisits = 0;
+            for (const std::atomic<uint32_t>& visits : nbVisits)
+            {
+                nbWrongVisits += visits != 1;
+            }
+            bbeTestCheck(nbWrongVisits == 0);
+        }
+
+        // explicit grain size & offset range: chunks tile [begin, end) exactly
+        std::atomic<uint64_t> sum = 0;
+        std::atomic<uint32_t> nbRanges = 0;
+        ParallelUtils::ParallelForRange(100, 1100, [&](uint32_t begin, uint32_t end)
+            {
+                bbeTestCheck(end - begin <= 7);
+                ++nbRanges;
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    sum += i;
+                }
+            }, 7);
+        bbeTestCheck(sum == (100ULL + 1099) * 1000 / 2);
+        bbeTestCheck(nbRanges == (1000 + 6) / 7);
+    }
+}
+
+static void TestParallelReduceIsDeterministic()
+{
+    // float sums depend on the order they're added in: the same chunks, combined in the same order, give the same bits whoever ran them
+    std::vector<float> values(100000);
+    RandomGenerator{ 5 }.FillFloats(values.data(), values.size(), -1.0f, 1.0f);
+
+    auto Reduce = [&]
+    {
+        return ParallelUtils::ParallelReduce(0, (uint32_t)values.size(), 0.0f, [&](uint32_t i) { return values[i]; }, std::plus<float>{}, 1000);
+    };
+
+    TestUtils::ResetTasksExecutor(1);
+    const float reference = Reduce();
+    bbeTestCheck(std::abs(reference - std::accumulate(values.begin(), values.end(), 0.0f)) < 0.1f);
+
+    for (uint32_t nbWorkers = 2; nbWorkers <= GetMaxNbWorkers(); nbWorkers *= 2)
+    {
+        TestUtils::ResetTasksExecutor(nbWorkers);
+        for (uint32_t i = 0; i < 10; ++i)
+        {
+            bbeTestCheck(Reduce() == reference);
+        }
+    }
+}
+
+static void TestParallelSort()
+{
+    RandomGenerator random{ 6 };
+
+    for (uint32_t nbWorkers = 1; nbWorkers <= GetMaxNbWorkers(); nbWorkers *= 2)
+    {
+        TestUtils::ResetTasksExecutor(nbWorkers);
+
+        for (uint32_t count : { 0U, 1U, 2047U, 100000U })
+        {
+            std::vector<uint32_t> values(count);
+            random.FillUInts(values.data(), count, 1000); // lots of duplicates
+
+            std::vector<uint32_t> expected = values;
+            std::sort(expected.begin(), expected.end(), std::greater<>{});
+
+            ParallelUtils::ParallelSort(values.begin(), values.end(), std::greater<>{});
+            bbeTestCheck(values == expected);
+        }
+    }
+}
+
+static void TestParallelScans()
+{
+    RandomGenerator random{ 7 };
+
+    for (uint32_t nbWorkers = 1; nbWorkers <= GetMaxNbWorkers(); nbWorkers *= 2)
+    {
+        TestUtils::ResetTasksExecutor(nbWorkers);
+
+        for (uint32_t count : { 0U, 1U, 1023U, 100000U })
+        {
+            std::vector<uint32_t> values(count);
+            random.FillUInts(values.data(), count, 100);
+
+            std::vector<uint64_t> expectedInclusive(count);
+            std::vector<uint64_t> expectedExclusive(count);
+            std::inclusive_scan(values.begin(), values.end(), expectedInclusive.begin(), std::plus<>{}, 10ULL);
+            std::exclusive_scan(values.begin(), values.end(), expectedExclusive.begin(), 10ULL);
+
+            std::vector<uint64_t> inclusive(count);
+            ParallelUtils::ParallelInclusiveScan(values.begin(), values.end(), inclusive.begin(), 10ULL);
+            bbeTestCheck(inclusive == expectedInclusive);
+
+            // in place
+            std::vector<uint64_t> exclusive(values.begin(), values.end());
+            ParallelUtils::ParallelExclusiveScan(exclusive.begin(), exclusive.end(), exclusive.begin(), 10ULL);
+            bbeTestCheck(exclusive == expectedExclusive);
+        }
+    }
+}
+
+static void TestNestedCallsFromTasks()
+{
+    // every worker busy in a task that itself waits on parallel loops: must degrade to serial, not deadlock
+    for (uint32_t nbWorkers : { 1U, 2U, 4U })
+    {
+        TestUtils::ResetTasksExecutor(nbWorkers);
+
+        static const uint32_t NbOuter = 16;
+        static const uint32_t NbInner = 1000;
+        std::atomic<uint64_t> nbInnerDone = 0;
+
+        tf::Taskflow taskflow;
+        for (uint32_t t = 0; t < nbWorkers * 2; ++t)
+        {
+            taskflow.emplace([&]
+                {
+                    ParallelUtils::ParallelFor(0, NbOuter, [&](uint32_t)
+                        {
+                            ParallelUtils::ParallelFor(0, NbInner, [&](uint32_t) { ++nbInnerDone; }, 10);
+                        }, 1);
+                });
+        }
+        g_TasksExecutor.run(taskflow).wait();
+
+        bbeTestCheck(nbInnerDone == (uint64_t)nbWorkers * 2 * NbOuter * NbInner);
+    }
+}
+
+int main()
+{
+    return TestUtils::RunTests({
+        { "ParallelForVisitsEachIndexOnce", TestParallelForVisitsEachIndexOnce },
+        { "ParallelReduceIsDeterministic", TestParallelReduceIsDeterministic },
+        { "ParallelSort", TestParallelSort },
+        { "ParallelScans", TestParallelScans },
+        { "NestedCallsFromTasks", TestNestedCallsFromTasks },
+    });
+}
@@ -0,0 +1,92 @@
+// Random values per second across threads: the old shared mt19937_64 (behind a lock, the least it needed to be correct) vs the per-thread generators, one value at a time & in batches
+
+static const uint32_t BatchSize = 4096;
+
+// Every thread produces nbValuesPerThread values, all threads start together. Returns the total in M values/s
+template <typename Func>
+static double MeasureMValuesPerSecond(uint32_t nbThreads, uint64_t nbValuesPerThread, Func&& func)
+{
+    std::vector<std::thread> threads;
+    threads.reserve(nbThreads);
+    Barrier startBarrier{ nbThreads + 1 };
+
+    for (uint32_t i = 0; i < nbThreads; ++i)
+    {
+        threads.emplace_back([&]
+            {
+                startBarrier.ArriveAndWait();
+                func(nbValuesPerThread);
+            });
+    }
+
+    const double seconds = TestUtils::MeasureSeconds([&]
+        {
+            startBarrier.ArriveAndWait();
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+        });
+
+    return (double)nbThreads * nbValuesPerThread / seconds / 1e6;
+}
+
+static std::mt19937_64 gs_SharedMT{ 0 };
+static std::mutex gs_SharedMTLock;
+
+static void SharedMTFloats(uint64_t nbValues)
+{
+    std::uniform_real_distribution<float> distribution{ 0.0f, 1.0f };
+
+    float sum = 0.0f;
+    for (uint64_t i = 0; i < nbValues; ++i)
+    {
+        std::lock_guard<std::mutex> lock{ gs_SharedMTLock };
+        sum += distribution(gs_SharedMT);
+    }
+    TestUtils::DoNotOptimize(sum);
+}
+
+static void ThreadRandomFloats(uint64_t nbValues)
+{
+    float sum = 0.0f;
+    for (uint64_t i = 0; i < nbValues; ++i)
+    {
+        sum += RandomFloat();
+    }
+    TestUtils::DoNotOptimize(sum);
+}
+
+static void ThreadBatchFloats(uint64_t nbValues)
+{
+    std::vector<float> values(BatchSize);
+
+    RandomGenerator& generator = RandomUtils::GetThreadGenerator();
+    for (uint64_t i = 0; i < nbValues; i += BatchSize)
+    {
+        generator.FillFloats(values.data(), BatchSize);
+        TestUtils::DoNotOptimize(values[i % BatchSize]);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = TestUtils::ParseQuickArg(argc, argv);
+    const uint64_t nbValuesPerThread = quick ? (1ULL << 16) : (1ULL << 26);
+
+    TestUtils::PrintBenchmarkHeader("Random floats (M values/s, all threads)");
+    printf("%-8s %20s %16s %16s\n", "threads", "locked mt19937_64", "RandomFloat", "FillFloats");
+
+    const uint32_t maxThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    for (uint32_t nbThreads = 1; nbThreads <= maxThreads; nbThreads *= 2)
+    {
+        // the locked version doesn't scale, no need to wait on it for as long
+        const double sharedMT = MeasureMValuesPerSecond(nbThreads, nbValuesPerThread / 8, SharedMTFloats);
+        const double threadRandom = MeasureMValuesPerSecond(nbThreads, nbValuesPerThread, ThreadRandomFloats);
+        const double threadBatch = MeasureMValuesPerSecond(nbThreads, nbValuesPerThread, ThreadBatchFloats);
+
+        printf("%-8u %20.1f %16.1f %16.1f\n", nbThreads, sharedMT, threadRandom, threadBatch);
+    }
+
+    return 0;
+}
@@ -0,0 +1,149 @@
+// Same seed, same values: across the AVX2 & scalar batch paths, and across threads whatever order they start in
+
+static void TestBatchPathsBitExact()
+{
+    // every count from all-scalar (< 8) to AVX2 + scalar tail. The values at a given index must not depend on which path produced them
+    static const uint32_t MaxCount = 75;
+
+    RandomGenerator reference{ 1234 };
+    std::vector<float> referenceFloats(MaxCount);
+    RandomGenerator{ reference }.FillFloats(referenceFloats.data(), MaxCount, -3.0f, 7.5f);
+    std::vector<uint32_t> referenceUInts(MaxCount);
+    RandomGenerator{ reference }.FillUInts(referenceUInts.data(), MaxCount, 1000);
+
+    uint32_t nbMismatches = 0;
+    for (uint32_t count = 1; count < MaxCount; ++count)
+    {
+        std::vector<float> floats(count);
+        RandomGenerator{ reference }.FillFloats(floats.data(), count, -3.0f, 7.5f);
+        nbMismatches += memcmp(floats.data(), referenceFloats.data(), count * sizeof(float)) != 0;
+
+        std::vector<uint32_t> uints(count);
+        RandomGenerator{ reference }.FillUInts(uints.data(), count, 1000);
+        nbMismatches += memcmp(uints.data(), referenceUInts.data(), count * sizeof(uint32_t)) != 0;
+    }
+    bbeTestCheck(nbMismatches == 0);
+
+    for (uint32_t i = 0; i < MaxCount; ++i)
+    {
+        bbeTestCheck(referenceFloats[i] >= -3.0f && referenceFloats[i] < 7.5f);
+        bbeTestCheck(referenceUInts[i] < 1000);
+    }
+}
+
+static void TestBatchGoldenValues()
+{
+    // pins the output, so changes in the instruction set, compiler or FP flags that alter the sequence are caught
+    RandomGenerator generator{ 42 };
+
+    std::vector<float> floats(1000);
+    generator.FillFloats(floats.data(), floats.size(), -1.0f, 1.0f);
+    std::vector<bbeVector3> vectors(333);
+    generator.FillVector3s(vectors.data(), vectors.size(), bbeVector3{ -10.0f, 0.0f, 5.0f }, bbeVector3{ 10.0f, 1.0f, 6.0f });
+    std::vector<uint32_t> uints(1000);
+    generator.FillUInts(uints.data(), uints.size(), 12345);
+
+    const uint64_t floatsHash = HashUtils::XXH3_64(floats.data(), floats.size() * sizeof(float));
+    const uint64_t vectorsHash = HashUtils::XXH3_64(vectors.data(), vectors.size() * sizeof(bbeVector3));
+    const uint64_t uintsHash = HashUtils::XXH3_64(uints.data(), uints.size() * sizeof(uint32_t));
+
+    bbeTestCheck(floatsHash == 0xAEE1BB251B279990ULL);
+    bbeTestCheck(vectorsHash == 0xFCF927A92601D5B3ULL);
+    bbeTestCheck(uintsHash == 0x597CED81F1B36EDFULL);
+    bbeTestCheck(generator.Next() == 0xCD0FEDA93006C6B6ULL);
+}
+
+static const uint32_t NbWorkers = 4;
+static const uint32_t NbValuesPerThread = 16;
+
+using ThreadValues = std::array<uint64_t, NbValuesPerThread>;
+
+// One task per worker: each one blocks in the barrier until all are running, so no worker can take 2
+static std::vector<ThreadValues> GetWorkersValues(uint64_t seed, bool staggerStarts)
+{
+    RandomUtils::SetMasterSeed(seed);
+
+    std::vector<ThreadValues> values(NbWorkers);
+    Barrier barrier{ NbWorkers };
+
+    tf::Taskflow taskflow;
+    for (uint32_t i = 0; i < NbWorkers; ++i)
+    {
+        taskflow.emplace([&, i]
+            {
+                barrier.ArriveAndWait();
+
+                // different arrival order than the previous run
+                if (staggerStarts)
+                    std::this_thread::sleep_for(std::chrono::milliseconds{ (NbWorkers - i) * 2 });
+
+                const int workerIdx = g_TasksExecutor.this_worker_id();
+                for (uint64_t& value : values[workerIdx])
+                {
+                    value = RandomUtils::GetThreadGenerator().Next();
+                }
+            });
+    }
+    g_TasksExecutor.run(taskflow).wait();
+
+    return values;
+}
+
+static void TestThreadStreamsIndependentOfArrivalOrder()
+{
+    TestUtils::ResetTasksExecutor(NbWorkers);
+
+    const std::vector<ThreadValues> run1 = GetWorkersValues(777, false);
+    const std::vector<ThreadValues> run2 = GetWorkersValues(777, true);
+    bbeTestCheck(run1 == run2);
+
+    // every worker has its own stream
+    for (uint32_t i = 0; i < NbWorkers; ++i)
+    {
+        for (uint32_t j = i + 1; j < NbWorkers; ++j)
+        {
+            bbeTestCheck(run1[i] != run1[j]);
+        }
+    }
+
+    // and the seed matters
+    bbeTestCheck(GetWorkersValues(778, false) != run1);
+}
+
+static void TestNamedThreadStreams()
+{
+    RandomUtils::SetMasterSeed(99);
+    const uint64_t mainValue = RandomUtils::GetThreadGenerator().Next();
+
+    auto GetNamedThreadValue = [](const char* threadName)
+    {
+        uint64_t value = 0;
+        std::thread{ [&]
+            {
+                RandomUtils::SetThreadStream(threadName);
+                value = RandomUtils::GetThreadGenerator().Next();
+            } }.join();
+        return value;
+    };
+
+    const uint64_t workerAValue = GetNamedThreadValue("BG Async Worker 0");
+    const uint64_t workerBValue = GetNamedThreadValue("BG Async Worker 1");
+    bbeTestCheck(workerAValue != workerBValue);
+    bbeTestCheck(workerAValue != mainValue);
+
+    // replayed after re-seeding, here & in new threads with the same names
+    RandomUtils::SetMasterSeed(99);
+    bbeTestCheck(RandomUtils::GetThreadGenerator().Next() == mainValue);
+    bbeTestCheck(GetNamedThreadValue("BG Async Worker 1") == workerBValue);
+    bbeTestCheck(GetNamedThreadValue("BG Async Worker 0") == workerAValue);
+}
+
+int main()
+{
+    return TestUtils::RunTests({
+        { "BatchPathsBitExact", TestBatchPathsBitExact },
+        { "BatchGoldenValues", TestBatchGoldenValues },
+        { "ThreadStreamsIndependentOfArrivalOrder", TestThreadStreamsIndependentOfArrivalOrder },
+        { "NamedThreadStreams", TestNamedThreadStreams },
+    });
+}
@@ -0,0 +1,57 @@
+#include <system/spikedetector.h>
+
+static void TestNoDetectionDuringWarmUp()
+{
+    SpikeDetector detector;
+    float threshold = 0.0f;
+    for (uint32_t i = 0; i < SpikeDetector::MinValuesBeforeDetection; ++i)
+    {
+        bbeTestCheck(!detector.IsSpike(1000.0f, 2.0f, threshold));
+        detector.AddValue(16.0f);
+    }
+    bbeTestCheck(detector.IsSpike(1000.0f, 2.0f, threshold));
+}
+
+static void TestThresholdIsMultipleOfP95()
+{
+    SpikeDetector detector;
+
+    // 0..99: p95 == 95
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        detector.AddValue((float)i);
+    }
+
+    float threshold = 0.0f;
+    bbeTestCheck(!detector.IsSpike(190.0f, 2.0f, threshold));
+    bbeTestCheck(threshold == 190.0f);
+    bbeTestCheck(detector.IsSpike(190.5f, 2.0f, threshold));
+}
+
+static void TestRollingHistory()
+{
+    SpikeDetector detector;
+    for (uint32_t i = 0; i < SpikeDetector::NbHistoryValues; ++i)
+    {
+        detector.AddValue(100.0f);
+    }
+
+    // old values roll out: the threshold follows the most recent frames
+    for (uint32_t i = 0; i < SpikeDetector::NbHistoryValues; ++i)
+    {
+        detector.AddValue(10.0f);
+    }
+
+    float threshold = 0.0f;
+    bbeTestCheck(detector.IsSpike(25.0f, 2.0f, threshold));
+    bbeTestCheck(threshold == 20.0f);
+}
+
+int main()
+{
+    return TestUtils::RunTests({
+        { "NoDetectionDuringWarmUp", TestNoDetectionDuringWarmUp },
+        { "ThresholdIsMultipleOfP95", TestThresholdIsMultipleOfP95 },
+        { "RollingHistory", TestRollingHistory },
+    });
+}
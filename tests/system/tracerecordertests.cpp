@@ -0,0 +1,87 @@
+static const char* gs_EventNames[] = { "ev0", "ev1", "ev2", "ev3" };
+
+static void TestRingsOnlyAllocatedWhileTracing()
+{
+    TraceRecorder::SetEnabled(false);
+
+    std::thread{ []
+        {
+            g_TraceRecorder.SetCurrentThreadName("Not Tracing");
+            const ScopedTraceEvent traceEvent{ "ignored", TraceRecorder::Scope };
+        } }.join();
+    bbeTestCheck(g_TraceRecorder.GetNbAllocatedRings() == 0);
+
+    TraceRecorder::SetEnabled(true);
+    std::thread{ []
+        {
+            g_TraceRecorder.SetCurrentThreadName("Tracing");
+            const ScopedTraceEvent traceEvent{ "recorded", TraceRecorder::Scope };
+        } }.join();
+    bbeTestCheck(g_TraceRecorder.GetNbAllocatedRings() == 1);
+
+    TraceRecorder::SetEnabled(false);
+}
+
+static void TestSnapshotsOnlyContainIntactEvents()
+{
+    // Each event's duration is tied to its name. A slot torn by the writer lapping the snapshot would break that
+    std::atomic<bool> exit = false;
+    std::atomic<uint64_t> nbRecorded = 0;
+    std::thread writer{ [&]
+        {
+            g_TraceRecorder.SetCurrentThreadName("Writer");
+            for (uint64_t i = 0; !exit; ++i)
+            {
+                const uint64_t beginNs = i * 1000;
+                g_TraceRecorder.RecordEvent(gs_EventNames[i % 4], TraceRecorder::Scope, beginNs, beginNs + 100 * (i % 4 + 1));
+                nbRecorded.store(i + 1, std::memory_order_relaxed);
+            }
+        } };
+
+    // make sure the ring wrapped around at least once
+    while (nbRecorded.load(std::memory_order_relaxed) < 100000)
+    {
+        std::this_thread::yield();
+    }
+
+    const std::string filePath = TestUtils::GetTempFilePath("trace.json");
+    uint32_t nbEvents = 0;
+    uint32_t nbTornEvents = 0;
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        bbeTestCheck(g_TraceRecorder.WriteChromeTrace(filePath.c_str()));
+
+        std::ifstream file{ filePath };
+        for (std::string line; std::getline(file, line);)
+        {
+            uint32_t nameIdx = 0;
+            double durUs = 0.0;
+            const size_t namePos = line.find("\"name\":\"ev");
+            const size_t durPos = line.find("\"dur\":");
+            if (namePos == std::string::npos || durPos == std::string::npos)
+                continue;
+
+            sscanf(line.c_str() + namePos, "\"name\":\"ev%u\"", &nameIdx);
+            sscanf(line.c_str() + durPos, "\"dur\":%lf", &durUs);
+
+            ++nbEvents;
+            nbTornEvents += std::abs(durUs - 0.1 * (nameIdx + 1)) > 0.01;
+        }
+    }
+    exit = true;
+    writer.join();
+    std::filesystem::remove(filePath);
+
+    bbeTestCheck(nbEvents > 0);
+    bbeTestCheck(nbTornEvents == 0);
+}
+
+int main()
+{
+    g_Log.Initialize(TestUtils::GetTempFilePath("tracerecordertests.txt").c_str(), false);
+
+    return TestUtils::RunTests({
+        { "RingsOnlyAllocatedWhileTracing", TestRingsOnlyAllocatedWhileTracing },
+        { "SnapshotsOnlyContainIntactEvents", TestSnapshotsOnlyContainIntactEvents },
+    });
+}
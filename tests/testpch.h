@@ -0,0 +1,92 @@
+#pragma once
+
+// Force included in every test & benchmark, in place of src/pch.h.
+// Only pulls the portable part of the engine (no Windows, no D3D12), so tests & benchmarks build and run headless on Linux too
+
+#define _CRT_SECURE_NO_WARNINGS
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+
+// C Standard Lib
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// C++ STL
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#endif
+
+// TaskFlow task threading lib
+#include <extern/taskflow/taskflow.hpp>
+
+// Boost
+#include <extern/boost/container_hash/hash.hpp>
+#include <extern/boost/preprocessor.hpp>
+#include <extern/boost/static_string.hpp>
+#include <extern/boost/uuid/uuid.hpp>
+#include <extern/boost/uuid/uuid_generators.hpp>
+#include <extern/boost/uuid/uuid_io.hpp>
+
+// SPD Log
+#include <extern/spdlog/spdlog/spdlog.h>
+#include <extern/spdlog/spdlog/sinks/basic_file_sink.h>
+
+// Cereal serialization lib
+#define CEREAL_SERIALIZE_FUNCTION_NAME Serialize
+#include <extern/cereal/types/vector.hpp>
+#include <extern/cereal/types/string.hpp>
+#include <extern/cereal/archives/json.hpp>
+
+// SimpleMath needs DirectXMath, which only ships with the Windows SDK. The portable modules only rely on the vector layouts
+struct bbeVector2 { float x = 0.0f; float y = 0.0f; };
+struct bbeVector3 { float x = 0.0f; float y = 0.0f; float z = 0.0f; };
+struct bbeVector4 { float x = 0.0f; float y = 0.0f; float z = 0.0f; float w = 0.0f; };
+
+// typedefs
+using ObjectID = boost::uuids::uuid;
+using ClassID = uint32_t;
+
+#include <system/containers.h>
+#include <system/math.h>
+#include <system/hash.h>
+#include <system/random.h>
+#include <system/utils.h>
+#include <system/timer.h>
+#include <system/logger.h>
+#include <system/profiler.h>
+#include <system/criticalsection.h>
+
+#include <system/memcpy.h>
+#include <system/parallel.h>
+
+// Tests don't run a System: parallel helpers & friends go through the tests' own executor
+#define g_TasksExecutor TestUtils::GetTasksExecutor()
+
+#include <tests/testutils.h>
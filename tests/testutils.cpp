@@ -0,0 +1,77 @@
+#include <tests/testutils.h>
+
+namespace TestUtils
+{
+    static std::unique_ptr<tf::Executor> gs_TasksExecutor;
+    static uint32_t gs_NbFailures = 0;
+    static std::mutex gs_FailuresLock;
+
+    static void CreateTasksExecutor(uint32_t numWorkers)
+    {
+        gs_TasksExecutor.reset();
+        gs_TasksExecutor = std::make_unique<tf::Executor>(numWorkers);
+
+        // same as System: per thread random streams follow the workers' indices
+        RandomUtils::SetWorkerIndexGetter([] { return gs_TasksExecutor ? gs_TasksExecutor->this_worker_id() : -1; });
+    }
+
+    tf::Executor& GetTasksExecutor()
+    {
+        if (!gs_TasksExecutor)
+            CreateTasksExecutor(std::thread::hardware_concurrency());
+
+        return *gs_TasksExecutor;
+    }
+
+    void ResetTasksExecutor(uint32_t numWorkers)
+    {
+        CreateTasksExecutor(std::max(numWorkers, 1U));
+    }
+
+    void ReportFailure(const char* expression, const char* file, int line)
+    {
+        std::lock_guard<std::mutex> lock{ gs_FailuresLock };
+        ++gs_NbFailures;
+        fprintf(stderr, "%s(%d): check failed: %s\n", file, line, expression);
+    }
+
+    int RunTests(std::initializer_list<TestEntry> tests)
+    {
+        for (const TestEntry& test : tests)
+        {
+            const uint32_t nbFailuresBefore = gs_NbFailures;
+            const double seconds = MeasureSeconds(test.m_Function);
+            printf("[%s] %s (%.3f s)\n", gs_NbFailures == nbFailuresBefore ? "  OK  " : "FAILED", test.m_Name, seconds);
+        }
+
+        if (gs_NbFailures)
+            printf("%u check(s) failed\n", gs_NbFailures);
+
+        return gs_NbFailures ? 1 : 0;
+    }
+
+    bool ParseQuickArg(int argc, char** argv)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            if (strcmp(argv[i], "--quick") == 0)
+                return true;
+        }
+        return false;
+    }
+
+    std::string GetTempFilePath(const char* fileName)
+    {
+#if defined(_WIN32)
+        const std::filesystem::path dir = std::filesystem::temp_directory_path();
+#else
+        const std::filesystem::path dir = std::filesystem::exists("/dev/shm") ? std::filesystem::path{ "/dev/shm" } : std::filesystem::temp_directory_path();
+#endif
+        return (dir / StringFormat("bbetest_%s", fileName)).string();
+    }
+
+    void PrintBenchmarkHeader(const char* name)
+    {
+        printf("\n=== %s (%u hardware threads)\n", name, std::thread::hardware_concurrency());
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+// Minimal test & benchmark helpers. Every *tests.cpp / *benchmark.cpp file is its own executable, registered in ctest.
+// Tests: main() returns TestUtils::RunTests(...), which is non zero when any check failed.
+// Benchmarks: print their results to stdout. '--quick' (what ctest passes) shrinks them to a smoke run
+namespace TestUtils
+{
+    // Stand-in for g_System's executor. Reset it to run the same code with a different number of workers (i.e. scaling tests)
+    tf::Executor& GetTasksExecutor();
+    void ResetTasksExecutor(uint32_t numWorkers);
+
+    // Failed checks are reported & counted, but don't abort: one run shows every failure
+    void ReportFailure(const char* expression, const char* file, int line);
+
+    using TestFunction = void(*)();
+    struct TestEntry
+    {
+        const char* m_Name;
+        TestFunction m_Function;
+    };
+    int RunTests(std::initializer_list<TestEntry> tests);
+
+    bool ParseQuickArg(int argc, char** argv);
+
+    // Files that are created & removed by the tests themselves. tmpfs on Linux, so file tests measure the code and not the disk
+    std::string GetTempFilePath(const char* fileName);
+
+    inline double GetTimeSeconds()
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    template <typename Func>
+    double MeasureSeconds(Func&& func)
+    {
+        const double begin = GetTimeSeconds();
+        func();
+        return GetTimeSeconds() - begin;
+    }
+
+    // Keeps the optimizer from discarding benchmarked results
+    template <typename T>
+    void DoNotOptimize(const T& value)
+    {
+        static volatile const void* s_Sink;
+        s_Sink = &value;
+    }
+
+    void PrintBenchmarkHeader(const char* name);
+}
+
+#define bbeTestCheck(expression)                                                      \
+    do                                                                                \
+    {                                                                                 \
+        if (!(expression))                                                            \
+            TestUtils::ReportFailure(#expression, __FILE__, __LINE__);                 \
+    } while (0)